@@ -65,6 +65,41 @@ ODE_API dSpaceID dQuadTreeSpaceCreate (dSpaceID space, const dVector3 Center, co
 
 ODE_API dSpaceID dSweepAndPruneSpaceCreate( dSpaceID space, int axisorder );
 
+/**
+ * @brief Create a space indexing its geoms with a dynamic AABB tree.
+ *
+ * The tree is updated incrementally: a geom is only moved in the tree when
+ * its AABB leaves the enlarged AABB it was inserted with. This suits worlds
+ * mixing very large and very small geoms, for which the hash space
+ * degenerates. Geoms with infinite AABBs, such as planes, are kept out of
+ * the tree and tested against every other geom.
+ *
+ * @param space the parent space, or 0
+ * @returns the new space
+ * @ingroup collide
+ */
+ODE_API dSpaceID dAABBTreeSpaceCreate (dSpaceID space);
+
+/**
+ * @brief Set the margin added to the AABBs stored in an AABB tree space.
+ *
+ * Larger margins move geoms in the tree less often, but report more
+ * candidate pairs. The new margin applies to geoms inserted afterwards.
+ *
+ * @param space the AABB tree space
+ * @param margin the margin, in world units
+ * @ingroup collide
+ */
+ODE_API void dAABBTreeSpaceSetMargin (dSpaceID space, dReal margin);
+
+/**
+ * @brief Get the margin added to the AABBs stored in an AABB tree space.
+ * @param space the AABB tree space
+ * @returns the margin
+ * @ingroup collide
+ */
+ODE_API dReal dAABBTreeSpaceGetMargin (dSpaceID space);
+
 
 
 ODE_API void dSpaceDestroy (dSpaceID);
@@ -161,6 +196,7 @@ ODE_API dGeomID dSpaceGetGeom (dSpaceID, int i);
  *  @li dHashSpaceClass
  *  @li dSweepAndPruneSpaceClass
  *  @li dQuadTreeSpaceClass
+ *  @li dAABBTreeSpaceClass
  *  @li dFirstUserClass
  *  @li dLastUserClass
  *
@@ -0,0 +1,586 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001-2003 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+/*
+
+dynamic AABB tree space. the geoms are the leaves of a binary tree of
+enlarged AABBs, kept balanced with tree rotations. a geom is only moved in
+the tree when its AABB leaves its enlarged AABB, so the cost of a step is
+proportional to the number of geoms that moved a lot, plus one tree query
+per geom to find the overlapping pairs.
+
+*/
+
+#include <unordered_map>
+#include <vector>
+#include <gazebo/ode/common.h>
+#include <gazebo/ode/collision_space.h>
+#include <gazebo/ode/collision.h>
+#include "config.h"
+#include "collision_kernel.h"
+#include "collision_space_internal.h"
+
+#define GEOM_ENABLED(g) (((g)->gflags & GEOM_ENABLE_TEST_MASK) == GEOM_ENABLE_TEST_VALUE)
+
+// the geom is not in the tree yet
+#define AABBTREE_NO_PROXY (-1)
+// the geom has an infinite AABB and is kept out of the tree
+#define AABBTREE_INFINITE_PROXY (-2)
+
+// default margin added to the AABBs stored in the tree
+#define AABBTREE_DEFAULT_MARGIN REAL(0.05)
+
+
+static bool aabbIsInfinite (const dReal aabb[6])
+{
+  return aabb[0] <= -dInfinity || aabb[1] >= dInfinity ||
+    aabb[2] <= -dInfinity || aabb[3] >= dInfinity ||
+    aabb[4] <= -dInfinity || aabb[5] >= dInfinity;
+}
+
+
+// geoms that have zero or negative/invalid AABBs are skipped, as in the
+// hash space
+static bool aabbIsEmpty (const dReal aabb[6])
+{
+  return aabb[1] - aabb[0] <= 0 &&
+    aabb[3] - aabb[2] <= 0 &&
+    aabb[5] - aabb[4] <= 0;
+}
+
+
+static bool aabbOverlap (const dReal a[6], const dReal b[6])
+{
+  return a[0] <= b[1] && a[1] >= b[0] &&
+    a[2] <= b[3] && a[3] >= b[2] &&
+    a[4] <= b[5] && a[5] >= b[4];
+}
+
+
+static bool aabbContains (const dReal outer[6], const dReal inner[6])
+{
+  return outer[0] <= inner[0] && outer[1] >= inner[1] &&
+    outer[2] <= inner[2] && outer[3] >= inner[3] &&
+    outer[4] <= inner[4] && outer[5] >= inner[5];
+}
+
+
+static void aabbMerge (const dReal a[6], const dReal b[6], dReal out[6])
+{
+  out[0] = a[0] < b[0] ? a[0] : b[0];
+  out[1] = a[1] > b[1] ? a[1] : b[1];
+  out[2] = a[2] < b[2] ? a[2] : b[2];
+  out[3] = a[3] > b[3] ? a[3] : b[3];
+  out[4] = a[4] < b[4] ? a[4] : b[4];
+  out[5] = a[5] > b[5] ? a[5] : b[5];
+}
+
+
+// surface area of an AABB, used as the cost of a node
+static dReal aabbArea (const dReal a[6])
+{
+  dReal x = a[1] - a[0];
+  dReal y = a[3] - a[2];
+  dReal z = a[5] - a[4];
+  return 2 * (x*y + y*z + z*x);
+}
+
+//****************************************************************************
+// the tree
+
+struct dxAABBTreeNode {
+  dReal aabb[6];	// enlarged AABB of a leaf, union of the children else
+  int parent;		// parent node, -1 for the root. next free node if free
+  int child1;		// first child, -1 for a leaf
+  int child2;		// second child, -1 for a leaf
+  int height;		// 0 for a leaf, -1 for a free node
+  dxGeom *geom;		// geom of a leaf
+};
+
+
+struct dxAABBTreeSpace : public dxSpace {
+  dReal margin;		// margin added to the AABBs stored in the tree
+
+  dxAABBTreeSpace (dSpaceID _space);
+  ~dxAABBTreeSpace();
+
+  virtual void remove (dxGeom *);
+  void cleanGeoms();
+  void collide (void *data, dNearCallback *callback);
+  void collide2 (void *data, dxGeom *geom, dNearCallback *callback);
+
+private:
+  void updateProxy (dxGeom *g);
+  void removeProxy (dxGeom *g);
+
+  int allocateNode();
+  void freeNode (int node);
+  int insertLeaf (dxGeom *g);
+  void removeLeaf (int leaf);
+  void refit (int node);
+  int balance (int a);
+
+  // collide geom with the geoms of the leaves whose enlarged AABB overlaps
+  // its AABB. if skip is a leaf, only the leaves after it are considered,
+  // so that every pair is reported once.
+  void query (dxGeom *geom, int skip, void *data, dNearCallback *callback);
+
+  std::vector<dxAABBTreeNode> nodes;
+  int root;
+  int free_list;
+
+  // leaf of every geom seen by cleanGeoms(), or AABBTREE_INFINITE_PROXY
+  std::unordered_map<dxGeom*, int> leaves;
+
+  // geoms with infinite AABBs, kept out of the tree
+  std::vector<dxGeom*> infinite;
+
+  // traversal stack, kept to avoid allocations
+  std::vector<int> stack;
+};
+
+
+dSpaceID dAABBTreeSpaceCreate (dxSpace *space)
+{
+  return new dxAABBTreeSpace (space);
+}
+
+
+void dAABBTreeSpaceSetMargin (dxSpace *space, dReal margin)
+{
+  dAASSERT (space);
+  dUASSERT (space->type == dAABBTreeSpaceClass,
+	    "argument must be an AABB tree space");
+  dUASSERT (margin >= 0, "margin must be non-negative");
+  ((dxAABBTreeSpace*)space)->margin = margin;
+}
+
+
+dReal dAABBTreeSpaceGetMargin (dxSpace *space)
+{
+  dAASSERT (space);
+  dUASSERT (space->type == dAABBTreeSpaceClass,
+	    "argument must be an AABB tree space");
+  return ((dxAABBTreeSpace*)space)->margin;
+}
+
+
+dxAABBTreeSpace::dxAABBTreeSpace (dSpaceID _space) : dxSpace (_space)
+{
+  type = dAABBTreeSpaceClass;
+  margin = AABBTREE_DEFAULT_MARGIN;
+  root = -1;
+  free_list = -1;
+}
+
+
+dxAABBTreeSpace::~dxAABBTreeSpace()
+{
+  CHECK_NOT_LOCKED (this);
+  // destroy or unhook the geoms here, while remove() still reaches this
+  // class. the base destructor then finds an empty list.
+  dxGeom *g,*n;
+  for (g = first; g; g=n) {
+    n = g->next;
+    if (cleanup) dGeomDestroy (g);
+    else remove (g);
+  }
+}
+
+
+void dxAABBTreeSpace::remove (dxGeom *g)
+{
+  CHECK_NOT_LOCKED (this);
+  removeProxy (g);
+  dxSpace::remove (g);
+}
+
+//****************************************************************************
+// proxies
+
+void dxAABBTreeSpace::updateProxy (dxGeom *g)
+{
+  bool inf = aabbIsInfinite (g->aabb);
+  std::unordered_map<dxGeom*, int>::iterator it = leaves.find (g);
+  if (it != leaves.end()) {
+    int leaf = it->second;
+    if (leaf == AABBTREE_INFINITE_PROXY) {
+      if (inf) return;
+    }
+    else if (!inf && aabbContains (nodes[leaf].aabb, g->aabb)) {
+      // still inside its enlarged AABB
+      return;
+    }
+    removeProxy (g);
+  }
+
+  if (inf) {
+    infinite.push_back (g);
+    leaves[g] = AABBTREE_INFINITE_PROXY;
+  }
+  else {
+    leaves[g] = insertLeaf (g);
+  }
+}
+
+
+void dxAABBTreeSpace::removeProxy (dxGeom *g)
+{
+  std::unordered_map<dxGeom*, int>::iterator it = leaves.find (g);
+  if (it == leaves.end()) return;
+
+  if (it->second == AABBTREE_INFINITE_PROXY) {
+    for (size_t i = 0; i < infinite.size(); ++i) {
+      if (infinite[i] == g) {
+	infinite[i] = infinite.back();
+	infinite.pop_back();
+	break;
+      }
+    }
+  }
+  else {
+    removeLeaf (it->second);
+    freeNode (it->second);
+  }
+  leaves.erase (it);
+}
+
+//****************************************************************************
+// tree maintenance, after Box2D's b2DynamicTree
+
+int dxAABBTreeSpace::allocateNode()
+{
+  int node;
+  if (free_list >= 0) {
+    node = free_list;
+    free_list = nodes[node].parent;
+  }
+  else {
+    node = (int)nodes.size();
+    nodes.push_back (dxAABBTreeNode());
+  }
+
+  dxAABBTreeNode &n = nodes[node];
+  n.parent = -1;
+  n.child1 = -1;
+  n.child2 = -1;
+  n.height = 0;
+  n.geom = 0;
+  return node;
+}
+
+
+void dxAABBTreeSpace::freeNode (int node)
+{
+  nodes[node].parent = free_list;
+  nodes[node].height = -1;
+  nodes[node].geom = 0;
+  free_list = node;
+}
+
+
+int dxAABBTreeSpace::insertLeaf (dxGeom *g)
+{
+  int leaf = allocateNode();
+  dReal *aabb = nodes[leaf].aabb;
+  for (int i = 0; i < 6; i += 2) {
+    aabb[i] = g->aabb[i] - margin;
+    aabb[i+1] = g->aabb[i+1] + margin;
+  }
+  nodes[leaf].geom = g;
+
+  if (root < 0) {
+    root = leaf;
+    return leaf;
+  }
+
+  // find the best sibling with the surface area heuristic
+  dReal merged[6];
+  int index = root;
+  while (nodes[index].child1 >= 0) {
+    const dxAABBTreeNode &node = nodes[index];
+    dReal area = aabbArea (node.aabb);
+    aabbMerge (node.aabb, aabb, merged);
+    dReal combined = aabbArea (merged);
+
+    // cost of creating a new parent for this node and the new leaf
+    dReal cost = 2 * combined;
+
+    // minimum cost of pushing the leaf further down the tree
+    dReal inheritance = 2 * (combined - area);
+
+    dReal cost1, cost2;
+    {
+      const dxAABBTreeNode &child = nodes[node.child1];
+      aabbMerge (child.aabb, aabb, merged);
+      cost1 = inheritance + aabbArea (merged);
+      if (child.child1 >= 0) cost1 -= aabbArea (child.aabb);
+    }
+    {
+      const dxAABBTreeNode &child = nodes[node.child2];
+      aabbMerge (child.aabb, aabb, merged);
+      cost2 = inheritance + aabbArea (merged);
+      if (child.child1 >= 0) cost2 -= aabbArea (child.aabb);
+    }
+
+    if (cost < cost1 && cost < cost2) break;
+    index = cost1 < cost2 ? node.child1 : node.child2;
+  }
+  int sibling = index;
+
+  // create a new parent. this may reallocate the nodes.
+  int old_parent = nodes[sibling].parent;
+  int new_parent = allocateNode();
+  dxAABBTreeNode &p = nodes[new_parent];
+  p.parent = old_parent;
+  aabbMerge (nodes[leaf].aabb, nodes[sibling].aabb, p.aabb);
+  p.height = nodes[sibling].height + 1;
+  p.child1 = sibling;
+  p.child2 = leaf;
+  nodes[sibling].parent = new_parent;
+  nodes[leaf].parent = new_parent;
+
+  if (old_parent >= 0) {
+    if (nodes[old_parent].child1 == sibling)
+      nodes[old_parent].child1 = new_parent;
+    else
+      nodes[old_parent].child2 = new_parent;
+  }
+  else {
+    root = new_parent;
+  }
+
+  refit (new_parent);
+  return leaf;
+}
+
+
+void dxAABBTreeSpace::removeLeaf (int leaf)
+{
+  if (leaf == root) {
+    root = -1;
+    return;
+  }
+
+  int parent = nodes[leaf].parent;
+  int grand_parent = nodes[parent].parent;
+  int sibling = nodes[parent].child1 == leaf ?
+    nodes[parent].child2 : nodes[parent].child1;
+
+  if (grand_parent >= 0) {
+    // replace the parent with the sibling
+    if (nodes[grand_parent].child1 == parent)
+      nodes[grand_parent].child1 = sibling;
+    else
+      nodes[grand_parent].child2 = sibling;
+    nodes[sibling].parent = grand_parent;
+    freeNode (parent);
+    refit (grand_parent);
+  }
+  else {
+    root = sibling;
+    nodes[sibling].parent = -1;
+    freeNode (parent);
+  }
+}
+
+
+void dxAABBTreeSpace::refit (int node)
+{
+  while (node >= 0) {
+    node = balance (node);
+
+    dxAABBTreeNode &n = nodes[node];
+    const dxAABBTreeNode &c1 = nodes[n.child1];
+    const dxAABBTreeNode &c2 = nodes[n.child2];
+    n.height = 1 + (c1.height > c2.height ? c1.height : c2.height);
+    aabbMerge (c1.aabb, c2.aabb, n.aabb);
+
+    node = n.parent;
+  }
+}
+
+
+// rotate the higher child of a up if the children of a are unbalanced.
+// returns the node that replaced a.
+int dxAABBTreeSpace::balance (int ia)
+{
+  dxAABBTreeNode &a = nodes[ia];
+  if (a.child1 < 0 || a.height < 2) return ia;
+
+  int ib = a.child1;
+  int ic = a.child2;
+  int diff = nodes[ic].height - nodes[ib].height;
+  if (diff <= 1 && diff >= -1) return ia;
+
+  // up is the child moving up, other the child staying below a
+  int iup = diff > 1 ? ic : ib;
+  int iother = diff > 1 ? ib : ic;
+  dxAABBTreeNode &up = nodes[iup];
+  dxAABBTreeNode &other = nodes[iother];
+
+  // the higher child of up stays below it, the other one moves below a
+  int ifirst = up.child1;
+  int isecond = up.child2;
+  int ikeep = nodes[ifirst].height > nodes[isecond].height ? ifirst : isecond;
+  int imove = ikeep == ifirst ? isecond : ifirst;
+  dxAABBTreeNode &keep = nodes[ikeep];
+  dxAABBTreeNode &move = nodes[imove];
+
+  // swap a and up
+  up.child1 = ia;
+  up.child2 = ikeep;
+  up.parent = a.parent;
+  a.parent = iup;
+  if (up.parent >= 0) {
+    if (nodes[up.parent].child1 == ia)
+      nodes[up.parent].child1 = iup;
+    else
+      nodes[up.parent].child2 = iup;
+  }
+  else {
+    root = iup;
+  }
+
+  if (diff > 1) a.child2 = imove;
+  else a.child1 = imove;
+  move.parent = ia;
+
+  aabbMerge (other.aabb, move.aabb, a.aabb);
+  a.height = 1 + (other.height > move.height ? other.height : move.height);
+  aabbMerge (a.aabb, keep.aabb, up.aabb);
+  up.height = 1 + (a.height > keep.height ? a.height : keep.height);
+
+  return iup;
+}
+
+//****************************************************************************
+// collision
+
+void dxAABBTreeSpace::query (dxGeom *geom, int skip, void *data,
+			     dNearCallback *callback)
+{
+  if (root < 0) return;
+
+  stack.clear();
+  stack.push_back (root);
+  while (!stack.empty()) {
+    int index = stack.back();
+    stack.pop_back();
+
+    // the nodes are not modified by the callback, since the space is locked
+    const dxAABBTreeNode &node = nodes[index];
+    if (!aabbOverlap (node.aabb, geom->aabb)) continue;
+
+    if (node.child1 >= 0) {
+      stack.push_back (node.child1);
+      stack.push_back (node.child2);
+    }
+    else if (index > skip) {
+      dxGeom *g = node.geom;
+      if (g != geom && GEOM_ENABLED(g) && !aabbIsEmpty (g->aabb))
+	collideAABBs (g,geom,data,callback);
+    }
+  }
+}
+
+
+void dxAABBTreeSpace::cleanGeoms()
+{
+  // compute the AABBs of all dirty geoms, clear the dirty flags and move
+  // the geoms that left their enlarged AABB in the tree
+  lock_count++;
+  for (dxGeom *g=first; g && (g->gflags & GEOM_DIRTY); g=g->next) {
+    if (IS_SPACE(g)) {
+      ((dxSpace*)g)->cleanGeoms();
+    }
+    g->recomputeAABB();
+    g->gflags &= (~(GEOM_DIRTY|GEOM_AABB_BAD));
+    updateProxy (g);
+  }
+  lock_count--;
+}
+
+
+void dxAABBTreeSpace::collide (void *data, dNearCallback *callback)
+{
+  dAASSERT (callback);
+
+  // 0 or 1 geoms can't collide with anything
+  if (count < 2) return;
+
+  lock_count++;
+  cleanGeoms();
+
+  // query the tree with every leaf, reporting each pair from its first leaf
+  for (int i = 0; i < (int)nodes.size(); ++i) {
+    dxGeom *g = nodes[i].geom;
+    if (nodes[i].height != 0 || !g) continue;
+    if (!GEOM_ENABLED(g) || aabbIsEmpty (g->aabb)) continue;
+    query (g, i, data, callback);
+  }
+
+  // test the geoms with infinite AABBs against everything
+  for (size_t i = 0; i < infinite.size(); ++i) {
+    dxGeom *g = infinite[i];
+    if (!GEOM_ENABLED(g)) continue;
+    for (int j = 0; j < (int)nodes.size(); ++j) {
+      dxGeom *g2 = nodes[j].geom;
+      if (nodes[j].height != 0 || !g2) continue;
+      if (GEOM_ENABLED(g2) && !aabbIsEmpty (g2->aabb))
+	collideAABBs (g,g2,data,callback);
+    }
+    for (size_t j = i+1; j < infinite.size(); ++j) {
+      if (GEOM_ENABLED(infinite[j]))
+	collideAABBs (g,infinite[j],data,callback);
+    }
+  }
+
+  lock_count--;
+}
+
+
+void dxAABBTreeSpace::collide2 (void *data, dxGeom *geom,
+				dNearCallback *callback)
+{
+  dAASSERT (geom && callback);
+
+  lock_count++;
+  cleanGeoms();
+  geom->recomputeAABB();
+
+  if (aabbIsInfinite (geom->aabb)) {
+    // the tree can't prune anything
+    for (dxGeom *g=first; g; g=g->next) {
+      if (GEOM_ENABLED(g)) collideAABBs (g,geom,data,callback);
+    }
+  }
+  else {
+    query (geom, -1, data, callback);
+    for (size_t i = 0; i < infinite.size(); ++i) {
+      if (GEOM_ENABLED(infinite[i]))
+	collideAABBs (infinite[i],geom,data,callback);
+    }
+  }
+
+  lock_count--;
+}
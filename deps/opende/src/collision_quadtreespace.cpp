@@ -532,6 +532,9 @@ void dxQuadTreeSpace::remove(dxGeom* g){
 }
 
 void dxQuadTreeSpace::dirty(dxGeom* g){
+	// lock mutex before altering the list, as dxSpace::dirty does, since
+	// geoms of different islands are moved by concurrent threads
+	boost::mutex::scoped_lock lock(this->mutex);
 	DirtyList.push(g);
 }
 
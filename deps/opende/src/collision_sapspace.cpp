@@ -366,6 +366,10 @@ void dxSAPSpace::dirty( dxGeom* g )
 	dAASSERT(g);
 	dUASSERT(g->parent_space == this,"object is not in this space");
 
+	// lock mutex before altering the lists, as dxSpace::dirty does, since
+	// geoms of different islands are moved by concurrent threads
+	boost::mutex::scoped_lock lock(this->mutex);
+
 	// check if already dirtied
 	int dirtyIdx = GEOM_GET_DIRTY_IDX(g);
 	if( dirtyIdx != GEOM_INVALID_IDX )
@@ -189,7 +189,7 @@ bool Server::ParseArgs(int _argc, char **_argv)
     ("play,p", po::value<std::string>(), "Play a log file.")
     ("record,r", "Record state data.")
     ("record_encoding", po::value<std::string>()->default_value("zlib"),
-     "Compression encoding format for log data (zlib|bz2|txt).")
+     "Compression encoding format for log data (zlib|bz2|txt|binary).")
     ("record_path", po::value<std::string>()->default_value(""),
      "Absolute path in which to store state data")
     ("record_period", po::value<double>()->default_value(-1),
@@ -470,7 +470,12 @@ bool Server::LoadFile(const std::string &_filename,
         if (fileExtension == "sdf" || fileExtension == "world")
         {
           filename = current.c_str();
-          if (!sdf::readFile(filename, sdf))
+          bool read;
+          {
+            std::lock_guard<std::mutex> lock(common::sdfParseMutex());
+            read = sdf::readFile(filename, sdf);
+          }
+          if (!read)
           {
             gzerr << "Unable to read SDF from URL[" << filename << "]\n";
             return false;
@@ -493,7 +498,12 @@ bool Server::LoadFile(const std::string &_filename,
     }
     fclose(test);
 
-    if (!sdf::readFile(foundFile, sdf))
+    bool read;
+    {
+      std::lock_guard<std::mutex> lock(common::sdfParseMutex());
+      read = sdf::readFile(foundFile, sdf);
+    }
+    if (!read)
     {
       gzerr << "Unable to read sdf file[" << filename << "]\n";
       return false;
@@ -516,7 +526,12 @@ bool Server::LoadString(const std::string &_sdfString)
     return false;
   }
 
-  if (!sdf::readString(_sdfString, sdf))
+  bool read;
+  {
+    std::lock_guard<std::mutex> lock(common::sdfParseMutex());
+    read = sdf::readString(_sdfString, sdf);
+  }
+  if (!read)
   {
     gzerr << "Unable to read SDF string[" << _sdfString << "]\n";
     return false;
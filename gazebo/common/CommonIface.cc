@@ -22,6 +22,7 @@
 #include <cstring>
 #include <string>
 #include <fstream>
+#include <mutex>
 #include <vector>
 
 #include <fcntl.h>
@@ -558,11 +559,14 @@ void common::convertToFullPaths(std::string &_sdfString,
     const std::string &_filePath)
 {
   sdf::SDFPtr sdf = std::make_shared<sdf::SDF>();
-  sdf::initFile("root.sdf", sdf);
-
-  if (!sdf::readString(_sdfString, sdf) || nullptr == sdf)
   {
-    return;
+    std::lock_guard<std::mutex> lock(sdfParseMutex());
+    sdf::initFile("root.sdf", sdf);
+
+    if (!sdf::readString(_sdfString, sdf) || nullptr == sdf)
+    {
+      return;
+    }
   }
 
   sdf->Root()->SetFilePath(_filePath);
@@ -571,3 +575,10 @@ void common::convertToFullPaths(std::string &_sdfString,
 
   _sdfString = sdf->Root()->ToString("");
 }
+
+//////////////////////////////////////////////////
+std::mutex &common::sdfParseMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
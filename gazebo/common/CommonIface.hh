@@ -29,6 +29,7 @@
 
 #include <boost/filesystem.hpp>
 #include <iomanip>
+#include <mutex>
 #include <sstream>
 
 #include <sdf/Element.hh>
@@ -214,6 +215,15 @@ namespace gazebo
     GZ_COMMON_VISIBLE
     void convertToFullPaths(std::string &_sdfString,
         const std::string &_filePath);
+
+    /// \brief Get the mutex which serializes the calls to the SDF parser,
+    /// such as sdf::readString and sdf::readFile, which is not thread safe.
+    /// It must be locked by any code that parses SDF while another thread
+    /// may be parsing too, such as the background parsers of the physics
+    /// library and the world thread.
+    /// \return The process-wide parse mutex.
+    GZ_COMMON_VISIBLE
+    std::mutex &sdfParseMutex();
     /// \}
   }
 
@@ -17,6 +17,8 @@
 
 #include <algorithm>
 #include <boost/filesystem.hpp>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 #include <gazebo/gazebo_config.h>
 
 #ifdef HAVE_GDAL
@@ -38,6 +40,13 @@ using namespace common;
 
 #ifdef HAVE_GDAL
 
+/// \brief Number of heights above which FillHeightMap uses several threads.
+static const size_t kParallelFillSize = 1 << 20;
+
+/// \brief Approximate number of heights in a band of rows that
+/// FillHeightMap hands to a thread at once.
+static const size_t kParallelFillGrain = 1 << 16;
+
 //////////////////////////////////////////////////
 Dem::Dem()
   : dataPtr(new DemPrivate)
@@ -319,6 +328,18 @@ void Dem::FillHeightMap(int _subSampling, unsigned int _vertSize,
     const ignition::math::Vector3d &_size,
     const ignition::math::Vector3d &_scale,
     bool _flipY, std::vector<float> &_heights)
+{
+  this->FillHeightMap(_subSampling, _vertSize, _size, _scale, _flipY,
+      0, 0, _vertSize, _vertSize, _heights);
+}
+
+//////////////////////////////////////////////////
+void Dem::FillHeightMap(const int _subSampling, const unsigned int _vertSize,
+    const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale,
+    const bool _flipY, const unsigned int _x, const unsigned int _y,
+    const unsigned int _width, const unsigned int _height,
+    std::vector<float> &_heights)
 {
   if (_subSampling <= 0)
   {
@@ -326,56 +347,92 @@ void Dem::FillHeightMap(int _subSampling, unsigned int _vertSize,
     return;
   }
 
-  // Resize the vector to match the size of the vertices.
-  _heights.resize(_vertSize * _vertSize);
+  if (_x + _width > _vertSize || _y + _height > _vertSize)
+  {
+    gzerr << "Heightmap region [" << _x << ", " << _y << ", " << _width
+          << ", " << _height << "] is out of bounds\n";
+    return;
+  }
+
+  // Resize the vector to match the size of the region.
+  _heights.resize(static_cast<size_t>(_width) * _height);
+
+  const unsigned int side = this->dataPtr->side;
+  const float *data = this->dataPtr->demData.data();
+  const double minElevation = this->dataPtr->minElevation;
+  const double scaleZ = _scale.Z();
+  const bool invert = _size.Z() < 0;
+
+  // The source columns and their weights are the same for every row, so
+  // they are computed once and the inner loop has no branch.
+  std::vector<unsigned int> x1(_width);
+  std::vector<unsigned int> x2(_width);
+  std::vector<double> dx(_width);
+  for (unsigned int i = 0; i < _width; ++i)
+  {
+    double xf = (_x + i) / static_cast<double>(_subSampling);
+    x1[i] = floor(xf);
+    x2[i] = std::min(static_cast<unsigned int>(ceil(xf)), side - 1);
+    dx[i] = xf - x1[i];
+  }
 
-  // Iterate over all the vertices
-  for (unsigned int y = 0; y < _vertSize; ++y)
+  auto fillRows = [&](const unsigned int _first, const unsigned int _last)
   {
-    double yf = y / static_cast<double>(_subSampling);
-    unsigned int y1 = floor(yf);
-    unsigned int y2 = ceil(yf);
-    if (y2 >= this->dataPtr->side)
-      y2 = this->dataPtr->side - 1;
-    double dy = yf - y1;
-
-    for (unsigned int x = 0; x < _vertSize; ++x)
+    for (unsigned int j = _first; j < _last; ++j)
     {
-      double xf = x / static_cast<double>(_subSampling);
-      unsigned int x1 = floor(xf);
-      unsigned int x2 = ceil(xf);
-      if (x2 >= this->dataPtr->side)
-        x2 = this->dataPtr->side - 1;
-      double dx = xf - x1;
-
-      double px1 = this->dataPtr->demData[y1 * this->dataPtr->side + x1];
-      double px2 = this->dataPtr->demData[y1 * this->dataPtr->side + x2];
-      float h1 = (px1 - ((px1 - px2) * dx));
-
-      double px3 = this->dataPtr->demData[y2 * this->dataPtr->side + x1];
-      double px4 = this->dataPtr->demData[y2 * this->dataPtr->side + x2];
-      float h2 = (px3 - ((px3 - px4) * dx));
-
-      float h = this->dataPtr->minElevation +
-          (h1 - ((h1 - h2) * dy) - this->dataPtr->minElevation) * _scale.Z();
-
-      // Invert pixel definition so 1=ground, 0=full height,
-      // if the terrain size has a negative z component
-      // this is mainly for backward compatibility
-      if (_size.Z() < 0)
-        h *= -1;
-
-      // Convert to minElevation if a NODATA value is found
-      if (_size.Z() >= 0 && h < this->dataPtr->minElevation)
-        h = this->dataPtr->minElevation;
-
-      // Store the height for future use
-      if (!_flipY)
-        _heights[y * _vertSize + x] = h;
-      else
-        _heights[(_vertSize - y - 1) * _vertSize + x] = h;
+      // Row of the terrain, before the table is flipped
+      unsigned int y = _flipY ? _vertSize - (_y + j) - 1 : _y + j;
+      double yf = y / static_cast<double>(_subSampling);
+      unsigned int y1 = floor(yf);
+      unsigned int y2 = std::min(static_cast<unsigned int>(ceil(yf)),
+          side - 1);
+      double dy = yf - y1;
+
+      const float *row1 = data + static_cast<size_t>(y1) * side;
+      const float *row2 = data + static_cast<size_t>(y2) * side;
+      float *out = _heights.data() + static_cast<size_t>(j) * _width;
+
+      for (unsigned int i = 0; i < _width; ++i)
+      {
+        double px1 = row1[x1[i]];
+        double px2 = row1[x2[i]];
+        float h1 = (px1 - ((px1 - px2) * dx[i]));
+
+        double px3 = row2[x1[i]];
+        double px4 = row2[x2[i]];
+        float h2 = (px3 - ((px3 - px4) * dx[i]));
+
+        float h = minElevation + (h1 - ((h1 - h2) * dy) - minElevation) *
+            scaleZ;
+
+        // Invert pixel definition so 1=ground, 0=full height,
+        // if the terrain size has a negative z component
+        // this is mainly for backward compatibility
+        if (invert)
+          h *= -1;
+        // Convert to minElevation if a NODATA value is found
+        else if (h < minElevation)
+          h = minElevation;
+
+        out[i] = h;
+      }
     }
+  };
+
+  // Large regions are split in bands of rows over the TBB pool
+  if (_height < 2 ||
+      static_cast<size_t>(_width) * _height < kParallelFillSize)
+  {
+    fillRows(0, _height);
+    return;
   }
+
+  tbb::parallel_for(tbb::blocked_range<unsigned int>(0, _height,
+      std::max(1u, static_cast<unsigned int>(kParallelFillGrain / _width))),
+      [&](const tbb::blocked_range<unsigned int> &_r)
+      {
+        fillRows(_r.begin(), _r.end());
+      });
 }
 
 //////////////////////////////////////////////////
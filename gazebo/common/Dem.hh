@@ -125,6 +125,30 @@ namespace gazebo
                   const bool _flipY,
                   std::vector<float> &_heights);
 
+      /// \brief Fill a rectangular region of the lookup table of the
+      /// terrain's height. Large regions are resampled in parallel with
+      /// TBB.
+      /// \param[in] _subsampling Multiplier used to increase the resolution.
+      /// \param[in] _vertSize Number of points per row of the whole table.
+      /// \param[in] _size Real dimmensions of the terrain in meters.
+      /// \param[in] _scale Vector3 used to scale the height.
+      /// \param[in] _flipY If true, it inverts the order in which the vector
+      /// is filled.
+      /// \param[in] _x First column of the region.
+      /// \param[in] _y First row of the region.
+      /// \param[in] _width Number of columns of the region.
+      /// \param[in] _height Number of rows of the region.
+      /// \param[out] _heights Heights of the region, row by row.
+      /// \sa HeightmapData::FillHeightMap
+      public: void FillHeightMap(const int _subSampling,
+                  const unsigned int _vertSize,
+                  const ignition::math::Vector3d &_size,
+                  const ignition::math::Vector3d &_scale,
+                  const bool _flipY, const unsigned int _x,
+                  const unsigned int _y, const unsigned int _width,
+                  const unsigned int _height,
+                  std::vector<float> &_heights);
+
       /// \brief Get the georeferenced coordinates (lat, long) of a terrain's
       /// pixel in WGS84.
       /// \param[in] _x X coordinate of the terrain.
@@ -166,6 +166,26 @@ TEST_F(DemTest, FillHeightmap)
   EXPECT_FLOAT_EQ(184.94113, elevations.at(0));
   EXPECT_FLOAT_EQ(179.63583, elevations.at(elevations.size() - 1));
   EXPECT_FLOAT_EQ(213.42966, elevations.at(elevations.size() / 2));
+
+  // A region holds the same heights as the whole table, flipped or not
+  for (bool flip : {false, true})
+  {
+    std::vector<float> all;
+    dem.FillHeightMap(subsampling, vertSize, size, scale, flip, all);
+
+    std::vector<float> region;
+    dem.FillHeightMap(subsampling, vertSize, size, scale, flip,
+        5, 17, 31, 12, region);
+    ASSERT_EQ(31u * 12u, region.size());
+    for (unsigned int y = 0; y < 12; ++y)
+    {
+      for (unsigned int x = 0; x < 31; ++x)
+      {
+        EXPECT_FLOAT_EQ(all[(17 + y) * vertSize + 5 + x],
+            region[y * 31 + x]);
+      }
+    }
+  }
 }
 
 /////////////////////////////////////////////////
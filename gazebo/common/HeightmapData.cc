@@ -15,6 +15,7 @@
  *
 */
 
+#include <algorithm>
 #include <gazebo/gazebo_config.h>
 
 #ifdef HAVE_GDAL
@@ -35,6 +36,33 @@
 using namespace gazebo;
 using namespace common;
 
+//////////////////////////////////////////////////
+void HeightmapData::FillHeightMap(int _subSampling,
+    unsigned int _vertSize, const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, bool _flipY,
+    unsigned int _x, unsigned int _y, unsigned int _width,
+    unsigned int _height, std::vector<float> &_heights)
+{
+  if (_x + _width > _vertSize || _y + _height > _vertSize)
+  {
+    gzerr << "Heightmap region [" << _x << ", " << _y << ", " << _width
+          << ", " << _height << "] is out of bounds\n";
+    return;
+  }
+
+  std::vector<float> heights;
+  this->FillHeightMap(_subSampling, _vertSize, _size, _scale, _flipY,
+      heights);
+
+  _heights.resize(static_cast<size_t>(_width) * _height);
+  for (unsigned int y = 0; y < _height; ++y)
+  {
+    auto row = heights.begin() + static_cast<size_t>(_y + y) * _vertSize + _x;
+    std::copy(row, row + _width,
+        _heights.begin() + static_cast<size_t>(y) * _width);
+  }
+}
+
 //////////////////////////////////////////////////
 HeightmapData *HeightmapDataLoader::LoadImageAsTerrain(
     const std::string &_filename)
@@ -57,6 +57,28 @@ namespace gazebo
           const ignition::math::Vector3d &_scale, bool _flipY,
           std::vector<float> &_heights) = 0;
 
+      /// \brief Fill a rectangular region of the lookup table created by
+      /// the other FillHeightMap function. The default implementation
+      /// creates the whole table and copies the region, derived classes
+      /// should resample the region only.
+      /// \param[in] _subsampling Multiplier used to increase the resolution.
+      /// \param[in] _vertSize Number of points per row of the whole table.
+      /// \param[in] _size Real dimmensions of the terrain.
+      /// \param[in] _scale Vector3 used to scale the height.
+      /// \param[in] _flipY If true, it inverts the order in which the vector
+      /// is filled.
+      /// \param[in] _x First column of the region.
+      /// \param[in] _y First row of the region.
+      /// \param[in] _width Number of columns of the region.
+      /// \param[in] _height Number of rows of the region.
+      /// \param[out] _heights Heights of the region, row by row, resized to
+      /// _width * _height. Row j holds row _y + j of the whole table.
+      public: virtual void FillHeightMap(int _subSampling,
+          unsigned int _vertSize, const ignition::math::Vector3d &_size,
+          const ignition::math::Vector3d &_scale, bool _flipY,
+          unsigned int _x, unsigned int _y, unsigned int _width,
+          unsigned int _height, std::vector<float> &_heights);
+
       /// \brief Get the terrain's height.
       /// \return The terrain's height.
       public: virtual unsigned int GetHeight() const = 0;
@@ -14,6 +14,8 @@
  * limitations under the License.
  *
  */
+#include <algorithm>
+#include <cmath>
 
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
@@ -45,8 +47,26 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
     const ignition::math::Vector3d &_scale, bool _flipY,
     std::vector<float> &_heights)
 {
-  // Resize the vector to match the size of the vertices.
-  _heights.resize(_vertSize * _vertSize);
+  this->FillHeightMap(_subSampling, _vertSize, _size, _scale, _flipY,
+      0, 0, _vertSize, _vertSize, _heights);
+}
+
+//////////////////////////////////////////////////
+void ImageHeightmap::FillHeightMap(int _subSampling,
+    unsigned int _vertSize, const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, bool _flipY,
+    unsigned int _x, unsigned int _y, unsigned int _width,
+    unsigned int _height, std::vector<float> &_heights)
+{
+  if (_x + _width > _vertSize || _y + _height > _vertSize)
+  {
+    gzerr << "Heightmap region [" << _x << ", " << _y << ", " << _width
+          << ", " << _height << "] is out of bounds\n";
+    return;
+  }
+
+  // Resize the vector to match the size of the region.
+  _heights.resize(static_cast<size_t>(_width) * _height);
 
   int imgHeight = this->GetHeight();
   int imgWidth = this->GetWidth();
@@ -63,9 +83,24 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
   unsigned int count;
   this->img.GetData(&data, count);
 
-  // Iterate over all the vertices
-  for (unsigned int y = 0; y < _vertSize; ++y)
+  // The source columns and their weights are the same for every row
+  std::vector<int> x1(_width);
+  std::vector<int> x2(_width);
+  std::vector<double> dx(_width);
+  for (unsigned int i = 0; i < _width; ++i)
+  {
+    double xf = (_x + i) / static_cast<double>(_subSampling);
+    x1[i] = floor(xf);
+    x2[i] = std::min(static_cast<int>(ceil(xf)), imgWidth - 1);
+    dx[i] = xf - x1[i];
+  }
+
+  // Iterate over the rows of the region
+  for (unsigned int j = 0; j < _height; ++j)
   {
+    // Row of the terrain, before the table is flipped
+    unsigned int y = _flipY ? _vertSize - (_y + j) - 1 : _y + j;
+
     // yf ranges between 0 and 4
     double yf = y / static_cast<double>(_subSampling);
     int y1 = floor(yf);
@@ -74,22 +109,19 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
       y2 = imgHeight-1;
     double dy = yf - y1;
 
-    for (unsigned int x = 0; x < _vertSize; ++x)
-    {
-      double xf = x / static_cast<double>(_subSampling);
-      int x1 = floor(xf);
-      int x2 = ceil(xf);
-      if (x2 >= imgWidth)
-        x2 = imgWidth-1;
-      double dx = xf - x1;
+    const unsigned char *row1 = data + y1 * pitch;
+    const unsigned char *row2 = data + y2 * pitch;
+    float *out = _heights.data() + static_cast<size_t>(j) * _width;
 
-      double px1 = static_cast<int>(data[y1 * pitch + x1 * bpp]) / 255.0;
-      double px2 = static_cast<int>(data[y1 * pitch + x2 * bpp]) / 255.0;
-      float h1 = (px1 - ((px1 - px2) * dx));
+    for (unsigned int i = 0; i < _width; ++i)
+    {
+      double px1 = static_cast<int>(row1[x1[i] * bpp]) / 255.0;
+      double px2 = static_cast<int>(row1[x2[i] * bpp]) / 255.0;
+      float h1 = (px1 - ((px1 - px2) * dx[i]));
 
-      double px3 = static_cast<int>(data[y2 * pitch + x1 * bpp]) / 255.0;
-      double px4 = static_cast<int>(data[y2 * pitch + x2 * bpp]) / 255.0;
-      float h2 = (px3 - ((px3 - px4) * dx));
+      double px3 = static_cast<int>(row2[x1[i] * bpp]) / 255.0;
+      double px4 = static_cast<int>(row2[x2[i] * bpp]) / 255.0;
+      float h2 = (px3 - ((px3 - px4) * dx[i]));
 
       float h = (h1 - ((h1 - h2) * dy)) * _scale.Z();
 
@@ -99,11 +131,7 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
       if (_size.Z() < 0)
         h = 1.0 - h;
 
-      // Store the height for future use
-      if (!_flipY)
-        _heights[y * _vertSize + x] = h;
-      else
-        _heights[(_vertSize - y - 1) * _vertSize + x] = h;
+      out[i] = h;
     }
   }
 
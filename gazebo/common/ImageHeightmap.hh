@@ -53,6 +53,13 @@ namespace gazebo
           const ignition::math::Vector3d &_scale, bool _flipY,
           std::vector<float> &_heights);
 
+      // Documentation inherited.
+      public: void FillHeightMap(int _subSampling, unsigned int _vertSize,
+          const ignition::math::Vector3d &_size,
+          const ignition::math::Vector3d &_scale, bool _flipY,
+          unsigned int _x, unsigned int _y, unsigned int _width,
+          unsigned int _height, std::vector<float> &_heights);
+
       /// \brief Get the full filename of the image
       /// \return The filename used to load the image
       public: std::string GetFilename() const;
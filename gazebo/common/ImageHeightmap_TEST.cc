@@ -101,6 +101,26 @@ TEST_F(ImageHeightmapTest, FillHeightmap)
   EXPECT_NEAR(0.0, elevations.at(0), ELEVATION_TOL);
   EXPECT_NEAR(10.0, elevations.at(elevations.size() - 1), ELEVATION_TOL);
   EXPECT_NEAR(5.0, elevations.at(elevations.size() / 2), ELEVATION_TOL);
+
+  // A region holds the same heights as the whole table, flipped or not
+  for (bool flip : {false, true})
+  {
+    std::vector<float> all;
+    img.FillHeightMap(subsampling, vertSize, size, scale, flip, all);
+
+    std::vector<float> region;
+    img.FillHeightMap(subsampling, vertSize, size, scale, flip,
+        100, 3, 20, 40, region);
+    ASSERT_EQ(20u * 40u, region.size());
+    for (unsigned int y = 0; y < 40; ++y)
+    {
+      for (unsigned int x = 0; x < 20; ++x)
+      {
+        EXPECT_FLOAT_EQ(all[(3 + y) * vertSize + 100 + x],
+            region[y * 20 + x]);
+      }
+    }
+  }
 }
 
 /////////////////////////////////////////////////
@@ -17,6 +17,8 @@
 
 #include <boost/filesystem.hpp>
 #include <algorithm>
+#include <mutex>
+#include <string>
 #include <boost/lexical_cast.hpp>
 
 #include "gazebo/common/SystemPaths.hh"
@@ -29,6 +31,20 @@ using namespace common;
 
 unsigned int Material::counter = 0;
 
+/// \brief Protects Material::counter, materials are created by the mesh
+/// loaders, which may run concurrently.
+static std::mutex g_counterMutex;
+
+/////////////////////////////////////////////////
+/// \brief Get a unique material name.
+/// \param[in,out] _counter Counter of the materials.
+/// \return The name.
+static std::string uniqueName(unsigned int &_counter)
+{
+  std::lock_guard<std::mutex> lock(g_counterMutex);
+  return "gazebo_material_" + boost::lexical_cast<std::string>(_counter++);
+}
+
 std::string Material::ShadeModeStr[SHADE_COUNT] = {"FLAT", "GOURAUD",
   "PHONG", "BLINN"};
 std::string Material::BlendModeStr[BLEND_COUNT] = {"ADD", "MODULATE",
@@ -37,7 +53,7 @@ std::string Material::BlendModeStr[BLEND_COUNT] = {"ADD", "MODULATE",
 //////////////////////////////////////////////////
 Material::Material()
 {
-  this->name = "gazebo_material_" + boost::lexical_cast<std::string>(counter++);
+  this->name = uniqueName(counter);
   this->blendMode = REPLACE;
   this->shadeMode = GOURAUD;
   this->ambient.Set(0.4, 0.4, 0.4, 1);
@@ -49,7 +65,7 @@ Material::Material()
 //////////////////////////////////////////////////
 Material::Material(const ignition::math::Color &_clr)
 {
-  this->name = "gazebo_material_" + boost::lexical_cast<std::string>(counter++);
+  this->name = uniqueName(counter);
   this->blendMode = REPLACE;
   this->shadeMode = GOURAUD;
   this->ambient = _clr;
@@ -0,0 +1,534 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifdef _WIN32
+  #include <process.h>
+  #define getpid _getpid
+#else
+  #include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Exception.hh"
+#include "gazebo/common/Material.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/SystemPaths.hh"
+#include "gazebo/common/MeshFileCache.hh"
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief Magic string at the start of every cache entry.
+static const char kMagic[8] = {'G', 'Z', 'M', 'E', 'S', 'H', '\0', '\0'};
+
+/// \brief Version of the format of the cache entries. Increase it whenever
+/// the format changes, so that old entries are ignored.
+static const uint32_t kVersion = 1;
+
+/// \brief Written in native byte order, to detect entries written on a
+/// machine of another endianness.
+static const uint32_t kByteOrder = 0x01020304;
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Private data for the MeshFileCache class.
+    class MeshFileCachePrivate
+    {
+      /// \brief Directory of the cache.
+      public: std::string path;
+    };
+
+    /// \internal
+    /// \brief Serializes values in native byte order.
+    class MeshFileCacheWriter
+    {
+      /// \brief Append a value.
+      /// \param[in] _value The value.
+      public: template<typename T>
+              void Put(const T &_value)
+      {
+        this->buffer.append(reinterpret_cast<const char *>(&_value),
+            sizeof(T));
+      }
+
+      /// \brief Append a string, prefixed with its length.
+      /// \param[in] _str The string.
+      public: void PutString(const std::string &_str)
+      {
+        this->Put<uint32_t>(static_cast<uint32_t>(_str.size()));
+        this->buffer.append(_str);
+      }
+
+      /// \brief Append a color.
+      /// \param[in] _color The color.
+      public: void PutColor(const ignition::math::Color &_color)
+      {
+        this->Put<float>(_color.R());
+        this->Put<float>(_color.G());
+        this->Put<float>(_color.B());
+        this->Put<float>(_color.A());
+      }
+
+      /// \brief Serialized data.
+      public: std::string buffer;
+    };
+
+    /// \internal
+    /// \brief Reads values written by a MeshFileCacheWriter, checking the
+    /// bounds of the data.
+    class MeshFileCacheReader
+    {
+      /// \brief Constructor.
+      /// \param[in] _data The data.
+      /// \param[in] _size Size of the data.
+      public: MeshFileCacheReader(const char *_data, const std::size_t _size)
+        : data(_data), size(_size)
+      {
+      }
+
+      /// \brief Read a value.
+      /// \param[out] _value The value.
+      /// \return False if the data is too short.
+      public: template<typename T>
+              bool Get(T &_value)
+      {
+        if (this->size - this->pos < sizeof(T))
+          return false;
+        std::memcpy(&_value, this->data + this->pos, sizeof(T));
+        this->pos += sizeof(T);
+        return true;
+      }
+
+      /// \brief Read a string.
+      /// \param[out] _str The string.
+      /// \return False if the data is too short.
+      public: bool GetString(std::string &_str)
+      {
+        uint32_t length;
+        if (!this->Get(length) || this->size - this->pos < length)
+          return false;
+        _str.assign(this->data + this->pos, length);
+        this->pos += length;
+        return true;
+      }
+
+      /// \brief Read a color.
+      /// \param[out] _color The color.
+      /// \return False if the data is too short.
+      public: bool GetColor(ignition::math::Color &_color)
+      {
+        float r, g, b, a;
+        if (!this->Get(r) || !this->Get(g) || !this->Get(b) || !this->Get(a))
+          return false;
+        _color.Set(r, g, b, a);
+        return true;
+      }
+
+      /// \brief Check that an array fits in the remaining data.
+      /// \param[in] _count Number of elements.
+      /// \param[in] _elementSize Size of an element.
+      /// \return True if the array fits.
+      public: bool Fits(const uint32_t _count, const std::size_t _elementSize)
+      {
+        return (this->size - this->pos) / _elementSize >= _count;
+      }
+
+      /// \brief The data.
+      private: const char *data;
+
+      /// \brief Size of the data.
+      private: std::size_t size;
+
+      /// \brief Read position.
+      private: std::size_t pos = 0;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the path of the cache entry of a mesh file.
+/// \param[in] _dir Directory of the cache.
+/// \param[in] _filename Full path of the mesh file.
+/// \return Path of the entry, named after a FNV-1a hash of _filename.
+static boost::filesystem::path entryPath(const std::string &_dir,
+    const std::string &_filename)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  for (const char c : _filename)
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+
+  std::ostringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << hash
+       << ".gzmesh";
+  return boost::filesystem::path(_dir) / name.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the size and modification time of a file.
+/// \param[in] _filename Path of the file.
+/// \param[out] _size Size of the file.
+/// \param[out] _mtime Modification time of the file.
+/// \return False if the file doesn't exist.
+static bool fileStamp(const std::string &_filename, uint64_t &_size,
+    int64_t &_mtime)
+{
+  boost::system::error_code ec;
+  _size = boost::filesystem::file_size(_filename, ec);
+  if (ec)
+    return false;
+  _mtime = static_cast<int64_t>(
+      boost::filesystem::last_write_time(_filename, ec));
+  return !ec;
+}
+
+//////////////////////////////////////////////////
+MeshFileCache::MeshFileCache(const std::string &_path)
+  : dataPtr(new MeshFileCachePrivate)
+{
+  this->dataPtr->path = _path;
+}
+
+//////////////////////////////////////////////////
+MeshFileCache::~MeshFileCache()
+{
+}
+
+//////////////////////////////////////////////////
+std::string MeshFileCache::Path() const
+{
+  return this->dataPtr->path;
+}
+
+//////////////////////////////////////////////////
+std::string MeshFileCache::DefaultPath()
+{
+  const char *pathEnv = std::getenv("GAZEBO_MESH_CACHE_PATH");
+  if (pathEnv)
+    return pathEnv;
+
+  return (boost::filesystem::path(SystemPaths::Instance()->GetLogPath()) /
+      "mesh_cache").string();
+}
+
+//////////////////////////////////////////////////
+bool MeshFileCache::Save(const std::string &_filename,
+    const Mesh &_mesh) const
+{
+  if (this->dataPtr->path.empty() || _mesh.HasSkeleton())
+    return false;
+
+  uint64_t size;
+  int64_t mtime;
+  if (!fileStamp(_filename, size, mtime))
+    return false;
+
+  MeshFileCacheWriter writer;
+  writer.buffer.append(kMagic, sizeof(kMagic));
+  writer.Put(kVersion);
+  writer.Put(kByteOrder);
+  writer.Put(size);
+  writer.Put(mtime);
+  writer.PutString(_filename);
+  writer.PutString(_mesh.GetPath());
+
+  writer.Put<uint32_t>(_mesh.GetMaterialCount());
+  for (unsigned int i = 0; i < _mesh.GetMaterialCount(); ++i)
+  {
+    const Material *mat = _mesh.GetMaterial(i);
+    double srcFactor, dstFactor;
+    mat->GetBlendFactors(srcFactor, dstFactor);
+
+    writer.PutString(mat->GetTextureImage());
+    writer.PutColor(mat->Ambient());
+    writer.PutColor(mat->Diffuse());
+    writer.PutColor(mat->Specular());
+    writer.PutColor(mat->Emissive());
+    writer.Put<double>(mat->GetTransparency());
+    writer.Put<double>(mat->GetShininess());
+    writer.Put<double>(mat->GetPointSize());
+    writer.Put<double>(srcFactor);
+    writer.Put<double>(dstFactor);
+    writer.Put<uint32_t>(mat->GetBlendMode());
+    writer.Put<uint32_t>(mat->GetShadeMode());
+    writer.Put<uint8_t>(mat->GetDepthWrite());
+    writer.Put<uint8_t>(mat->GetLighting());
+  }
+
+  writer.Put<uint32_t>(_mesh.GetSubMeshCount());
+  for (unsigned int i = 0; i < _mesh.GetSubMeshCount(); ++i)
+  {
+    const SubMesh *subMesh = _mesh.GetSubMesh(i);
+    if (subMesh->GetNodeAssignmentsCount() > 0)
+      return false;
+
+    writer.PutString(subMesh->GetName());
+    writer.Put<uint32_t>(subMesh->GetPrimitiveType());
+    writer.Put<uint32_t>(subMesh->GetMaterialIndex());
+    writer.Put<uint32_t>(subMesh->GetVertexCount());
+    writer.Put<uint32_t>(subMesh->GetNormalCount());
+    writer.Put<uint32_t>(subMesh->GetTexCoordCount());
+    writer.Put<uint32_t>(subMesh->GetIndexCount());
+
+    for (unsigned int j = 0; j < subMesh->GetVertexCount(); ++j)
+    {
+      ignition::math::Vector3d v = subMesh->Vertex(j);
+      writer.Put(v.X());
+      writer.Put(v.Y());
+      writer.Put(v.Z());
+    }
+    for (unsigned int j = 0; j < subMesh->GetNormalCount(); ++j)
+    {
+      ignition::math::Vector3d n = subMesh->Normal(j);
+      writer.Put(n.X());
+      writer.Put(n.Y());
+      writer.Put(n.Z());
+    }
+    for (unsigned int j = 0; j < subMesh->GetTexCoordCount(); ++j)
+    {
+      ignition::math::Vector2d t = subMesh->TexCoord(j);
+      writer.Put(t.X());
+      writer.Put(t.Y());
+    }
+    for (unsigned int j = 0; j < subMesh->GetIndexCount(); ++j)
+      writer.Put<uint32_t>(subMesh->GetIndex(j));
+  }
+
+  // Write to a temporary file first, and rename it, so that readers never
+  // see a partial entry.
+  boost::filesystem::path entry = entryPath(this->dataPtr->path, _filename);
+  static std::atomic<unsigned int> tmpCounter(0);
+  std::ostringstream tmpName;
+  tmpName << entry.string() << "." << getpid() << "."
+          << std::hash<std::thread::id>()(std::this_thread::get_id()) << "."
+          << tmpCounter++ << ".tmp";
+  const std::string tmpPath = tmpName.str();
+
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(this->dataPtr->path, ec);
+
+  {
+    std::ofstream out(tmpPath, std::ios::out | std::ios::binary);
+    if (!out)
+    {
+      gzwarn << "Unable to write mesh cache entry [" << tmpPath << "]\n";
+      return false;
+    }
+    out.write(writer.buffer.data(), writer.buffer.size());
+    if (!out)
+    {
+      out.close();
+      boost::filesystem::remove(tmpPath, ec);
+      return false;
+    }
+  }
+
+  boost::filesystem::rename(tmpPath, entry, ec);
+  if (ec)
+  {
+    boost::filesystem::remove(tmpPath, ec);
+    return false;
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+Mesh *MeshFileCache::Load(const std::string &_filename) const
+{
+  if (this->dataPtr->path.empty())
+    return nullptr;
+
+  boost::filesystem::path entry = entryPath(this->dataPtr->path, _filename);
+  boost::system::error_code ec;
+  if (!boost::filesystem::exists(entry, ec) ||
+      boost::filesystem::file_size(entry, ec) == 0 || ec)
+  {
+    return nullptr;
+  }
+
+  uint64_t size;
+  int64_t mtime;
+  if (!fileStamp(_filename, size, mtime))
+    return nullptr;
+
+  boost::interprocess::file_mapping mapping;
+  boost::interprocess::mapped_region region;
+  try
+  {
+    boost::interprocess::file_mapping(entry.string().c_str(),
+        boost::interprocess::read_only).swap(mapping);
+    boost::interprocess::mapped_region(mapping,
+        boost::interprocess::read_only).swap(region);
+  }
+  catch(boost::interprocess::interprocess_exception &_e)
+  {
+    gzwarn << "Unable to read mesh cache entry [" << entry.string() << "]: "
+           << _e.what() << "\n";
+    return nullptr;
+  }
+
+  MeshFileCacheReader reader(static_cast<const char *>(region.get_address()),
+      region.get_size());
+
+  char magic[sizeof(kMagic)];
+  uint32_t version, byteOrder;
+  uint64_t cachedSize;
+  int64_t cachedMtime;
+  std::string cachedFilename;
+  if (!reader.Get(magic) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      !reader.Get(version) || version != kVersion ||
+      !reader.Get(byteOrder) || byteOrder != kByteOrder ||
+      !reader.Get(cachedSize) || cachedSize != size ||
+      !reader.Get(cachedMtime) || cachedMtime != mtime ||
+      !reader.GetString(cachedFilename) || cachedFilename != _filename)
+  {
+    // Stale entry, or a hash collision
+    return nullptr;
+  }
+
+  std::unique_ptr<Mesh> mesh(new Mesh());
+  std::string meshPath;
+  uint32_t materialCount;
+  if (!reader.GetString(meshPath) || !reader.Get(materialCount))
+    return nullptr;
+  mesh->SetPath(meshPath);
+
+  for (uint32_t i = 0; i < materialCount; ++i)
+  {
+    std::string texImage;
+    ignition::math::Color ambient, diffuse, specular, emissive;
+    double transparency, shininess, pointSize, srcFactor, dstFactor;
+    uint32_t blendMode, shadeMode;
+    uint8_t depthWrite, lighting;
+    if (!reader.GetString(texImage) || !reader.GetColor(ambient) ||
+        !reader.GetColor(diffuse) || !reader.GetColor(specular) ||
+        !reader.GetColor(emissive) || !reader.Get(transparency) ||
+        !reader.Get(shininess) || !reader.Get(pointSize) ||
+        !reader.Get(srcFactor) || !reader.Get(dstFactor) ||
+        !reader.Get(blendMode) || blendMode >= Material::BLEND_COUNT ||
+        !reader.Get(shadeMode) || shadeMode >= Material::SHADE_COUNT ||
+        !reader.Get(depthWrite) || !reader.Get(lighting))
+    {
+      return nullptr;
+    }
+
+    Material *mat = new Material();
+    mat->SetTextureImage(texImage);
+    mat->SetAmbient(ambient);
+    mat->SetDiffuse(diffuse);
+    mat->SetSpecular(specular);
+    mat->SetEmissive(emissive);
+    mat->SetTransparency(transparency);
+    mat->SetShininess(shininess);
+    mat->SetPointSize(pointSize);
+    mat->SetBlendFactors(srcFactor, dstFactor);
+    mat->SetBlendMode(static_cast<Material::BlendMode>(blendMode));
+    mat->SetShadeMode(static_cast<Material::ShadeMode>(shadeMode));
+    mat->SetDepthWrite(depthWrite != 0);
+    mat->SetLighting(lighting != 0);
+    mesh->AddMaterial(mat);
+  }
+
+  uint32_t subMeshCount;
+  if (!reader.Get(subMeshCount))
+    return nullptr;
+
+  for (uint32_t i = 0; i < subMeshCount; ++i)
+  {
+    std::string name;
+    uint32_t primitiveType, materialIndex;
+    uint32_t vertexCount, normalCount, texCoordCount, indexCount;
+    if (!reader.GetString(name) || !reader.Get(primitiveType) ||
+        primitiveType > SubMesh::TRISTRIPS || !reader.Get(materialIndex) ||
+        !reader.Get(vertexCount) || !reader.Fits(vertexCount, 24) ||
+        !reader.Get(normalCount) || !reader.Get(texCoordCount) ||
+        !reader.Get(indexCount))
+    {
+      return nullptr;
+    }
+
+    SubMesh *subMesh = new SubMesh();
+    mesh->AddSubMesh(subMesh);
+    subMesh->SetName(name);
+    subMesh->SetPrimitiveType(static_cast<SubMesh::PrimitiveType>(
+          primitiveType));
+    subMesh->SetMaterialIndex(materialIndex);
+
+    double x, y, z;
+    subMesh->SetVertexCount(vertexCount);
+    for (uint32_t j = 0; j < vertexCount; ++j)
+    {
+      if (!reader.Get(x) || !reader.Get(y) || !reader.Get(z))
+        return nullptr;
+      subMesh->SetVertex(j, ignition::math::Vector3d(x, y, z));
+    }
+
+    if (!reader.Fits(normalCount, 24))
+      return nullptr;
+    subMesh->SetNormalCount(normalCount);
+    for (uint32_t j = 0; j < normalCount; ++j)
+    {
+      if (!reader.Get(x) || !reader.Get(y) || !reader.Get(z))
+        return nullptr;
+      subMesh->SetNormal(j, ignition::math::Vector3d(x, y, z));
+    }
+
+    if (!reader.Fits(texCoordCount, 16))
+      return nullptr;
+    subMesh->SetTexCoordCount(texCoordCount);
+    for (uint32_t j = 0; j < texCoordCount; ++j)
+    {
+      if (!reader.Get(x) || !reader.Get(y))
+        return nullptr;
+      subMesh->SetTexCoord(j, ignition::math::Vector2d(x, y));
+    }
+
+    if (!reader.Fits(indexCount, 4))
+      return nullptr;
+    uint32_t index;
+    for (uint32_t j = 0; j < indexCount; ++j)
+    {
+      if (!reader.Get(index) || index >= vertexCount)
+        return nullptr;
+      subMesh->AddIndex(index);
+    }
+  }
+
+  return mesh.release();
+}
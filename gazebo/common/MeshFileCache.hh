@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_MESHFILECACHE_HH_
+#define GAZEBO_COMMON_MESHFILECACHE_HH_
+
+#include <memory>
+#include <string>
+
+#include "gazebo/common/CommonTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class
+    class MeshFileCachePrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class MeshFileCache MeshFileCache.hh common/common.hh
+    /// \brief On-disk cache of parsed meshes.
+    ///
+    /// Each mesh is stored in its own file, in a flat binary form which is
+    /// memory mapped when it is read back. The submeshes are stored with
+    /// their vertices, normals, texture coordinates and indices, along with
+    /// the materials of the mesh. An entry is only valid while the size and
+    /// the modification time of its source file are unchanged.
+    ///
+    /// Meshes with a skeleton are not cached.
+    ///
+    /// The functions of this class can be called from several threads, and
+    /// from several processes sharing the same cache directory.
+    class GZ_COMMON_VISIBLE MeshFileCache
+    {
+      /// \brief Constructor.
+      /// \param[in] _path Directory of the cache, created when the first
+      /// mesh is stored.
+      public: explicit MeshFileCache(const std::string &_path);
+
+      /// \brief Destructor.
+      public: virtual ~MeshFileCache();
+
+      /// \brief Get the directory of the cache.
+      /// \return The directory.
+      public: std::string Path() const;
+
+      /// \brief Read a mesh from the cache.
+      /// \param[in] _filename Full path of the source mesh file.
+      /// \return The mesh, owned by the caller, or null if the mesh is not
+      /// cached or if its source file changed since it was cached.
+      public: Mesh *Load(const std::string &_filename) const;
+
+      /// \brief Store a mesh in the cache.
+      /// \param[in] _filename Full path of the source mesh file.
+      /// \param[in] _mesh The mesh parsed from _filename.
+      /// \return True if the mesh was stored. False if the mesh has a
+      /// skeleton, or if the cache couldn't be written.
+      public: bool Save(const std::string &_filename, const Mesh &_mesh) const;
+
+      /// \brief Get the default cache directory: the value of the
+      /// GAZEBO_MESH_CACHE_PATH environment variable if it is set, otherwise
+      /// the mesh_cache directory in the gazebo log path, usually
+      /// ~/.gazebo/mesh_cache.
+      /// \return The directory. Empty if GAZEBO_MESH_CACHE_PATH is set to an
+      /// empty string, which disables the cache.
+      public: static std::string DefaultPath();
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<MeshFileCachePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
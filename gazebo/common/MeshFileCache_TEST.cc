@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+#include <ctime>
+#include <memory>
+#include <string>
+
+#include <boost/filesystem.hpp>
+
+#include "test_config.h"
+#include "gazebo/common/ColladaLoader.hh"
+#include "gazebo/common/Material.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshFileCache.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class MeshFileCache : public gazebo::testing::AutoLogFixture
+{
+  /// \brief Create a temporary directory with a copy of box.dae.
+  protected: virtual void SetUp()
+  {
+    gazebo::testing::AutoLogFixture::SetUp();
+    this->dir = boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path("gz_mesh_cache_%%%%-%%%%");
+    boost::filesystem::create_directories(this->dir);
+    this->filename = (this->dir / "box.dae").string();
+    boost::filesystem::copy_file(
+        std::string(PROJECT_SOURCE_PATH) + "/test/data/box.dae",
+        this->filename);
+  }
+
+  /// \brief Remove the temporary directory.
+  protected: virtual void TearDown()
+  {
+    boost::filesystem::remove_all(this->dir);
+    gazebo::testing::AutoLogFixture::TearDown();
+  }
+
+  /// \brief Temporary directory.
+  protected: boost::filesystem::path dir;
+
+  /// \brief Copy of box.dae.
+  protected: std::string filename;
+};
+
+/////////////////////////////////////////////////
+TEST_F(MeshFileCache, SaveLoad)
+{
+  common::MeshFileCache cache((this->dir / "cache").string());
+  EXPECT_EQ(cache.Path(), (this->dir / "cache").string());
+
+  // Nothing cached yet
+  EXPECT_TRUE(cache.Load(this->filename) == nullptr);
+
+  common::ColladaLoader loader;
+  std::unique_ptr<common::Mesh> mesh(loader.Load(this->filename));
+  ASSERT_TRUE(mesh != nullptr);
+  EXPECT_TRUE(cache.Save(this->filename, *mesh));
+
+  std::unique_ptr<common::Mesh> cached(cache.Load(this->filename));
+  ASSERT_TRUE(cached != nullptr);
+  EXPECT_EQ(cached->GetPath(), mesh->GetPath());
+  EXPECT_EQ(cached->Min(), mesh->Min());
+  EXPECT_EQ(cached->Max(), mesh->Max());
+
+  ASSERT_EQ(cached->GetMaterialCount(), mesh->GetMaterialCount());
+  for (unsigned int i = 0; i < mesh->GetMaterialCount(); ++i)
+  {
+    const common::Material *expected = mesh->GetMaterial(i);
+    const common::Material *mat = cached->GetMaterial(i);
+    EXPECT_EQ(mat->GetTextureImage(), expected->GetTextureImage());
+    EXPECT_EQ(mat->Ambient(), expected->Ambient());
+    EXPECT_EQ(mat->Diffuse(), expected->Diffuse());
+    EXPECT_EQ(mat->Specular(), expected->Specular());
+    EXPECT_EQ(mat->Emissive(), expected->Emissive());
+    EXPECT_DOUBLE_EQ(mat->GetTransparency(), expected->GetTransparency());
+    EXPECT_DOUBLE_EQ(mat->GetShininess(), expected->GetShininess());
+    EXPECT_EQ(mat->GetShadeMode(), expected->GetShadeMode());
+    EXPECT_EQ(mat->GetBlendMode(), expected->GetBlendMode());
+    EXPECT_EQ(mat->GetLighting(), expected->GetLighting());
+  }
+
+  ASSERT_EQ(cached->GetSubMeshCount(), mesh->GetSubMeshCount());
+  for (unsigned int i = 0; i < mesh->GetSubMeshCount(); ++i)
+  {
+    const common::SubMesh *expected = mesh->GetSubMesh(i);
+    const common::SubMesh *subMesh = cached->GetSubMesh(i);
+    EXPECT_EQ(subMesh->GetName(), expected->GetName());
+    EXPECT_EQ(subMesh->GetPrimitiveType(), expected->GetPrimitiveType());
+    EXPECT_EQ(subMesh->GetMaterialIndex(), expected->GetMaterialIndex());
+    ASSERT_EQ(subMesh->GetVertexCount(), expected->GetVertexCount());
+    ASSERT_EQ(subMesh->GetNormalCount(), expected->GetNormalCount());
+    ASSERT_EQ(subMesh->GetTexCoordCount(), expected->GetTexCoordCount());
+    ASSERT_EQ(subMesh->GetIndexCount(), expected->GetIndexCount());
+    for (unsigned int j = 0; j < expected->GetVertexCount(); ++j)
+      EXPECT_EQ(subMesh->Vertex(j), expected->Vertex(j));
+    for (unsigned int j = 0; j < expected->GetNormalCount(); ++j)
+      EXPECT_EQ(subMesh->Normal(j), expected->Normal(j));
+    for (unsigned int j = 0; j < expected->GetTexCoordCount(); ++j)
+      EXPECT_EQ(subMesh->TexCoord(j), expected->TexCoord(j));
+    for (unsigned int j = 0; j < expected->GetIndexCount(); ++j)
+      EXPECT_EQ(subMesh->GetIndex(j), expected->GetIndex(j));
+  }
+
+  // Another file isn't in the cache
+  EXPECT_TRUE(cache.Load((this->dir / "other.dae").string()) == nullptr);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshFileCache, Stale)
+{
+  common::MeshFileCache cache((this->dir / "cache").string());
+
+  common::ColladaLoader loader;
+  std::unique_ptr<common::Mesh> mesh(loader.Load(this->filename));
+  ASSERT_TRUE(mesh != nullptr);
+  ASSERT_TRUE(cache.Save(this->filename, *mesh));
+  std::unique_ptr<common::Mesh> cached(cache.Load(this->filename));
+  EXPECT_TRUE(cached != nullptr);
+
+  // Touching the source file invalidates its entry
+  std::time_t mtime = boost::filesystem::last_write_time(this->filename);
+  boost::filesystem::last_write_time(this->filename, mtime + 10);
+  cached.reset(cache.Load(this->filename));
+  EXPECT_TRUE(cached == nullptr);
+
+  // Until it is saved again
+  ASSERT_TRUE(cache.Save(this->filename, *mesh));
+  cached.reset(cache.Load(this->filename));
+  EXPECT_TRUE(cached != nullptr);
+
+  // A corrupted entry is ignored
+  boost::filesystem::directory_iterator end;
+  for (boost::filesystem::directory_iterator iter(this->dir / "cache");
+       iter != end; ++iter)
+  {
+    boost::filesystem::resize_file(iter->path(), 32);
+  }
+  cached.reset(cache.Load(this->filename));
+  EXPECT_TRUE(cached == nullptr);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshFileCache, Disabled)
+{
+  common::MeshFileCache cache("");
+
+  common::ColladaLoader loader;
+  std::unique_ptr<common::Mesh> mesh(loader.Load(this->filename));
+  ASSERT_TRUE(mesh != nullptr);
+  EXPECT_FALSE(cache.Save(this->filename, *mesh));
+  EXPECT_TRUE(cache.Load(this->filename) == nullptr);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
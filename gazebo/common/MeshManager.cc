@@ -16,8 +16,17 @@
  */
 
 #include <sys/stat.h>
+#include <algorithm>
+#include <memory>
+#include <set>
 #include <string>
 #include <map>
+#include <vector>
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Matrix3.hh>
@@ -31,6 +40,7 @@
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshFileCache.hh"
 #include "gazebo/common/ColladaLoader.hh"
 #include "gazebo/common/ColladaExporter.hh"
 #include "gazebo/common/STLLoader.hh"
@@ -51,15 +61,9 @@ namespace common
 //////////////////////////////////////////////////
 class MeshManagerPrivate
 {
-  /// \brief 3D mesh loader for COLLADA files
-  public: ColladaLoader *colladaLoader = nullptr;
-
   /// \brief 3D mesh exporter for COLLADA files
   public: ColladaExporter *colladaExporter = nullptr;
 
-  /// \brief 3D mesh loader for STL files
-  public: STLLoader *stlLoader = nullptr;
-
   // \brief 3D mesh loader for FBX files
   // \todo The FBX loader needs to be implemented.
   // public: FBXLoader *fbxLoader = nullptr;
@@ -70,22 +74,49 @@ class MeshManagerPrivate
   /// \brief supported file extensions for meshes
   public: std::vector<std::string> fileExtensions;
 
-  /// \brief Mutex to protect from loading the same mesh in different threads
-  /// at the same time.
-  public: boost::mutex mutex;
-};
+  /// \brief On-disk cache of parsed mesh files, null if disabled. Protected
+  /// by the mutex, and copied before use so that it can be replaced while
+  /// a mesh is loaded.
+  public: std::shared_ptr<MeshFileCache> fileCache;
+
+  /// \brief Insert a mesh, unless a mesh with the same name exists.
+  /// \param[in] _name Name of the mesh.
+  /// \param[in] _mesh The mesh.
+  public: void Insert(const std::string &_name, Mesh *_mesh)
+  {
+    boost::mutex::scoped_lock lock(this->mutex);
+    this->meshes.insert(std::make_pair(_name, _mesh));
+  }
+
+  /// \brief Mark a mesh as loaded, and wake up the threads waiting for it.
+  /// \param[in] _filename Filename of the mesh.
+  /// \param[in] _mesh The loaded mesh, null if it could not be loaded.
+  public: void FinishLoading(const std::string &_filename, Mesh *_mesh)
+  {
+    boost::mutex::scoped_lock lock(this->mutex);
+    if (_mesh)
+      this->meshes.insert(std::make_pair(_filename, _mesh));
+    this->loading.erase(_filename);
+    this->loadingCondition.notify_all();
+  }
+
+  /// \brief Protects the meshes. It is not held while a mesh file is
+  /// parsed, so that different meshes can be loaded concurrently.
+  public: mutable boost::mutex mutex;
 
-// added here for ABI compatibility
-// TODO move to header / private class when merging forward.
-static OBJLoader objLoader;
+  /// \brief Filenames of the meshes being loaded.
+  public: std::set<std::string> loading;
+
+  /// \brief Notified when a mesh is done loading.
+  public: boost::condition_variable loadingCondition;
+};
 
 //////////////////////////////////////////////////
 MeshManager::MeshManager()
   : dataPtr(new MeshManagerPrivate)
 {
-  this->dataPtr->colladaLoader = new ColladaLoader();
   this->dataPtr->colladaExporter = new ColladaExporter();
-  this->dataPtr->stlLoader = new STLLoader();
+  this->SetCachePath(MeshFileCache::DefaultPath());
 
   // Create some basic shapes
   this->CreatePlane("unit_plane",
@@ -124,9 +155,7 @@ MeshManager::MeshManager()
 //////////////////////////////////////////////////
 MeshManager::~MeshManager()
 {
-  delete this->dataPtr->colladaLoader;
   delete this->dataPtr->colladaExporter;
-  delete this->dataPtr->stlLoader;
   for (auto &pairNameMesh : this->dataPtr->meshes)
   {
     delete pairNameMesh.second;
@@ -146,81 +175,151 @@ const Mesh *MeshManager::Load(const std::string &_filename)
     return nullptr;
   }
 
-  Mesh *mesh = nullptr;
+  // Each new trimesh should have a unique name, a loaded mesh is never
+  // replaced.
+  const Mesh *existing = this->GetMesh(_filename);
+  if (existing)
+    return existing;
 
-  std::string extension;
+  std::string fullname = common::find_file(_filename);
+  if (fullname.empty())
+  {
+    gzerr << "Unable to find file[" << _filename << "]\n";
+    return nullptr;
+  }
 
-  if (this->HasMesh(_filename))
+  std::string extension = fullname.substr(fullname.rfind(".")+1,
+      fullname.size());
+  std::transform(extension.begin(), extension.end(),
+      extension.begin(), ::tolower);
+
+  // The loaders keep the state of the file they parse, so each load uses
+  // its own loader.
+  std::unique_ptr<MeshLoader> loader;
+  if (extension == "stl" || extension == "stlb" || extension == "stla")
+    loader.reset(new STLLoader());
+  else if (extension == "dae")
+    loader.reset(new ColladaLoader());
+  else if (extension == "obj")
+    loader.reset(new OBJLoader());
+  else
   {
-    return this->dataPtr->meshes[_filename];
-
-    // This breaks trimesh geom. Each new trimesh should have a unique name.
-    /*
-    // erase mesh from this->dataPtr->meshes.
-    // This allows a mesh to be modified and
-    // inserted into gazebo again without closing gazebo.
-    std::map<std::string, Mesh*>::iterator iter;
-    iter = this->dataPtr->meshes.find(_filename);
-    delete iter->second;
-    iter->second = nullptr;
-    this->dataPtr->meshes.erase(iter);
-    */
+    gzerr << "Unsupported mesh format for file[" << _filename << "]\n";
+    return nullptr;
   }
 
-  std::string fullname = common::find_file(_filename);
+  {
+    // Wait if another thread is loading the same mesh
+    boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+    while (this->dataPtr->loading.count(_filename) > 0)
+      this->dataPtr->loadingCondition.wait(lock);
+
+    auto iter = this->dataPtr->meshes.find(_filename);
+    if (iter != this->dataPtr->meshes.end())
+      return iter->second;
 
-  if (!fullname.empty())
+    this->dataPtr->loading.insert(_filename);
+  }
+
+  std::shared_ptr<MeshFileCache> fileCache;
   {
-    extension = fullname.substr(fullname.rfind(".")+1, fullname.size());
-    std::transform(extension.begin(), extension.end(),
-        extension.begin(), ::tolower);
-    MeshLoader *loader = nullptr;
-
-    if (extension == "stl" || extension == "stlb" || extension == "stla")
-      loader = this->dataPtr->stlLoader;
-    else if (extension == "dae")
-      loader = this->dataPtr->colladaLoader;
-    else if (extension == "obj")
-      loader = &objLoader;
-    else
-    {
-      gzerr << "Unsupported mesh format for file[" << _filename << "]\n";
-      return nullptr;
-    }
+    boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+    fileCache = this->dataPtr->fileCache;
+  }
 
-    try
-    {
-      // This mutex prevents two threads from loading the same mesh at the
-      // same time.
-      boost::mutex::scoped_lock lock(this->dataPtr->mutex);
-      if (!this->HasMesh(_filename))
-      {
-        if ((mesh = loader->Load(fullname)) != nullptr)
-        {
-          mesh->SetName(_filename);
-          this->dataPtr->meshes.insert(std::make_pair(_filename, mesh));
-        }
-        else
-          gzerr << "Unable to load mesh[" << fullname << "]\n";
-      }
-      else
-      {
-        mesh = this->dataPtr->meshes[_filename];
-      }
-    }
-    catch(gazebo::common::Exception &e)
+  Mesh *mesh = nullptr;
+  if (fileCache)
+  {
+    mesh = fileCache->Load(fullname);
+    if (mesh)
     {
-      gzerr << "Error loading mesh[" << fullname << "]\n";
-      gzerr << e << "\n";
-      gzthrow(e);
+      mesh->SetName(_filename);
+      this->dataPtr->FinishLoading(_filename, mesh);
+      return mesh;
     }
   }
+
+  try
+  {
+    mesh = loader->Load(fullname);
+  }
+  catch(gazebo::common::Exception &e)
+  {
+    this->dataPtr->FinishLoading(_filename, nullptr);
+    gzerr << "Error loading mesh[" << fullname << "]\n";
+    gzerr << e << "\n";
+    gzthrow(e);
+  }
+  catch(...)
+  {
+    this->dataPtr->FinishLoading(_filename, nullptr);
+    throw;
+  }
+
+  if (mesh)
+  {
+    mesh->SetName(_filename);
+    if (fileCache)
+      fileCache->Save(fullname, *mesh);
+  }
   else
-    gzerr << "Unable to find file[" << _filename << "]\n";
+    gzerr << "Unable to load mesh[" << fullname << "]\n";
 
+  this->dataPtr->FinishLoading(_filename, mesh);
   return mesh;
 }
 
+//////////////////////////////////////////////////
+void MeshManager::SetCachePath(const std::string &_path)
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  if (_path.empty())
+    this->dataPtr->fileCache.reset();
+  else
+    this->dataPtr->fileCache.reset(new MeshFileCache(_path));
+}
+
+//////////////////////////////////////////////////
+std::string MeshManager::CachePath() const
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  return this->dataPtr->fileCache ? this->dataPtr->fileCache->Path() : "";
+}
+
+//////////////////////////////////////////////////
+unsigned int MeshManager::Preload(const std::vector<std::string> &_filenames)
+{
+  std::set<std::string> unique;
+  for (auto const &filename : _filenames)
+  {
+    if (!filename.empty() && !this->HasMesh(filename))
+      unique.insert(filename);
+  }
+
+  std::vector<std::string> filenames(unique.begin(), unique.end());
+  std::vector<char> loaded(filenames.size(), 0);
+
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, filenames.size(), 1),
+      [&](const tbb::blocked_range<size_t> &_r)
+      {
+        for (size_t i = _r.begin(); i != _r.end(); ++i)
+        {
+          try
+          {
+            loaded[i] = this->Load(filenames[i]) != nullptr;
+          }
+          catch(...)
+          {
+            // The error is reported by Load, and again when the mesh is
+            // used.
+          }
+        }
+      });
+
+  return static_cast<unsigned int>(
+      std::count(loaded.begin(), loaded.end(), 1));
+}
+
 //////////////////////////////////////////////////
 void MeshManager::Export(const Mesh *_mesh, const std::string &_filename,
     const std::string &_extension, bool _exportTextures)
@@ -257,28 +356,37 @@ void MeshManager::GetMeshAABB(const Mesh *_mesh,
     ignition::math::Vector3d &_center,
     ignition::math::Vector3d &_minXYZ, ignition::math::Vector3d &_maxXYZ)
 {
-  if (this->HasMesh(_mesh->GetName()))
-    this->dataPtr->meshes[_mesh->GetName()]->GetAABB(_center, _minXYZ, _maxXYZ);
+  const Mesh *mesh = this->GetMesh(_mesh->GetName());
+  if (mesh)
+    mesh->GetAABB(_center, _minXYZ, _maxXYZ);
 }
 
 //////////////////////////////////////////////////
 void MeshManager::GenSphericalTexCoord(const Mesh *_mesh,
     const ignition::math::Vector3d &_center)
 {
-  if (this->HasMesh(_mesh->GetName()))
-    this->dataPtr->meshes[_mesh->GetName()]->GenSphericalTexCoord(_center);
+  Mesh *mesh = nullptr;
+  {
+    boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+    auto iter = this->dataPtr->meshes.find(_mesh->GetName());
+    if (iter != this->dataPtr->meshes.end())
+      mesh = iter->second;
+  }
+
+  if (mesh)
+    mesh->GenSphericalTexCoord(_center);
 }
 
 //////////////////////////////////////////////////
 void MeshManager::AddMesh(Mesh *_mesh)
 {
-  if (!this->HasMesh(_mesh->GetName()))
-    this->dataPtr->meshes[_mesh->GetName()] = _mesh;
+  this->dataPtr->Insert(_mesh->GetName(), _mesh);
 }
 
 //////////////////////////////////////////////////
 const Mesh *MeshManager::GetMesh(const std::string &_name) const
 {
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
   std::map<std::string, Mesh*>::const_iterator iter;
 
   iter = this->dataPtr->meshes.find(_name);
@@ -295,6 +403,7 @@ bool MeshManager::HasMesh(const std::string &_name) const
   if (_name.empty())
     return false;
 
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
   std::map<std::string, Mesh*>::const_iterator iter;
   iter = this->dataPtr->meshes.find(_name);
 
@@ -318,7 +427,7 @@ void MeshManager::CreateSphere(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
+  this->dataPtr->Insert(name, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -386,7 +495,7 @@ void MeshManager::CreatePlane(const std::string &_name,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->Insert(_name, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -466,7 +575,7 @@ void MeshManager::CreateBox(const std::string &_name,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->Insert(_name, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -767,7 +876,7 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
     }
   }
 
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->Insert(_name, mesh);
   return;
 }
 
@@ -783,7 +892,7 @@ void MeshManager::CreateCamera(const std::string &_name, float _scale)
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->Insert(_name, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -884,7 +993,7 @@ void MeshManager::CreateCylinder(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
+  this->dataPtr->Insert(name, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -1001,7 +1110,7 @@ void MeshManager::CreateCone(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
+  this->dataPtr->Insert(name, mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -1118,7 +1227,7 @@ void MeshManager::CreateTube(const std::string &_name, float _innerRadius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->Insert(_name, mesh);
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
 
@@ -1339,7 +1448,7 @@ void MeshManager::CreateBoolean(const std::string &_name, const Mesh *_m1,
   MeshCSG csg;
   Mesh *mesh = csg.CreateBoolean(_m1, _m2, _operation, _offset);
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->Insert(_name, mesh);
 }
 #endif
 
@@ -57,11 +57,28 @@ namespace gazebo
       /// Destroys the collada loader, the stl loader and all the meshes
       private: virtual ~MeshManager();
 
-      /// \brief Load a mesh from a file
+      /// \brief Load a mesh from a file. This function is thread safe, and
+      /// different meshes can be loaded concurrently.
       /// \param[in] _filename the path to the mesh
       /// \return a pointer to the created mesh
       public: const Mesh *Load(const std::string &_filename);
 
+      /// \brief Load meshes in parallel, on the TBB thread pool. The meshes
+      /// which are already loaded are skipped.
+      /// \param[in] _filenames Paths to the meshes, as passed to Load.
+      /// \return Number of meshes loaded by this call.
+      public: unsigned int Preload(const std::vector<std::string> &_filenames);
+
+      /// \brief Set the directory of the on-disk cache of parsed mesh
+      /// files, see MeshFileCache. It defaults to
+      /// MeshFileCache::DefaultPath().
+      /// \param[in] _path The directory, empty to disable the cache.
+      public: void SetCachePath(const std::string &_path);
+
+      /// \brief Get the directory of the on-disk cache of parsed mesh files.
+      /// \return The directory, empty if the cache is disabled.
+      public: std::string CachePath() const;
+
       /// \brief Export a mesh to a file
       /// \param[in] _mesh Pointer to the mesh to be exported
       /// \param[in] _filename Exported file's path and name
@@ -16,6 +16,9 @@
 */
 
 #include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "test_config.h"
 #include "gazebo/common/Mesh.hh"
@@ -266,6 +269,52 @@ TEST_F(MeshManager, CreateExtrudedPolylineInvalid)
   EXPECT_TRUE(!common::MeshManager::Instance()->HasMesh(meshName));
 }
 
+/////////////////////////////////////////////////
+TEST_F(MeshManager, Preload)
+{
+  const std::string dataPath = std::string(PROJECT_SOURCE_PATH) +
+    "/test/data/";
+  std::vector<std::string> filenames = {
+    dataPath + "box.dae",
+    dataPath + "box_offset.dae",
+    dataPath + "box_with_multiple_geoms.dae",
+    dataPath + "box.obj",
+    dataPath + "twoFaces.stl",
+    dataPath + "box.dae",
+    dataPath + "does_not_exist.dae",
+    ""};
+
+  common::MeshManager *mgr = common::MeshManager::Instance();
+  EXPECT_EQ(mgr->Preload(filenames), 5u);
+  for (unsigned int i = 0; i < 5u; ++i)
+  {
+    EXPECT_TRUE(mgr->HasMesh(filenames[i]));
+
+    // Already loaded, the same mesh is returned
+    const common::Mesh *mesh = mgr->GetMesh(filenames[i]);
+    ASSERT_TRUE(mesh != nullptr);
+    EXPECT_EQ(mgr->Load(filenames[i]), mesh);
+    EXPECT_EQ(mesh->GetName(), filenames[i]);
+    EXPECT_GT(mesh->GetVertexCount(), 0u);
+  }
+  EXPECT_FALSE(mgr->HasMesh(dataPath + "does_not_exist.dae"));
+
+  // Nothing left to load
+  EXPECT_EQ(mgr->Preload(filenames), 0u);
+
+  // Concurrent loads of the same mesh share it
+  const std::string filename = dataPath + "box_nested_animation.dae";
+  std::vector<const common::Mesh *> meshes(8, nullptr);
+  std::vector<std::thread> threads;
+  for (auto &mesh : meshes)
+    threads.emplace_back([&]() { mesh = mgr->Load(filename); });
+  for (auto &thread : threads)
+    thread.join();
+  ASSERT_TRUE(meshes[0] != nullptr);
+  for (auto const &mesh : meshes)
+    EXPECT_EQ(mesh, meshes[0]);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -15,9 +15,15 @@
  *
  */
 
+#include <chrono>
+#include <cstdint>
 #include <iostream>
 #include <fstream>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <boost/filesystem.hpp>
 #include <ignition/common/StringUtils.hh>
@@ -56,9 +62,169 @@ char pathDelimiter()
 /// TODO(chapulina): Move to member variable when porting forward
 std::vector<std::function<std::string (const std::string &)>> g_findFileCbs;
 
+/// \brief Protects the gazebo paths while FindFile copies them. The paths
+/// are read again from the environment each time they are requested, and
+/// meshes are loaded concurrently.
+static std::mutex g_gazeboPathsMutex;
+
+/// \brief How long a file which wasn't found is remembered.
+static const std::chrono::seconds kNegativeEntryLifetime(2);
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Result of a FindFile or FindFileURI lookup.
+    class FindFileEntry
+    {
+      /// \brief The full path, empty if the file wasn't found.
+      public: std::string path;
+
+      /// \brief When the entry expires, for files which weren't found.
+      public: std::chrono::steady_clock::time_point expiry;
+    };
+
+    /// \internal
+    /// \brief Private data for the SystemPaths class.
+    class SystemPathsPrivate
+    {
+      /// \brief Look up a cached result.
+      /// \param[in] _cache The cache.
+      /// \param[in] _key Key of the lookup.
+      /// \param[out] _path The cached path.
+      /// \return True if the result is cached.
+      public: bool Lookup(
+                  const std::unordered_map<std::string, FindFileEntry> &_cache,
+                  const std::string &_key, std::string &_path)
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (!this->cacheEnabled)
+          return false;
+
+        auto iter = _cache.find(_key);
+        if (iter == _cache.end() || (iter->second.path.empty() &&
+            std::chrono::steady_clock::now() >= iter->second.expiry))
+        {
+          return false;
+        }
+
+        _path = iter->second.path;
+        return true;
+      }
+
+      /// \brief Cache a result, unless the cache was cleared since the
+      /// lookup started.
+      /// \param[in] _cache The cache.
+      /// \param[in] _key Key of the lookup.
+      /// \param[in] _path The result.
+      /// \param[in] _generation Value of generation when the lookup started.
+      public: void Store(std::unordered_map<std::string, FindFileEntry> &_cache,
+                  const std::string &_key, const std::string &_path,
+                  const uint64_t _generation)
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (!this->cacheEnabled || _generation != this->generation)
+          return;
+
+        FindFileEntry &entry = _cache[_key];
+        entry.path = _path;
+        if (_path.empty())
+        {
+          entry.expiry =
+            std::chrono::steady_clock::now() + kNegativeEntryLifetime;
+        }
+      }
+
+      /// \brief Get the current generation.
+      /// \return The generation.
+      public: uint64_t Generation()
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->generation;
+      }
+
+      /// \brief Forget all the cached results and indices.
+      public: void Clear()
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->files.clear();
+        this->uris.clear();
+        this->indices.clear();
+        ++this->generation;
+      }
+
+      /// \brief Check if a model path may contain a file, using its index.
+      /// \param[in] _modelPath The model path.
+      /// \param[in] _relative Path of the file, relative to _modelPath.
+      /// \return False if the first directory of _relative is not in
+      /// _modelPath. True if it is, or if the indices are disabled.
+      public: bool MayContain(const std::string &_modelPath,
+                  const boost::filesystem::path &_relative)
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (!this->indexEnabled)
+          return true;
+
+        std::string first;
+        for (auto const &part : _relative.relative_path())
+        {
+          first = part.string();
+          break;
+        }
+        if (first.empty())
+          return true;
+
+        auto iter = this->indices.find(_modelPath);
+        if (iter == this->indices.end())
+        {
+          // Build the index of the model path
+          iter = this->indices.insert(std::make_pair(_modelPath,
+                std::unordered_set<std::string>())).first;
+          boost::system::error_code ec;
+          boost::filesystem::directory_iterator dirIter(_modelPath, ec);
+          boost::filesystem::directory_iterator end;
+          for (; !ec && dirIter != end; dirIter.increment(ec))
+            iter->second.insert(dirIter->path().filename().string());
+        }
+
+        return iter->second.count(first) > 0;
+      }
+
+      /// \brief Protects the members below.
+      public: std::mutex mutex;
+
+      /// \brief True if the results are cached.
+      public: bool cacheEnabled = true;
+
+      /// \brief True if the model paths are indexed.
+      public: bool indexEnabled = false;
+
+      /// \brief Incremented every time the cache is cleared, so that lookups
+      /// running concurrently don't store stale results.
+      public: uint64_t generation = 0;
+
+      /// \brief Results of FindFile, indexed by filename, search flag and
+      /// current directory.
+      public: std::unordered_map<std::string, FindFileEntry> files;
+
+      /// \brief Results of FindFileURI, indexed by URI.
+      public: std::unordered_map<std::string, FindFileEntry> uris;
+
+      /// \brief Entries of each model path directory.
+      public: std::unordered_map<std::string,
+              std::unordered_set<std::string>> indices;
+    };
+  }
+}
+
 //////////////////////////////////////////////////
 SystemPaths::SystemPaths()
+  : dataPtr(new SystemPathsPrivate)
 {
+  const char *indexEnv = getenv("GAZEBO_MODEL_PATH_INDEX");
+  this->dataPtr->indexEnabled = indexEnv && std::string(indexEnv) == "1";
+
   this->gazeboPaths.clear();
   this->ogrePaths.clear();
   this->pluginPaths.clear();
@@ -135,6 +301,11 @@ SystemPaths::SystemPaths()
   this->ogrePathsFromEnv = true;
 }
 
+/////////////////////////////////////////////////
+SystemPaths::~SystemPaths()
+{
+}
+
 /////////////////////////////////////////////////
 std::string SystemPaths::GetLogPath() const
 {
@@ -305,6 +476,19 @@ std::string SystemPaths::GetWorldPathExtension()
 
 //////////////////////////////////////////////////
 std::string SystemPaths::FindFileURI(const std::string &_uri)
+{
+  std::string filename;
+  if (this->dataPtr->Lookup(this->dataPtr->uris, _uri, filename))
+    return filename;
+
+  const uint64_t generation = this->dataPtr->Generation();
+  filename = this->FindFileURIUncached(_uri);
+  this->dataPtr->Store(this->dataPtr->uris, _uri, filename, generation);
+  return filename;
+}
+
+//////////////////////////////////////////////////
+std::string SystemPaths::FindFileURIUncached(const std::string &_uri)
 {
   int index = _uri.find("://");
   std::string prefix = _uri.substr(0, index);
@@ -319,6 +503,9 @@ std::string SystemPaths::FindFileURI(const std::string &_uri)
     for (std::list<std::string>::iterator iter = this->modelPaths.begin();
          iter != this->modelPaths.end(); ++iter)
     {
+      if (!this->dataPtr->MayContain(*iter, suffix))
+        continue;
+
       path = boost::filesystem::path(*iter) / suffix;
       if (boost::filesystem::exists(path))
       {
@@ -350,10 +537,40 @@ static bool isAbsolute(const std::string &_filename)
 std::string SystemPaths::FindFile(const std::string &_filename,
                                   bool _searchLocalPath)
 {
-  boost::filesystem::path path;
-
   if (_filename.empty())
-    return path.string();
+    return std::string();
+
+  // Copying the paths also reads them again from the environment, which
+  // clears the cache if they changed.
+  std::list<std::string> paths;
+  {
+    std::lock_guard<std::mutex> lock(g_gazeboPathsMutex);
+    paths = this->GetGazeboPaths();
+  }
+
+  // Relative paths depend on the current directory
+  std::string key = std::string(_searchLocalPath ? "1" : "0") + _filename;
+  if (_filename.find("://") == std::string::npos && !isAbsolute(_filename))
+  {
+    boost::system::error_code ec;
+    key += "\n" + boost::filesystem::current_path(ec).string();
+  }
+
+  std::string filename;
+  if (this->dataPtr->Lookup(this->dataPtr->files, key, filename))
+    return filename;
+
+  const uint64_t generation = this->dataPtr->Generation();
+  filename = this->FindFileUncached(_filename, _searchLocalPath, paths);
+  this->dataPtr->Store(this->dataPtr->files, key, filename, generation);
+  return filename;
+}
+
+//////////////////////////////////////////////////
+std::string SystemPaths::FindFileUncached(const std::string &_filename,
+    bool _searchLocalPath, const std::list<std::string> &_paths)
+{
+  boost::filesystem::path path;
 
   // Handle as URI
   if (_filename.find("://") != std::string::npos)
@@ -375,6 +592,9 @@ std::string SystemPaths::FindFile(const std::string &_filename,
       for (std::list<std::string>::iterator iter = this->modelPaths.begin();
            iter != this->modelPaths.end(); ++iter)
       {
+        if (!this->dataPtr->MayContain(*iter, path))
+          continue;
+
         auto modelPath = boost::filesystem::path(*iter) / path;
         if (boost::filesystem::exists(modelPath))
         {
@@ -410,10 +630,8 @@ std::string SystemPaths::FindFile(const std::string &_filename,
     else
     {
       bool found = false;
-      std::list<std::string> paths = this->GetGazeboPaths();
-
-      for (std::list<std::string>::const_iterator iter = paths.begin();
-          iter != paths.end() && !found; ++iter)
+      for (std::list<std::string>::const_iterator iter = _paths.begin();
+          iter != _paths.end() && !found; ++iter)
       {
         path = boost::filesystem::path((*iter));
         path = boost::filesystem::operator/(path, _filename);
@@ -469,30 +687,75 @@ void SystemPaths::AddFindFileCallback(
     std::function<std::string (const std::string &)> _cb)
 {
   g_findFileCbs.push_back(_cb);
+  this->dataPtr->Clear();
+}
+
+/////////////////////////////////////////////////
+void SystemPaths::SetFindFileCacheEnabled(const bool _enable)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->cacheEnabled = _enable;
+  }
+  this->dataPtr->Clear();
+}
+
+/////////////////////////////////////////////////
+bool SystemPaths::FindFileCacheEnabled() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->cacheEnabled;
+}
+
+/////////////////////////////////////////////////
+void SystemPaths::ClearFindFileCache()
+{
+  this->dataPtr->Clear();
+}
+
+/////////////////////////////////////////////////
+void SystemPaths::SetModelPathIndexEnabled(const bool _enable)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->indexEnabled = _enable;
+  }
+  this->dataPtr->Clear();
+}
+
+/////////////////////////////////////////////////
+bool SystemPaths::ModelPathIndexEnabled() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->indexEnabled;
 }
 
 /////////////////////////////////////////////////
 void SystemPaths::ClearGazeboPaths()
 {
   this->gazeboPaths.clear();
+  this->dataPtr->Clear();
 }
 
 /////////////////////////////////////////////////
 void SystemPaths::ClearOgrePaths()
 {
   this->ogrePaths.clear();
+  this->dataPtr->Clear();
 }
 
 /////////////////////////////////////////////////
 void SystemPaths::ClearPluginPaths()
 {
   this->pluginPaths.clear();
+  this->dataPtr->Clear();
 }
 
 /////////////////////////////////////////////////
 void SystemPaths::ClearModelPaths()
 {
   this->modelPaths.clear();
+  this->dataPtr->Clear();
 }
 
 /////////////////////////////////////////////////
@@ -559,7 +822,10 @@ void SystemPaths::InsertUnique(const std::string &_path,
                                std::list<std::string> &_list)
 {
   if (std::find(_list.begin(), _list.end(), _path) == _list.end())
+  {
     _list.push_back(_path);
+    this->dataPtr->Clear();
+  }
 }
 
 /////////////////////////////////////////////////
@@ -576,6 +842,7 @@ void SystemPaths::AddSearchPathSuffix(const std::string &_suffix)
     s += "/";
 
   this->suffixPaths.push_back(s);
+  this->dataPtr->Clear();
 }
 
 //////////////////////////////////////////////////
@@ -30,6 +30,7 @@
 
 #include <boost/filesystem.hpp>
 #include <list>
+#include <memory>
 #include <string>
 
 #include "gazebo/common/CommonTypes.hh"
@@ -44,6 +45,9 @@ namespace gazebo
 {
   namespace common
   {
+    // Forward declare private data class
+    class SystemPathsPrivate;
+
     /// \addtogroup gazebo_common Common
     /// \{
 
@@ -61,6 +65,9 @@ namespace gazebo
       /// Constructor for SystemPaths
       private: SystemPaths();
 
+      /// \brief Destructor
+      private: virtual ~SystemPaths();
+
       /// \brief Get the log path
       /// \return the path
       public: std::string GetLogPath() const;
@@ -126,6 +133,38 @@ namespace gazebo
       public: void AddFindFileCallback(
                   std::function<std::string (const std::string &)> _cb);
 
+      /// \brief Enable or disable the cache of FindFile and FindFileURI.
+      /// Files which are found are remembered until a search path is added
+      /// or cleared, or until ClearFindFileCache is called. Files which are
+      /// not found are remembered for a few seconds. The cache is enabled
+      /// by default.
+      /// \param[in] _enable True to enable the cache.
+      public: void SetFindFileCacheEnabled(const bool _enable);
+
+      /// \brief Get whether the cache of FindFile and FindFileURI is
+      /// enabled.
+      /// \return True if the cache is enabled.
+      public: bool FindFileCacheEnabled() const;
+
+      /// \brief Forget all the files remembered by FindFile and FindFileURI,
+      /// and the model path indices. Call it after adding or removing files
+      /// in the search paths.
+      public: void ClearFindFileCache();
+
+      /// \brief Enable or disable the model path indices. When enabled, the
+      /// entries of each model path directory are listed once, and a model
+      /// path is only searched if it contains the first directory of the
+      /// requested file. This saves a filesystem access per model path and
+      /// lookup, at the cost of missing files added to the model paths until
+      /// ClearFindFileCache is called. It is disabled by default, and can
+      /// also be enabled by setting GAZEBO_MODEL_PATH_INDEX to 1.
+      /// \param[in] _enable True to enable the indices.
+      public: void SetModelPathIndexEnabled(const bool _enable);
+
+      /// \brief Get whether the model path indices are enabled.
+      /// \return True if the indices are enabled.
+      public: bool ModelPathIndexEnabled() const;
+
       /// \brief Add colon delimited paths to Gazebo install
       /// \param[in] _path the directory to add
       public: void AddGazeboPaths(const std::string &_path);
@@ -163,6 +202,21 @@ namespace gazebo
       /// \param[in] _suffix The suffix to add
       public: void AddSearchPathSuffix(const std::string &_suffix);
 
+      /// \brief Find a file or path using a URI, without the cache.
+      /// \param[in] _uri the uniform resource identifier
+      /// \return Full path name to file or an empty string.
+      private: std::string FindFileURIUncached(const std::string &_uri);
+
+      /// \brief Find a file in the gazebo paths, without the cache.
+      /// \param[in] _filename Name of the file to find.
+      /// \param[in] _searchLocalPath True to search in the current working
+      /// directory.
+      /// \param[in] _paths Copy of the gazebo paths.
+      /// \return Full path name to file or an empty string.
+      private: std::string FindFileUncached(const std::string &_filename,
+                   bool _searchLocalPath,
+                   const std::list<std::string> &_paths);
+
       /// \brief re-read SystemPaths#gazeboPaths from environment variable
       private: void UpdateModelPaths();
 
@@ -222,6 +276,10 @@ namespace gazebo
 
       /// \brief Path to the instance temporary directory
       private: boost::filesystem::path tmpInstancePath;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<SystemPathsPrivate> dataPtr;
     };
     /// \}
   }
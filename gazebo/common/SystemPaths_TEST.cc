@@ -16,9 +16,12 @@
 */
 #include <gtest/gtest.h>
 
+#include <fstream>
 #include <string>
 #include <vector>
 
+#include <boost/filesystem.hpp>
+
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/SystemPaths.hh"
 #include "test/util.hh"
@@ -90,6 +93,69 @@ TEST_F(SystemPathsTest, FindFile)
   }
 }
 
+//////////////////////////////////////////////////
+TEST_F(SystemPathsTest, FindFileCache)
+{
+  auto sysPaths = common::SystemPaths::Instance();
+  EXPECT_TRUE(sysPaths->FindFileCacheEnabled());
+
+  boost::filesystem::path dir = boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gz_find_file_%%%%-%%%%");
+  boost::filesystem::create_directories(dir / "resources");
+  boost::filesystem::create_directories(dir / "models" / "my_model");
+  std::ofstream((dir / "resources" / "cached.txt").string()) << "cached";
+  std::ofstream((dir / "models" / "my_model" / "model.config").string())
+      << "model";
+
+  // Found files are remembered, even after they are removed
+  sysPaths->AddGazeboPaths((dir / "resources").string());
+  const std::string cached = (dir / "resources" / "cached.txt").string();
+  EXPECT_EQ(cached, sysPaths->FindFile("cached.txt"));
+  boost::filesystem::remove(cached);
+  EXPECT_EQ(cached, sysPaths->FindFile("cached.txt"));
+
+  // Until the cache is cleared
+  sysPaths->ClearFindFileCache();
+  EXPECT_EQ("", sysPaths->FindFile("cached.txt"));
+
+  // Adding a search path also clears it
+  std::ofstream(cached) << "cached";
+  EXPECT_EQ("", sysPaths->FindFile("cached.txt"));
+  sysPaths->AddSearchPathSuffix("gz_find_file_test");
+  EXPECT_EQ(cached, sysPaths->FindFile("cached.txt"));
+
+  // Without the cache, every lookup checks the filesystem
+  sysPaths->SetFindFileCacheEnabled(false);
+  EXPECT_FALSE(sysPaths->FindFileCacheEnabled());
+  boost::filesystem::remove(cached);
+  EXPECT_EQ("", sysPaths->FindFile("cached.txt"));
+  std::ofstream(cached) << "cached";
+  EXPECT_EQ(cached, sysPaths->FindFile("cached.txt"));
+  sysPaths->SetFindFileCacheEnabled(true);
+
+  // Model path index
+  sysPaths->AddModelPaths((dir / "models").string());
+  sysPaths->SetModelPathIndexEnabled(true);
+  EXPECT_TRUE(sysPaths->ModelPathIndexEnabled());
+  EXPECT_EQ((dir / "models" / "my_model" / "model.config").string(),
+      sysPaths->FindFileURI("model://my_model/model.config"));
+  EXPECT_EQ((dir / "models" / "my_model" / "model.config").string(),
+      sysPaths->FindFile("/my_model/model.config"));
+
+  // Models added after the index was built are missed until it is cleared
+  boost::filesystem::create_directories(dir / "models" / "new_model");
+  std::ofstream((dir / "models" / "new_model" / "model.config").string())
+      << "model";
+  EXPECT_EQ("", sysPaths->FindFile("/new_model/model.config"));
+  sysPaths->ClearFindFileCache();
+  EXPECT_EQ((dir / "models" / "new_model" / "model.config").string(),
+      sysPaths->FindFile("/new_model/model.config"));
+
+  sysPaths->SetModelPathIndexEnabled(false);
+  boost::filesystem::remove_all(dir);
+  sysPaths->ClearFindFileCache();
+}
+
 //////////////////////////////////////////////////
 TEST_F(SystemPathsTest, SystemPaths)
 {
@@ -50,7 +50,7 @@ void help()
   << "  -r [ --record ]               Record state data.\n"
   << "  --record_encoding arg (=zlib) Compression encoding format for log "
   << "data \n"
-  << "                                (zlib|bz2|txt).\n"
+  << "                                (zlib|bz2|txt|binary).\n"
   << "  --record_path arg             Absolute path in which to store "
   << "state data.\n"
   << "  --record_period arg (=-1)     Recording period (seconds).\n"
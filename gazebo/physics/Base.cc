@@ -74,6 +74,11 @@ void Base::Load(sdf::ElementPtr _sdf)
 
   this->ComputeScopedName();
 
+  // The entity is now part of the entity tree, make it visible to
+  // World::BaseByName.
+  if (this->parent && this->world)
+    this->world->IndexEntity(shared_from_this());
+
   this->RegisterIntrospectionItems();
 }
 
@@ -90,6 +95,9 @@ void Base::Fini()
 {
   this->UnregisterIntrospectionItems();
 
+  if (this->world)
+    this->world->UnindexEntity(*this);
+
   // Remove self as a child of the parent
   if (this->parent)
   {
@@ -138,6 +146,9 @@ void Base::SetName(const std::string &_name)
   this->sdf->GetAttribute("name")->Set(_name);
   this->name = _name;
   this->ComputeScopedName();
+
+  if (this->world)
+    this->world->ReindexEntity(*this);
 }
 
 //////////////////////////////////////////////////
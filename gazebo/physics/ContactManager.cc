@@ -99,88 +99,115 @@ bool ContactManager::SubscribersConnected(Collision *_collision1,
   if (this->contactPub->HasConnections()) return true;
 
   boost::recursive_mutex::scoped_lock lock(*this->customMutex);
-  boost::unordered_map<std::string, ContactPublisher *>::const_iterator iter;
-  for (iter = this->customContactPublishers.begin();
-       iter != this->customContactPublishers.end(); ++iter)
+
+  // only reason _collision1 or _collision1 cannot be const parameters
+  // is that compiler can't find const pointers in unordered map
+  return this->collisionFilters.find(_collision1) !=
+         this->collisionFilters.end() ||
+         this->collisionFilters.find(_collision2) !=
+         this->collisionFilters.end();
+}
+
+/////////////////////////////////////////////////
+void ContactManager::GetCustomPublishers(Collision *_collision1,
+                     Collision *_collision2, const bool _getOnlyConnected,
+                     std::vector<ContactPublisher*> &_publishers)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+
+  auto iter1 = this->collisionFilters.find(_collision1);
+  auto iter2 = this->collisionFilters.find(_collision2);
+
+  // Most pairs are not monitored by any filter
+  if (iter1 == this->collisionFilters.end() &&
+      iter2 == this->collisionFilters.end())
   {
-    // A model can simply be loaded later, so check the collisionNames as well.
-    if (!iter->second->collisionNames.empty())
-    {
-      std::vector<std::string>::const_iterator it;
-      for (it = iter->second->collisionNames.begin();
-           it != iter->second->collisionNames.end(); ++it)
-      {
-        BasePtr b = this->world->BaseByName(*it);
-        if (b)
-        {
-          return true;
-        }
-        // We could do the same transformation which is done in
-        // GetCustomPublishers() here (insert collisions which now have been
-        // loaded), but this would remove the const qualifier of this function.
-        // It would however speed up repeated calls of this function without
-        // a call of NewContact() or GetCustomPublishers() in between.
-      }
-    }
+    return;
+  }
+
+  const boost::dynamic_bitset<> *filters1 =
+      iter1 != this->collisionFilters.end() ? &iter1->second : nullptr;
+  const boost::dynamic_bitset<> *filters2 =
+      iter2 != this->collisionFilters.end() ? &iter2->second : nullptr;
 
-    // only reason _collision1 or _collision1 cannot be const parameters
-    // is that compiler can't find const pointers in unordered set
-    if (iter->second->collisions.find(_collision1) !=
-        iter->second->collisions.end() ||
-        iter->second->collisions.find(_collision2) !=
-        iter->second->collisions.end())
+  for (size_t i = 0; i < this->filterPublishers.size(); ++i)
+  {
+    if (!(filters1 && filters1->test(i)) && !(filters2 && filters2->test(i)))
+      continue;
+
+    ContactPublisher *contactPublisher = this->filterPublishers[i];
+    GZ_ASSERT(contactPublisher->publisher != NULL ||
+              contactPublisher->callback,
+              "ContactPublisher must have a valid publisher or callback");
+    if (!_getOnlyConnected || contactPublisher->callback ||
+        contactPublisher->publisher->HasConnections())
     {
-      return true;
+      _publishers.push_back(contactPublisher);
     }
   }
-  return false;
 }
 
 /////////////////////////////////////////////////
-void ContactManager::GetCustomPublishers(Collision *_collision1,
-                     Collision *_collision2, const bool _getOnlyConnected,
-                     std::vector<ContactPublisher*> &_publishers)
+void ContactManager::RebuildCollisionFilters()
 {
   boost::recursive_mutex::scoped_lock lock(*this->customMutex);
-  boost::unordered_map<std::string, ContactPublisher *>::iterator iter;
-  for (iter = this->customContactPublishers.begin();
-       iter != this->customContactPublishers.end(); ++iter)
+
+  this->filterPublishers.clear();
+  this->collisionFilters.clear();
+  this->pendingCollisionNames = false;
+
+  for (auto const &iter : this->customContactPublishers)
+    this->filterPublishers.push_back(iter.second);
+
+  const size_t filterCount = this->filterPublishers.size();
+  for (size_t i = 0; i < filterCount; ++i)
   {
-    // A model can simply be loaded later, so convert ones that are not yet
-    // found
-    if (!iter->second->collisionNames.empty())
+    ContactPublisher *contactPublisher = this->filterPublishers[i];
+    if (!contactPublisher->collisionNames.empty())
+      this->pendingCollisionNames = true;
+
+    for (auto const &collision : contactPublisher->collisions)
     {
-      std::vector<std::string>::iterator it;
-      for (it = iter->second->collisionNames.begin();
-          it != iter->second->collisionNames.end();)
+      auto iter = this->collisionFilters.find(collision);
+      if (iter == this->collisionFilters.end())
       {
-        Collision *col = boost::dynamic_pointer_cast<Collision>(
-            this->world->BaseByName(*it)).get();
-        if (!col)
-        {
-          ++it;
-          continue;
-        }
-        it = iter->second->collisionNames.erase(it);
-        iter->second->collisions.insert(col);
+        iter = this->collisionFilters.insert(std::make_pair(collision,
+              boost::dynamic_bitset<>(filterCount))).first;
       }
+      iter->second.set(i);
     }
+  }
+}
+
+/////////////////////////////////////////////////
+void ContactManager::ResolveCollisionNames()
+{
+  boost::recursive_mutex::scoped_lock lock(*this->customMutex);
 
-    // only reason _collision1 or _collision1 cannot be const parameters
-    // is that compiler can't find const pointers in unordered set
-    if (iter->second->collisions.find(_collision1) !=
-        iter->second->collisions.end() ||
-        iter->second->collisions.find(_collision2) !=
-        iter->second->collisions.end())
+  bool resolved = false;
+  for (auto &contactPublisher : this->filterPublishers)
+  {
+    // A model can simply be loaded later, so convert ones that are not yet
+    // found
+    std::vector<std::string>::iterator it;
+    for (it = contactPublisher->collisionNames.begin();
+        it != contactPublisher->collisionNames.end();)
     {
-      GZ_ASSERT(iter->second->publisher != NULL,
-                "ContactPublisher must have a valid publisher");
-      if (!_getOnlyConnected || iter->second->publisher->HasConnections())
+      Collision *col = boost::dynamic_pointer_cast<Collision>(
+          this->world->BaseByName(*it)).get();
+      if (!col)
       {
-        _publishers.push_back(iter->second);
+        ++it;
+        continue;
       }
+      it = contactPublisher->collisionNames.erase(it);
+      contactPublisher->collisions.insert(col);
+      resolved = true;
     }
   }
+
+  if (resolved)
+    this->RebuildCollisionFilters();
 }
 
 /////////////////////////////////////////////////
@@ -198,7 +225,8 @@ Contact *ContactManager::NewContact(Collision *_collision1,
   // This is a signal to the Physics engine that it can skip the extra
   // processing necessary to get back contact information.
 
-  std::vector<ContactPublisher *> publishers;
+  std::vector<ContactPublisher *> &publishers = this->contactPublishers;
+  publishers.clear();
   bool getOnlyConnected = false;
   // TODO check: getOnlyConnected set to false to keep same behaviour as before.
   // But should we not only add publishers which are connected, as is done
@@ -262,6 +290,12 @@ const std::vector<Contact*> &ContactManager::GetContacts() const
 void ContactManager::ResetCount()
 {
   this->contactIndex = 0;
+
+  // Collisions named by a filter may be loaded at any time. Look them up
+  // once per collision step, rather than for every colliding pair.
+  boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+  if (this->pendingCollisionNames)
+    this->ResolveCollisionNames();
 }
 
 /////////////////////////////////////////////////
@@ -295,42 +329,53 @@ void ContactManager::PublishContacts()
     return;
   }
 
-  // publish to default topic, ~/physics/contacts
-  if (!transport::getMinimalComms())
+  // publish to default topic, ~/physics/contacts, only if someone listens.
+  // The message is reused: Clear() keeps the memory of its contacts, so no
+  // allocation happens once the number of contacts has settled.
+  if (!transport::getMinimalComms() && this->contactPub->HasConnections())
   {
-    msgs::Contacts msg;
+    this->contactsMsg.Clear();
     for (unsigned int i = 0; i < this->contactIndex; ++i)
     {
       if (this->contacts[i]->count == 0)
         continue;
 
-      msgs::Contact *contactMsg = msg.add_contact();
+      msgs::Contact *contactMsg = this->contactsMsg.add_contact();
       this->contacts[i]->FillMsg(*contactMsg);
     }
 
-    msgs::Set(msg.mutable_time(), this->world->SimTime());
-    this->contactPub->Publish(msg);
+    msgs::Set(this->contactsMsg.mutable_time(), this->world->SimTime());
+    this->contactPub->Publish(this->contactsMsg);
   }
 
   // publish to other custom topics
   boost::recursive_mutex::scoped_lock lock(*this->customMutex);
-  boost::unordered_map<std::string, ContactPublisher *>::iterator iter;
-  for (iter = this->customContactPublishers.begin();
-      iter != this->customContactPublishers.end(); ++iter)
+  for (auto &contactPublisher : this->filterPublishers)
   {
-    ContactPublisher *contactPublisher = iter->second;
-    msgs::Contacts msg2;
-    for (unsigned int j = 0;
-        j < contactPublisher->contacts.size(); ++j)
+    // In-process consumers get the contacts as they are
+    if (contactPublisher->callback)
     {
-      if (contactPublisher->contacts[j]->count == 0)
-        continue;
+      contactPublisher->callback(contactPublisher->contacts,
+          this->world->SimTime());
+    }
 
-      msgs::Contact *contactMsg = msg2.add_contact();
-      contactPublisher->contacts[j]->FillMsg(*contactMsg);
+    if (contactPublisher->publisher &&
+        contactPublisher->publisher->HasConnections())
+    {
+      msgs::Contacts &msg = contactPublisher->msg;
+      msg.Clear();
+      for (unsigned int j = 0;
+          j < contactPublisher->contacts.size(); ++j)
+      {
+        if (contactPublisher->contacts[j]->count == 0)
+          continue;
+
+        msgs::Contact *contactMsg = msg.add_contact();
+        contactPublisher->contacts[j]->FillMsg(*contactMsg);
+      }
+      msgs::Set(msg.mutable_time(), this->world->SimTime());
+      contactPublisher->publisher->Publish(msg);
     }
-    msgs::Set(msg2.mutable_time(), this->world->SimTime());
-    contactPublisher->publisher->Publish(msg2);
     contactPublisher->contacts.clear();
   }
 }
@@ -375,6 +420,7 @@ std::string ContactManager::CreateFilter(const std::string &_name,
   {
     boost::recursive_mutex::scoped_lock lock(*this->customMutex);
     this->customContactPublishers[name] = contactPublisher;
+    this->RebuildCollisionFilters();
   }
 
   return topic;
@@ -419,11 +465,57 @@ std::string ContactManager::CreateFilter(const std::string &_name,
 
     // Let it know about collisions not yet found.
     this->customContactPublishers[name]->collisionNames = collisionNames;
+    if (!collisionNames.empty())
+      this->pendingCollisionNames = true;
   }
 
   return topic;
 }
 
+/////////////////////////////////////////////////
+bool ContactManager::CreateCallbackFilter(const std::string &_name,
+    const std::vector<std::string> &_collisions,
+    ContactFilterCallback _callback)
+{
+  if (_collisions.empty() || !_callback)
+    return false;
+
+  std::string name = _name;
+  boost::replace_all(name, "::", "/");
+
+  boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+  if (this->customContactPublishers.find(name) !=
+    this->customContactPublishers.end())
+  {
+    gzerr << "Filter with the same name already exists! Aborting" << std::endl;
+    return false;
+  }
+
+  // The contacts are also published to the topic of a regular filter, for
+  // subscribers outside of the process.
+  ContactPublisher *contactPublisher = new ContactPublisher;
+  contactPublisher->callback = _callback;
+  contactPublisher->publisher = this->node->Advertise<msgs::Contacts>(
+      "~/" + name + "/contacts");
+
+  // some collisions may not be loaded yet, so store their names in
+  // collisionNames and try to find them later.
+  for (auto const &collisionName : _collisions)
+  {
+    Collision *col = boost::dynamic_pointer_cast<Collision>(
+        this->world->BaseByName(collisionName)).get();
+    if (col)
+      contactPublisher->collisions.insert(col);
+    else
+      contactPublisher->collisionNames.push_back(collisionName);
+  }
+
+  this->customContactPublishers[name] = contactPublisher;
+  this->RebuildCollisionFilters();
+
+  return true;
+}
+
 /////////////////////////////////////////////////
 void ContactManager::RemoveFilter(const std::string &_name)
 {
@@ -439,9 +531,14 @@ void ContactManager::RemoveFilter(const std::string &_name)
     contactPublisher->contacts.clear();
     contactPublisher->collisionNames.clear();
     contactPublisher->collisions.clear();
-    contactPublisher->publisher->Fini();
-    contactPublisher->publisher.reset();
+    if (contactPublisher->publisher)
+    {
+      contactPublisher->publisher->Fini();
+      contactPublisher->publisher.reset();
+    }
+    contactPublisher->callback = nullptr;
     this->customContactPublishers.erase(iter);
+    this->RebuildCollisionFilters();
   }
 }
 
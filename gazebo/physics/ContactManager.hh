@@ -18,11 +18,13 @@
 #ifndef GAZEBO_PHYSICS_CONTACTMANAGER_HH_
 #define GAZEBO_PHYSICS_CONTACTMANAGER_HH_
 
+#include <functional>
 #include <vector>
 #include <string>
 #include <map>
 #include <ignition/transport/Node.hh>
 
+#include <boost/dynamic_bitset.hpp>
 #include <boost/unordered/unordered_set.hpp>
 #include <boost/unordered/unordered_map.hpp>
 #include <boost/thread/recursive_mutex.hpp>
@@ -37,13 +39,26 @@ namespace gazebo
 {
   namespace physics
   {
+    /// \brief Function called by ContactManager::PublishContacts with the
+    /// contacts of a filter created with
+    /// ContactManager::CreateCallbackFilter. Contacts with a count of 0 must
+    /// be ignored. The contacts are only valid during the call.
+    /// \param[in] _contacts Contacts of the monitored collisions.
+    /// \param[in] _time Simulation time.
+    using ContactFilterCallback =
+        std::function<void (const std::vector<Contact *> &_contacts,
+                            const common::Time &_time)>;
+
     /// \brief A custom contact publisher created for each contact filter
     /// in the Contact Manager.
     class GZ_PHYSICS_VISIBLE ContactPublisher
     {
-      /// \brief Contact message publisher
+      /// \brief Contact message publisher.
       public: transport::PublisherPtr publisher;
 
+      /// \brief Callback of a filter created with CreateCallbackFilter.
+      public: ContactFilterCallback callback;
+
       /// \brief Pointers of collisions monitored by contact manager for
       /// contacts.
       public: boost::unordered_set<Collision *> collisions;
@@ -56,6 +71,11 @@ namespace gazebo
       /// \brief A list of contacts associated to the collisions.
       public: std::vector<Contact *> contacts;
 
+      /// \internal
+      /// \brief Message reused by every PublishContacts call, so that the
+      /// memory of its contacts is recycled between time steps.
+      public: msgs::Contacts msg;
+
       // Place ignition::transport objects at the end of this file to
       // guarantee they are destructed first.
 
@@ -191,6 +211,24 @@ namespace gazebo
                   const std::map<std::string, physics::CollisionPtr>
                   &_collisions);
 
+      /// \brief Create a filter for contacts which hands the contacts
+      /// associated to the input collisions directly to a callback, after
+      /// every physics update. This saves the conversion of the contacts to
+      /// messages, and is meant for in-process consumers such as contact
+      /// sensors. The contacts are still published to the topic of a filter
+      /// created with CreateFilter, but only while it has subscribers. The
+      /// filter is removed with RemoveFilter.
+      /// \param[in] _name Filter name.
+      /// \param[in] _collisions A list of collision names used for filtering.
+      /// Collisions which aren't loaded yet are picked up when they are.
+      /// \param[in] _callback Function called by PublishContacts, from the
+      /// physics thread and with the filters locked. It must not create or
+      /// remove filters.
+      /// \return False if the filter couldn't be created.
+      public: bool CreateCallbackFilter(const std::string &_name,
+                  const std::vector<std::string> &_collisions,
+                  ContactFilterCallback _callback);
+
       /// \brief Remove a contacts filter and the associated custom publisher
       /// param[in] _name Filter name.
       public: void RemoveFilter(const std::string &_name);
@@ -215,6 +253,15 @@ namespace gazebo
                        Collision *_collision2, const bool _getOnlyConnected,
                        std::vector<ContactPublisher*> &_publishers);
 
+      /// \brief Rebuild collisionFilters and filterPublishers from the
+      /// custom publishers. Must be called whenever a filter, or the
+      /// collisions it monitors, change.
+      private: void RebuildCollisionFilters();
+
+      /// \brief Convert collision names of filters, whose collisions were
+      /// not loaded when the filter was created, to collision pointers.
+      private: void ResolveCollisionNames();
+
       private: std::vector<Contact*> contacts;
 
       private: unsigned int contactIndex;
@@ -236,6 +283,27 @@ namespace gazebo
       /// \brief Mutex to protect the list of custom publishers.
       private: boost::recursive_mutex *customMutex;
 
+      /// \brief Custom publishers, indexed by their bit in collisionFilters.
+      private: std::vector<ContactPublisher *> filterPublishers;
+
+      /// \brief For each collision monitored by at least one filter, the
+      /// set of filters that monitor it. Bit i refers to
+      /// filterPublishers[i].
+      private: boost::unordered_map<Collision *, boost::dynamic_bitset<>>
+          collisionFilters;
+
+      /// \brief True if any filter has collision names that are not
+      /// resolved yet.
+      private: bool pendingCollisionNames = false;
+
+      /// \brief Custom publishers of the contact being created, kept as a
+      /// member to avoid an allocation in every NewContact call.
+      private: std::vector<ContactPublisher *> contactPublishers;
+
+      /// \brief Message reused by every PublishContacts call for the
+      /// default contacts topic.
+      private: msgs::Contacts contactsMsg;
+
       // Place ignition::transport objects at the end of this file to
       // guarantee they are destructed first.
 
@@ -15,6 +15,10 @@
  *
 */
 
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "gazebo/physics/ContactManager.hh"
 #include "gazebo/test/ServerFixture.hh"
 
@@ -194,6 +198,159 @@ TEST_F(ContactManagerTest, NeverDropContacts)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(ContactManagerTest, FilterSubscribers)
+{
+  Load("test/worlds/box.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  physics::ContactManager *manager = physics->GetContactManager();
+  ASSERT_TRUE(manager != nullptr);
+
+  physics::CollisionPtr boxCollision =
+      boost::dynamic_pointer_cast<physics::Collision>(
+      world->BaseByName("box::link::collision"));
+  ASSERT_TRUE(boxCollision != nullptr);
+
+  // Nobody listens, so no contacts are created
+  world->Step(1);
+  EXPECT_EQ(manager->GetContactCount(), 0u);
+  EXPECT_FALSE(manager->SubscribersConnected(boxCollision.get(), nullptr));
+
+  // One collision exists, the other one is spawned later
+  std::vector<std::string> collisions;
+  collisions.push_back("box::link::collision");
+  collisions.push_back("late::body::geom");
+  std::string topic = manager->CreateFilter("box_filter", collisions);
+  EXPECT_FALSE(topic.empty());
+
+  EXPECT_TRUE(manager->SubscribersConnected(boxCollision.get(), nullptr));
+  EXPECT_TRUE(manager->SubscribersConnected(nullptr, boxCollision.get()));
+
+  // Contacts of monitored collisions are created even without subscribers,
+  // but no message is published.
+  world->Step(1);
+  EXPECT_GT(manager->GetContactCount(), 0u);
+
+  // Messages are published once the filter topic has a subscriber
+  std::mutex mutex;
+  int received = 0;
+  int contactCount = 0;
+  boost::function<void(ConstContactsPtr &)> callback =
+      [&](ConstContactsPtr &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++received;
+        contactCount = _msg->contact_size();
+      };
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::SubscriberPtr sub = node->Subscribe(topic, callback);
+
+  for (int i = 0; i < 50; ++i)
+  {
+    world->Step(1);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (received > 0)
+        break;
+    }
+    common::Time::MSleep(10);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_GT(received, 0);
+    EXPECT_GT(contactCount, 0);
+  }
+
+  // The collision that was missing is picked up once it is loaded
+  SpawnBox("late", ignition::math::Vector3d(1, 1, 1),
+      ignition::math::Vector3d(5, 5, 0.5));
+  physics::CollisionPtr lateCollision =
+      boost::dynamic_pointer_cast<physics::Collision>(
+      world->BaseByName("late::body::geom"));
+  ASSERT_TRUE(lateCollision != nullptr);
+
+  world->Step(1);
+  EXPECT_TRUE(manager->SubscribersConnected(lateCollision.get(), nullptr));
+
+  // Removing the filter clears the monitored collisions
+  manager->RemoveFilter("box_filter");
+  EXPECT_FALSE(manager->SubscribersConnected(boxCollision.get(),
+      lateCollision.get()));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ContactManagerTest, CallbackFilter)
+{
+  Load("test/worlds/box.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  physics::ContactManager *manager = physics->GetContactManager();
+  ASSERT_TRUE(manager != nullptr);
+
+  physics::CollisionPtr boxCollision =
+      boost::dynamic_pointer_cast<physics::Collision>(
+      world->BaseByName("box::link::collision"));
+  ASSERT_TRUE(boxCollision != nullptr);
+
+  // The callback is called after every step, from the physics thread
+  int calls = 0;
+  int contactCount = 0;
+  common::Time time;
+  std::vector<std::string> collisions;
+  collisions.push_back("box::link::collision");
+  EXPECT_FALSE(manager->CreateCallbackFilter("box_callback", collisions,
+      nullptr));
+  EXPECT_TRUE(manager->CreateCallbackFilter("box_callback", collisions,
+      [&](const std::vector<physics::Contact *> &_contacts,
+          const common::Time &_time)
+      {
+        ++calls;
+        time = _time;
+        contactCount = 0;
+        for (auto const &contact : _contacts)
+        {
+          if (contact->count == 0)
+            continue;
+          ++contactCount;
+          EXPECT_TRUE(contact->collision1 == boxCollision.get() ||
+                      contact->collision2 == boxCollision.get());
+        }
+      }));
+  EXPECT_TRUE(manager->HasFilter("box_callback"));
+  EXPECT_TRUE(manager->SubscribersConnected(boxCollision.get(), nullptr));
+
+  // A filter with the same name can't be created twice
+  EXPECT_FALSE(manager->CreateCallbackFilter("box_callback", collisions,
+      [](const std::vector<physics::Contact *> &, const common::Time &) {}));
+
+  world->Step(1);
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(time, world->SimTime());
+  EXPECT_GT(contactCount, 0);
+
+  world->Step(2);
+  EXPECT_EQ(calls, 3);
+
+  // No callback once the filter is removed
+  manager->RemoveFilter("box_callback");
+  EXPECT_FALSE(manager->HasFilter("box_callback"));
+  world->Step(1);
+  EXPECT_EQ(calls, 3);
+}
+
+/////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
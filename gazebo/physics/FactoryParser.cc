@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <string>
+
+#include <boost/filesystem.hpp>
+#include <ignition/common/URI.hh>
+
+#include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/FuelModelDatabase.hh"
+#include "gazebo/common/ModelDatabase.hh"
+#include "gazebo/physics/FactoryParserPrivate.hh"
+#include "gazebo/physics/FactoryParser.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+//////////////////////////////////////////////////
+FactoryParser::FactoryParser(const unsigned int _threads)
+  : dataPtr(new FactoryParserPrivate)
+{
+  if (_threads > 0)
+    this->dataPtr->threadCount = _threads;
+}
+
+//////////////////////////////////////////////////
+FactoryParser::~FactoryParser()
+{
+  this->Fini();
+}
+
+//////////////////////////////////////////////////
+void FactoryParser::Fini()
+{
+  std::vector<std::thread> threads;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+    this->dataPtr->requests.clear();
+    this->dataPtr->pending.clear();
+    threads.swap(this->dataPtr->threads);
+  }
+  this->dataPtr->condition.notify_all();
+
+  for (auto &thread : threads)
+    thread.join();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->stop = false;
+}
+
+//////////////////////////////////////////////////
+void FactoryParser::Push(const msgs::Factory &_msg)
+{
+  auto request = std::make_shared<FactoryRequest>();
+  request->msg = _msg;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->requests.push_back(request);
+
+  if (!HasSDF(_msg))
+  {
+    request->ready = true;
+    return;
+  }
+
+  this->dataPtr->pending.push_back(request);
+  if (this->dataPtr->threads.empty())
+  {
+    for (unsigned int i = 0; i < this->dataPtr->threadCount; ++i)
+      this->dataPtr->threads.emplace_back(&FactoryParser::Run, this);
+  }
+  this->dataPtr->condition.notify_one();
+}
+
+//////////////////////////////////////////////////
+bool FactoryParser::Pop(msgs::Factory &_msg, sdf::ElementPtr &_root)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->requests.empty() ||
+      !this->dataPtr->requests.front()->ready)
+  {
+    return false;
+  }
+
+  auto request = this->dataPtr->requests.front();
+  this->dataPtr->requests.pop_front();
+
+  _msg = request->msg;
+  _root = request->root;
+  return true;
+}
+
+//////////////////////////////////////////////////
+size_t FactoryParser::QueuedCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->requests.size();
+}
+
+//////////////////////////////////////////////////
+size_t FactoryParser::TemplateCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->templateMutex);
+  return this->dataPtr->templates.size();
+}
+
+//////////////////////////////////////////////////
+size_t FactoryParser::TemplateHits() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->templateMutex);
+  return this->dataPtr->hits;
+}
+
+//////////////////////////////////////////////////
+void FactoryParser::ClearTemplates()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->templateMutex);
+  this->dataPtr->templates.clear();
+}
+
+//////////////////////////////////////////////////
+bool FactoryParser::HasSDF(const msgs::Factory &_msg)
+{
+  return (_msg.has_sdf() && !_msg.sdf().empty()) ||
+      (_msg.has_sdf_filename() && !_msg.sdf_filename().empty());
+}
+
+//////////////////////////////////////////////////
+void FactoryParser::Run()
+{
+  // sdf::initFile causes disk access, do it once per thread
+  sdf::SDFPtr sdf(new sdf::SDF);
+  sdf::initFile("root.sdf", sdf);
+
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+  while (true)
+  {
+    this->dataPtr->condition.wait(lock, [this]
+        {
+          return this->dataPtr->stop || !this->dataPtr->pending.empty();
+        });
+
+    if (this->dataPtr->stop)
+      break;
+
+    auto request = this->dataPtr->pending.front();
+    this->dataPtr->pending.pop_front();
+
+    lock.unlock();
+    sdf::ElementPtr root = this->dataPtr->Parse(request->msg, sdf);
+    lock.lock();
+
+    request->root = root;
+    request->ready = true;
+  }
+}
+
+//////////////////////////////////////////////////
+sdf::ElementPtr FactoryParserPrivate::Parse(const msgs::Factory &_msg,
+    const sdf::SDFPtr &_sdf)
+{
+  const bool isString = _msg.has_sdf() && !_msg.sdf().empty();
+
+  std::string key;
+  std::string filename;
+  std::time_t modified = 0;
+  if (isString)
+  {
+    key = "sdf:" + _msg.sdf();
+  }
+  else
+  {
+    // If http(s), look at Fuel
+    auto uri = ignition::common::URI(_msg.sdf_filename());
+    if (uri.Valid() && (uri.Scheme() == "https" || uri.Scheme() == "http"))
+    {
+      filename = common::FuelModelDatabase::Instance()->ModelFile(
+          _msg.sdf_filename());
+    }
+    // Otherwise, look at database
+    else
+    {
+      filename = common::ModelDatabase::Instance()->GetModelFile(
+          _msg.sdf_filename());
+    }
+
+    boost::system::error_code ec;
+    modified = boost::filesystem::last_write_time(filename, ec);
+    if (ec)
+      modified = 0;
+
+    key = "file:" + filename;
+  }
+
+  sdf::ElementPtr root;
+  {
+    std::lock_guard<std::mutex> lock(this->templateMutex);
+    auto iter = this->templates.find(key);
+    if (iter != this->templates.end() && iter->second.modified == modified)
+    {
+      iter->second.lastUse = ++this->useCount;
+      ++this->hits;
+      root = iter->second.root;
+    }
+  }
+
+  if (root)
+    return root->Clone();
+
+  {
+    std::lock_guard<std::mutex> lock(common::sdfParseMutex());
+
+    _sdf->Clear();
+    if (isString)
+    {
+      if (!sdf::readString(_msg.sdf(), _sdf))
+      {
+        gzerr << "Unable to read sdf string[" << _msg.sdf() << "]\n";
+        return sdf::ElementPtr();
+      }
+    }
+    else
+    {
+      if (!sdf::readFile(filename, _sdf))
+      {
+        gzerr << "Unable to read sdf file [" << filename << "]\n";
+        return sdf::ElementPtr();
+      }
+
+      common::convertToFullPaths(_sdf->Root());
+    }
+
+    root = _sdf->Root()->Clone();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->templateMutex);
+
+    // Drop the least recently used template
+    if (this->templates.size() >= kMaxTemplates &&
+        this->templates.find(key) == this->templates.end())
+    {
+      auto oldest = std::min_element(this->templates.begin(),
+          this->templates.end(), [](
+            const std::pair<const std::string, FactoryTemplate> &_a,
+            const std::pair<const std::string, FactoryTemplate> &_b)
+          {
+            return _a.second.lastUse < _b.second.lastUse;
+          });
+      this->templates.erase(oldest);
+    }
+
+    FactoryTemplate &entry = this->templates[key];
+    entry.root = root;
+    entry.modified = modified;
+    entry.lastUse = ++this->useCount;
+  }
+
+  return root->Clone();
+}
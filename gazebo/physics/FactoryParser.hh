@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_FACTORYPARSER_HH_
+#define GAZEBO_PHYSICS_FACTORYPARSER_HH_
+
+#include <cstddef>
+#include <memory>
+
+#include <sdf/sdf.hh>
+
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class
+    class FactoryParserPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class FactoryParser FactoryParser.hh physics/physics.hh
+    /// \brief Parses the SDF of factory messages on background threads.
+    ///
+    /// Messages are queued with Push. The SDF string or file of a message
+    /// is resolved and parsed by a pool of threads, and the world thread
+    /// gets the parsed elements back with Pop, in the order the messages
+    /// were pushed.
+    ///
+    /// Parsed trees are kept as templates, keyed by SDF string or by file
+    /// name and modification time, so spawning the same model again only
+    /// clones the template. Files included by a model file are not
+    /// checked for modifications.
+    class GZ_PHYSICS_VISIBLE FactoryParser
+    {
+      /// \brief Constructor.
+      /// \param[in] _threads Number of parsing threads, 0 for the default.
+      /// The threads are started by the first call to Push.
+      public: explicit FactoryParser(const unsigned int _threads = 0);
+
+      /// \brief Destructor. Stops the threads.
+      public: virtual ~FactoryParser();
+
+      /// \brief Stop the threads and drop the queued messages.
+      public: void Fini();
+
+      /// \brief Queue a factory message. Its SDF, if any, is parsed in the
+      /// background. Thread safe.
+      /// \param[in] _msg The message.
+      public: void Push(const msgs::Factory &_msg);
+
+      /// \brief Get the oldest queued message, if it is ready. Messages
+      /// without SDF, such as clone requests, are ready right away.
+      /// \param[out] _msg The message.
+      /// \param[out] _root Root element parsed from the SDF of the message,
+      /// owned by the caller. Null if the message has no SDF, or if it
+      /// could not be parsed, in which case an error was printed.
+      /// \return False if the queue is empty, or its oldest message is still
+      /// being parsed.
+      public: bool Pop(msgs::Factory &_msg, sdf::ElementPtr &_root);
+
+      /// \brief Get the number of queued messages.
+      /// \return Number of messages.
+      public: size_t QueuedCount() const;
+
+      /// \brief Get the number of cached templates.
+      /// \return Number of templates.
+      public: size_t TemplateCount() const;
+
+      /// \brief Get the number of parses that were saved by the templates.
+      /// \return Number of hits.
+      public: size_t TemplateHits() const;
+
+      /// \brief Drop all the cached templates.
+      public: void ClearTemplates();
+
+      /// \brief Check whether the SDF of a message is parsed by this class.
+      /// \param[in] _msg The message.
+      /// \return True if the message has an SDF string or an SDF file name.
+      public: static bool HasSDF(const msgs::Factory &_msg);
+
+      /// \brief Entry point of the parsing threads.
+      private: void Run();
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<FactoryParserPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
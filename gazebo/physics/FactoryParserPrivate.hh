@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_FACTORYPARSERPRIVATE_HH_
+#define GAZEBO_PHYSICS_FACTORYPARSERPRIVATE_HH_
+
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <sdf/sdf.hh>
+
+#include "gazebo/msgs/msgs.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief A message queued in a FactoryParser.
+    class FactoryRequest
+    {
+      /// \brief The message.
+      public: msgs::Factory msg;
+
+      /// \brief Root element parsed from the message.
+      public: sdf::ElementPtr root;
+
+      /// \brief True once the message was parsed.
+      public: bool ready = false;
+    };
+
+    /// \internal
+    /// \brief A parsed tree kept by a FactoryParser.
+    class FactoryTemplate
+    {
+      /// \brief Root element of the tree. It is never modified, only
+      /// cloned.
+      public: sdf::ElementPtr root;
+
+      /// \brief Modification time of the file the tree was parsed from, 0
+      /// for a string.
+      public: std::time_t modified = 0;
+
+      /// \brief Value of FactoryParserPrivate::useCount when the template
+      /// was last used.
+      public: uint64_t lastUse = 0;
+    };
+
+    /// \internal
+    /// \brief Private data for the FactoryParser class.
+    class FactoryParserPrivate
+    {
+      /// \brief Resolve and parse the SDF of a message, or clone it from
+      /// a template.
+      /// \param[in] _msg The message.
+      /// \param[in] _sdf SDF object of the calling thread, used for parsing.
+      /// \return The parsed root element, null on error.
+      public: sdf::ElementPtr Parse(const msgs::Factory &_msg,
+                  const sdf::SDFPtr &_sdf);
+
+      /// \brief Max number of templates.
+      public: static const size_t kMaxTemplates = 64;
+
+      /// \brief Protects the queues and the threads.
+      public: std::mutex mutex;
+
+      /// \brief Wakes up the threads.
+      public: std::condition_variable condition;
+
+      /// \brief Number of threads to start.
+      public: unsigned int threadCount = 2;
+
+      /// \brief The parsing threads.
+      public: std::vector<std::thread> threads;
+
+      /// \brief Tells the threads to exit.
+      public: bool stop = false;
+
+      /// \brief Queued messages, in the order they were pushed.
+      public: std::deque<std::shared_ptr<FactoryRequest>> requests;
+
+      /// \brief Messages that no thread picked yet.
+      public: std::deque<std::shared_ptr<FactoryRequest>> pending;
+
+      /// \brief Protects the templates.
+      public: std::mutex templateMutex;
+
+      /// \brief Templates, keyed by SDF string or by file name.
+      public: std::unordered_map<std::string, FactoryTemplate> templates;
+
+      /// \brief Incremented every time a template is used.
+      public: uint64_t useCount = 0;
+
+      /// \brief Number of messages that were cloned from a template.
+      public: size_t hits = 0;
+    };
+  }
+}
+#endif
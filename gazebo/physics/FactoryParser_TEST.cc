@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+#include <string>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/FactoryParser.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class FactoryParserTest : public gazebo::testing::AutoLogFixture
+{
+  /// \brief Wait for the oldest queued message to be parsed.
+  /// \param[in] _parser The parser.
+  /// \param[out] _msg The message.
+  /// \param[out] _root The parsed element.
+  /// \return True if a message was popped.
+  protected: bool WaitPop(physics::FactoryParser &_parser,
+                 msgs::Factory &_msg, sdf::ElementPtr &_root)
+  {
+    for (int i = 0; i < 500; ++i)
+    {
+      if (_parser.Pop(_msg, _root))
+        return true;
+      common::Time::MSleep(10);
+    }
+    return false;
+  }
+};
+
+/// \brief SDF of a box model.
+static const char kBoxSDF[] =
+    "<sdf version='1.6'>"
+    "<model name='box'>"
+    "  <pose>0 0 0.5 0 0 0</pose>"
+    "  <link name='link'>"
+    "    <collision name='collision'>"
+    "      <geometry><box><size>1 1 1</size></box></geometry>"
+    "    </collision>"
+    "  </link>"
+    "</model>"
+    "</sdf>";
+
+/////////////////////////////////////////////////
+TEST_F(FactoryParserTest, Parse)
+{
+  physics::FactoryParser parser;
+
+  msgs::Factory msg;
+  sdf::ElementPtr root;
+  EXPECT_FALSE(parser.Pop(msg, root));
+  EXPECT_EQ(parser.QueuedCount(), 0u);
+
+  msgs::Factory boxMsg;
+  boxMsg.set_sdf(kBoxSDF);
+  EXPECT_TRUE(physics::FactoryParser::HasSDF(boxMsg));
+  parser.Push(boxMsg);
+
+  ASSERT_TRUE(this->WaitPop(parser, msg, root));
+  EXPECT_EQ(msg.sdf(), boxMsg.sdf());
+  ASSERT_TRUE(root != nullptr);
+  ASSERT_TRUE(root->HasElement("model"));
+  EXPECT_EQ(root->GetElement("model")->Get<std::string>("name"), "box");
+  EXPECT_EQ(parser.TemplateCount(), 1u);
+  EXPECT_EQ(parser.TemplateHits(), 0u);
+
+  // The same model again is cloned from the template, into a tree owned by
+  // the caller
+  root->GetElement("model")->GetAttribute("name")->Set("renamed");
+  parser.Push(boxMsg);
+  sdf::ElementPtr root2;
+  ASSERT_TRUE(this->WaitPop(parser, msg, root2));
+  ASSERT_TRUE(root2 != nullptr);
+  EXPECT_NE(root2, root);
+  EXPECT_EQ(root2->GetElement("model")->Get<std::string>("name"), "box");
+  EXPECT_EQ(parser.TemplateCount(), 1u);
+  EXPECT_EQ(parser.TemplateHits(), 1u);
+
+  parser.ClearTemplates();
+  EXPECT_EQ(parser.TemplateCount(), 0u);
+
+  // Invalid SDF
+  msgs::Factory badMsg;
+  badMsg.set_sdf("<sdf version='1.6'><model name='bad'>");
+  parser.Push(badMsg);
+  ASSERT_TRUE(this->WaitPop(parser, msg, root));
+  EXPECT_TRUE(root == nullptr);
+  EXPECT_EQ(parser.TemplateCount(), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(FactoryParserTest, Order)
+{
+  physics::FactoryParser parser(4);
+
+  // Messages come out in the order they were pushed, including the ones
+  // that need no parsing
+  for (int i = 0; i < 20; ++i)
+  {
+    msgs::Factory msg;
+    if (i % 5 == 4)
+    {
+      msg.set_clone_model_name("box_" + std::to_string(i));
+      EXPECT_FALSE(physics::FactoryParser::HasSDF(msg));
+    }
+    else
+    {
+      std::string sdf = kBoxSDF;
+      sdf.replace(sdf.find("'box'"), 5, "'box_" + std::to_string(i) + "'");
+      msg.set_sdf(sdf);
+    }
+    parser.Push(msg);
+  }
+  EXPECT_EQ(parser.QueuedCount(), 20u);
+
+  for (int i = 0; i < 20; ++i)
+  {
+    msgs::Factory msg;
+    sdf::ElementPtr root;
+    ASSERT_TRUE(this->WaitPop(parser, msg, root));
+
+    const std::string name = "box_" + std::to_string(i);
+    if (i % 5 == 4)
+    {
+      EXPECT_EQ(msg.clone_model_name(), name);
+      EXPECT_TRUE(root == nullptr);
+    }
+    else
+    {
+      ASSERT_TRUE(root != nullptr);
+      EXPECT_EQ(root->GetElement("model")->Get<std::string>("name"), name);
+    }
+  }
+  EXPECT_EQ(parser.QueuedCount(), 0u);
+
+  // Queued messages are dropped by Fini
+  msgs::Factory msg;
+  msg.set_clone_model_name("box");
+  parser.Push(msg);
+  parser.Fini();
+  EXPECT_EQ(parser.QueuedCount(), 0u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -16,7 +16,10 @@
 */
 #include <algorithm>
 #include <cmath>
+#include <iomanip>
+#include <sstream>
 #include <string>
+#include <boost/filesystem.hpp>
 #include <ignition/math/Helpers.hh>
 #include <gazebo/gazebo_config.h>
 
@@ -25,6 +28,7 @@
 #include "gazebo/common/Image.hh"
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/SphericalCoordinates.hh"
+#include "gazebo/common/SystemPaths.hh"
 #include "gazebo/physics/HeightmapShape.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/transport/transport.hh"
@@ -42,6 +46,7 @@ HeightmapShape::HeightmapShape(CollisionPtr _parent)
       std::is_same<HeightType, double>::value,
       "Height field needs to be double or float");
   this->vertSize = 0;
+  this->heightmapData = nullptr;
   this->AddType(Base::HEIGHTMAP_SHAPE);
 }
 
@@ -97,17 +102,16 @@ int HeightmapShape::LoadTerrainFile(const std::string &_filename)
   auto demData = dynamic_cast<common::Dem *>(this->heightmapData);
   if (demData)
   {
-    this->dem = *demData;
     if (this->sdf->HasElement("size"))
     {
       this->heightmapSize = this->sdf->Get<ignition::math::Vector3d>("size");
     }
     else
     {
-      this->heightmapSize.X() = this->dem.GetWorldWidth();
-      this->heightmapSize.Y() = this->dem.GetWorldHeight();
-      this->heightmapSize.Z() = this->dem.GetMaxElevation() -
-          this->dem.GetMinElevation();
+      this->heightmapSize.X() = demData->GetWorldWidth();
+      this->heightmapSize.Y() = demData->GetWorldHeight();
+      this->heightmapSize.Z() = demData->GetMaxElevation() -
+          demData->GetMinElevation();
     }
 
     // Modify the reference geotedic latitude/longitude.
@@ -120,7 +124,7 @@ int HeightmapShape::LoadTerrainFile(const std::string &_filename)
 
       try
       {
-        this->dem.GetGeoReferenceOrigin(latitude, longitude);
+        demData->GetGeoReferenceOrigin(latitude, longitude);
       }
       catch(const common::Exception &)
       {
@@ -128,7 +132,7 @@ int HeightmapShape::LoadTerrainFile(const std::string &_filename)
                << "SphericalCoordiantes and GpsSensor may not function properly."
                << std::endl;
       }
-      elevation = this->dem.GetElevation(0.0, 0.0);
+      elevation = demData->GetElevation(0.0, 0.0);
 
       sphericalCoordinates->SetLatitudeReference(latitude);
       sphericalCoordinates->SetLongitudeReference(longitude);
@@ -172,12 +176,6 @@ void HeightmapShape::Load(sdf::ElementPtr _sdf)
     return;
   }
 
-  if (this->LoadTerrainFile(filename) != 0)
-  {
-    gzerr << "Heightmap data size must be square, with a size of 2^n+1\n";
-    return;
-  }
-
   this->subSampling = 2u;
   if (this->sdf->HasElement("sampling"))
   {
@@ -194,6 +192,22 @@ void HeightmapShape::Load(sdf::ElementPtr _sdf)
     }
   }
 
+  // Tiles cached by a previous load describe the table, so the terrain
+  // file doesn't need to be loaded.
+  this->tileCache.reset();
+  if (this->tileSupport && this->sdf->HasElement("use_terrain_paging") &&
+      this->sdf->Get<bool>("use_terrain_paging") &&
+      this->OpenTiles(filename))
+  {
+    return;
+  }
+
+  if (this->LoadTerrainFile(filename) != 0)
+  {
+    gzerr << "Heightmap data size must be square, with a size of 2^n+1\n";
+    return;
+  }
+
   // Check if the geometry of the terrain data matches Ogre constrains
   if (this->heightmapData->GetWidth() != this->heightmapData->GetHeight() ||
       !ignition::math::isPowerOfTwo(this->heightmapData->GetWidth() - 1))
@@ -212,6 +226,14 @@ int HeightmapShape::GetSubSampling() const
 //////////////////////////////////////////////////
 void HeightmapShape::FillHeightfield(std::vector<float>& _heights)
 {
+  // The terrain file isn't loaded when the tiles were already cached
+  if (!this->heightmapData && this->tileCache)
+  {
+    this->tileCache->Heights(0, 0, this->vertSize, this->vertSize,
+        _heights);
+    return;
+  }
+
   this->heightmapData->FillHeightMap(this->subSampling, this->vertSize,
       this->Size(), this->scale, this->flipY, _heights);
 }
@@ -220,8 +242,7 @@ void HeightmapShape::FillHeightfield(std::vector<float>& _heights)
 void HeightmapShape::FillHeightfield(std::vector<double>& _heights)
 {
   std::vector<float> fHeights;
-  this->heightmapData->FillHeightMap(this->subSampling, this->vertSize,
-      this->Size(), this->scale, this->flipY, fHeights);
+  this->FillHeightfield(fHeights);
   _heights = std::vector<double>(fHeights.begin(), fHeights.end());
 }
 
@@ -235,6 +256,15 @@ void HeightmapShape::Init()
       &HeightmapShape::OnRequest, this, true);
   this->responsePub = this->node->Advertise<msgs::Response>("~/response");
 
+  // The table is described by the tiles opened by Load
+  if (this->tileCache)
+  {
+    this->vertSize = this->tileCache->VertexCount();
+    this->scale = this->tileCache->Scale();
+    this->heights.clear();
+    return;
+  }
+
   ignition::math::Vector3d terrainSize = this->Size();
 
   // sampling size along image width and height
@@ -258,10 +288,133 @@ void HeightmapShape::Init()
   else
     this->scale.Z() = fabs(terrainSize.Z()) / heightmapSizeZ;
 
+  // Page the heights from tiles if requested
+  if (this->tileSupport && this->sdf->HasElement("use_terrain_paging") &&
+      this->sdf->Get<bool>("use_terrain_paging"))
+  {
+    if (this->LoadTiles())
+    {
+      this->heights.clear();
+      return;
+    }
+
+    gzwarn << "Unable to tile heightmap[" << this->GetURI() << "], the "
+           << "heights will be held in memory.\n";
+    this->tileCache.reset();
+  }
+
   // Construct the heightmap lookup table
   this->FillHeightfield(this->heights);
 }
 
+//////////////////////////////////////////////////
+bool HeightmapShape::TileLocation(const std::string &_filename,
+    std::string &_key, std::string &_dir) const
+{
+  // The tiles are created again if the terrain file or the parameters of
+  // the table change. Each combination gets its own directory, so
+  // heightmaps that share a file name or a file don't replace each
+  // other's tiles. The key determines the whole table.
+  std::ostringstream key;
+  try
+  {
+    boost::filesystem::path path(_filename);
+    key << boost::filesystem::canonical(path).string() << " "
+        << boost::filesystem::file_size(path) << " "
+        << boost::filesystem::last_write_time(path) << " "
+        << this->subSampling << " " << this->flipY;
+    if (this->sdf->HasElement("size"))
+      key << " " << this->sdf->Get<ignition::math::Vector3d>("size");
+
+    _dir = (boost::filesystem::path(
+        common::SystemPaths::Instance()->GetLogPath()) / "paging" /
+        "physics" / (path.filename().stem().string() + "_" +
+        common::get_sha1(key.str()).substr(0, 16))).string();
+  }
+  catch(const boost::filesystem::filesystem_error &_e)
+  {
+    gzerr << "Unable to read heightmap[" << _filename << "]: " << _e.what()
+          << "\n";
+    return false;
+  }
+
+  _key = key.str();
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool HeightmapShape::OpenTiles(const std::string &_filename)
+{
+  std::string key, dir;
+  if (!this->TileLocation(_filename, key, dir))
+    return false;
+
+  std::unique_ptr<HeightmapTileCache> cache(new HeightmapTileCache());
+  if (!cache->Open(dir, key))
+    return false;
+
+  this->heightmapSize = cache->Size();
+
+  // The geo reference origin of a DEM, which is used by the GPS sensors
+  std::istringstream info(cache->Info());
+  double latitude, longitude, elevation;
+  if (info >> latitude >> longitude >> elevation)
+  {
+    common::SphericalCoordinatesPtr sphericalCoordinates =
+        this->world->SphericalCoords();
+    if (sphericalCoordinates)
+    {
+      sphericalCoordinates->SetLatitudeReference(
+          ignition::math::Angle(latitude));
+      sphericalCoordinates->SetLongitudeReference(
+          ignition::math::Angle(longitude));
+      sphericalCoordinates->SetElevationReference(elevation);
+    }
+    else
+    {
+      gzerr << "Unable to get a valid SphericalCoordinates pointer\n";
+    }
+  }
+
+  this->tileCache = std::move(cache);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool HeightmapShape::LoadTiles()
+{
+  std::string key, dir;
+  if (!this->TileLocation(common::find_file(this->GetURI()), key, dir))
+    return false;
+
+  // Keep the geo reference origin that LoadTerrainFile read from a DEM,
+  // for OpenTiles
+  std::ostringstream info;
+#ifdef HAVE_GDAL
+  common::SphericalCoordinatesPtr sphericalCoordinates =
+      this->world->SphericalCoords();
+  if (dynamic_cast<common::Dem *>(this->heightmapData) &&
+      sphericalCoordinates)
+  {
+    info << std::setprecision(17)
+         << sphericalCoordinates->LatitudeReference().Radian() << " "
+         << sphericalCoordinates->LongitudeReference().Radian() << " "
+         << sphericalCoordinates->GetElevationReference();
+  }
+#endif
+
+  this->tileCache.reset(new HeightmapTileCache());
+  return this->tileCache->Load(*this->heightmapData, dir, key,
+      this->subSampling, this->vertSize, this->Size(), this->scale,
+      this->flipY, 256, info.str());
+}
+
+//////////////////////////////////////////////////
+bool HeightmapShape::Tiled() const
+{
+  return this->tileCache != nullptr;
+}
+
 //////////////////////////////////////////////////
 void HeightmapShape::SetScale(const ignition::math::Vector3d &_scale)
 {
@@ -307,6 +460,29 @@ void HeightmapShape::FillMsg(msgs::Geometry &_msg)
 //////////////////////////////////////////////////
 void HeightmapShape::FillHeights(msgs::Geometry &_msg) const
 {
+  if (this->tileCache)
+  {
+    // The rows are sent from the last one. Read them one row of tiles at
+    // a time, so every tile is only read once.
+    const unsigned int tileSize = this->tileCache->TileSize();
+    std::vector<float> band;
+    for (unsigned int end = this->vertSize; end > 0;)
+    {
+      const unsigned int begin = ((end - 1) / tileSize) * tileSize;
+      this->tileCache->Heights(0, begin, this->vertSize, end - begin, band);
+      for (unsigned int y = end; y-- > begin;)
+      {
+        for (unsigned int x = 0; x < this->vertSize; ++x)
+        {
+          _msg.mutable_heightmap()->add_heights(
+              band[static_cast<size_t>(y - begin) * this->vertSize + x]);
+        }
+      }
+      end = begin;
+    }
+    return;
+  }
+
   for (unsigned int y = 0; y < this->vertSize; ++y)
   {
     for (unsigned int x = 0; x < this->vertSize; ++x)
@@ -332,6 +508,13 @@ ignition::math::Vector2i HeightmapShape::VertexCount() const
 /////////////////////////////////////////////////
 HeightmapShape::HeightType HeightmapShape::GetHeight(int _x, int _y) const
 {
+  if (this->tileCache)
+  {
+    if (_x < 0 || _y < 0)
+      return 0.0;
+    return this->tileCache->Height(_x, _y);
+  }
+
   int index =  _y * this->vertSize + _x;
   if (_x < 0 || _y < 0 || index >= static_cast<int>(this->heights.size()))
     return 0.0;
@@ -342,6 +525,16 @@ HeightmapShape::HeightType HeightmapShape::GetHeight(int _x, int _y) const
 /////////////////////////////////////////////////
 void HeightmapShape::SetHeight(int _x, int _y, HeightmapShape::HeightType _h)
 {
+  if (this->tileCache)
+  {
+    if (_x < 0 || _y < 0 || !this->tileCache->SetHeight(_x, _y, _h))
+    {
+      gzerr << "SetHeight position (" << _x << ", " << _y << ")"
+            << " is out of bounds" << std::endl;
+    }
+    return;
+  }
+
   int index =  _y * this->vertSize + _x;
   if (_x < 0 || _y < 0 || index >= static_cast<int>(this->heights.size()))
   {
@@ -356,6 +549,9 @@ void HeightmapShape::SetHeight(int _x, int _y, HeightmapShape::HeightType _h)
 /////////////////////////////////////////////////
 HeightmapShape::HeightType HeightmapShape::GetMaxHeight() const
 {
+  if (this->tileCache)
+    return this->tileCache->MaxHeight();
+
   HeightType max = -std::numeric_limits<HeightType>::max();
   for (unsigned int i = 0; i < this->heights.size(); ++i)
   {
@@ -369,6 +565,9 @@ HeightmapShape::HeightType HeightmapShape::GetMaxHeight() const
 /////////////////////////////////////////////////
 HeightmapShape::HeightType HeightmapShape::GetMinHeight() const
 {
+  if (this->tileCache)
+    return this->tileCache->MinHeight();
+
   HeightType min = std::numeric_limits<HeightType>::max();
   for (unsigned int i = 0; i < this->heights.size(); ++i)
   {
@@ -17,6 +17,7 @@
 #ifndef GAZEBO_PHYSICS_HEIGHTMAPSHAPE_HH_
 #define GAZEBO_PHYSICS_HEIGHTMAPSHAPE_HH_
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <ignition/transport/Node.hh>
@@ -27,6 +28,7 @@
 #include "gazebo/common/HeightmapData.hh"
 #include "gazebo/common/Dem.hh"
 #include "gazebo/transport/TransportTypes.hh"
+#include "gazebo/physics/HeightmapTileCache.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/Shape.hh"
 #include "gazebo/util/system.hh"
@@ -42,6 +44,10 @@ namespace gazebo
     /// \brief HeightmapShape collision shape builds a heightmap from
     /// an image.  The supplied image must be square with
     /// N*N+1 pixels per side, where N is an integer.
+    ///
+    /// When use_terrain_paging is set and the physics engine supports it,
+    /// the heights are not held in memory but paged from tiles cached on
+    /// disk, see HeightmapTileCache and Tiled().
     class GZ_PHYSICS_VISIBLE HeightmapShape : public Shape
     {
       /// \brief height field type, float or double
@@ -124,6 +130,13 @@ namespace gazebo
       /// \return Amount of subsampling.
       public: int GetSubSampling() const;
 
+      /// \brief Get whether the heights are paged from tiles cached on
+      /// disk instead of being held in memory. This is the case if the
+      /// heightmap sets use_terrain_paging and the physics engine reads
+      /// the heights through GetHeight, which only ODE does.
+      /// \return True if the heights are tiled.
+      public: bool Tiled() const;
+
       /// \brief Return an image representation of the heightmap.
       /// \return Image where white pixels represents the highest locations,
       /// and black pixels the lowest.
@@ -141,6 +154,29 @@ namespace gazebo
       /// \param[in] _msg The request message.
       private: void OnRequest(ConstRequestPtr &_msg);
 
+      /// \brief Get the key and the directory of the tiles of the heights,
+      /// in the paging directory of the log path.
+      /// \param[in] _filename Path of the terrain file.
+      /// \param[out] _key Key that identifies the terrain file and the
+      /// parameters of the table.
+      /// \param[out] _dir Cache directory.
+      /// \return False if the terrain file can't be read.
+      private: bool TileLocation(const std::string &_filename,
+                   std::string &_key, std::string &_dir) const;
+
+      /// \brief Open the tiles cached by a previous load, without loading
+      /// the terrain file. The size of the terrain and the geo reference
+      /// of a DEM are read from the tiles.
+      /// \param[in] _filename Path of the terrain file.
+      /// \return True if the tiles were opened.
+      private: bool OpenTiles(const std::string &_filename);
+
+      /// \brief Create the tiles of the heights, or reuse the tiles
+      /// cached by a previous load, in the paging directory of the log
+      /// path.
+      /// \return True on success.
+      private: bool LoadTiles();
+
       /// \brief Fills the heightmap data (float) into the vector
       /// by calling HeightmapData::FillHeightMap with \e heights
       /// \param[in] heights height field to fill with data.
@@ -155,7 +191,8 @@ namespace gazebo
       /// \brief Image used to generate the heights.
       protected: common::ImageHeightmap img;
 
-      /// \brief HeightmapData used to generate the heights.
+      /// \brief HeightmapData used to generate the heights. Null if the
+      /// heights are tiled and the tiles were cached by a previous load.
       protected: common::HeightmapData *heightmapData;
 
       /// \brief Size of the height lookup table.
@@ -167,6 +204,14 @@ namespace gazebo
       /// \brief The amount of subsampling. Default is 2.
       protected: int subSampling;
 
+      /// \brief True if the physics engine supports tiled heights. Derived
+      /// classes set it when they only read the heights through GetHeight.
+      protected: bool tileSupport = false;
+
+      /// \brief Tiles of the heights, null unless the heights are tiled,
+      /// in which case the heights vector is empty.
+      protected: std::unique_ptr<HeightmapTileCache> tileCache;
+
       /// \brief Transportation node.
       private: transport::NodePtr node;
 
@@ -182,11 +227,6 @@ namespace gazebo
       /// \brief Terrain size
       private: ignition::math::Vector3d heightmapSize;
 
-      #ifdef HAVE_GDAL
-      /// \brief DEM used to generate the heights.
-      private: common::Dem dem;
-      #endif
-
       // Place ignition::transport objects at the end of this file to
       // guarantee they are destructed first.
 
@@ -0,0 +1,590 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/Console.hh"
+#include "gazebo/physics/HeightmapTileCachePrivate.hh"
+#include "gazebo/physics/HeightmapTileCache.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief Version of the tile format, part of the hashes of the tiles.
+static const char *kTileFormat = "gazebo_heightmap_tiles_2";
+
+/// \brief Name of the file which holds the hashes and the description of
+/// the table. It is written after the tiles.
+static const char *kTileMetaFilename = "tiles.meta";
+
+/// \brief Hash a key that identifies terrain data.
+/// \param[in] _key The key.
+/// \return The hash.
+static std::string keyHash(const std::string &_key)
+{
+  return common::get_sha1(std::string(kTileFormat) + "\n" + _key);
+}
+
+//////////////////////////////////////////////////
+HeightmapTileCache::HeightmapTileCache()
+  : dataPtr(new HeightmapTileCachePrivate)
+{
+}
+
+//////////////////////////////////////////////////
+HeightmapTileCache::~HeightmapTileCache()
+{
+}
+
+//////////////////////////////////////////////////
+bool HeightmapTileCache::Load(common::HeightmapData &_data,
+    const std::string &_dir, const std::string &_key, const int _subSampling,
+    const unsigned int _vertSize, const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, const bool _flipY,
+    const unsigned int _tileSize, const std::string &_info)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->Clear();
+
+  if (_subSampling <= 0 || _vertSize == 0)
+  {
+    gzerr << "Invalid heightmap table of " << _vertSize
+          << " points per row, with a subsampling of " << _subSampling
+          << "\n";
+    return false;
+  }
+
+  const unsigned int tileSize = std::max(_tileSize, 16u);
+
+  std::ostringstream params;
+  params << std::setprecision(17) << kTileFormat << "\n" << _key << "\n"
+         << _subSampling << " " << _vertSize << " " << _size.X() << " "
+         << _size.Y() << " " << _size.Z() << " " << _scale.X() << " "
+         << _scale.Y() << " " << _scale.Z() << " " << _flipY << " "
+         << tileSize << "\n" << _info;
+  const std::string hash = common::get_sha1(params.str());
+  const std::string key = keyHash(_key);
+
+  // Reuse the tiles if they were created with the same parameters
+  if (this->dataPtr->ReadMeta(_dir, hash, key))
+    return true;
+
+  gzmsg << "Creating heightmap tiles in [" << _dir << "]" << std::endl;
+
+  // The tiles are written to a temporary directory which is renamed once
+  // complete, so other loads never see partial tiles.
+  boost::filesystem::path tmpDir;
+  try
+  {
+    const boost::filesystem::path dir(_dir);
+    if (dir.has_parent_path())
+      boost::filesystem::create_directories(dir.parent_path());
+    tmpDir = boost::filesystem::unique_path(
+        dir.string() + ".tmp-%%%%-%%%%-%%%%");
+    boost::filesystem::create_directory(tmpDir);
+  }
+  catch(const boost::filesystem::filesystem_error &_e)
+  {
+    gzerr << "Unable to create heightmap tile directory [" << _dir << "]: "
+          << _e.what() << "\n";
+    return false;
+  }
+
+  this->dataPtr->dir = tmpDir.string();
+  this->dataPtr->tileSize = tileSize;
+  this->dataPtr->vertSize = _vertSize;
+  this->dataPtr->tileCount = (_vertSize + tileSize - 1) / tileSize;
+  this->dataPtr->size = _size;
+  this->dataPtr->scale = _scale;
+  this->dataPtr->info = _info;
+
+  bool result = this->dataPtr->WriteTiles(_data, _subSampling, _size,
+      _scale, _flipY) && this->dataPtr->WriteMeta(hash, key);
+  this->dataPtr->dir = _dir;
+
+  if (result)
+  {
+    boost::system::error_code ec;
+
+    // Tiles left by other parameters, or by a previous version, are moved
+    // away before being removed, so the directory is never partial.
+    HeightmapTileCachePrivate existing;
+    if (boost::filesystem::exists(_dir, ec) &&
+        !existing.ReadMeta(_dir, hash, key))
+    {
+      const boost::filesystem::path staleDir =
+          boost::filesystem::unique_path(_dir + ".old-%%%%-%%%%-%%%%");
+      boost::filesystem::rename(_dir, staleDir, ec);
+      if (!ec)
+        boost::filesystem::remove_all(staleDir, ec);
+    }
+
+    boost::filesystem::rename(tmpDir, _dir, ec);
+    if (ec)
+    {
+      // Another load may have created the same tiles meanwhile
+      result = this->dataPtr->ReadMeta(_dir, hash, key);
+      if (!result)
+      {
+        gzerr << "Unable to move heightmap tiles to [" << _dir << "]: "
+              << ec.message() << "\n";
+      }
+    }
+  }
+
+  boost::system::error_code ec;
+  boost::filesystem::remove_all(tmpDir, ec);
+  if (!result)
+    this->dataPtr->Clear();
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool HeightmapTileCache::Open(const std::string &_dir,
+    const std::string &_key)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->Clear();
+  return this->dataPtr->ReadMeta(_dir, "", keyHash(_key));
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTileCache::VertexCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->vertSize;
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTileCache::TileSize() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->tileSize;
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTileCache::TileCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->tileCount;
+}
+
+//////////////////////////////////////////////////
+float HeightmapTileCache::MinHeight() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->minHeight;
+}
+
+//////////////////////////////////////////////////
+float HeightmapTileCache::MaxHeight() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->maxHeight;
+}
+
+//////////////////////////////////////////////////
+ignition::math::Vector3d HeightmapTileCache::Size() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->size;
+}
+
+//////////////////////////////////////////////////
+ignition::math::Vector3d HeightmapTileCache::Scale() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->scale;
+}
+
+//////////////////////////////////////////////////
+std::string HeightmapTileCache::Info() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->info;
+}
+
+//////////////////////////////////////////////////
+float HeightmapTileCache::Height(const unsigned int _x, const unsigned int _y)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (_x >= this->dataPtr->vertSize || _y >= this->dataPtr->vertSize)
+    return 0;
+
+  const unsigned int tileSize = this->dataPtr->tileSize;
+  const unsigned int tx = _x / tileSize;
+  const unsigned int ty = _y / tileSize;
+  HeightmapTile &tile =
+      this->dataPtr->Tile(ty * this->dataPtr->tileCount + tx);
+
+  return tile.heights[(_y - ty * tileSize) * tile.width +
+      (_x - tx * tileSize)];
+}
+
+//////////////////////////////////////////////////
+bool HeightmapTileCache::SetHeight(const unsigned int _x,
+    const unsigned int _y, const float _height)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (_x >= this->dataPtr->vertSize || _y >= this->dataPtr->vertSize)
+    return false;
+
+  const unsigned int tileSize = this->dataPtr->tileSize;
+  const unsigned int tx = _x / tileSize;
+  const unsigned int ty = _y / tileSize;
+  HeightmapTile &tile =
+      this->dataPtr->Tile(ty * this->dataPtr->tileCount + tx);
+
+  tile.heights[(_y - ty * tileSize) * tile.width + (_x - tx * tileSize)] =
+      _height;
+  tile.modified = true;
+
+  this->dataPtr->minHeight = std::min(this->dataPtr->minHeight, _height);
+  this->dataPtr->maxHeight = std::max(this->dataPtr->maxHeight, _height);
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool HeightmapTileCache::Heights(const unsigned int _x, const unsigned int _y,
+    const unsigned int _width, const unsigned int _height,
+    std::vector<float> &_heights)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  const unsigned int vertSize = this->dataPtr->vertSize;
+  if (_width == 0 || _height == 0 ||
+      _x + _width > vertSize || _y + _height > vertSize)
+  {
+    return false;
+  }
+
+  _heights.resize(static_cast<size_t>(_width) * _height);
+
+  const unsigned int tileSize = this->dataPtr->tileSize;
+  std::vector<float> buffer;
+  for (unsigned int ty = _y / tileSize; ty <= (_y + _height - 1) / tileSize;
+       ++ty)
+  {
+    for (unsigned int tx = _x / tileSize;
+         tx <= (_x + _width - 1) / tileSize; ++tx)
+    {
+      const uint32_t id = ty * this->dataPtr->tileCount + tx;
+      const unsigned int width = this->dataPtr->TileExtent(tx);
+
+      // Don't disturb the tiles in memory
+      const std::vector<float> *heights = &buffer;
+      auto iter = this->dataPtr->tiles.find(id);
+      if (iter != this->dataPtr->tiles.end())
+        heights = &iter->second.heights;
+      else
+        this->dataPtr->ReadTile(id, buffer);
+
+      // Intersection of the tile and the region
+      const unsigned int x0 = std::max(_x, tx * tileSize);
+      const unsigned int x1 = std::min(_x + _width, tx * tileSize + width);
+      const unsigned int y0 = std::max(_y, ty * tileSize);
+      const unsigned int y1 = std::min(_y + _height,
+          ty * tileSize + this->dataPtr->TileExtent(ty));
+
+      for (unsigned int y = y0; y < y1; ++y)
+      {
+        auto row = heights->begin() +
+            static_cast<size_t>(y - ty * tileSize) * width +
+            (x0 - tx * tileSize);
+        std::copy(row, row + (x1 - x0), _heights.begin() +
+            static_cast<size_t>(y - _y) * _width + (x0 - _x));
+      }
+    }
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void HeightmapTileCache::Prefetch(const unsigned int _x0,
+    const unsigned int _y0, const unsigned int _x1, const unsigned int _y1)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  const unsigned int vertSize = this->dataPtr->vertSize;
+  if (vertSize == 0 || _x0 > _x1 || _y0 > _y1 ||
+      _x0 >= vertSize || _y0 >= vertSize)
+  {
+    return;
+  }
+
+  const unsigned int tileSize = this->dataPtr->tileSize;
+  const unsigned int tx1 = std::min(_x1, vertSize - 1) / tileSize;
+  const unsigned int ty1 = std::min(_y1, vertSize - 1) / tileSize;
+
+  unsigned int count = 0;
+  for (unsigned int ty = _y0 / tileSize; ty <= ty1; ++ty)
+  {
+    for (unsigned int tx = _x0 / tileSize; tx <= tx1; ++tx)
+    {
+      if (count++ >= this->dataPtr->capacity)
+        return;
+      this->dataPtr->Tile(ty * this->dataPtr->tileCount + tx);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void HeightmapTileCache::SetCapacity(const unsigned int _capacity)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->capacity = std::max(_capacity, 1u);
+  this->dataPtr->Evict();
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTileCache::Capacity() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->capacity;
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTileCache::ResidentCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return static_cast<unsigned int>(this->dataPtr->tiles.size());
+}
+
+//////////////////////////////////////////////////
+uint64_t HeightmapTileCache::ReadCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->reads;
+}
+
+//////////////////////////////////////////////////
+bool HeightmapTileCachePrivate::WriteTiles(common::HeightmapData &_data,
+    const int _subSampling, const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, const bool _flipY)
+{
+  // Resample one row of tiles at a time, which keeps the memory bounded
+  // while large regions are resampled by several threads.
+  this->minHeight = std::numeric_limits<float>::max();
+  this->maxHeight = -std::numeric_limits<float>::max();
+  std::vector<float> band;
+  for (unsigned int ty = 0; ty < this->tileCount; ++ty)
+  {
+    const unsigned int rows = this->TileExtent(ty);
+    _data.FillHeightMap(_subSampling, this->vertSize, _size, _scale, _flipY,
+        0, ty * this->tileSize, this->vertSize, rows, band);
+    if (band.size() != static_cast<size_t>(this->vertSize) * rows)
+    {
+      gzerr << "Unable to resample heightmap rows [" << ty * this->tileSize
+            << ", " << ty * this->tileSize + rows << "]\n";
+      return false;
+    }
+
+    for (unsigned int tx = 0; tx < this->tileCount; ++tx)
+    {
+      const unsigned int columns = this->TileExtent(tx);
+      const std::string path = this->TilePath(tx, ty);
+      std::ofstream out(path, std::ios::binary | std::ios::trunc);
+
+      for (unsigned int y = 0; y < rows; ++y)
+      {
+        const float *row = band.data() +
+            static_cast<size_t>(y) * this->vertSize + tx * this->tileSize;
+        auto range = std::minmax_element(row, row + columns);
+        this->minHeight = std::min(this->minHeight, *range.first);
+        this->maxHeight = std::max(this->maxHeight, *range.second);
+        out.write(reinterpret_cast<const char *>(row),
+            columns * sizeof(float));
+      }
+
+      if (!out)
+      {
+        gzerr << "Unable to write heightmap tile [" << path << "]\n";
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool HeightmapTileCachePrivate::WriteMeta(const std::string &_hash,
+    const std::string &_keyHash) const
+{
+  const std::string path =
+      (boost::filesystem::path(this->dir) / kTileMetaFilename).string();
+  std::ofstream meta(path, std::ios::trunc);
+  meta << std::setprecision(17) << _hash << "\n" << _keyHash << "\n"
+       << this->vertSize << " " << this->tileSize << "\n"
+       << this->minHeight << " " << this->maxHeight << "\n"
+       << this->size.X() << " " << this->size.Y() << " " << this->size.Z()
+       << " " << this->scale.X() << " " << this->scale.Y() << " "
+       << this->scale.Z() << "\n" << this->info << "\n";
+  meta.close();
+  if (!meta)
+  {
+    gzerr << "Unable to write [" << path << "]\n";
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool HeightmapTileCachePrivate::ReadMeta(const std::string &_dir,
+    const std::string &_hash, const std::string &_keyHash)
+{
+  std::ifstream meta(
+      (boost::filesystem::path(_dir) / kTileMetaFilename).string());
+  std::string metaHash, metaKeyHash;
+  unsigned int metaVertSize, metaTileSize;
+  float metaMinHeight, metaMaxHeight;
+  double values[6];
+  if (!(meta >> metaHash >> metaKeyHash >> metaVertSize >> metaTileSize >>
+        metaMinHeight >> metaMaxHeight >> values[0] >> values[1] >>
+        values[2] >> values[3] >> values[4] >> values[5]) ||
+      (!_hash.empty() && metaHash != _hash) || metaKeyHash != _keyHash ||
+      metaVertSize == 0 || metaTileSize == 0)
+  {
+    return false;
+  }
+
+  // The rest of the line after the scale, then the info line
+  std::string metaInfo;
+  std::getline(meta, metaInfo);
+  std::getline(meta, metaInfo);
+
+  this->dir = _dir;
+  this->vertSize = metaVertSize;
+  this->tileSize = metaTileSize;
+  this->tileCount = (metaVertSize + metaTileSize - 1) / metaTileSize;
+  this->minHeight = metaMinHeight;
+  this->maxHeight = metaMaxHeight;
+  this->size.Set(values[0], values[1], values[2]);
+  this->scale.Set(values[3], values[4], values[5]);
+  this->info = metaInfo;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void HeightmapTileCachePrivate::Clear()
+{
+  this->tiles.clear();
+  this->lru.clear();
+  this->last = nullptr;
+  this->reads = 0;
+  this->vertSize = 0;
+  this->tileCount = 0;
+  this->minHeight = 0;
+  this->maxHeight = 0;
+  this->size = ignition::math::Vector3d::Zero;
+  this->scale = ignition::math::Vector3d::One;
+  this->info.clear();
+}
+
+//////////////////////////////////////////////////
+std::string HeightmapTileCachePrivate::TilePath(const unsigned int _tx,
+    const unsigned int _ty) const
+{
+  return (boost::filesystem::path(this->dir) /
+      ("tile_" + std::to_string(_tx) + "_" + std::to_string(_ty) +
+       ".bin")).string();
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTileCachePrivate::TileExtent(const unsigned int _t) const
+{
+  return std::min(this->tileSize, this->vertSize - _t * this->tileSize);
+}
+
+//////////////////////////////////////////////////
+void HeightmapTileCachePrivate::ReadTile(const uint32_t _id,
+    std::vector<float> &_heights)
+{
+  const unsigned int tx = _id % this->tileCount;
+  const unsigned int ty = _id / this->tileCount;
+  const size_t count =
+      static_cast<size_t>(this->TileExtent(tx)) * this->TileExtent(ty);
+
+  _heights.assign(count, 0.0f);
+  ++this->reads;
+
+  const std::string path = this->TilePath(tx, ty);
+  std::ifstream in(path, std::ios::binary);
+  in.read(reinterpret_cast<char *>(_heights.data()), count * sizeof(float));
+  if (static_cast<size_t>(in.gcount()) != count * sizeof(float))
+  {
+    gzerr << "Unable to read heightmap tile [" << path << "]\n";
+    std::fill(_heights.begin(), _heights.end(), 0.0f);
+  }
+}
+
+//////////////////////////////////////////////////
+HeightmapTile &HeightmapTileCachePrivate::Tile(const uint32_t _id)
+{
+  if (this->last && this->lastId == _id)
+    return *this->last;
+
+  auto iter = this->tiles.find(_id);
+  if (iter == this->tiles.end())
+  {
+    iter = this->tiles.emplace(_id, HeightmapTile()).first;
+    HeightmapTile &tile = iter->second;
+    tile.width = this->TileExtent(_id % this->tileCount);
+    this->ReadTile(_id, tile.heights);
+
+    this->lru.push_front(_id);
+    tile.lru = this->lru.begin();
+  }
+  else
+  {
+    this->lru.splice(this->lru.begin(), this->lru, iter->second.lru);
+  }
+
+  this->last = &iter->second;
+  this->lastId = _id;
+
+  // The tile is the most recently used one, so it is kept
+  this->Evict();
+
+  return iter->second;
+}
+
+//////////////////////////////////////////////////
+void HeightmapTileCachePrivate::Evict()
+{
+  auto iter = this->lru.end();
+  while (this->tiles.size() > this->capacity && iter != this->lru.begin())
+  {
+    --iter;
+    auto tile = this->tiles.find(*iter);
+    if (tile->second.modified || &tile->second == this->last)
+      continue;
+
+    this->tiles.erase(tile);
+    iter = this->lru.erase(iter);
+  }
+}
@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_HEIGHTMAPTILECACHE_HH_
+#define GAZEBO_PHYSICS_HEIGHTMAPTILECACHE_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/HeightmapData.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class
+    class HeightmapTileCachePrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class HeightmapTileCache HeightmapTileCache.hh physics/physics.hh
+    /// \brief Pages the height lookup table of a large heightmap from
+    /// tiles stored on disk.
+    ///
+    /// The table that HeightmapShape would otherwise hold in memory is
+    /// split in square tiles, which are resampled once from the terrain
+    /// data and written to a cache directory, along with a hash of the
+    /// parameters of the table. Later loads with the same parameters reuse
+    /// the tiles without resampling the terrain. The tiles are written to
+    /// a temporary directory which is then renamed, so a load never sees
+    /// the partial tiles of another one.
+    ///
+    /// Only a bounded number of tiles are kept in memory. A tile is read
+    /// from disk the first time one of its heights is needed, and the
+    /// least recently used tile is released when the capacity is exceeded.
+    /// Tiles whose heights were changed with SetHeight stay in memory.
+    /// All the functions are thread safe.
+    class GZ_PHYSICS_VISIBLE HeightmapTileCache
+    {
+      /// \brief Constructor.
+      public: HeightmapTileCache();
+
+      /// \brief Destructor.
+      public: virtual ~HeightmapTileCache();
+
+      /// \brief Load the tiles of a height lookup table from a directory,
+      /// after creating them if the directory holds no tiles for the
+      /// given parameters. The parameters are the ones of
+      /// common::HeightmapData::FillHeightMap.
+      /// \param[in] _data Terrain data, only used to create the tiles.
+      /// \param[in] _dir Cache directory, created if needed. Tiles of other
+      /// parameters it holds are replaced.
+      /// \param[in] _key String that identifies the terrain data, such as
+      /// its filename and modification time. It is hashed with the other
+      /// parameters.
+      /// \param[in] _subSampling Multiplier used to increase the resolution.
+      /// \param[in] _vertSize Number of points per row of the table.
+      /// \param[in] _size Real dimmensions of the terrain.
+      /// \param[in] _scale Vector3 used to scale the height.
+      /// \param[in] _flipY If true, the rows of the table are inverted.
+      /// \param[in] _tileSize Number of points per row of a tile.
+      /// \param[in] _info Single line of text stored with the tiles, such
+      /// as properties of the terrain data that are needed without it.
+      /// \return True on success.
+      public: bool Load(common::HeightmapData &_data, const std::string &_dir,
+                  const std::string &_key, const int _subSampling,
+                  const unsigned int _vertSize,
+                  const ignition::math::Vector3d &_size,
+                  const ignition::math::Vector3d &_scale, const bool _flipY,
+                  const unsigned int _tileSize = 256,
+                  const std::string &_info = "");
+
+      /// \brief Load the tiles that a previous Load created in a directory
+      /// for the same terrain data, without the terrain data. This avoids
+      /// loading the terrain when the key alone determines the parameters
+      /// of the table, which are then read from the directory.
+      /// \param[in] _dir Cache directory.
+      /// \param[in] _key Key given to Load.
+      /// \return True if the directory holds tiles for the key.
+      public: bool Open(const std::string &_dir, const std::string &_key);
+
+      /// \brief Get the number of points per row of the table.
+      /// \return Number of points, 0 if nothing is loaded.
+      public: unsigned int VertexCount() const;
+
+      /// \brief Get the number of points per row of a tile.
+      /// \return Number of points.
+      public: unsigned int TileSize() const;
+
+      /// \brief Get the number of tiles per row of the table.
+      /// \return Number of tiles.
+      public: unsigned int TileCount() const;
+
+      /// \brief Get the lowest height of the table.
+      /// \return The minimum height.
+      public: float MinHeight() const;
+
+      /// \brief Get the highest height of the table.
+      /// \return The maximum height.
+      public: float MaxHeight() const;
+
+      /// \brief Get the real dimmensions of the terrain the table was
+      /// created for.
+      /// \return The size.
+      public: ignition::math::Vector3d Size() const;
+
+      /// \brief Get the scale of the heights the table was created for.
+      /// \return The scale.
+      public: ignition::math::Vector3d Scale() const;
+
+      /// \brief Get the text stored with the tiles.
+      /// \return The text given to Load.
+      public: std::string Info() const;
+
+      /// \brief Get a height, reading its tile if it isn't in memory.
+      /// \param[in] _x Column of the table.
+      /// \param[in] _y Row of the table.
+      /// \return The height, 0 if the point is out of bounds.
+      public: float Height(const unsigned int _x, const unsigned int _y);
+
+      /// \brief Change a height. The tile of the point stays in memory
+      /// afterwards, the tiles on disk are not modified.
+      /// \param[in] _x Column of the table.
+      /// \param[in] _y Row of the table.
+      /// \param[in] _height The new height.
+      /// \return False if the point is out of bounds.
+      public: bool SetHeight(const unsigned int _x, const unsigned int _y,
+                  const float _height);
+
+      /// \brief Copy a rectangular region of the table. Tiles that aren't
+      /// in memory are read but not kept, so reading the whole table
+      /// doesn't release the tiles in use.
+      /// \param[in] _x First column of the region.
+      /// \param[in] _y First row of the region.
+      /// \param[in] _width Number of columns of the region.
+      /// \param[in] _height Number of rows of the region.
+      /// \param[out] _heights Heights of the region, row by row.
+      /// \return False if the region is out of bounds.
+      public: bool Heights(const unsigned int _x, const unsigned int _y,
+                  const unsigned int _width, const unsigned int _height,
+                  std::vector<float> &_heights);
+
+      /// \brief Read the tiles which contain a rectangular region of the
+      /// table, and mark them as the most recently used ones. This is
+      /// used to read the tiles near moving bodies before they collide.
+      /// At most Capacity() tiles are read.
+      /// \param[in] _x0 First column of the region.
+      /// \param[in] _y0 First row of the region.
+      /// \param[in] _x1 Last column of the region, included.
+      /// \param[in] _y1 Last row of the region, included.
+      public: void Prefetch(const unsigned int _x0, const unsigned int _y0,
+                  const unsigned int _x1, const unsigned int _y1);
+
+      /// \brief Set the number of tiles kept in memory.
+      /// \param[in] _capacity Number of tiles, at least 1. The default is
+      /// 64.
+      public: void SetCapacity(const unsigned int _capacity);
+
+      /// \brief Get the number of tiles kept in memory.
+      /// \return Number of tiles.
+      public: unsigned int Capacity() const;
+
+      /// \brief Get the number of tiles currently in memory.
+      /// \return Number of tiles.
+      public: unsigned int ResidentCount() const;
+
+      /// \brief Get the number of tiles read from disk since Load.
+      /// \return Number of reads.
+      public: uint64_t ReadCount() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<HeightmapTileCachePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_HEIGHTMAPTILECACHEPRIVATE_HH_
+#define GAZEBO_PHYSICS_HEIGHTMAPTILECACHEPRIVATE_HH_
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/HeightmapData.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief A tile of a HeightmapTileCache held in memory.
+    class HeightmapTile
+    {
+      /// \brief Heights of the tile, row by row.
+      public: std::vector<float> heights;
+
+      /// \brief Number of columns.
+      public: unsigned int width = 0;
+
+      /// \brief True if a height was changed, in which case the tile is
+      /// never released.
+      public: bool modified = false;
+
+      /// \brief Position of the tile in the list of recently used tiles.
+      public: std::list<uint32_t>::iterator lru;
+    };
+
+    /// \internal
+    /// \brief Private data for the HeightmapTileCache class.
+    class HeightmapTileCachePrivate
+    {
+      /// \brief Resample the table and write all its tiles to dir. The
+      /// height range is set from the heights.
+      /// \param[in] _data Terrain data.
+      /// \param[in] _subSampling Multiplier used to increase the resolution.
+      /// \param[in] _size Real dimmensions of the terrain.
+      /// \param[in] _scale Vector3 used to scale the height.
+      /// \param[in] _flipY If true, the rows of the table are inverted.
+      /// \return True on success.
+      public: bool WriteTiles(common::HeightmapData &_data,
+                  const int _subSampling,
+                  const ignition::math::Vector3d &_size,
+                  const ignition::math::Vector3d &_scale, const bool _flipY);
+
+      /// \brief Write the hashes and the description of the table to the
+      /// tiles.meta file of dir.
+      /// \param[in] _hash Hash of all the parameters of the table.
+      /// \param[in] _keyHash Hash of the key of the terrain data.
+      /// \return True on success.
+      public: bool WriteMeta(const std::string &_hash,
+                  const std::string &_keyHash) const;
+
+      /// \brief Read the tiles.meta file of a directory. If it matches the
+      /// hashes, dir and the description of the table are set from it.
+      /// \param[in] _dir Cache directory.
+      /// \param[in] _hash Hash of all the parameters of the table, empty
+      /// to accept any parameters.
+      /// \param[in] _keyHash Hash of the key of the terrain data.
+      /// \return True if the file matches.
+      public: bool ReadMeta(const std::string &_dir,
+                  const std::string &_hash, const std::string &_keyHash);
+
+      /// \brief Release the tiles and reset the description of the table.
+      /// The mutex must be locked.
+      public: void Clear();
+
+      /// \brief Get the path of the file of a tile.
+      /// \param[in] _tx Column of the tile.
+      /// \param[in] _ty Row of the tile.
+      /// \return The path.
+      public: std::string TilePath(const unsigned int _tx,
+                  const unsigned int _ty) const;
+
+      /// \brief Get the number of points per row or column of the tiles of
+      /// a row or column of tiles.
+      /// \param[in] _t Index of the row or column of tiles.
+      /// \return Number of points, smaller for the last tiles.
+      public: unsigned int TileExtent(const unsigned int _t) const;
+
+      /// \brief Read the heights of a tile from its file. Heights that
+      /// can't be read are set to 0.
+      /// \param[in] _id Identifier of the tile.
+      /// \param[out] _heights Heights of the tile.
+      public: void ReadTile(const uint32_t _id, std::vector<float> &_heights);
+
+      /// \brief Get a tile, reading it if it isn't in memory, and mark it
+      /// as the most recently used one. The mutex must be locked.
+      /// \param[in] _id Identifier of the tile, row * tileCount + column.
+      /// \return The tile.
+      public: HeightmapTile &Tile(const uint32_t _id);
+
+      /// \brief Release the least recently used tiles that weren't
+      /// modified until the capacity is respected. The mutex must be
+      /// locked.
+      public: void Evict();
+
+      /// \brief Protects everything below.
+      public: mutable std::mutex mutex;
+
+      /// \brief Cache directory.
+      public: std::string dir;
+
+      /// \brief Number of points per row of the table.
+      public: unsigned int vertSize = 0;
+
+      /// \brief Number of points per row of a tile.
+      public: unsigned int tileSize = 256;
+
+      /// \brief Number of tiles per row of the table.
+      public: unsigned int tileCount = 0;
+
+      /// \brief Lowest height.
+      public: float minHeight = 0;
+
+      /// \brief Highest height.
+      public: float maxHeight = 0;
+
+      /// \brief Real dimmensions of the terrain.
+      public: ignition::math::Vector3d size;
+
+      /// \brief Scale of the heights.
+      public: ignition::math::Vector3d scale = ignition::math::Vector3d::One;
+
+      /// \brief Text stored with the tiles.
+      public: std::string info;
+
+      /// \brief Maximum number of tiles in memory.
+      public: unsigned int capacity = 64;
+
+      /// \brief Tiles in memory, indexed by identifier.
+      public: std::unordered_map<uint32_t, HeightmapTile> tiles;
+
+      /// \brief Identifiers of the tiles in memory, the most recently used
+      /// first.
+      public: std::list<uint32_t> lru;
+
+      /// \brief The most recently used tile, nullptr if there is none.
+      public: HeightmapTile *last = nullptr;
+
+      /// \brief Identifier of the most recently used tile.
+      public: uint32_t lastId = 0;
+
+      /// \brief Number of tiles read from disk.
+      public: uint64_t reads = 0;
+    };
+  }
+}
+#endif
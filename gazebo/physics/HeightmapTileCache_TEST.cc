@@ -0,0 +1,353 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/HeightmapData.hh"
+#include "gazebo/physics/HeightmapTileCache.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+/// \brief Terrain data with analytic heights, which counts the rows that
+/// are resampled.
+class FakeHeightmapData : public common::HeightmapData
+{
+  // Documentation inherited
+  public: virtual void FillHeightMap(int _subSampling,
+      unsigned int _vertSize, const ignition::math::Vector3d &_size,
+      const ignition::math::Vector3d &_scale, bool _flipY,
+      std::vector<float> &_heights)
+  {
+    this->FillHeightMap(_subSampling, _vertSize, _size, _scale, _flipY,
+        0, 0, _vertSize, _vertSize, _heights);
+  }
+
+  // Documentation inherited
+  public: virtual void FillHeightMap(int /*_subSampling*/,
+      unsigned int _vertSize, const ignition::math::Vector3d &/*_size*/,
+      const ignition::math::Vector3d &/*_scale*/, bool _flipY,
+      unsigned int _x, unsigned int _y, unsigned int _width,
+      unsigned int _height, std::vector<float> &_heights)
+  {
+    _heights.resize(_width * _height);
+    for (unsigned int y = 0; y < _height; ++y)
+    {
+      for (unsigned int x = 0; x < _width; ++x)
+      {
+        _heights[y * _width + x] =
+            Expected(_vertSize, _flipY, _x + x, _y + y);
+      }
+    }
+    this->rows += _height;
+  }
+
+  // Documentation inherited
+  public: virtual unsigned int GetHeight() const {return 50;}
+
+  // Documentation inherited
+  public: virtual unsigned int GetWidth() const {return 50;}
+
+  // Documentation inherited
+  public: virtual float GetMaxElevation() const {return 0;}
+
+  /// \brief Height of a point of the table.
+  /// \param[in] _vertSize Number of points per row.
+  /// \param[in] _flipY True if the rows are inverted.
+  /// \param[in] _x Column.
+  /// \param[in] _y Row.
+  /// \return The height.
+  public: static float Expected(const unsigned int _vertSize,
+              const bool _flipY, const unsigned int _x, const unsigned int _y)
+  {
+    return _x + 1000.0f * (_flipY ? _vertSize - 1 - _y : _y);
+  }
+
+  /// \brief Number of rows resampled.
+  public: unsigned int rows = 0;
+};
+
+class HeightmapTileCacheTest : public gazebo::testing::AutoLogFixture
+{
+  /// \brief Create a temporary cache directory.
+  protected: virtual void SetUp()
+  {
+    gazebo::testing::AutoLogFixture::SetUp();
+    this->dir = boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path("gz_heightmap_tiles_%%%%-%%%%");
+  }
+
+  /// \brief Remove the cache directory.
+  protected: virtual void TearDown()
+  {
+    boost::system::error_code ec;
+    boost::filesystem::remove_all(this->dir, ec);
+    gazebo::testing::AutoLogFixture::TearDown();
+  }
+
+  /// \brief Cache directory.
+  protected: boost::filesystem::path dir;
+};
+
+/// \brief Number of points per row of the tables of the tests.
+static const unsigned int kVertSize = 50;
+
+/// \brief Size of the terrain.
+static const ignition::math::Vector3d kSize(100, 100, 10);
+
+//////////////////////////////////////////////////
+TEST_F(HeightmapTileCacheTest, Load)
+{
+  FakeHeightmapData data;
+  physics::HeightmapTileCache cache;
+  EXPECT_EQ(cache.VertexCount(), 0u);
+  EXPECT_FLOAT_EQ(cache.Height(0, 0), 0.0f);
+
+  // Invalid parameters
+  EXPECT_FALSE(cache.Load(data, this->dir.string(), "fake", 0, kVertSize,
+      kSize, ignition::math::Vector3d::One, false, 16));
+  EXPECT_FALSE(cache.Load(data, this->dir.string(), "fake", 1, 0,
+      kSize, ignition::math::Vector3d::One, false, 16));
+
+  // The tiles are created, one band of tiles at a time
+  ASSERT_TRUE(cache.Load(data, this->dir.string(), "fake", 1, kVertSize,
+      kSize, ignition::math::Vector3d::One, true, 16));
+  EXPECT_EQ(data.rows, kVertSize);
+  EXPECT_EQ(cache.VertexCount(), kVertSize);
+  EXPECT_EQ(cache.TileSize(), 16u);
+  EXPECT_EQ(cache.TileCount(), 4u);
+  EXPECT_FLOAT_EQ(cache.MinHeight(), 0.0f);
+  EXPECT_FLOAT_EQ(cache.MaxHeight(),
+      FakeHeightmapData::Expected(kVertSize, true, kVertSize - 1, 0));
+  EXPECT_TRUE(boost::filesystem::exists(this->dir / "tile_3_3.bin"));
+
+  for (unsigned int y = 0; y < kVertSize; ++y)
+  {
+    for (unsigned int x = 0; x < kVertSize; ++x)
+    {
+      EXPECT_FLOAT_EQ(cache.Height(x, y),
+          FakeHeightmapData::Expected(kVertSize, true, x, y));
+    }
+  }
+  EXPECT_EQ(cache.ReadCount(), 16u);
+  EXPECT_FLOAT_EQ(cache.Height(kVertSize, 0), 0.0f);
+
+  // Same parameters, the tiles are reused
+  physics::HeightmapTileCache cache2;
+  ASSERT_TRUE(cache2.Load(data, this->dir.string(), "fake", 1, kVertSize,
+      kSize, ignition::math::Vector3d::One, true, 16));
+  EXPECT_EQ(data.rows, kVertSize);
+  EXPECT_EQ(cache2.ReadCount(), 0u);
+  EXPECT_FLOAT_EQ(cache2.MaxHeight(), cache.MaxHeight());
+  EXPECT_FLOAT_EQ(cache2.Height(20, 40),
+      FakeHeightmapData::Expected(kVertSize, true, 20, 40));
+
+  // Any other parameter or key creates them again
+  ASSERT_TRUE(cache2.Load(data, this->dir.string(), "fake", 1, kVertSize,
+      kSize, ignition::math::Vector3d::One, false, 16));
+  EXPECT_EQ(data.rows, 2 * kVertSize);
+  EXPECT_FLOAT_EQ(cache2.Height(20, 40),
+      FakeHeightmapData::Expected(kVertSize, false, 20, 40));
+
+  ASSERT_TRUE(cache2.Load(data, this->dir.string(), "other", 1, kVertSize,
+      kSize, ignition::math::Vector3d::One, false, 16));
+  EXPECT_EQ(data.rows, 3 * kVertSize);
+}
+
+//////////////////////////////////////////////////
+TEST_F(HeightmapTileCacheTest, Open)
+{
+  physics::HeightmapTileCache cache;
+  EXPECT_FALSE(cache.Open(this->dir.string(), "fake"));
+
+  FakeHeightmapData data;
+  const ignition::math::Vector3d scale(2, 2, 0.5);
+  ASSERT_TRUE(cache.Load(data, this->dir.string(), "fake", 1, kVertSize,
+      kSize, scale, false, 16, "0.5 -1.25 100"));
+
+  // The description of the table is read back without the terrain data
+  physics::HeightmapTileCache cache2;
+  EXPECT_FALSE(cache2.Open(this->dir.string(), "other"));
+  EXPECT_EQ(cache2.VertexCount(), 0u);
+
+  ASSERT_TRUE(cache2.Open(this->dir.string(), "fake"));
+  EXPECT_EQ(cache2.VertexCount(), kVertSize);
+  EXPECT_EQ(cache2.TileSize(), 16u);
+  EXPECT_EQ(cache2.TileCount(), 4u);
+  EXPECT_EQ(cache2.Size(), kSize);
+  EXPECT_EQ(cache2.Scale(), scale);
+  EXPECT_EQ(cache2.Info(), "0.5 -1.25 100");
+  EXPECT_FLOAT_EQ(cache2.MinHeight(), cache.MinHeight());
+  EXPECT_FLOAT_EQ(cache2.MaxHeight(), cache.MaxHeight());
+  EXPECT_FLOAT_EQ(cache2.Height(20, 40),
+      FakeHeightmapData::Expected(kVertSize, false, 20, 40));
+  EXPECT_EQ(data.rows, kVertSize);
+}
+
+//////////////////////////////////////////////////
+TEST_F(HeightmapTileCacheTest, Publish)
+{
+  // A directory left without a tiles.meta file is replaced
+  boost::filesystem::create_directories(this->dir);
+  std::ofstream((this->dir / "tile_0_0.bin").string()) << "partial";
+  {
+    FakeHeightmapData data;
+    physics::HeightmapTileCache cache;
+    ASSERT_TRUE(cache.Load(data, this->dir.string(), "fake", 1, kVertSize,
+        kSize, ignition::math::Vector3d::One, false, 16));
+    EXPECT_EQ(data.rows, kVertSize);
+    EXPECT_FLOAT_EQ(cache.Height(0, 0),
+        FakeHeightmapData::Expected(kVertSize, false, 0, 0));
+  }
+  boost::filesystem::remove_all(this->dir);
+
+  // Loads of the same tiles from several threads all succeed, and the
+  // temporary directories they wrote to are removed.
+  std::vector<std::thread> threads;
+  bool results[4];
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([this, &results, i]()
+    {
+      FakeHeightmapData data;
+      physics::HeightmapTileCache cache;
+      results[i] = cache.Load(data, this->dir.string(), "fake", 1,
+          kVertSize, kSize, ignition::math::Vector3d::One, false, 16) &&
+          cache.Height(20, 40) ==
+          FakeHeightmapData::Expected(kVertSize, false, 20, 40);
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  for (const bool result : results)
+    EXPECT_TRUE(result);
+
+  unsigned int entries = 0;
+  for (boost::filesystem::directory_iterator iter(this->dir.parent_path());
+       iter != boost::filesystem::directory_iterator(); ++iter)
+  {
+    if (iter->path().filename().string().find(
+        this->dir.filename().string()) == 0)
+    {
+      ++entries;
+    }
+  }
+  EXPECT_EQ(entries, 1u);
+  EXPECT_TRUE(boost::filesystem::exists(this->dir / "tiles.meta"));
+
+  physics::HeightmapTileCache cache;
+  FakeHeightmapData data;
+  ASSERT_TRUE(cache.Load(data, this->dir.string(), "fake", 1, kVertSize,
+      kSize, ignition::math::Vector3d::One, false, 16));
+  EXPECT_EQ(data.rows, 0u);
+}
+
+//////////////////////////////////////////////////
+TEST_F(HeightmapTileCacheTest, Capacity)
+{
+  FakeHeightmapData data;
+  physics::HeightmapTileCache cache;
+  ASSERT_TRUE(cache.Load(data, this->dir.string(), "fake", 1, kVertSize,
+      kSize, ignition::math::Vector3d::One, false, 16));
+  EXPECT_EQ(cache.Capacity(), 64u);
+
+  cache.SetCapacity(0);
+  EXPECT_EQ(cache.Capacity(), 1u);
+  cache.SetCapacity(2);
+  EXPECT_EQ(cache.Capacity(), 2u);
+
+  // The least recently used tile is released
+  cache.Height(0, 0);
+  cache.Height(20, 0);
+  EXPECT_EQ(cache.ResidentCount(), 2u);
+  cache.Height(0, 0);
+  cache.Height(40, 0);
+  EXPECT_EQ(cache.ResidentCount(), 2u);
+  EXPECT_EQ(cache.ReadCount(), 3u);
+  cache.Height(1, 1);
+  EXPECT_EQ(cache.ReadCount(), 3u);
+  cache.Height(21, 1);
+  EXPECT_EQ(cache.ReadCount(), 4u);
+
+  // Modified tiles stay in memory
+  EXPECT_TRUE(cache.SetHeight(5, 5, -3.0f));
+  EXPECT_FALSE(cache.SetHeight(kVertSize, 5, -3.0f));
+  EXPECT_FLOAT_EQ(cache.MinHeight(), -3.0f);
+  cache.Height(0, 20);
+  cache.Height(20, 20);
+  cache.Height(40, 20);
+  EXPECT_FLOAT_EQ(cache.Height(5, 5), -3.0f);
+  EXPECT_EQ(cache.ReadCount(), 7u);
+
+  // Prefetch reads at most Capacity() tiles
+  cache.SetCapacity(4);
+  const uint64_t reads = cache.ReadCount();
+  cache.Prefetch(0, 32, kVertSize - 1, kVertSize - 1);
+  EXPECT_EQ(cache.ReadCount(), reads + 4);
+  EXPECT_LE(cache.ResidentCount(), 5u);
+  cache.Prefetch(kVertSize, 0, kVertSize + 1, 1);
+  EXPECT_EQ(cache.ReadCount(), reads + 4);
+}
+
+//////////////////////////////////////////////////
+TEST_F(HeightmapTileCacheTest, Heights)
+{
+  FakeHeightmapData data;
+  physics::HeightmapTileCache cache;
+  ASSERT_TRUE(cache.Load(data, this->dir.string(), "fake", 1, kVertSize,
+      kSize, ignition::math::Vector3d::One, false, 16));
+  cache.SetCapacity(1);
+  EXPECT_TRUE(cache.SetHeight(17, 17, 5.0f));
+
+  std::vector<float> heights;
+  EXPECT_FALSE(cache.Heights(0, 0, 0, 1, heights));
+  EXPECT_FALSE(cache.Heights(40, 0, 11, 1, heights));
+
+  // A region over several tiles, including the modified one, which is
+  // the only one kept in memory
+  ASSERT_TRUE(cache.Heights(10, 12, 40, 30, heights));
+  ASSERT_EQ(heights.size(), 40u * 30u);
+  for (unsigned int y = 0; y < 30; ++y)
+  {
+    for (unsigned int x = 0; x < 40; ++x)
+    {
+      if (x + 10 == 17 && y + 12 == 17)
+      {
+        EXPECT_FLOAT_EQ(heights[y * 40 + x], 5.0f);
+      }
+      else
+      {
+        EXPECT_FLOAT_EQ(heights[y * 40 + x],
+            FakeHeightmapData::Expected(kVertSize, false, x + 10, y + 12));
+      }
+    }
+  }
+  EXPECT_EQ(cache.ResidentCount(), 1u);
+  EXPECT_FLOAT_EQ(cache.Height(17, 17), 5.0f);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
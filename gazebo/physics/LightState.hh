@@ -125,6 +125,9 @@ namespace gazebo
         return _out;
       }
 
+      /// \brief WorldStateSnapshot fills states directly.
+      friend class WorldStateSnapshot;
+
       /// \brief Pose of the light.
       private: ignition::math::Pose3d pose;
     };
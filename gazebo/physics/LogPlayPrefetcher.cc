@@ -0,0 +1,441 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <string>
+
+#include "gazebo/common/CommonIface.hh"
+#include "gazebo/physics/LogPlayPrefetcherPrivate.hh"
+#include "gazebo/physics/LogPlayPrefetcher.hh"
+#include "gazebo/util/LogPlay.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+//////////////////////////////////////////////////
+LogPlayPrefetcher::LogPlayPrefetcher()
+  : dataPtr(new LogPlayPrefetcherPrivate)
+{
+  this->dataPtr->stateSDF.reset(new sdf::Element);
+  sdf::initFile("state.sdf", this->dataPtr->stateSDF);
+}
+
+//////////////////////////////////////////////////
+LogPlayPrefetcher::~LogPlayPrefetcher()
+{
+  this->Stop();
+}
+
+//////////////////////////////////////////////////
+void LogPlayPrefetcher::Start()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->running)
+    return;
+
+  this->dataPtr->Reset();
+  this->dataPtr->stop = false;
+  this->dataPtr->suspended = false;
+  this->dataPtr->running = true;
+  this->dataPtr->thread = std::thread(&LogPlayPrefetcher::Run, this);
+}
+
+//////////////////////////////////////////////////
+void LogPlayPrefetcher::Stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (!this->dataPtr->running)
+      return;
+    this->dataPtr->stop = true;
+    this->dataPtr->workCondition.notify_all();
+  }
+
+  this->dataPtr->thread.join();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->running = false;
+  this->dataPtr->stop = false;
+  this->dataPtr->Reset();
+}
+
+//////////////////////////////////////////////////
+void LogPlayPrefetcher::SetCapacity(const unsigned int _ahead,
+    const unsigned int _behind)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->ahead = std::max(_ahead, 1u);
+  this->dataPtr->behind = _behind;
+  this->dataPtr->Trim();
+  this->dataPtr->workCondition.notify_all();
+}
+
+//////////////////////////////////////////////////
+unsigned int LogPlayPrefetcher::AheadCapacity() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->ahead;
+}
+
+//////////////////////////////////////////////////
+unsigned int LogPlayPrefetcher::BehindCapacity() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->behind;
+}
+
+//////////////////////////////////////////////////
+unsigned int LogPlayPrefetcher::ReadyCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return static_cast<unsigned int>(this->dataPtr->read -
+      std::max(this->dataPtr->current, this->dataPtr->first - 1));
+}
+
+//////////////////////////////////////////////////
+uint64_t LogPlayPrefetcher::ReadCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->logReads;
+}
+
+//////////////////////////////////////////////////
+bool LogPlayPrefetcher::Step(const int _step, WorldState &_state)
+{
+  if (_step == 0)
+    return false;
+
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+
+  int64_t wanted = this->dataPtr->current + _step;
+  if (_step > 0 && this->dataPtr->running)
+  {
+    // Ask for frames beyond the window, then wait for the frame to be read
+    if (wanted > this->dataPtr->target)
+    {
+      this->dataPtr->target = wanted;
+      this->dataPtr->workCondition.notify_all();
+    }
+
+    this->dataPtr->readyCondition.wait(lock, [this, wanted]
+        {
+          return this->dataPtr->read >= wanted || this->dataPtr->atEnd;
+        });
+
+    // As util::LogPlay, stop on the last frame of the log
+    if (wanted > this->dataPtr->read)
+    {
+      if (this->dataPtr->read == this->dataPtr->current)
+        return false;
+      wanted = this->dataPtr->read;
+    }
+  }
+
+  if (wanted >= this->dataPtr->first && wanted <= this->dataPtr->read)
+  {
+    _state = this->dataPtr->frames[wanted - this->dataPtr->first];
+    this->dataPtr->current = wanted;
+    this->dataPtr->Trim();
+    this->dataPtr->workCondition.notify_all();
+    return true;
+  }
+
+  // The frame is before the prepared ones, which happens when stepping
+  // back after a seek. Prepare the frames behind it as well, so that the
+  // next steps back don't move util::LogPlay again.
+  if (wanted < this->dataPtr->first)
+  {
+    this->dataPtr->Suspend(lock);
+
+    const int64_t reached = std::max(wanted,
+        this->dataPtr->ReadBehind(wanted));
+    const bool result = reached >= this->dataPtr->first &&
+        reached <= this->dataPtr->read &&
+        (_step > 0 ? reached > this->dataPtr->current :
+         reached < this->dataPtr->current);
+    if (result)
+    {
+      this->dataPtr->current = reached;
+      _state = this->dataPtr->frames[reached - this->dataPtr->first];
+    }
+    this->dataPtr->target = this->dataPtr->current;
+    this->dataPtr->Trim();
+
+    this->dataPtr->Resume();
+    return result;
+  }
+
+  // The frame is after the prepared ones, move util::LogPlay to it from
+  // the last frame that was read.
+  this->dataPtr->Suspend(lock);
+
+  std::string data;
+  int64_t reached = this->dataPtr->read;
+  while (reached < wanted && util::LogPlay::Instance()->Step(data))
+  {
+    ++reached;
+    ++this->dataPtr->logReads;
+  }
+
+  // As util::LogPlay, fail if the beginning or the end of the log was
+  // reached before moving past the current frame. The current frame is
+  // unchanged in that case.
+  const bool result = _step > 0 ? reached > this->dataPtr->current :
+      reached < this->dataPtr->current;
+
+  if (!data.empty())
+  {
+    WorldState state;
+    this->dataPtr->Parse(data, state);
+
+    this->dataPtr->frames.clear();
+    this->dataPtr->frames.push_back(state);
+    this->dataPtr->first = reached;
+    this->dataPtr->read = reached;
+    this->dataPtr->atEnd = false;
+    if (result)
+    {
+      this->dataPtr->current = reached;
+      _state = state;
+    }
+    this->dataPtr->target = this->dataPtr->current;
+  }
+
+  this->dataPtr->Resume();
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool LogPlayPrefetcher::Seek(const common::Time &_time)
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+
+  // Reuse the prepared frames if they contain the time. As
+  // util::LogPlay::Seek, stop on the last frame before it.
+  auto &frames = this->dataPtr->frames;
+  for (size_t i = 0; i + 1 < frames.size(); ++i)
+  {
+    if (frames[i].GetSimTime() < _time && frames[i + 1].GetSimTime() >= _time)
+    {
+      this->dataPtr->current = this->dataPtr->first + i;
+      this->dataPtr->target = this->dataPtr->current;
+      this->dataPtr->Trim();
+      this->dataPtr->workCondition.notify_all();
+      return true;
+    }
+  }
+
+  this->dataPtr->Suspend(lock);
+  bool result = util::LogPlay::Instance()->Seek(_time);
+  this->dataPtr->Reset();
+  this->dataPtr->Resume();
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool LogPlayPrefetcher::Rewind()
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+
+  this->dataPtr->Suspend(lock);
+  bool result = util::LogPlay::Instance()->Rewind();
+  this->dataPtr->Reset();
+  this->dataPtr->Resume();
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool LogPlayPrefetcher::Forward()
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+
+  this->dataPtr->Suspend(lock);
+  bool result = util::LogPlay::Instance()->Forward();
+  this->dataPtr->Reset();
+  this->dataPtr->Resume();
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+void LogPlayPrefetcher::Run()
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+
+  while (true)
+  {
+    this->dataPtr->workCondition.wait(lock, [this]
+        {
+          return this->dataPtr->stop ||
+              (!this->dataPtr->suspended && !this->dataPtr->atEnd &&
+               this->dataPtr->read < std::max(this->dataPtr->target,
+                 this->dataPtr->current + this->dataPtr->ahead));
+        });
+
+    if (this->dataPtr->stop)
+      break;
+
+    // Frames skipped by a large step are read but not parsed
+    const int64_t next = this->dataPtr->read + 1;
+    const bool skip = next <
+        this->dataPtr->target - static_cast<int64_t>(this->dataPtr->behind);
+
+    this->dataPtr->busy = true;
+    lock.unlock();
+
+    std::string data;
+    WorldState state;
+    bool read = util::LogPlay::Instance()->Step(data);
+    if (read)
+      ++this->dataPtr->logReads;
+    if (read && !skip)
+      this->dataPtr->Parse(data, state);
+
+    lock.lock();
+    this->dataPtr->busy = false;
+
+    if (!read)
+    {
+      this->dataPtr->atEnd = true;
+    }
+    else
+    {
+      this->dataPtr->read = next;
+      if (skip)
+      {
+        this->dataPtr->frames.clear();
+        this->dataPtr->first = next + 1;
+      }
+      else
+      {
+        this->dataPtr->frames.push_back(state);
+      }
+      this->dataPtr->Trim();
+    }
+
+    this->dataPtr->readyCondition.notify_all();
+  }
+}
+
+//////////////////////////////////////////////////
+void LogPlayPrefetcherPrivate::Parse(const std::string &_data,
+    WorldState &_state)
+{
+  {
+    std::lock_guard<std::mutex> lock(common::sdfParseMutex());
+    this->stateSDF->Clear();
+    sdf::readString(_data, this->stateSDF);
+  }
+  _state.Load(this->stateSDF);
+}
+
+//////////////////////////////////////////////////
+void LogPlayPrefetcherPrivate::Suspend(std::unique_lock<std::mutex> &_lock)
+{
+  this->suspended = true;
+  this->readyCondition.wait(_lock, [this] {return !this->busy;});
+}
+
+//////////////////////////////////////////////////
+void LogPlayPrefetcherPrivate::Resume()
+{
+  this->suspended = false;
+  this->workCondition.notify_all();
+}
+
+//////////////////////////////////////////////////
+void LogPlayPrefetcherPrivate::Reset()
+{
+  this->frames.clear();
+  this->first = this->read + 1;
+  this->current = this->read;
+  this->target = this->read;
+  this->atEnd = false;
+}
+
+//////////////////////////////////////////////////
+int64_t LogPlayPrefetcherPrivate::ReadBehind(const int64_t _wanted)
+{
+  // The prepared frames are [first, read], which is empty if first is
+  // read + 1. Walk back from read, and parse the frames before them.
+  const int64_t oldest = _wanted - static_cast<int64_t>(this->behind);
+  const int64_t lastPrepared = this->read;
+  const bool empty = this->frames.empty();
+
+  std::deque<WorldState> older;
+  std::string data;
+  int64_t reached = this->read;
+  while (reached > oldest && util::LogPlay::Instance()->StepBack(data))
+  {
+    --reached;
+    ++this->logReads;
+    if (reached < this->first)
+    {
+      older.emplace_front();
+      this->Parse(data, older.front());
+    }
+  }
+
+  this->frames.insert(this->frames.begin(),
+      std::make_move_iterator(older.begin()),
+      std::make_move_iterator(older.end()));
+  this->first = reached;
+
+  // Walk forward again, but keep no more than ahead frames after the
+  // wanted one. The last frame that was read is only missing if nothing
+  // was prepared.
+  const int64_t top = std::min(lastPrepared,
+      std::max(_wanted, reached) + static_cast<int64_t>(this->ahead));
+  int64_t forward = reached;
+  while (forward < top && util::LogPlay::Instance()->Step(data))
+  {
+    ++forward;
+    ++this->logReads;
+    if (empty && forward == lastPrepared)
+    {
+      this->frames.emplace_back();
+      this->Parse(data, this->frames.back());
+    }
+  }
+
+  while (this->first + static_cast<int64_t>(this->frames.size()) >
+         forward + 1)
+  {
+    this->frames.pop_back();
+  }
+  this->read = forward;
+  if (this->frames.empty())
+    this->first = this->read + 1;
+  if (forward < lastPrepared)
+    this->atEnd = false;
+
+  return reached;
+}
+
+//////////////////////////////////////////////////
+void LogPlayPrefetcherPrivate::Trim()
+{
+  const int64_t oldest = this->current - static_cast<int64_t>(this->behind);
+  while (!this->frames.empty() && this->first < oldest)
+  {
+    this->frames.pop_front();
+    ++this->first;
+  }
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_LOGPLAYPREFETCHER_HH_
+#define GAZEBO_PHYSICS_LOGPLAYPREFETCHER_HH_
+
+#include <cstdint>
+#include <memory>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class
+    class LogPlayPrefetcherPrivate;
+    class WorldState;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class LogPlayPrefetcher LogPlayPrefetcher.hh physics/physics.hh
+    /// \brief Reads and parses the frames of the open log file ahead of
+    /// playback.
+    ///
+    /// A background thread steps util::LogPlay forward, which decompresses
+    /// the chunks of the log, and parses every frame into a WorldState
+    /// kept in a bounded window around the frame being played. Stepping
+    /// forward or backward within the window only copies a prepared state.
+    /// Frames outside of the window are read and parsed synchronously, as
+    /// util::LogPlay does.
+    ///
+    /// While the prefetcher is running, the position of util::LogPlay must
+    /// only be changed through Seek, Rewind and Forward.
+    class GZ_PHYSICS_VISIBLE LogPlayPrefetcher
+    {
+      /// \brief Constructor.
+      public: LogPlayPrefetcher();
+
+      /// \brief Destructor. Stops the background thread.
+      public: virtual ~LogPlayPrefetcher();
+
+      /// \brief Start prefetching from the current position of
+      /// util::LogPlay, which becomes the current frame.
+      public: void Start();
+
+      /// \brief Stop the background thread and clear the prepared frames.
+      /// util::LogPlay is left on the last frame that was read, which may be
+      /// ahead of the current frame.
+      public: void Stop();
+
+      /// \brief Set the size of the window of prepared frames.
+      /// \param[in] _ahead Max number of frames prepared after the current
+      /// one.
+      /// \param[in] _behind Max number of frames kept before the current
+      /// one, for stepping back.
+      public: void SetCapacity(const unsigned int _ahead,
+                               const unsigned int _behind);
+
+      /// \brief Get the max number of frames prepared after the current one.
+      /// \return Number of frames.
+      public: unsigned int AheadCapacity() const;
+
+      /// \brief Get the max number of frames kept before the current one.
+      /// \return Number of frames.
+      public: unsigned int BehindCapacity() const;
+
+      /// \brief Get the number of frames after the current one that are
+      /// ready to be played.
+      /// \return Number of frames.
+      public: unsigned int ReadyCount() const;
+
+      /// \brief Get the number of frames read from util::LogPlay, forward
+      /// or backward, since the prefetcher was created. This measures how
+      /// well the prepared frames are reused.
+      /// \return Number of frames read.
+      public: uint64_t ReadCount() const;
+
+      /// \brief Move by a number of frames, as util::LogPlay::Step does,
+      /// and get the state of the new current frame.
+      /// \param[in] _step Number of frames to move, negative to go back.
+      /// \param[out] _state State of the new current frame.
+      /// \return True if at least one frame could be played, false at the
+      /// end or the beginning of the log. When the frame is before the
+      /// prepared ones, the frames up to BehindCapacity() before it are
+      /// prepared too, so that the next steps back reuse them.
+      public: bool Step(const int _step, WorldState &_state);
+
+      /// \brief Move right before the first frame of a given simulation
+      /// time, as util::LogPlay::Seek does. The prepared frames are reused
+      /// if they contain that time.
+      /// \param[in] _time Simulation time.
+      /// \return True if the operation succeeded.
+      public: bool Seek(const common::Time &_time);
+
+      /// \brief Move to the beginning of the log, see util::LogPlay::Rewind.
+      /// \return True if the operation succeeded.
+      public: bool Rewind();
+
+      /// \brief Move to the end of the log, see util::LogPlay::Forward.
+      /// \return True if the operation succeeded.
+      public: bool Forward();
+
+      /// \brief Entry point of the background thread.
+      private: void Run();
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<LogPlayPrefetcherPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
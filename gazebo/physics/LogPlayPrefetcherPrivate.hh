@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_LOGPLAYPREFETCHERPRIVATE_HH_
+#define GAZEBO_PHYSICS_LOGPLAYPREFETCHERPRIVATE_HH_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <sdf/sdf.hh>
+
+#include "gazebo/physics/WorldState.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Private data for the LogPlayPrefetcher class.
+    ///
+    /// Frames are numbered in the order they are played, starting from the
+    /// frame util::LogPlay was on when the prefetcher started. The prepared
+    /// frames always are the ones right before the frame util::LogPlay is
+    /// on, including it, so first + frames.size() == read + 1.
+    class LogPlayPrefetcherPrivate
+    {
+      /// \brief Parse a frame of the log.
+      /// \param[in] _data The frame, as returned by util::LogPlay::Step.
+      /// \param[out] _state The parsed state.
+      public: void Parse(const std::string &_data, WorldState &_state);
+
+      /// \brief Wait for the background thread to be done with
+      /// util::LogPlay, and keep it from reading more frames until Resume
+      /// is called.
+      /// \param[in] _lock Lock held on mutex.
+      public: void Suspend(std::unique_lock<std::mutex> &_lock);
+
+      /// \brief Let the background thread read frames again.
+      public: void Resume();
+
+      /// \brief Drop the prepared frames, after util::LogPlay was moved.
+      /// Its new position becomes the current frame.
+      public: void Reset();
+
+      /// \brief Drop prepared frames that are too far behind the current
+      /// one.
+      public: void Trim();
+
+      /// \brief Prepare the frames before the first prepared one, up to
+      /// behind frames before a given frame. util::LogPlay is moved back
+      /// to the oldest of them, then forward again to at most ahead frames
+      /// after the given frame. Must be called while suspended.
+      /// \param[in] _wanted Number of the frame to prepare, before first.
+      /// \return Number of the oldest frame that could be reached, which
+      /// is after _wanted at the beginning of the log.
+      public: int64_t ReadBehind(const int64_t _wanted);
+
+      /// \brief Protects all the members below.
+      public: std::mutex mutex;
+
+      /// \brief Wakes up the background thread.
+      public: std::condition_variable workCondition;
+
+      /// \brief Notified when a frame was read or the background thread
+      /// went idle.
+      public: std::condition_variable readyCondition;
+
+      /// \brief The background thread.
+      public: std::thread thread;
+
+      /// \brief True while the background thread runs.
+      public: bool running = false;
+
+      /// \brief Tells the background thread to exit.
+      public: bool stop = false;
+
+      /// \brief True while the background thread must not use
+      /// util::LogPlay.
+      public: bool suspended = false;
+
+      /// \brief True while the background thread uses util::LogPlay without
+      /// holding the mutex.
+      public: bool busy = false;
+
+      /// \brief True when the end of the log was reached.
+      public: bool atEnd = false;
+
+      /// \brief Prepared frames.
+      public: std::deque<WorldState> frames;
+
+      /// \brief Number of the first prepared frame.
+      public: int64_t first = 1;
+
+      /// \brief Number of the frame util::LogPlay is on.
+      public: int64_t read = 0;
+
+      /// \brief Number of the current frame.
+      public: int64_t current = 0;
+
+      /// \brief Number of a frame waited for, beyond the window.
+      public: int64_t target = 0;
+
+      /// \brief Max number of frames prepared after the current one.
+      public: unsigned int ahead = 100;
+
+      /// \brief Max number of frames kept before the current one.
+      public: unsigned int behind = 100;
+
+      /// \brief Number of frames read from util::LogPlay.
+      public: uint64_t logReads = 0;
+
+      /// \brief Element frames are parsed into. Only used while holding
+      /// busy or suspended.
+      public: sdf::ElementPtr stateSDF;
+    };
+  }
+}
+#endif
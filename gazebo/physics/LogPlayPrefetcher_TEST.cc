@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <sdf/sdf.hh>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/LogPlayPrefetcher.hh"
+#include "gazebo/physics/WorldState.hh"
+#include "gazebo/util/LogPlay.hh"
+#include "test_config.h"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class LogPlayPrefetcherTest : public gazebo::testing::AutoLogFixture
+{
+  /// \brief Open a log file and skip its first frame, which describes the
+  /// world, as the server does.
+  /// \param[in] _name Name of the log file.
+  protected: void Open(const std::string &_name)
+  {
+    boost::filesystem::path logFilePath(TEST_PATH);
+    logFilePath /= boost::filesystem::path("logs");
+    logFilePath /= boost::filesystem::path(_name);
+
+    ASSERT_NO_THROW(util::LogPlay::Instance()->Open(logFilePath.string()));
+    std::string data;
+    ASSERT_TRUE(util::LogPlay::Instance()->Step(data));
+  }
+
+  /// \brief Read the simulation time of every frame directly.
+  /// \return The simulation times.
+  protected: std::vector<common::Time> Times()
+  {
+    sdf::ElementPtr stateSDF(new sdf::Element);
+    sdf::initFile("state.sdf", stateSDF);
+
+    std::vector<common::Time> times;
+    std::string data;
+    while (util::LogPlay::Instance()->Step(data))
+    {
+      stateSDF->Clear();
+      sdf::readString(data, stateSDF);
+      times.push_back(physics::WorldState(stateSDF).GetSimTime());
+    }
+    return times;
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(LogPlayPrefetcherTest, Step)
+{
+  this->Open("state.log");
+  std::vector<common::Time> times = this->Times();
+  ASSERT_GT(times.size(), 100u);
+
+  this->Open("state.log");
+  physics::LogPlayPrefetcher prefetcher;
+  prefetcher.SetCapacity(8, 4);
+  EXPECT_EQ(prefetcher.AheadCapacity(), 8u);
+  EXPECT_EQ(prefetcher.BehindCapacity(), 4u);
+  prefetcher.Start();
+
+  // Play forward, one frame at a time
+  physics::WorldState state;
+  int frame = -1;
+  for (; frame < 19; ++frame)
+  {
+    ASSERT_TRUE(prefetcher.Step(1, state));
+    EXPECT_EQ(state.GetSimTime(), times[frame + 1]);
+  }
+
+  // Back within the window, then beyond it
+  ASSERT_TRUE(prefetcher.Step(-3, state));
+  frame -= 3;
+  EXPECT_EQ(state.GetSimTime(), times[frame]);
+  ASSERT_TRUE(prefetcher.Step(-10, state));
+  frame -= 10;
+  EXPECT_EQ(state.GetSimTime(), times[frame]);
+
+  // Fast forward beyond the window
+  ASSERT_TRUE(prefetcher.Step(50, state));
+  frame += 50;
+  EXPECT_EQ(state.GetSimTime(), times[frame]);
+  ASSERT_TRUE(prefetcher.Step(1, state));
+  ++frame;
+  EXPECT_EQ(state.GetSimTime(), times[frame]);
+  ASSERT_TRUE(prefetcher.Step(-1, state));
+  --frame;
+  EXPECT_EQ(state.GetSimTime(), times[frame]);
+
+  // The frames ahead get prepared in the background
+  for (int i = 0; i < 100 && prefetcher.ReadyCount() < 8u; ++i)
+    common::Time::MSleep(10);
+  EXPECT_EQ(prefetcher.ReadyCount(), 8u);
+
+  // Stepping past the end stops on the last frame
+  ASSERT_TRUE(prefetcher.Step(static_cast<int>(times.size()), state));
+  EXPECT_EQ(state.GetSimTime(), times.back());
+  EXPECT_FALSE(prefetcher.Step(1, state));
+  EXPECT_EQ(prefetcher.ReadyCount(), 0u);
+
+  ASSERT_TRUE(prefetcher.Step(-1, state));
+  EXPECT_EQ(state.GetSimTime(), times[times.size() - 2]);
+
+  prefetcher.Stop();
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogPlayPrefetcherTest, Seek)
+{
+  this->Open("state.log");
+  std::vector<common::Time> times = this->Times();
+  ASSERT_GT(times.size(), 100u);
+
+  this->Open("state.log");
+  physics::LogPlayPrefetcher prefetcher;
+  prefetcher.SetCapacity(50, 50);
+  prefetcher.Start();
+
+  physics::WorldState state;
+  ASSERT_TRUE(prefetcher.Step(1, state));
+  EXPECT_EQ(state.GetSimTime(), times[0]);
+
+  // Within the prepared frames
+  for (int i = 0; i < 100 && prefetcher.ReadyCount() < 50u; ++i)
+    common::Time::MSleep(10);
+  EXPECT_TRUE(prefetcher.Seek(times[20]));
+  ASSERT_TRUE(prefetcher.Step(1, state));
+  EXPECT_EQ(state.GetSimTime(), times[20]);
+
+  // Far away
+  EXPECT_TRUE(prefetcher.Seek(times[times.size() / 2]));
+  ASSERT_TRUE(prefetcher.Step(1, state));
+  EXPECT_EQ(state.GetSimTime(), times[times.size() / 2]);
+
+  // Back to the beginning
+  EXPECT_TRUE(prefetcher.Rewind());
+  ASSERT_TRUE(prefetcher.Step(1, state));
+  EXPECT_EQ(state.GetSimTime(), times[0]);
+  ASSERT_TRUE(prefetcher.Step(1, state));
+  EXPECT_EQ(state.GetSimTime(), times[1]);
+
+  // To the end
+  EXPECT_TRUE(prefetcher.Forward());
+  ASSERT_TRUE(prefetcher.Step(-1, state));
+  EXPECT_EQ(state.GetSimTime(), times.back());
+  EXPECT_FALSE(prefetcher.Step(1, state));
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogPlayPrefetcherTest, StepBackAfterSeek)
+{
+  this->Open("state.log");
+  std::vector<common::Time> times = this->Times();
+  ASSERT_GT(times.size(), 100u);
+
+  this->Open("state.log");
+  physics::LogPlayPrefetcher prefetcher;
+  prefetcher.SetCapacity(50, 50);
+  prefetcher.Start();
+
+  physics::WorldState state;
+  ASSERT_TRUE(prefetcher.Step(1, state));
+
+  // Far away, so that nothing before the new frame is prepared
+  const int middle = static_cast<int>(times.size() / 2);
+  EXPECT_TRUE(prefetcher.Seek(times[middle]));
+  ASSERT_TRUE(prefetcher.Step(1, state));
+  EXPECT_EQ(state.GetSimTime(), times[middle]);
+  for (int i = 0; i < 100 && prefetcher.ReadyCount() < 50u; ++i)
+    common::Time::MSleep(10);
+
+  // The first step back prepares the frames behind, the next ones reuse
+  // them instead of moving util::LogPlay back each time.
+  const uint64_t reads = prefetcher.ReadCount();
+  for (int frame = middle - 1; frame > middle - 40; --frame)
+  {
+    ASSERT_TRUE(prefetcher.Step(-1, state));
+    EXPECT_EQ(state.GetSimTime(), times[frame]);
+  }
+  EXPECT_LE(prefetcher.ReadCount() - reads, 3u * (50u + 50u));
+
+  prefetcher.Stop();
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -14,6 +14,10 @@
  * limitations under the License.
  *
 */
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
 #include <boost/thread/recursive_mutex.hpp>
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Console.hh"
@@ -33,6 +37,7 @@ using namespace physics;
 MeshShape::MeshShape(CollisionPtr _parent)
   : Shape(_parent)
 {
+  this->mesh = NULL;
   this->submesh = NULL;
   this->AddType(Base::MESH_SHAPE);
   sdf::initFile("mesh_shape.sdf", this->sdf);
@@ -118,6 +123,43 @@ std::string MeshShape::GetMeshURI() const
   return this->sdf->Get<std::string>("uri");
 }
 
+//////////////////////////////////////////////////
+const common::Mesh *MeshShape::CollisionMesh() const
+{
+  return this->mesh;
+}
+
+//////////////////////////////////////////////////
+const common::SubMesh *MeshShape::CollisionSubMesh() const
+{
+  return this->submesh;
+}
+
+//////////////////////////////////////////////////
+std::string MeshShape::MeshCacheKey() const
+{
+  if (!this->mesh)
+    return std::string();
+
+  std::ostringstream key;
+  key << this->mesh->GetName() << '\n';
+  if (this->submesh)
+  {
+    sdf::ElementPtr submeshElem = this->sdf->GetElement("submesh");
+    key << this->submesh->GetName() << '\n'
+        << (submeshElem->HasElement("center") &&
+            submeshElem->Get<bool>("center")) << '\n';
+  }
+
+  // Scales which only differ by rounding produce different keys, which
+  // is harmless.
+  ignition::math::Vector3d scale =
+    this->sdf->Get<ignition::math::Vector3d>("scale");
+  key << std::setprecision(std::numeric_limits<double>::max_digits10)
+      << scale.X() << ' ' << scale.Y() << ' ' << scale.Z();
+  return key.str();
+}
+
 //////////////////////////////////////////////////
 void MeshShape::SetMesh(const std::string &_uri,
     const std::string &_submesh, bool _center)
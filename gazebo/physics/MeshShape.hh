@@ -56,6 +56,23 @@ namespace gazebo
       /// \return The URI of the mesh data.
       public: std::string GetMeshURI() const;
 
+      /// \brief Get the mesh used for collisions, without the scale of
+      /// the shape applied. Only valid if CollisionSubMesh returns null.
+      /// \return The mesh, null if it could not be loaded.
+      public: const common::Mesh *CollisionMesh() const;
+
+      /// \brief Get the submesh used for collisions, if a submesh is
+      /// specified, without the scale of the shape applied.
+      /// \return The submesh, null if the whole mesh is used.
+      public: const common::SubMesh *CollisionSubMesh() const;
+
+      /// \brief Get a key identifying the triangles of the shape, made of
+      /// the mesh file, the submesh, whether it is centered, and the scale.
+      /// Physics engines use it to share the collision data of the shapes
+      /// using the same mesh, see TriMeshCache.
+      /// \return The key, empty if the mesh could not be loaded.
+      public: std::string MeshCacheKey() const;
+
       /// \brief Set the mesh uri and submesh name.
       /// \param[in] _uri Filename of the mesh file to load from.
       /// \param[in] _submesh Name of the submesh to use within the mesh
@@ -1334,6 +1334,21 @@ void Model::StopAnimation()
   this->jointAnimations.clear();
 }
 
+//////////////////////////////////////////////////
+bool Model::HasJointAnimation() const
+{
+  boost::recursive_mutex::scoped_lock lock(this->updateMutex);
+  if (!this->jointAnimations.empty())
+    return true;
+
+  for (const auto &model : this->models)
+  {
+    if (model->HasJointAnimation())
+      return true;
+  }
+  return false;
+}
+
 //////////////////////////////////////////////////
 void Model::AttachStaticModel(ModelPtr &_model, ignition::math::Pose3d _offset)
 {
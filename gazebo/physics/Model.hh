@@ -273,6 +273,12 @@ namespace gazebo
       /// \brief Stop the current animations.
       public: virtual void StopAnimation() override;
 
+      /// \brief Check whether joint animations are playing on this model or
+      /// on one of its nested models. Their positions and completion
+      /// callbacks are applied by Update().
+      /// \return True if a joint animation is playing.
+      public: bool HasJointAnimation() const;
+
       /// \brief Attach a static model to this model
       ///
       /// This function takes as input a static Model, which is a Model that
@@ -0,0 +1,682 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/ModelSpatialIndexPrivate.hh"
+#include "gazebo/physics/ModelSpatialIndex.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief Margin added to the bounds of dynamic models in the tree, so that
+/// small motions don't require to move them in the tree.
+static const double kMargin = 0.1;
+
+/// \brief Bounds are clamped to this value in the tree, so that the
+/// infinite bounds of planes don't break the cost heuristics.
+static const double kWorldLimit = 1e9;
+
+/// \brief A model seen by an update, whose bounds must be updated.
+class ModelSpatialChange
+{
+  /// \brief The entry, null for a new model.
+  public: ModelSpatialEntry *entry = nullptr;
+
+  /// \brief The model.
+  public: ModelPtr model;
+
+  /// \brief Bounding box of the model.
+  public: ignition::math::AxisAlignedBox box;
+
+  /// \brief True if the model is static.
+  public: bool isStatic = false;
+
+  /// \brief Position of the model in the traversal, for a new model.
+  public: uint32_t order = 0;
+
+  /// \brief World pose of the model, for a new model.
+  public: ignition::math::Pose3d pose;
+
+  /// \brief World poses of the links, for a new model.
+  public: std::vector<ignition::math::Pose3d> linkPoses;
+};
+
+//////////////////////////////////////////////////
+/// \brief Merge two bounds.
+/// \param[in] _a First bounds.
+/// \param[in] _b Second bounds.
+/// \return Bounds containing both.
+static ModelSpatialBounds Merge(const ModelSpatialBounds &_a,
+    const ModelSpatialBounds &_b)
+{
+  ModelSpatialBounds result = _a;
+  result.min.Min(_b.min);
+  result.max.Max(_b.max);
+  return result;
+}
+
+//////////////////////////////////////////////////
+/// \brief Surface area of bounds, used as the cost of a node.
+/// \param[in] _b The bounds.
+/// \return The area.
+static double Area(const ModelSpatialBounds &_b)
+{
+  const ignition::math::Vector3d size = _b.max - _b.min;
+  return 2.0 * (size.X() * size.Y() + size.Y() * size.Z() +
+      size.Z() * size.X());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check if two bounds overlap. Touching bounds overlap.
+/// \param[in] _a First bounds.
+/// \param[in] _b Second bounds.
+/// \return True if they overlap.
+static bool Overlaps(const ModelSpatialBounds &_a,
+    const ModelSpatialBounds &_b)
+{
+  return _a.min.X() <= _b.max.X() && _a.max.X() >= _b.min.X() &&
+         _a.min.Y() <= _b.max.Y() && _a.max.Y() >= _b.min.Y() &&
+         _a.min.Z() <= _b.max.Z() && _a.max.Z() >= _b.min.Z();
+}
+
+//////////////////////////////////////////////////
+/// \brief Check if bounds contain other bounds.
+/// \param[in] _a The outer bounds.
+/// \param[in] _b The inner bounds.
+/// \return True if _a contains _b.
+static bool Contains(const ModelSpatialBounds &_a,
+    const ModelSpatialBounds &_b)
+{
+  return _a.min.X() <= _b.min.X() && _a.max.X() >= _b.max.X() &&
+         _a.min.Y() <= _b.min.Y() && _a.max.Y() >= _b.max.Y() &&
+         _a.min.Z() <= _b.min.Z() && _a.max.Z() >= _b.max.Z();
+}
+
+//////////////////////////////////////////////////
+/// \brief Check if a bounding box is valid. The bounding box of a model
+/// without collisions is inverted.
+/// \param[in] _box The box.
+/// \return True if the box is valid.
+static bool IsValid(const ignition::math::AxisAlignedBox &_box)
+{
+  return _box.Min().X() <= _box.Max().X() &&
+         _box.Min().Y() <= _box.Max().Y() &&
+         _box.Min().Z() <= _box.Max().Z();
+}
+
+//////////////////////////////////////////////////
+/// \brief Compute the bounds of a model.
+/// \param[in] _box Bounding box of the model.
+/// \param[in] _origin Position of the model.
+/// \return The bounding box, extended to contain the origin.
+static ModelSpatialBounds ModelBounds(
+    const ignition::math::AxisAlignedBox &_box,
+    const ignition::math::Vector3d &_origin)
+{
+  ModelSpatialBounds bounds;
+  bounds.min = _origin;
+  bounds.max = _origin;
+  if (IsValid(_box))
+  {
+    bounds.min.Min(_box.Min());
+    bounds.max.Max(_box.Max());
+  }
+  return bounds;
+}
+
+//////////////////////////////////////////////////
+/// \brief Compute the bounds of a model in the tree.
+/// \param[in] _bounds Bounds of the model.
+/// \param[in] _margin Margin to add.
+/// \return The enlarged and clamped bounds.
+static ModelSpatialBounds TreeBounds(const ModelSpatialBounds &_bounds,
+    const double _margin)
+{
+  const ignition::math::Vector3d margin(_margin, _margin, _margin);
+  const ignition::math::Vector3d limit(kWorldLimit, kWorldLimit, kWorldLimit);
+  ModelSpatialBounds bounds;
+  bounds.min = _bounds.min - margin;
+  bounds.max = _bounds.max + margin;
+  bounds.min.Max(-limit);
+  bounds.min.Min(limit);
+  bounds.max.Max(-limit);
+  bounds.max.Min(limit);
+  return bounds;
+}
+
+//////////////////////////////////////////////////
+int ModelSpatialTree::AllocateNode()
+{
+  int node;
+  if (this->freeList >= 0)
+  {
+    node = this->freeList;
+    this->freeList = this->nodes[node].parent;
+  }
+  else
+  {
+    node = static_cast<int>(this->nodes.size());
+    this->nodes.emplace_back();
+  }
+
+  this->nodes[node] = Node();
+  return node;
+}
+
+//////////////////////////////////////////////////
+void ModelSpatialTree::FreeNode(const int _node)
+{
+  this->nodes[_node].parent = this->freeList;
+  this->nodes[_node].height = -1;
+  this->nodes[_node].entry = nullptr;
+  this->freeList = _node;
+}
+
+//////////////////////////////////////////////////
+int ModelSpatialTree::Insert(ModelSpatialEntry *_entry,
+    const ModelSpatialBounds &_bounds)
+{
+  const int leaf = this->AllocateNode();
+  this->nodes[leaf].bounds = _bounds;
+  this->nodes[leaf].entry = _entry;
+  this->InsertLeaf(leaf);
+  return leaf;
+}
+
+//////////////////////////////////////////////////
+void ModelSpatialTree::Remove(const int _proxy)
+{
+  this->RemoveLeaf(_proxy);
+  this->FreeNode(_proxy);
+}
+
+//////////////////////////////////////////////////
+const ModelSpatialBounds &ModelSpatialTree::Bounds(const int _proxy) const
+{
+  return this->nodes[_proxy].bounds;
+}
+
+//////////////////////////////////////////////////
+int ModelSpatialTree::Height() const
+{
+  return this->root < 0 ? 0 : this->nodes[this->root].height;
+}
+
+//////////////////////////////////////////////////
+void ModelSpatialTree::InsertLeaf(const int _leaf)
+{
+  if (this->root < 0)
+  {
+    this->root = _leaf;
+    this->nodes[_leaf].parent = -1;
+    return;
+  }
+
+  // Find the best sibling, with the surface area heuristic
+  const ModelSpatialBounds leafBounds = this->nodes[_leaf].bounds;
+  int index = this->root;
+  while (this->nodes[index].child1 >= 0)
+  {
+    const Node &node = this->nodes[index];
+    const double area = Area(node.bounds);
+    const double combinedArea = Area(Merge(node.bounds, leafBounds));
+
+    // Cost of creating a new parent for this node and the new leaf
+    const double cost = 2.0 * combinedArea;
+
+    // Minimum cost of pushing the leaf further down the tree
+    const double inheritanceCost = 2.0 * (combinedArea - area);
+
+    double childCost[2];
+    const int children[2] = {node.child1, node.child2};
+    for (int i = 0; i < 2; ++i)
+    {
+      const Node &child = this->nodes[children[i]];
+      const double merged = Area(Merge(child.bounds, leafBounds));
+      childCost[i] = inheritanceCost +
+          (child.child1 < 0 ? merged : merged - Area(child.bounds));
+    }
+
+    if (cost < childCost[0] && cost < childCost[1])
+      break;
+
+    index = childCost[0] < childCost[1] ? children[0] : children[1];
+  }
+  const int sibling = index;
+
+  // Create a new parent
+  const int oldParent = this->nodes[sibling].parent;
+  const int newParent = this->AllocateNode();
+  this->nodes[newParent].parent = oldParent;
+  this->nodes[newParent].bounds =
+      Merge(leafBounds, this->nodes[sibling].bounds);
+  this->nodes[newParent].height = this->nodes[sibling].height + 1;
+  this->nodes[newParent].child1 = sibling;
+  this->nodes[newParent].child2 = _leaf;
+  this->nodes[sibling].parent = newParent;
+  this->nodes[_leaf].parent = newParent;
+
+  if (oldParent >= 0)
+  {
+    if (this->nodes[oldParent].child1 == sibling)
+      this->nodes[oldParent].child1 = newParent;
+    else
+      this->nodes[oldParent].child2 = newParent;
+  }
+  else
+  {
+    this->root = newParent;
+  }
+
+  this->Refit(this->nodes[_leaf].parent);
+}
+
+//////////////////////////////////////////////////
+void ModelSpatialTree::RemoveLeaf(const int _leaf)
+{
+  if (_leaf == this->root)
+  {
+    this->root = -1;
+    return;
+  }
+
+  const int parent = this->nodes[_leaf].parent;
+  const int grandParent = this->nodes[parent].parent;
+  const int sibling = this->nodes[parent].child1 == _leaf ?
+      this->nodes[parent].child2 : this->nodes[parent].child1;
+
+  if (grandParent >= 0)
+  {
+    // Replace the parent with the sibling
+    if (this->nodes[grandParent].child1 == parent)
+      this->nodes[grandParent].child1 = sibling;
+    else
+      this->nodes[grandParent].child2 = sibling;
+    this->nodes[sibling].parent = grandParent;
+    this->FreeNode(parent);
+    this->Refit(grandParent);
+  }
+  else
+  {
+    this->root = sibling;
+    this->nodes[sibling].parent = -1;
+    this->FreeNode(parent);
+  }
+}
+
+//////////////////////////////////////////////////
+void ModelSpatialTree::Refit(int _node)
+{
+  while (_node >= 0)
+  {
+    _node = this->Balance(_node);
+
+    Node &node = this->nodes[_node];
+    const Node &child1 = this->nodes[node.child1];
+    const Node &child2 = this->nodes[node.child2];
+    node.height = 1 + std::max(child1.height, child2.height);
+    node.bounds = Merge(child1.bounds, child2.bounds);
+
+    _node = node.parent;
+  }
+}
+
+//////////////////////////////////////////////////
+int ModelSpatialTree::Balance(const int _a)
+{
+  Node &a = this->nodes[_a];
+  if (a.child1 < 0 || a.height < 2)
+    return _a;
+
+  const int ib = a.child1;
+  const int ic = a.child2;
+  Node &b = this->nodes[ib];
+  Node &c = this->nodes[ic];
+  const int balance = c.height - b.height;
+
+  // Rotate the higher child up
+  if (balance > 1 || balance < -1)
+  {
+    // up is the child moving up, other is the child staying below a
+    const int iUp = balance > 1 ? ic : ib;
+    const int iOther = balance > 1 ? ib : ic;
+    Node &up = this->nodes[iUp];
+    Node &other = this->nodes[iOther];
+    const int iF = up.child1;
+    const int iG = up.child2;
+    Node &f = this->nodes[iF];
+    Node &g = this->nodes[iG];
+
+    // Swap a and up
+    up.child1 = _a;
+    up.parent = a.parent;
+    a.parent = iUp;
+
+    if (up.parent >= 0)
+    {
+      if (this->nodes[up.parent].child1 == _a)
+        this->nodes[up.parent].child1 = iUp;
+      else
+        this->nodes[up.parent].child2 = iUp;
+    }
+    else
+    {
+      this->root = iUp;
+    }
+
+    // The higher grandchild stays below up, the other one goes below a,
+    // in place of up
+    const int iKeep = f.height > g.height ? iF : iG;
+    const int iMove = f.height > g.height ? iG : iF;
+    Node &keep = this->nodes[iKeep];
+    Node &move = this->nodes[iMove];
+
+    up.child2 = iKeep;
+    if (balance > 1)
+      a.child2 = iMove;
+    else
+      a.child1 = iMove;
+    move.parent = _a;
+
+    a.bounds = Merge(other.bounds, move.bounds);
+    a.height = 1 + std::max(other.height, move.height);
+    up.bounds = Merge(a.bounds, keep.bounds);
+    up.height = 1 + std::max(a.height, keep.height);
+
+    return iUp;
+  }
+
+  return _a;
+}
+
+//////////////////////////////////////////////////
+/// \brief Find the models which must be updated, recursively.
+/// \param[in] _data Private data of the index.
+/// \param[in] _model The model.
+/// \param[in,out] _order Position of the model in the traversal.
+/// \param[out] _changes Models whose bounds must be updated.
+static void CollectModel(ModelSpatialIndexPrivate &_data,
+    const ModelPtr &_model, uint32_t &_order,
+    std::vector<ModelSpatialChange> &_changes)
+{
+  if (!_model)
+    return;
+
+  const Link_V &links = _model->GetLinks();
+  auto iter = _data.entries.find(_model->GetId());
+  if (iter == _data.entries.end())
+  {
+    ModelSpatialChange change;
+    change.model = _model;
+    change.box = _model->BoundingBox();
+    change.isStatic = _model->IsStatic();
+    change.order = _order;
+    change.pose = _model->WorldPose();
+    for (auto const &link : links)
+      change.linkPoses.push_back(link->WorldPose());
+    _changes.push_back(change);
+  }
+  else
+  {
+    // The entry is only modified by updates, and the fields read here are
+    // not read by queries, so the lock isn't needed.
+    ModelSpatialEntry &entry = iter->second;
+    entry.stamp = _data.stamp;
+    entry.nextOrder = _order;
+
+    bool moved = entry.pose != _model->WorldPose() ||
+        entry.linkPoses.size() != links.size();
+    for (size_t i = 0; i < links.size() && !moved; ++i)
+      moved = entry.linkPoses[i] != links[i]->WorldPose();
+
+    if (moved)
+    {
+      entry.pose = _model->WorldPose();
+      entry.linkPoses.resize(links.size());
+      for (size_t i = 0; i < links.size(); ++i)
+        entry.linkPoses[i] = links[i]->WorldPose();
+
+      ModelSpatialChange change;
+      change.entry = &entry;
+      change.box = _model->BoundingBox();
+      change.isStatic = _model->IsStatic();
+      _changes.push_back(change);
+    }
+  }
+  ++_order;
+
+  for (auto const &nested : _model->NestedModels())
+    CollectModel(_data, nested, _order, _changes);
+}
+
+//////////////////////////////////////////////////
+ModelSpatialIndex::ModelSpatialIndex(WorldPtr _world)
+  : dataPtr(new ModelSpatialIndexPrivate)
+{
+  this->dataPtr->world = _world;
+}
+
+//////////////////////////////////////////////////
+ModelSpatialIndex::~ModelSpatialIndex()
+{
+  this->Fini();
+}
+
+//////////////////////////////////////////////////
+void ModelSpatialIndex::Fini()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->tree = ModelSpatialTree();
+  this->dataPtr->entries.clear();
+  this->dataPtr->valid = false;
+  this->dataPtr->world.reset();
+}
+
+//////////////////////////////////////////////////
+void ModelSpatialIndex::AddUser()
+{
+  ++this->dataPtr->users;
+}
+
+//////////////////////////////////////////////////
+void ModelSpatialIndex::RemoveUser()
+{
+  unsigned int users = this->dataPtr->users;
+  while (users > 0 &&
+      !this->dataPtr->users.compare_exchange_weak(users, users - 1))
+  {
+  }
+
+  // The index isn't updated anymore without users
+  if (users == 1)
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->valid = false;
+  }
+}
+
+//////////////////////////////////////////////////
+unsigned int ModelSpatialIndex::UserCount() const
+{
+  return this->dataPtr->users;
+}
+
+//////////////////////////////////////////////////
+void ModelSpatialIndex::Update()
+{
+  if (this->dataPtr->users == 0 || !this->dataPtr->world)
+    return;
+
+  ModelSpatialIndexPrivate &data = *this->dataPtr;
+  ++data.stamp;
+
+  // Find the new and moved models, and compute their bounding boxes,
+  // without blocking the queries.
+  std::vector<ModelSpatialChange> changes;
+  uint32_t order = 0;
+  for (auto const &model : data.world->Models())
+    CollectModel(data, model, order, changes);
+
+  std::lock_guard<std::mutex> lock(data.mutex);
+  for (auto &change : changes)
+  {
+    ModelSpatialEntry *entry = change.entry;
+    if (!entry)
+    {
+      entry = &data.entries[change.model->GetId()];
+      entry->model = change.model;
+      entry->pose = change.pose;
+      entry->linkPoses = change.linkPoses;
+      entry->stamp = data.stamp;
+      entry->nextOrder = change.order;
+    }
+
+    entry->box = change.box;
+    entry->isStatic = change.isStatic;
+    entry->bounds = ModelBounds(change.box, entry->pose.Pos());
+
+    const double margin = entry->isStatic ? 0.0 : kMargin;
+    if (entry->proxy < 0)
+    {
+      entry->proxy = data.tree.Insert(entry,
+          TreeBounds(entry->bounds, margin));
+    }
+    else if (!Contains(data.tree.Bounds(entry->proxy),
+          TreeBounds(entry->bounds, 0.0)))
+    {
+      // The model left its enlarged bounds
+      data.tree.Remove(entry->proxy);
+      entry->proxy = data.tree.Insert(entry,
+          TreeBounds(entry->bounds, margin));
+    }
+  }
+
+  // Remove the models which weren't seen, and publish the order
+  for (auto iter = data.entries.begin(); iter != data.entries.end();)
+  {
+    if (iter->second.stamp != data.stamp)
+    {
+      if (iter->second.proxy >= 0)
+        data.tree.Remove(iter->second.proxy);
+      iter = data.entries.erase(iter);
+    }
+    else
+    {
+      iter->second.order = iter->second.nextOrder;
+      ++iter;
+    }
+  }
+
+  data.valid = true;
+}
+
+//////////////////////////////////////////////////
+bool ModelSpatialIndex::ModelsInBox(const ignition::math::AxisAlignedBox &_box,
+    Model_V &_models) const
+{
+  _models.clear();
+
+  ModelSpatialBounds query;
+  query.min = _box.Min();
+  query.max = _box.Max();
+
+  std::vector<std::pair<uint32_t, ModelPtr>> found;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (!this->dataPtr->valid || this->dataPtr->users == 0)
+      return false;
+
+    this->dataPtr->tree.Query(
+        [&](const ModelSpatialBounds &_bounds)
+        {
+          return Overlaps(_bounds, query);
+        },
+        [&](const ModelSpatialEntry &_entry)
+        {
+          if (!Overlaps(_entry.bounds, query))
+            return;
+          ModelPtr model = _entry.model.lock();
+          if (model)
+            found.push_back(std::make_pair(_entry.order, model));
+        });
+  }
+
+  std::sort(found.begin(), found.end(),
+      [](const std::pair<uint32_t, ModelPtr> &_a,
+         const std::pair<uint32_t, ModelPtr> &_b)
+      {
+        return _a.first < _b.first;
+      });
+  for (auto const &item : found)
+    _models.push_back(item.second);
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool ModelSpatialIndex::ModelsInFrustum(
+    const ignition::math::Frustum &_frustum, Model_V &_models) const
+{
+  _models.clear();
+
+  std::vector<std::pair<uint32_t, ModelPtr>> found;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (!this->dataPtr->valid || this->dataPtr->users == 0)
+      return false;
+
+    // Frustum::Contains is conservative: it only rejects boxes which are
+    // entirely outside one of the planes, so it can prune the tree.
+    this->dataPtr->tree.Query(
+        [&](const ModelSpatialBounds &_bounds)
+        {
+          return _frustum.Contains(
+              ignition::math::AxisAlignedBox(_bounds.min, _bounds.max));
+        },
+        [&](const ModelSpatialEntry &_entry)
+        {
+          if (!IsValid(_entry.box) || !_frustum.Contains(_entry.box))
+            return;
+          ModelPtr model = _entry.model.lock();
+          if (model)
+            found.push_back(std::make_pair(_entry.order, model));
+        });
+  }
+
+  std::sort(found.begin(), found.end(),
+      [](const std::pair<uint32_t, ModelPtr> &_a,
+         const std::pair<uint32_t, ModelPtr> &_b)
+      {
+        return _a.first < _b.first;
+      });
+  for (auto const &item : found)
+    _models.push_back(item.second);
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+unsigned int ModelSpatialIndex::ModelCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->entries.size();
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_MODELSPATIALINDEX_HH_
+#define GAZEBO_PHYSICS_MODELSPATIALINDEX_HH_
+
+#include <memory>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Frustum.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class
+    class ModelSpatialIndexPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class ModelSpatialIndex ModelSpatialIndex.hh physics/physics.hh
+    /// \brief Spatial index of the bounding boxes of the models of a world,
+    /// nested models included, for region and frustum queries.
+    ///
+    /// While at least one user is registered, the index is updated after
+    /// every physics update. Only the models which moved, or whose links
+    /// moved, have their bounding box computed again, and a model only
+    /// moves in the index once it leaves the enlarged bounds it was
+    /// inserted with. Queries can be called from any thread, and see the
+    /// models as they were after the last update.
+    ///
+    /// The bounds of a model are its bounding box, extended to contain the
+    /// origin of the model, so that the index can also find models by
+    /// their position.
+    class GZ_PHYSICS_VISIBLE ModelSpatialIndex
+    {
+      /// \brief Constructor.
+      /// \param[in] _world Pointer to the world.
+      public: explicit ModelSpatialIndex(WorldPtr _world);
+
+      /// \brief Destructor.
+      public: virtual ~ModelSpatialIndex();
+
+      /// \brief Release the world and the models.
+      public: void Fini();
+
+      /// \brief Register a user. The index is only updated while there is
+      /// at least one user.
+      public: void AddUser();
+
+      /// \brief Unregister a user added with AddUser.
+      public: void RemoveUser();
+
+      /// \brief Get the number of registered users.
+      /// \return Number of users.
+      public: unsigned int UserCount() const;
+
+      /// \brief Update the index, if there are users. This is called by
+      /// World::Update after the physics update.
+      public: void Update();
+
+      /// \brief Get the models whose bounds intersect a box.
+      /// \param[in] _box The box, in world coordinates.
+      /// \param[out] _models The models, in the order of a depth first
+      /// traversal of World::Models.
+      /// \return False if the index isn't up to date, because it has no
+      /// users or wasn't updated since the first user was added. _models is
+      /// not valid in that case.
+      public: bool ModelsInBox(const ignition::math::AxisAlignedBox &_box,
+                  Model_V &_models) const;
+
+      /// \brief Get the models whose bounding box intersects a frustum, as
+      /// tested by ignition::math::Frustum::Contains.
+      /// \param[in] _frustum The frustum, in world coordinates.
+      /// \param[out] _models The models, in the order of a depth first
+      /// traversal of World::Models.
+      /// \return False if the index isn't up to date, see ModelsInBox.
+      public: bool ModelsInFrustum(const ignition::math::Frustum &_frustum,
+                  Model_V &_models) const;
+
+      /// \brief Get the number of models in the index.
+      /// \return Number of models.
+      public: unsigned int ModelCount() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ModelSpatialIndexPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_MODELSPATIALINDEXPRIVATE_HH_
+#define GAZEBO_PHYSICS_MODELSPATIALINDEXPRIVATE_HH_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/weak_ptr.hpp>
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Axis aligned bounds in a ModelSpatialTree.
+    class ModelSpatialBounds
+    {
+      /// \brief Minimum corner.
+      public: ignition::math::Vector3d min;
+
+      /// \brief Maximum corner.
+      public: ignition::math::Vector3d max;
+    };
+
+    /// \internal
+    /// \brief A model known to a ModelSpatialIndex.
+    class ModelSpatialEntry
+    {
+      /// \brief The model.
+      public: boost::weak_ptr<Model> model;
+
+      /// \brief Bounding box of the model, as returned by
+      /// Model::BoundingBox.
+      public: ignition::math::AxisAlignedBox box;
+
+      /// \brief Bounding box of the model, extended to contain the origin
+      /// of the model.
+      public: ModelSpatialBounds bounds;
+
+      /// \brief Position of the model in a depth first traversal of the
+      /// world, used to sort query results.
+      public: uint32_t order = 0;
+
+      /// \brief Leaf of the entry in the tree, -1 if it isn't inserted.
+      public: int proxy = -1;
+
+      /// \brief True if the model is static, in which case its bounds are
+      /// not enlarged in the tree.
+      public: bool isStatic = false;
+
+      /// \brief World poses of the links of the model when its bounds were
+      /// computed, used to detect motion. Only accessed by Update.
+      public: std::vector<ignition::math::Pose3d> linkPoses;
+
+      /// \brief World pose of the model when its bounds were computed. Only
+      /// accessed by Update.
+      public: ignition::math::Pose3d pose;
+
+      /// \brief Value of ModelSpatialIndexPrivate::stamp when the model was
+      /// last seen. Only accessed by Update.
+      public: uint64_t stamp = 0;
+
+      /// \brief Value of order found by the running update. Only accessed
+      /// by Update.
+      public: uint32_t nextOrder = 0;
+    };
+
+    /// \internal
+    /// \brief Dynamic bounding volume tree of ModelSpatialEntry objects.
+    /// Leaves hold enlarged bounds, so that small motions don't require to
+    /// update the tree. The tree is kept balanced with rotations.
+    class ModelSpatialTree
+    {
+      /// \brief A node of the tree.
+      public: class Node
+      {
+        /// \brief Bounds of the node. For a leaf, the enlarged bounds of
+        /// its entry.
+        public: ModelSpatialBounds bounds;
+
+        /// \brief Parent node, -1 for the root. Next free node for a node
+        /// in the free list.
+        public: int parent = -1;
+
+        /// \brief First child, -1 for a leaf.
+        public: int child1 = -1;
+
+        /// \brief Second child, -1 for a leaf.
+        public: int child2 = -1;
+
+        /// \brief Height of the node, 0 for a leaf, -1 for a free node.
+        public: int height = 0;
+
+        /// \brief Entry of a leaf.
+        public: ModelSpatialEntry *entry = nullptr;
+      };
+
+      /// \brief Insert an entry.
+      /// \param[in] _entry The entry.
+      /// \param[in] _bounds Enlarged bounds of the entry.
+      /// \return The leaf of the entry.
+      public: int Insert(ModelSpatialEntry *_entry,
+                  const ModelSpatialBounds &_bounds);
+
+      /// \brief Remove a leaf.
+      /// \param[in] _proxy The leaf.
+      public: void Remove(const int _proxy);
+
+      /// \brief Visit the leaves whose bounds are accepted by a test.
+      /// \param[in] _test Function returning true if a node's bounds may
+      /// contain results.
+      /// \param[in] _visit Function called with the entry of every accepted
+      /// leaf.
+      public: template<typename Test, typename Visit>
+              void Query(const Test &_test, const Visit &_visit) const
+      {
+        if (this->root < 0)
+          return;
+
+        std::vector<int> &stack = this->stack;
+        stack.clear();
+        stack.push_back(this->root);
+        while (!stack.empty())
+        {
+          const Node &node = this->nodes[stack.back()];
+          stack.pop_back();
+          if (!_test(node.bounds))
+            continue;
+
+          if (node.child1 < 0)
+          {
+            _visit(*node.entry);
+          }
+          else
+          {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+          }
+        }
+      }
+
+      /// \brief Get the bounds of a leaf.
+      /// \param[in] _proxy The leaf.
+      /// \return The enlarged bounds of the leaf.
+      public: const ModelSpatialBounds &Bounds(const int _proxy) const;
+
+      /// \brief Get the height of the tree.
+      /// \return The height, 0 for an empty tree or a single leaf.
+      public: int Height() const;
+
+      /// \brief Allocate a node.
+      /// \return The node.
+      private: int AllocateNode();
+
+      /// \brief Return a node to the free list.
+      /// \param[in] _node The node.
+      private: void FreeNode(const int _node);
+
+      /// \brief Insert a leaf in the tree.
+      /// \param[in] _leaf The leaf.
+      private: void InsertLeaf(const int _leaf);
+
+      /// \brief Detach a leaf from the tree.
+      /// \param[in] _leaf The leaf.
+      private: void RemoveLeaf(const int _leaf);
+
+      /// \brief Fix the bounds and heights from a node to the root,
+      /// balancing the tree on the way.
+      /// \param[in] _node The first node.
+      private: void Refit(int _node);
+
+      /// \brief Rotate a node if its children are unbalanced.
+      /// \param[in] _a The node.
+      /// \return The node which replaced _a.
+      private: int Balance(const int _a);
+
+      /// \brief All the nodes.
+      private: std::vector<Node> nodes;
+
+      /// \brief Root of the tree, -1 if it is empty.
+      private: int root = -1;
+
+      /// \brief First node of the free list, -1 if it is empty.
+      private: int freeList = -1;
+
+      /// \brief Traversal stack of Query, kept to avoid allocations. Queries
+      /// are serialized by ModelSpatialIndexPrivate::mutex.
+      private: mutable std::vector<int> stack;
+    };
+
+    /// \internal
+    /// \brief Private data for the ModelSpatialIndex class.
+    class ModelSpatialIndexPrivate
+    {
+      /// \brief The world.
+      public: WorldPtr world;
+
+      /// \brief Number of users.
+      public: std::atomic<unsigned int> users{0};
+
+      /// \brief Protects the tree and the entries read by queries.
+      public: mutable std::mutex mutex;
+
+      /// \brief Tree of the entries.
+      public: ModelSpatialTree tree;
+
+      /// \brief Entries, indexed by model id. Elements of an unordered map
+      /// are never moved, so the tree can point to them.
+      public: std::unordered_map<uint32_t, ModelSpatialEntry> entries;
+
+      /// \brief Incremented by every update.
+      public: uint64_t stamp = 0;
+
+      /// \brief True once an update has been done since the first user was
+      /// added.
+      public: bool valid = false;
+    };
+  }
+}
+#endif
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <string>
+
+#include <ignition/math/Frustum.hh>
+
+#include "gazebo/test/ServerFixture.hh"
+#include "test/util.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/ModelSpatialIndex.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/World.hh"
+
+using namespace gazebo;
+
+class ModelSpatialIndexTest : public ServerFixture { };
+
+//////////////////////////////////////////////////
+/// \brief Helper to check if a model is in a list.
+/// \param[in] _models The list.
+/// \param[in] _name Name of the model.
+/// \return True if the model was found.
+bool HasModel(const physics::Model_V &_models, const std::string &_name)
+{
+  return std::find_if(_models.begin(), _models.end(),
+      [&](const physics::ModelPtr &_model)
+      {
+        return _model->GetName() == _name;
+      }) != _models.end();
+}
+
+//////////////////////////////////////////////////
+TEST_F(ModelSpatialIndexTest, Queries)
+{
+  this->Load("worlds/shapes.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::ModelSpatialIndexPtr index = world->SpatialIndex();
+  ASSERT_TRUE(index != nullptr);
+  EXPECT_EQ(index->UserCount(), 0u);
+
+  // The index isn't updated without users
+  const ignition::math::AxisAlignedBox center(
+      ignition::math::Vector3d(-0.2, -0.2, 0.2),
+      ignition::math::Vector3d(0.2, 0.2, 0.8));
+  physics::Model_V models;
+  index->Update();
+  EXPECT_FALSE(index->ModelsInBox(center, models));
+  EXPECT_EQ(index->ModelCount(), 0u);
+
+  // World::ModelsInBox tests every model instead
+  const physics::Model_V expected = world->ModelsInBox(center);
+  EXPECT_TRUE(HasModel(expected, "box"));
+  EXPECT_FALSE(HasModel(expected, "sphere"));
+  EXPECT_FALSE(HasModel(expected, "cylinder"));
+
+  index->AddUser();
+  EXPECT_EQ(index->UserCount(), 1u);
+  world->Step(1);
+  EXPECT_EQ(index->ModelCount(), world->ModelCount());
+
+  // Same result with the index
+  ASSERT_TRUE(index->ModelsInBox(center, models));
+  ASSERT_EQ(models.size(), expected.size());
+  for (size_t i = 0; i < models.size(); ++i)
+    EXPECT_EQ(models[i], expected[i]);
+  EXPECT_EQ(world->ModelsInBox(center), models);
+
+  // The index follows the models after a step
+  physics::ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+  box->SetWorldPose(ignition::math::Pose3d(5, 0, 0.5, 0, 0, 0));
+  world->Step(1);
+  ASSERT_TRUE(index->ModelsInBox(center, models));
+  EXPECT_FALSE(HasModel(models, "box"));
+
+  const ignition::math::AxisAlignedBox moved(
+      ignition::math::Vector3d(4.8, -0.2, 0.2),
+      ignition::math::Vector3d(5.2, 0.2, 0.8));
+  ASSERT_TRUE(index->ModelsInBox(moved, models));
+  EXPECT_TRUE(HasModel(models, "box"));
+
+  // Frustum at (2, 0, 0.5) looking along X, which only sees the box
+  ignition::math::Frustum frustum;
+  frustum.SetNear(0.1);
+  frustum.SetFar(10);
+  frustum.SetFOV(0.5);
+  frustum.SetAspectRatio(1.0);
+  frustum.SetPose(ignition::math::Pose3d(2, 0, 0.5, 0, 0, 0));
+  ASSERT_TRUE(index->ModelsInFrustum(frustum, models));
+  EXPECT_TRUE(HasModel(models, "box"));
+  EXPECT_FALSE(HasModel(models, "sphere"));
+  EXPECT_FALSE(HasModel(models, "cylinder"));
+
+  // Removed models leave the index
+  world->RemoveModel("sphere");
+  world->Step(1);
+  EXPECT_EQ(index->ModelCount(), world->ModelCount());
+
+  const ignition::math::AxisAlignedBox side(
+      ignition::math::Vector3d(-0.2, 1.3, 0.2),
+      ignition::math::Vector3d(0.2, 1.7, 0.8));
+  ASSERT_TRUE(index->ModelsInBox(side, models));
+  EXPECT_FALSE(HasModel(models, "sphere"));
+
+  // The index is released with the last user
+  index->RemoveUser();
+  EXPECT_EQ(index->UserCount(), 0u);
+  EXPECT_FALSE(index->ModelsInBox(center, models));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -285,6 +285,9 @@ namespace gazebo
         return _out;
       }
 
+      /// \brief WorldStateSnapshot fills states directly.
+      friend class WorldStateSnapshot;
+
       /// \brief Pose of the model.
       private: ignition::math::Pose3d pose;
 
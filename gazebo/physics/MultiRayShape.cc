@@ -17,6 +17,7 @@
 #include "gazebo/common/Exception.hh"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/MultiRayShape.hh"
+#include "gazebo/physics/World.hh"
 
 using namespace gazebo;
 using namespace physics;
@@ -38,9 +39,23 @@ MultiRayShape::MultiRayShape(PhysicsEnginePtr /*_physicsEngine*/)
 //////////////////////////////////////////////////
 MultiRayShape::~MultiRayShape()
 {
+  if (this->rayQueryManager)
+    this->rayQueryManager->RemoveUser();
   this->rays.clear();
 }
 
+//////////////////////////////////////////////////
+void MultiRayShape::Fini()
+{
+  if (this->rayQueryManager)
+  {
+    this->rayQueryManager->RemoveUser();
+    this->rayQueryManager.reset();
+  }
+
+  Shape::Fini();
+}
+
 //////////////////////////////////////////////////
 void MultiRayShape::Init()
 {
@@ -105,6 +120,13 @@ void MultiRayShape::Init()
       this->AddRay(start, end);
     }
   }
+
+  // Ask the world to capture snapshots for lock-free ray queries
+  if (!this->rayQueryManager && this->world && this->world->RayQueryMgr())
+  {
+    this->rayQueryManager = this->world->RayQueryMgr();
+    this->rayQueryManager->AddUser();
+  }
 }
 
 //////////////////////////////////////////////////
@@ -182,8 +204,40 @@ void MultiRayShape::Update()
     this->rays[i]->Update();
   }
 
-  // do actual collision checks
-  this->UpdateRays();
+  // Intersect the rays with the last snapshot of the world, without
+  // locking the physics engine
+  bool intersected = false;
+  if (this->rayQueryManager)
+  {
+    this->rayQueries.resize(raySize);
+    for (unsigned int i = 0; i < raySize; ++i)
+    {
+      this->rays[i]->GlobalPoints(this->rayQueries[i].start,
+          this->rayQueries[i].end);
+    }
+
+    intersected = this->rayQueryManager->Intersect(this->rayQueries,
+        this->rayResults);
+  }
+
+  if (intersected)
+  {
+    for (unsigned int i = 0; i < raySize; ++i)
+    {
+      const RayQueryResult &result = this->rayResults[i];
+      if (result.hit)
+      {
+        this->rays[i]->SetLength(result.distance);
+        this->rays[i]->SetRetro(result.retro);
+      }
+      this->rays[i]->SetCollisionName(result.collisionName);
+    }
+  }
+  else
+  {
+    // do actual collision checks
+    this->UpdateRays();
+  }
 
   // for plugin
   this->newLaserScans();
@@ -22,6 +22,7 @@
 #include <ignition/math/Angle.hh>
 
 #include "gazebo/physics/Collision.hh"
+#include "gazebo/physics/RayQueryManager.hh"
 #include "gazebo/physics/Shape.hh"
 #include "gazebo/physics/RayShape.hh"
 #include "gazebo/util/system.hh"
@@ -58,6 +59,9 @@ namespace gazebo
       /// \brief Destructor.
       public: virtual ~MultiRayShape();
 
+      // Documentation inherited.
+      public: virtual void Fini();
+
       /// \brief Init the shape.
       public: virtual void Init();
 
@@ -124,7 +128,9 @@ namespace gazebo
       /// \return Vertical max angle.
       public: ignition::math::Angle VerticalMaxAngle() const;
 
-      /// \brief Update the ray collisions.
+      /// \brief Update the ray collisions. The rays are intersected with
+      /// the snapshot of the world's RayQueryManager when possible, without
+      /// locking the physics engine, and with UpdateRays otherwise.
       public: void Update();
 
       /// \TODO This function is not implemented.
@@ -208,6 +214,16 @@ namespace gazebo
 
       /// \brief Max range of a ray
       private: double maxRange = 1000;
+
+      /// \brief Manager used for lock-free ray queries, set if this shape
+      /// is registered as one of its users.
+      private: RayQueryManagerPtr rayQueryManager;
+
+      /// \brief Ray queries, reused by every update.
+      private: std::vector<RayQuery> rayQueries;
+
+      /// \brief Results of the ray queries, reused by every update.
+      private: std::vector<RayQueryResult> rayResults;
     };
     /// \}
   }
@@ -243,6 +243,14 @@ bool PhysicsEngine::SetParam(const std::string &_key,
       this->world->SetMagneticField(
           any_cast<ignition::math::Vector3d>(copy));
     }
+    else if (_key == "model_update_mode")
+    {
+      return this->world->SetModelUpdateMode(any_cast<std::string>(_value));
+    }
+    else if (_key == "model_update_threads")
+    {
+      this->world->SetModelUpdateThreads(any_cast<unsigned int>(_value));
+    }
     else
     {
       gzwarn << "SetParam failed for [" << _key << "] in physics engine "
@@ -295,6 +303,10 @@ bool PhysicsEngine::GetParam(const std::string &_key,
     _value = this->world->Gravity();
   else if (_key == "magnetic_field")
     _value = this->world->MagneticField();
+  else if (_key == "model_update_mode")
+    _value = this->world->ModelUpdateMode();
+  else if (_key == "model_update_threads")
+    _value = this->world->ModelUpdateThreads();
   else
   {
     gzwarn << "GetParam failed for [" << _key << "] in physics engine "
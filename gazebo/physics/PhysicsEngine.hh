@@ -215,6 +215,11 @@ namespace gazebo
       ///          (defined but not used in ode).
       ///       -# "max_step_size" (double) - maximum physics step size when
       ///          physics update step must return.
+      ///       -# "model_update_mode" (string) - how models are updated
+      ///          each step: "serial", "parallel" or "deterministic".
+      ///          See World::SetModelUpdateMode.
+      ///       -# "model_update_threads" (unsigned int) - number of threads
+      ///          used by the parallel model update modes, 0 for automatic.
       ///
       /// \param[in] _value The value to set to
       /// \return true if SetParam is successful, false if operation fails.
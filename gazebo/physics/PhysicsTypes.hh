@@ -38,6 +38,7 @@ namespace gazebo
     class Entity;
     class World;
     class Model;
+    class ModelSpatialIndex;
     class Actor;
     class Light;
     class Link;
@@ -48,6 +49,7 @@ namespace gazebo
     class JointController;
     class Contact;
     class PresetManager;
+    class RayQueryManager;
     class UserCmd;
     class UserCmdManager;
     class PhysicsEngine;
@@ -125,10 +127,18 @@ namespace gazebo
     /// \brief Boost shared pointer to a PhysicsEngine object
     typedef boost::shared_ptr<PhysicsEngine> PhysicsEnginePtr;
 
+    /// \def  ModelSpatialIndexPtr
+    /// \brief Shared pointer to a ModelSpatialIndex object
+    typedef boost::shared_ptr<ModelSpatialIndex> ModelSpatialIndexPtr;
+
     /// \def  PresetManagerPtr
     /// \brief Shared pointer to a PresetManager object
     typedef boost::shared_ptr<PresetManager> PresetManagerPtr;
 
+    /// \def  RayQueryManagerPtr
+    /// \brief Shared pointer to a RayQueryManager object
+    typedef boost::shared_ptr<RayQueryManager> RayQueryManagerPtr;
+
     /// \def  UserCmdPtr
     /// \brief Shared pointer to a UserCmd object
     typedef std::shared_ptr<UserCmd> UserCmdPtr;
@@ -0,0 +1,898 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <limits>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Matrix3.hh>
+
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/physics/BoxShape.hh"
+#include "gazebo/physics/Collision.hh"
+#include "gazebo/physics/CylinderShape.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/MeshShape.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/PlaneShape.hh"
+#include "gazebo/physics/SphereShape.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/RayQueryManagerPrivate.hh"
+#include "gazebo/physics/RayQueryManager.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief Maximum number of items in a leaf of a RayQueryBVH.
+static const uint32_t kLeafSize = 4;
+
+/// \brief Maximum depth of a RayQueryBVH traversal stack.
+static const int kStackSize = 64;
+
+/// \brief Direction components and determinants below this value are
+/// treated as zero.
+static const double kEpsilon = 1e-12;
+
+//////////////////////////////////////////////////
+/// \brief Grow bounds to include other bounds.
+/// \param[in,out] _bounds Bounds to grow.
+/// \param[in] _other Bounds to include.
+static void Merge(RayQueryBounds &_bounds, const RayQueryBounds &_other)
+{
+  _bounds.min.Min(_other.min);
+  _bounds.max.Max(_other.max);
+}
+
+//////////////////////////////////////////////////
+/// \brief Empty bounds, which any Merge replaces.
+/// \return The bounds.
+static RayQueryBounds EmptyBounds()
+{
+  const double inf = std::numeric_limits<double>::infinity();
+  RayQueryBounds bounds;
+  bounds.min.Set(inf, inf, inf);
+  bounds.max.Set(-inf, -inf, -inf);
+  return bounds;
+}
+
+//////////////////////////////////////////////////
+/// \brief Bounds of a box with the given center and half extents, rotated.
+/// \param[in] _pose Pose of the center of the box.
+/// \param[in] _center Center of the box in the frame of the pose.
+/// \param[in] _half Half extents of the box.
+/// \return World bounds.
+static RayQueryBounds RotatedBounds(const ignition::math::Pose3d &_pose,
+    const ignition::math::Vector3d &_center,
+    const ignition::math::Vector3d &_half)
+{
+  ignition::math::Matrix3d rot(_pose.Rot());
+  ignition::math::Vector3d extent;
+  for (int i = 0; i < 3; ++i)
+  {
+    extent[i] = std::abs(rot(i, 0)) * _half.X() +
+                std::abs(rot(i, 1)) * _half.Y() +
+                std::abs(rot(i, 2)) * _half.Z();
+  }
+
+  ignition::math::Vector3d center = _pose.CoordPositionAdd(_center);
+  RayQueryBounds bounds;
+  bounds.min = center - extent;
+  bounds.max = center + extent;
+  return bounds;
+}
+
+//////////////////////////////////////////////////
+/// \brief Inverse of a direction, with zero components replaced by a tiny
+/// value of the same sign, to keep slab tests free of NaNs.
+/// \param[in] _dir Direction.
+/// \return Component-wise inverse.
+static ignition::math::Vector3d InverseDir(
+    const ignition::math::Vector3d &_dir)
+{
+  ignition::math::Vector3d inv;
+  for (int i = 0; i < 3; ++i)
+  {
+    const double d = std::abs(_dir[i]) < kEpsilon ?
+        std::copysign(kEpsilon, _dir[i]) : _dir[i];
+    inv[i] = 1.0 / d;
+  }
+  return inv;
+}
+
+//////////////////////////////////////////////////
+/// \brief Check whether a ray segment overlaps bounds.
+/// \param[in] _bounds Bounds to test.
+/// \param[in] _origin Origin of the ray.
+/// \param[in] _invDir Inverse of the direction of the ray.
+/// \param[in] _maxDist Length of the segment.
+/// \return True if the segment overlaps the bounds.
+static bool OverlapsBounds(const RayQueryBounds &_bounds,
+    const ignition::math::Vector3d &_origin,
+    const ignition::math::Vector3d &_invDir, const double _maxDist)
+{
+  double tmin = 0;
+  double tmax = _maxDist;
+  for (int i = 0; i < 3; ++i)
+  {
+    const double t1 = (_bounds.min[i] - _origin[i]) * _invDir[i];
+    const double t2 = (_bounds.max[i] - _origin[i]) * _invDir[i];
+    tmin = std::max(tmin, std::min(t1, t2));
+    tmax = std::min(tmax, std::max(t1, t2));
+  }
+  return tmin <= tmax;
+}
+
+//////////////////////////////////////////////////
+/// \brief Visit the items of a hierarchy whose leaf overlaps a ray
+/// segment.
+/// \param[in] _bvh Hierarchy.
+/// \param[in] _origin Origin of the ray.
+/// \param[in] _invDir Inverse of the direction of the ray.
+/// \param[in] _maxDist Length of the segment, which the visitor may
+/// shorten as closer hits are found.
+/// \param[in] _visit Function called with each item. Returning false stops
+/// the traversal.
+/// \return False if the traversal was stopped.
+template<typename Visitor>
+static bool Traverse(const RayQueryBVH &_bvh,
+    const ignition::math::Vector3d &_origin,
+    const ignition::math::Vector3d &_invDir, const double &_maxDist,
+    Visitor _visit)
+{
+  if (_bvh.nodes.empty())
+    return true;
+
+  uint32_t stack[kStackSize];
+  int top = 0;
+  stack[top++] = 0;
+
+  while (top > 0)
+  {
+    const uint32_t index = stack[--top];
+    const RayQueryBVH::Node &node = _bvh.nodes[index];
+    if (!OverlapsBounds(node.bounds, _origin, _invDir, _maxDist))
+      continue;
+
+    if (node.count > 0)
+    {
+      for (uint32_t i = node.first; i < node.first + node.count; ++i)
+      {
+        if (!_visit(_bvh.items[i]))
+          return false;
+      }
+    }
+    else
+    {
+      stack[top++] = node.first;
+      stack[top++] = index + 1;
+    }
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Build a node of a hierarchy, and the nodes below it.
+/// \param[in,out] _bvh Hierarchy being built.
+/// \param[in] _bounds Bounds of every item.
+/// \param[in] _centers Center of every item.
+/// \param[in] _begin First item of the node in _bvh.items.
+/// \param[in] _end One past the last item of the node in _bvh.items.
+static void BuildNode(RayQueryBVH &_bvh,
+    const std::vector<RayQueryBounds> &_bounds,
+    const std::vector<ignition::math::Vector3d> &_centers,
+    const uint32_t _begin, const uint32_t _end)
+{
+  const uint32_t index = _bvh.nodes.size();
+  _bvh.nodes.emplace_back();
+
+  RayQueryBounds bounds = EmptyBounds();
+  RayQueryBounds centerBounds = EmptyBounds();
+  for (uint32_t i = _begin; i < _end; ++i)
+  {
+    const uint32_t item = _bvh.items[i];
+    Merge(bounds, _bounds[item]);
+    centerBounds.min.Min(_centers[item]);
+    centerBounds.max.Max(_centers[item]);
+  }
+  _bvh.nodes[index].bounds = bounds;
+
+  // Split along the axis with the largest spread of centers
+  const ignition::math::Vector3d spread = centerBounds.max - centerBounds.min;
+  int axis = 0;
+  if (spread.Y() > spread[axis])
+    axis = 1;
+  if (spread.Z() > spread[axis])
+    axis = 2;
+
+  if (_end - _begin <= kLeafSize || spread[axis] <= 0)
+  {
+    _bvh.nodes[index].first = _begin;
+    _bvh.nodes[index].count = _end - _begin;
+    return;
+  }
+
+  const uint32_t middle = _begin + (_end - _begin) / 2;
+  std::nth_element(_bvh.items.begin() + _begin, _bvh.items.begin() + middle,
+      _bvh.items.begin() + _end,
+      [&](const uint32_t _a, const uint32_t _b)
+      {
+        return _centers[_a][axis] < _centers[_b][axis];
+      });
+
+  BuildNode(_bvh, _bounds, _centers, _begin, middle);
+  _bvh.nodes[index].first = _bvh.nodes.size();
+  BuildNode(_bvh, _bounds, _centers, middle, _end);
+}
+
+//////////////////////////////////////////////////
+void RayQueryBVH::Build(const std::vector<RayQueryBounds> &_bounds)
+{
+  this->nodes.clear();
+  this->items.resize(_bounds.size());
+  if (_bounds.empty())
+    return;
+
+  std::vector<ignition::math::Vector3d> centers(_bounds.size());
+  for (uint32_t i = 0; i < _bounds.size(); ++i)
+  {
+    this->items[i] = i;
+    centers[i] = (_bounds[i].min + _bounds[i].max) * 0.5;
+  }
+
+  BuildNode(*this, _bounds, centers, 0, _bounds.size());
+}
+
+//////////////////////////////////////////////////
+/// \brief Intersect a ray with a box centered at the origin.
+/// \param[in] _half Half extents of the box.
+/// \param[in] _origin Origin of the ray.
+/// \param[in] _dir Unit direction of the ray.
+/// \param[out] _dist Distance to the closest crossing of the surface ahead
+/// of the origin.
+/// \return True if the ray crosses the surface.
+static bool IntersectBox(const ignition::math::Vector3d &_half,
+    const ignition::math::Vector3d &_origin,
+    const ignition::math::Vector3d &_dir, double &_dist)
+{
+  double tmin = -std::numeric_limits<double>::infinity();
+  double tmax = std::numeric_limits<double>::infinity();
+  for (int i = 0; i < 3; ++i)
+  {
+    if (std::abs(_dir[i]) < kEpsilon)
+    {
+      if (std::abs(_origin[i]) > _half[i])
+        return false;
+      continue;
+    }
+
+    const double t1 = (-_half[i] - _origin[i]) / _dir[i];
+    const double t2 = (_half[i] - _origin[i]) / _dir[i];
+    tmin = std::max(tmin, std::min(t1, t2));
+    tmax = std::min(tmax, std::max(t1, t2));
+  }
+
+  if (tmin > tmax || tmax < 0)
+    return false;
+
+  _dist = tmin >= 0 ? tmin : tmax;
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Intersect a ray with a sphere centered at the origin.
+/// \param[in] _radius Radius of the sphere.
+/// \param[in] _origin Origin of the ray.
+/// \param[in] _dir Unit direction of the ray.
+/// \param[out] _dist Distance to the closest crossing of the surface ahead
+/// of the origin.
+/// \return True if the ray crosses the surface.
+static bool IntersectSphere(const double _radius,
+    const ignition::math::Vector3d &_origin,
+    const ignition::math::Vector3d &_dir, double &_dist)
+{
+  const double b = _origin.Dot(_dir);
+  const double c = _origin.SquaredLength() - _radius * _radius;
+  const double disc = b * b - c;
+  if (disc < 0)
+    return false;
+
+  const double s = std::sqrt(disc);
+  if (-b + s < 0)
+    return false;
+
+  _dist = -b - s >= 0 ? -b - s : -b + s;
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Intersect a ray with a cylinder centered at the origin, along
+/// the Z axis.
+/// \param[in] _radius Radius of the cylinder.
+/// \param[in] _length Length of the cylinder.
+/// \param[in] _origin Origin of the ray.
+/// \param[in] _dir Unit direction of the ray.
+/// \param[out] _dist Distance to the closest crossing of the surface ahead
+/// of the origin.
+/// \return True if the ray crosses the surface.
+static bool IntersectCylinder(const double _radius, const double _length,
+    const ignition::math::Vector3d &_origin,
+    const ignition::math::Vector3d &_dir, double &_dist)
+{
+  const double halfLength = _length * 0.5;
+  const double radius2 = _radius * _radius;
+  double best = std::numeric_limits<double>::infinity();
+
+  // Side
+  const double a = _dir.X() * _dir.X() + _dir.Y() * _dir.Y();
+  if (a > kEpsilon)
+  {
+    const double b = _origin.X() * _dir.X() + _origin.Y() * _dir.Y();
+    const double c = _origin.X() * _origin.X() + _origin.Y() * _origin.Y() -
+        radius2;
+    const double disc = b * b - a * c;
+    if (disc >= 0)
+    {
+      const double s = std::sqrt(disc);
+      for (const double t : {(-b - s) / a, (-b + s) / a})
+      {
+        if (t >= 0 && t < best &&
+            std::abs(_origin.Z() + t * _dir.Z()) <= halfLength)
+        {
+          best = t;
+        }
+      }
+    }
+  }
+
+  // Caps
+  if (std::abs(_dir.Z()) > kEpsilon)
+  {
+    for (const double z : {-halfLength, halfLength})
+    {
+      const double t = (z - _origin.Z()) / _dir.Z();
+      const double x = _origin.X() + t * _dir.X();
+      const double y = _origin.Y() + t * _dir.Y();
+      if (t >= 0 && t < best && x * x + y * y <= radius2)
+        best = t;
+    }
+  }
+
+  if (std::isinf(best))
+    return false;
+
+  _dist = best;
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Intersect a ray with a triangle, from either side.
+/// \param[in] _v0 First vertex.
+/// \param[in] _v1 Second vertex.
+/// \param[in] _v2 Third vertex.
+/// \param[in] _origin Origin of the ray.
+/// \param[in] _dir Unit direction of the ray.
+/// \param[out] _dist Distance to the triangle.
+/// \return True if the ray hits the triangle ahead of the origin.
+static bool IntersectTriangle(const ignition::math::Vector3d &_v0,
+    const ignition::math::Vector3d &_v1,
+    const ignition::math::Vector3d &_v2,
+    const ignition::math::Vector3d &_origin,
+    const ignition::math::Vector3d &_dir, double &_dist)
+{
+  const ignition::math::Vector3d e1 = _v1 - _v0;
+  const ignition::math::Vector3d e2 = _v2 - _v0;
+  const ignition::math::Vector3d p = _dir.Cross(e2);
+  const double det = e1.Dot(p);
+  if (std::abs(det) < kEpsilon)
+    return false;
+
+  const double invDet = 1.0 / det;
+  const ignition::math::Vector3d s = _origin - _v0;
+  const double u = s.Dot(p) * invDet;
+  if (u < 0 || u > 1)
+    return false;
+
+  const ignition::math::Vector3d q = s.Cross(e1);
+  const double v = _dir.Dot(q) * invDet;
+  if (v < 0 || u + v > 1)
+    return false;
+
+  const double t = e2.Dot(q) * invDet;
+  if (t < 0)
+    return false;
+
+  _dist = t;
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Intersect a ray with a captured shape.
+/// \param[in] _shape Shape, which must not be unsupported.
+/// \param[in] _origin Origin of the ray in world coordinates.
+/// \param[in] _dir Unit direction of the ray in world coordinates.
+/// \param[in] _maxDist Hits farther than this are ignored.
+/// \param[out] _dist Distance to the closest hit.
+/// \return True if the ray hits the shape.
+static bool IntersectShape(const RayQueryShape &_shape,
+    const ignition::math::Vector3d &_origin,
+    const ignition::math::Vector3d &_dir, const double _maxDist,
+    double &_dist)
+{
+  if (_shape.type == RayQueryShapeType::PLANE)
+  {
+    const ignition::math::Vector3d normal = _shape.pose.Rot() * _shape.size;
+    const double denom = normal.Dot(_dir);
+    if (std::abs(denom) < kEpsilon)
+      return false;
+
+    const double t = normal.Dot(_shape.pose.Pos() - _origin) / denom;
+    if (t < 0 || t >= _maxDist)
+      return false;
+
+    _dist = t;
+    return true;
+  }
+
+  // Everything else is tested in the frame of the collision
+  const ignition::math::Vector3d origin =
+      _shape.pose.Rot().RotateVectorReverse(_origin - _shape.pose.Pos());
+  const ignition::math::Vector3d dir =
+      _shape.pose.Rot().RotateVectorReverse(_dir);
+
+  bool hit = false;
+  switch (_shape.type)
+  {
+    case RayQueryShapeType::BOX:
+      hit = IntersectBox(_shape.size * 0.5, origin, dir, _dist);
+      break;
+    case RayQueryShapeType::SPHERE:
+      hit = IntersectSphere(_shape.size.X(), origin, dir, _dist);
+      break;
+    case RayQueryShapeType::CYLINDER:
+      hit = IntersectCylinder(_shape.size.X(), _shape.size.Y(), origin, dir,
+          _dist);
+      break;
+    case RayQueryShapeType::MESH:
+    {
+      const RayQueryMesh &mesh = *_shape.mesh;
+      double best = _maxDist;
+      Traverse(mesh.bvh, origin, InverseDir(dir), best,
+          [&](const uint32_t _tri)
+          {
+            double t;
+            if (IntersectTriangle(mesh.vertices[mesh.indices[_tri * 3]],
+                  mesh.vertices[mesh.indices[_tri * 3 + 1]],
+                  mesh.vertices[mesh.indices[_tri * 3 + 2]],
+                  origin, dir, t) && t < best)
+            {
+              best = t;
+              hit = true;
+            }
+            return true;
+          });
+      _dist = best;
+      break;
+    }
+    default:
+      break;
+  }
+
+  return hit && _dist < _maxDist;
+}
+
+//////////////////////////////////////////////////
+/// \brief Read the triangles of a mesh shape.
+/// \param[in] _shape The mesh shape.
+/// \param[in] _scale Scale to apply to the vertices.
+/// \return The triangles, null if the shape has no mesh.
+static std::shared_ptr<const RayQueryMesh> LoadMesh(const MeshShape &_shape,
+    const ignition::math::Vector3d &_scale)
+{
+  std::vector<const common::SubMesh *> submeshes;
+  if (_shape.CollisionSubMesh())
+  {
+    submeshes.push_back(_shape.CollisionSubMesh());
+  }
+  else if (_shape.CollisionMesh())
+  {
+    const common::Mesh *mesh = _shape.CollisionMesh();
+    for (unsigned int i = 0; i < mesh->GetSubMeshCount(); ++i)
+    {
+      // Skip degenerate submeshes, as common::Mesh::FillArrays does
+      if (mesh->GetSubMesh(i)->GetVertexCount() > 2)
+        submeshes.push_back(mesh->GetSubMesh(i));
+    }
+  }
+
+  if (submeshes.empty())
+    return nullptr;
+
+  auto result = std::make_shared<RayQueryMesh>();
+  for (const common::SubMesh *submesh : submeshes)
+  {
+    const uint32_t offset = result->vertices.size();
+    const unsigned int vertexCount = submesh->GetVertexCount();
+    for (unsigned int i = 0; i < vertexCount; ++i)
+      result->vertices.push_back(submesh->Vertex(i) * _scale);
+
+    const unsigned int indexCount = submesh->GetIndexCount() / 3 * 3;
+    for (unsigned int i = 0; i < indexCount; i += 3)
+    {
+      const unsigned int a = submesh->GetIndex(i);
+      const unsigned int b = submesh->GetIndex(i + 1);
+      const unsigned int c = submesh->GetIndex(i + 2);
+      if (a >= vertexCount || b >= vertexCount || c >= vertexCount)
+        continue;
+
+      result->indices.push_back(offset + a);
+      result->indices.push_back(offset + b);
+      result->indices.push_back(offset + c);
+    }
+  }
+
+  std::vector<RayQueryBounds> bounds(result->indices.size() / 3);
+  for (size_t i = 0; i < bounds.size(); ++i)
+  {
+    bounds[i] = EmptyBounds();
+    for (size_t j = 0; j < 3; ++j)
+    {
+      const ignition::math::Vector3d &v =
+          result->vertices[result->indices[i * 3 + j]];
+      bounds[i].min.Min(v);
+      bounds[i].max.Max(v);
+    }
+  }
+  result->bvh.Build(bounds);
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+/// \brief Capture the collisions of a model and its nested models.
+/// \param[in,out] _data Private data of the manager, for the mesh cache.
+/// \param[in,out] _snapshot Snapshot being captured.
+/// \param[in] _model Model to capture.
+/// \param[in,out] _count Number of shapes captured so far.
+static void CaptureModel(RayQueryManagerPrivate &_data,
+    RayQuerySnapshot &_snapshot, const ModelPtr &_model, size_t &_count)
+{
+  for (const auto &link : _model->GetLinks())
+  {
+    for (const auto &collision : link->GetCollisions())
+    {
+      ShapePtr shape = collision->GetShape();
+      if (!shape || shape->HasType(Base::RAY_SHAPE) ||
+          shape->HasType(Base::MULTIRAY_SHAPE))
+      {
+        continue;
+      }
+
+      // Skip collisions that the rays of the physics engine don't hit,
+      // such as links whose collide mode is "sensors" or "none". Rays
+      // have GZ_SENSOR_COLLIDE category bits and collide with everything
+      // else.
+      if (!(collision->GetCollideBits() & GZ_SENSOR_COLLIDE) &&
+          !(collision->GetCategoryBits() & ~GZ_SENSOR_COLLIDE))
+      {
+        continue;
+      }
+
+      if (_count == _snapshot.shapes.size())
+        _snapshot.shapes.emplace_back();
+      RayQueryShape &entry = _snapshot.shapes[_count++];
+
+      entry.pose = collision->WorldPose();
+      entry.retro = collision->GetLaserRetro();
+      entry.collision = collision;
+      entry.mesh.reset();
+      entry.type = RayQueryShapeType::UNSUPPORTED;
+
+      if (shape->HasType(Base::BOX_SHAPE))
+      {
+        entry.type = RayQueryShapeType::BOX;
+        entry.size = static_cast<BoxShape *>(shape.get())->Size();
+      }
+      else if (shape->HasType(Base::SPHERE_SHAPE))
+      {
+        entry.type = RayQueryShapeType::SPHERE;
+        entry.size.Set(static_cast<SphereShape *>(shape.get())->GetRadius(),
+            0, 0);
+      }
+      else if (shape->HasType(Base::CYLINDER_SHAPE))
+      {
+        auto cylinder = static_cast<CylinderShape *>(shape.get());
+        entry.type = RayQueryShapeType::CYLINDER;
+        entry.size.Set(cylinder->GetRadius(), cylinder->GetLength(), 0);
+      }
+      else if (shape->HasType(Base::PLANE_SHAPE))
+      {
+        entry.type = RayQueryShapeType::PLANE;
+        entry.size = static_cast<PlaneShape *>(shape.get())->Normal();
+        entry.size.Normalize();
+      }
+      else if (shape->HasType(Base::MESH_SHAPE))
+      {
+        auto meshShape = static_cast<MeshShape *>(shape.get());
+        const ignition::math::Vector3d scale = meshShape->Size();
+
+        RayQueryMeshCacheEntry &cached = _data.meshes[collision->GetId()];
+        if (!cached.mesh || cached.scale != scale ||
+            cached.source != meshShape->CollisionMesh() ||
+            cached.subSource != meshShape->CollisionSubMesh())
+        {
+          cached.source = meshShape->CollisionMesh();
+          cached.subSource = meshShape->CollisionSubMesh();
+          cached.scale = scale;
+          cached.mesh = LoadMesh(*meshShape, scale);
+        }
+        cached.used = true;
+
+        if (cached.mesh)
+        {
+          entry.type = RayQueryShapeType::MESH;
+          entry.mesh = cached.mesh;
+        }
+      }
+    }
+  }
+
+  for (const auto &nested : _model->NestedModels())
+    CaptureModel(_data, _snapshot, nested, _count);
+}
+
+//////////////////////////////////////////////////
+RayQueryManager::RayQueryManager(WorldPtr _world)
+  : dataPtr(new RayQueryManagerPrivate)
+{
+  this->dataPtr->world = _world;
+}
+
+//////////////////////////////////////////////////
+RayQueryManager::~RayQueryManager()
+{
+  this->Fini();
+}
+
+//////////////////////////////////////////////////
+void RayQueryManager::Fini()
+{
+  std::atomic_store(&this->dataPtr->snapshot,
+      std::shared_ptr<RayQuerySnapshot>());
+  this->dataPtr->spare.reset();
+  this->dataPtr->meshes.clear();
+  this->dataPtr->world.reset();
+}
+
+//////////////////////////////////////////////////
+void RayQueryManager::AddUser()
+{
+  ++this->dataPtr->users;
+}
+
+//////////////////////////////////////////////////
+void RayQueryManager::RemoveUser()
+{
+  unsigned int users = this->dataPtr->users;
+  while (users > 0 &&
+      !this->dataPtr->users.compare_exchange_weak(users, users - 1))
+  {
+  }
+
+  // Release the memory of the last snapshot when it is not needed anymore
+  if (users == 1)
+    std::atomic_store(&this->dataPtr->snapshot,
+        std::shared_ptr<RayQuerySnapshot>());
+}
+
+//////////////////////////////////////////////////
+unsigned int RayQueryManager::UserCount() const
+{
+  return this->dataPtr->users;
+}
+
+//////////////////////////////////////////////////
+void RayQueryManager::Update()
+{
+  if (this->dataPtr->users == 0 || !this->dataPtr->world ||
+      !this->dataPtr->world->Physics())
+  {
+    return;
+  }
+
+  // Reuse the previous snapshot if no reader holds it anymore. It is not
+  // published, so no reader can acquire it once its count drops to one.
+  std::shared_ptr<RayQuerySnapshot> snapshot;
+  if (this->dataPtr->spare && this->dataPtr->spare.use_count() == 1)
+    snapshot.swap(this->dataPtr->spare);
+  else
+    snapshot = std::make_shared<RayQuerySnapshot>();
+  this->dataPtr->spare.reset();
+
+  for (auto &cached : this->dataPtr->meshes)
+    cached.second.used = false;
+
+  size_t count = 0;
+  {
+    boost::recursive_mutex::scoped_lock lock(
+        *this->dataPtr->world->Physics()->GetPhysicsUpdateMutex());
+
+    for (const auto &model : this->dataPtr->world->Models())
+      CaptureModel(*this->dataPtr, *snapshot, model, count);
+
+    snapshot->shapes.resize(count);
+
+    // Bounds of unsupported shapes come from the physics engine
+    snapshot->bounds.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      RayQueryShape &shape = snapshot->shapes[i];
+      if (shape.type != RayQueryShapeType::UNSUPPORTED)
+        continue;
+
+      CollisionPtr collision = shape.collision.lock();
+      ignition::math::AxisAlignedBox box;
+      if (collision)
+        box = collision->BoundingBox();
+      snapshot->bounds[i].min = box.Min();
+      snapshot->bounds[i].max = box.Max();
+    }
+  }
+
+  // Drop the triangles of collisions that no longer exist
+  for (auto iter = this->dataPtr->meshes.begin();
+       iter != this->dataPtr->meshes.end();)
+  {
+    if (iter->second.used)
+      ++iter;
+    else
+      iter = this->dataPtr->meshes.erase(iter);
+  }
+
+  snapshot->planes.clear();
+  snapshot->unbounded = false;
+  std::vector<RayQueryBounds> bounded;
+  std::vector<uint32_t> boundedShapes;
+  bounded.reserve(count);
+  boundedShapes.reserve(count);
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    const RayQueryShape &shape = snapshot->shapes[i];
+    RayQueryBounds &bounds = snapshot->bounds[i];
+    switch (shape.type)
+    {
+      case RayQueryShapeType::PLANE:
+        snapshot->planes.push_back(i);
+        continue;
+      case RayQueryShapeType::BOX:
+        bounds = RotatedBounds(shape.pose, ignition::math::Vector3d::Zero,
+            shape.size * 0.5);
+        break;
+      case RayQueryShapeType::SPHERE:
+      {
+        const ignition::math::Vector3d radius(shape.size.X(), shape.size.X(),
+            shape.size.X());
+        bounds.min = shape.pose.Pos() - radius;
+        bounds.max = shape.pose.Pos() + radius;
+        break;
+      }
+      case RayQueryShapeType::CYLINDER:
+        bounds = RotatedBounds(shape.pose, ignition::math::Vector3d::Zero,
+            ignition::math::Vector3d(shape.size.X(), shape.size.X(),
+              shape.size.Y() * 0.5));
+        break;
+      case RayQueryShapeType::MESH:
+      {
+        if (shape.mesh->bvh.nodes.empty())
+          continue;
+        const RayQueryBounds &local = shape.mesh->bvh.nodes[0].bounds;
+        bounds = RotatedBounds(shape.pose, (local.min + local.max) * 0.5,
+            (local.max - local.min) * 0.5);
+        break;
+      }
+      default:
+        if (!std::isfinite(bounds.min.X()) || !std::isfinite(bounds.min.Y()) ||
+            !std::isfinite(bounds.min.Z()) || !std::isfinite(bounds.max.X()) ||
+            !std::isfinite(bounds.max.Y()) || !std::isfinite(bounds.max.Z()) ||
+            bounds.min.X() > bounds.max.X())
+        {
+          snapshot->unbounded = true;
+          continue;
+        }
+        break;
+    }
+
+    bounded.push_back(bounds);
+    boundedShapes.push_back(i);
+  }
+
+  // Build the hierarchy over the bounded shapes, then map its items back
+  // to shape indices
+  snapshot->bvh.Build(bounded);
+  for (auto &item : snapshot->bvh.items)
+    item = boundedShapes[item];
+
+  // Publish. The previous snapshot becomes the spare.
+  this->dataPtr->spare = std::atomic_exchange(&this->dataPtr->snapshot,
+      snapshot);
+}
+
+//////////////////////////////////////////////////
+bool RayQueryManager::Intersect(const std::vector<RayQuery> &_rays,
+    std::vector<RayQueryResult> &_results) const
+{
+  std::shared_ptr<const RayQuerySnapshot> snapshot =
+      std::atomic_load(&this->dataPtr->snapshot);
+
+  if (!snapshot || snapshot->unbounded)
+    return false;
+
+  _results.resize(_rays.size());
+  for (size_t i = 0; i < _rays.size(); ++i)
+  {
+    RayQueryResult &result = _results[i];
+    result.hit = false;
+    result.distance = 0;
+    result.retro = 0;
+    result.collisionName.clear();
+
+    ignition::math::Vector3d dir = _rays[i].end - _rays[i].start;
+    const double length = dir.Length();
+    if (length <= 0)
+      continue;
+    dir /= length;
+
+    const ignition::math::Vector3d &origin = _rays[i].start;
+    double best = length;
+    const RayQueryShape *closest = nullptr;
+
+    auto visit = [&](const uint32_t _index)
+    {
+      const RayQueryShape &shape = snapshot->shapes[_index];
+      if (shape.type == RayQueryShapeType::UNSUPPORTED)
+        return false;
+
+      double dist;
+      if (IntersectShape(shape, origin, dir, best, dist))
+      {
+        best = dist;
+        closest = &shape;
+      }
+      return true;
+    };
+
+    if (!Traverse(snapshot->bvh, origin, InverseDir(dir), best, visit))
+      return false;
+
+    for (const uint32_t plane : snapshot->planes)
+      visit(plane);
+
+    if (closest)
+    {
+      result.hit = true;
+      result.distance = best;
+      result.retro = closest->retro;
+      CollisionPtr collision = closest->collision.lock();
+      if (collision)
+        result.collisionName = collision->GetScopedName();
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_RAYQUERYMANAGER_HH_
+#define GAZEBO_PHYSICS_RAYQUERYMANAGER_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class
+    class RayQueryManagerPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class RayQuery RayQueryManager.hh physics/physics.hh
+    /// \brief A ray segment, in world coordinates, to intersect with the
+    /// collision shapes of a world.
+    class GZ_PHYSICS_VISIBLE RayQuery
+    {
+      /// \brief Start point of the ray.
+      public: ignition::math::Vector3d start;
+
+      /// \brief End point of the ray.
+      public: ignition::math::Vector3d end;
+    };
+
+    /// \class RayQueryResult RayQueryManager.hh physics/physics.hh
+    /// \brief Result of a RayQuery.
+    class GZ_PHYSICS_VISIBLE RayQueryResult
+    {
+      /// \brief True if the ray hit a collision.
+      public: bool hit = false;
+
+      /// \brief Distance from the start of the ray to the closest hit.
+      /// Only valid when hit is true.
+      public: double distance = 0;
+
+      /// \brief Laser retro value of the collision that was hit.
+      public: float retro = 0;
+
+      /// \brief Scoped name of the collision that was hit, empty if
+      /// nothing was hit.
+      public: std::string collisionName;
+    };
+
+    /// \class RayQueryManager RayQueryManager.hh physics/physics.hh
+    /// \brief Answers ray queries from sensor threads without locking the
+    /// physics engine.
+    ///
+    /// After every physics update, while at least one user is registered,
+    /// the manager captures the pose and geometry of every collision of the
+    /// world in an immutable snapshot, indexed with a bounding volume
+    /// hierarchy. The snapshot is published atomically, so Intersect can be
+    /// called from any thread while the next step is simulated, and always
+    /// sees a consistent world of the last completed step.
+    ///
+    /// Boxes, spheres, cylinders, planes and triangle meshes are supported.
+    /// Intersect returns false if a ray may hit any other kind of shape,
+    /// such as a heightmap, in which case the caller should fall back to
+    /// the ray shapes of the physics engine.
+    class GZ_PHYSICS_VISIBLE RayQueryManager
+    {
+      /// \brief Constructor.
+      /// \param[in] _world Pointer to the world.
+      public: explicit RayQueryManager(WorldPtr _world);
+
+      /// \brief Destructor.
+      public: virtual ~RayQueryManager();
+
+      /// \brief Release the world and the snapshot.
+      public: void Fini();
+
+      /// \brief Register a user. Snapshots are only captured while there is
+      /// at least one user.
+      public: void AddUser();
+
+      /// \brief Unregister a user added with AddUser.
+      public: void RemoveUser();
+
+      /// \brief Get the number of registered users.
+      /// \return Number of users.
+      public: unsigned int UserCount() const;
+
+      /// \brief Capture a new snapshot of the world, if there are users.
+      /// This is called by World::Update after the physics update, and
+      /// locks the physics engine while the collisions are read.
+      public: void Update();
+
+      /// \brief Intersect rays with the last captured snapshot. A ray that
+      /// starts inside a shape hits it where it leaves the shape, as with
+      /// the ray shapes of the physics engines. This function is thread
+      /// safe and does not lock the physics engine.
+      /// \param[in] _rays Rays to intersect.
+      /// \param[out] _results Closest hit of each ray, resized to the size
+      /// of _rays.
+      /// \return False if no snapshot is available yet, or if a ray may
+      /// hit an unsupported shape. _results is not valid in that case.
+      public: bool Intersect(const std::vector<RayQuery> &_rays,
+                  std::vector<RayQueryResult> &_results) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<RayQueryManagerPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
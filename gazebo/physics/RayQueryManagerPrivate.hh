@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_RAYQUERYMANAGERPRIVATE_HH_
+#define GAZEBO_PHYSICS_RAYQUERYMANAGERPRIVATE_HH_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/weak_ptr.hpp>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/CommonTypes.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Axis aligned bounds of an item of a RayQueryBVH.
+    class RayQueryBounds
+    {
+      /// \brief Minimum corner.
+      public: ignition::math::Vector3d min;
+
+      /// \brief Maximum corner.
+      public: ignition::math::Vector3d max;
+    };
+
+    /// \internal
+    /// \brief Bounding volume hierarchy over a set of items, stored as a
+    /// flat array of nodes in depth first order.
+    class RayQueryBVH
+    {
+      /// \brief A node of the hierarchy.
+      public: class Node
+      {
+        /// \brief Bounds of all the items below the node.
+        public: RayQueryBounds bounds;
+
+        /// \brief For a leaf, index of its first item in items. For an
+        /// inner node, index of its second child. The first child always
+        /// follows its parent.
+        public: uint32_t first = 0;
+
+        /// \brief Number of items of a leaf, 0 for an inner node.
+        public: uint32_t count = 0;
+      };
+
+      /// \brief Build the hierarchy.
+      /// \param[in] _bounds Bounds of every item.
+      public: void Build(const std::vector<RayQueryBounds> &_bounds);
+
+      /// \brief Nodes, the root is the first one. Empty if there are no
+      /// items.
+      public: std::vector<Node> nodes;
+
+      /// \brief Item indices, grouped by leaf.
+      public: std::vector<uint32_t> items;
+    };
+
+    /// \internal
+    /// \brief Triangles of a mesh collision, in the frame of the collision
+    /// and with the scale of the shape applied.
+    class RayQueryMesh
+    {
+      /// \brief Vertices.
+      public: std::vector<ignition::math::Vector3d> vertices;
+
+      /// \brief Three vertex indices per triangle.
+      public: std::vector<uint32_t> indices;
+
+      /// \brief Hierarchy over the triangles.
+      public: RayQueryBVH bvh;
+    };
+
+    /// \internal
+    /// \brief Type of a RayQueryShape.
+    enum class RayQueryShapeType
+    {
+      /// \brief Box, size holds the full extents.
+      BOX,
+
+      /// \brief Sphere, size.X() holds the radius.
+      SPHERE,
+
+      /// \brief Cylinder along Z, size.X() holds the radius and size.Y()
+      /// the length.
+      CYLINDER,
+
+      /// \brief Infinite plane, size holds the normal.
+      PLANE,
+
+      /// \brief Triangle mesh.
+      MESH,
+
+      /// \brief Any other shape. The bounds come from the physics engine.
+      UNSUPPORTED
+    };
+
+    /// \internal
+    /// \brief Geometry and pose of a collision in a RayQuerySnapshot.
+    class RayQueryShape
+    {
+      /// \brief Type of the shape.
+      public: RayQueryShapeType type = RayQueryShapeType::UNSUPPORTED;
+
+      /// \brief World pose of the collision.
+      public: ignition::math::Pose3d pose;
+
+      /// \brief Parameters of the shape, see RayQueryShapeType.
+      public: ignition::math::Vector3d size;
+
+      /// \brief Triangles, for meshes.
+      public: std::shared_ptr<const RayQueryMesh> mesh;
+
+      /// \brief Laser retro value of the collision.
+      public: float retro = 0;
+
+      /// \brief The collision, used to look up its name on a hit.
+      public: boost::weak_ptr<Collision> collision;
+    };
+
+    /// \internal
+    /// \brief Immutable capture of the collisions of a world.
+    class RayQuerySnapshot
+    {
+      /// \brief Every captured shape.
+      public: std::vector<RayQueryShape> shapes;
+
+      /// \brief World bounds of the shapes, used to build the hierarchy.
+      public: std::vector<RayQueryBounds> bounds;
+
+      /// \brief Hierarchy over the shapes, planes excluded.
+      public: RayQueryBVH bvh;
+
+      /// \brief Indices of the planes, which have no finite bounds.
+      public: std::vector<uint32_t> planes;
+
+      /// \brief True if an unsupported shape has no finite bounds, in
+      /// which case every query must fall back to the physics engine.
+      public: bool unbounded = false;
+    };
+
+    /// \internal
+    /// \brief Mesh triangles cached for a collision.
+    class RayQueryMeshCacheEntry
+    {
+      /// \brief Mesh the triangles were read from.
+      public: const common::Mesh *source = nullptr;
+
+      /// \brief Submesh the triangles were read from, if any.
+      public: const common::SubMesh *subSource = nullptr;
+
+      /// \brief Scale applied to the triangles.
+      public: ignition::math::Vector3d scale;
+
+      /// \brief The triangles.
+      public: std::shared_ptr<const RayQueryMesh> mesh;
+
+      /// \brief True if the collision was seen by the last update.
+      public: bool used = false;
+    };
+
+    /// \internal
+    /// \brief Private data for the RayQueryManager class.
+    class RayQueryManagerPrivate
+    {
+      /// \brief The world.
+      public: WorldPtr world;
+
+      /// \brief Number of users.
+      public: std::atomic<unsigned int> users{0};
+
+      /// \brief Last published snapshot, accessed with std::atomic_load
+      /// and std::atomic_store.
+      public: std::shared_ptr<RayQuerySnapshot> snapshot;
+
+      /// \brief The snapshot published before the last one. Its memory is
+      /// reused by the next update if no reader holds it anymore.
+      public: std::shared_ptr<RayQuerySnapshot> spare;
+
+      /// \brief Mesh triangles, indexed by collision id. Only accessed by
+      /// Update.
+      public: std::unordered_map<uint32_t, RayQueryMeshCacheEntry> meshes;
+    };
+  }
+}
+#endif
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <string>
+#include <vector>
+
+#include "gazebo/test/ServerFixture.hh"
+#include "test/util.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/RayQueryManager.hh"
+#include "gazebo/physics/RayShape.hh"
+#include "gazebo/physics/World.hh"
+
+using namespace gazebo;
+
+class RayQueryManagerTest : public ServerFixture { };
+
+//////////////////////////////////////////////////
+/// \brief Helper to create a query.
+/// \param[in] _start Start of the ray.
+/// \param[in] _end End of the ray.
+/// \return The query.
+physics::RayQuery Query(const ignition::math::Vector3d &_start,
+    const ignition::math::Vector3d &_end)
+{
+  physics::RayQuery query;
+  query.start = _start;
+  query.end = _end;
+  return query;
+}
+
+//////////////////////////////////////////////////
+TEST_F(RayQueryManagerTest, Intersect)
+{
+  this->Load("worlds/shapes.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::RayQueryManagerPtr mgr = world->RayQueryMgr();
+  ASSERT_TRUE(mgr != nullptr);
+  EXPECT_EQ(mgr->UserCount(), 0u);
+
+  // No snapshot is captured without users
+  std::vector<physics::RayQuery> queries;
+  std::vector<physics::RayQueryResult> results;
+  queries.push_back(Query(ignition::math::Vector3d(-5, 0, 0.5),
+      ignition::math::Vector3d(5, 0, 0.5)));
+  mgr->Update();
+  EXPECT_FALSE(mgr->Intersect(queries, results));
+
+  mgr->AddUser();
+  EXPECT_EQ(mgr->UserCount(), 1u);
+  world->Step(1);
+
+  // Box, centered at (0, 0, 0.5)
+  ASSERT_TRUE(mgr->Intersect(queries, results));
+  ASSERT_EQ(results.size(), 1u);
+  EXPECT_TRUE(results[0].hit);
+  EXPECT_NEAR(results[0].distance, 4.5, 1e-6);
+  EXPECT_NE(results[0].collisionName.find("box"), std::string::npos);
+
+  // Starting inside the box, the ray hits where it leaves it
+  queries[0] = Query(ignition::math::Vector3d(0, 0, 0.5),
+      ignition::math::Vector3d(0, 0, 5));
+  ASSERT_TRUE(mgr->Intersect(queries, results));
+  EXPECT_TRUE(results[0].hit);
+  EXPECT_NEAR(results[0].distance, 0.5, 1e-6);
+
+  // Sphere, centered at (0, 1.5, 0.5), too short then long enough
+  queries[0] = Query(ignition::math::Vector3d(0, 5, 0.5),
+      ignition::math::Vector3d(0, 3, 0.5));
+  queries.push_back(Query(ignition::math::Vector3d(0, 5, 0.5),
+      ignition::math::Vector3d(0, 2.5, 0.5)));
+  ASSERT_TRUE(mgr->Intersect(queries, results));
+  ASSERT_EQ(results.size(), 2u);
+  EXPECT_FALSE(results[0].hit);
+  EXPECT_TRUE(results[0].collisionName.empty());
+  EXPECT_TRUE(results[1].hit);
+  EXPECT_NEAR(results[1].distance, 3.0, 1e-6);
+  EXPECT_NE(results[1].collisionName.find("sphere"), std::string::npos);
+
+  // Cylinder, centered at (0, -1.5, 0.5) with its axis along X
+  queries[0] = Query(ignition::math::Vector3d(0, -5, 0.5),
+      ignition::math::Vector3d(0, 0, 0.5));
+  queries[1] = Query(ignition::math::Vector3d(2, -1.5, 0.5),
+      ignition::math::Vector3d(-2, -1.5, 0.5));
+  ASSERT_TRUE(mgr->Intersect(queries, results));
+  EXPECT_TRUE(results[0].hit);
+  EXPECT_NEAR(results[0].distance, 3.0, 1e-3);
+  EXPECT_NE(results[0].collisionName.find("cylinder"), std::string::npos);
+  EXPECT_TRUE(results[1].hit);
+  EXPECT_NEAR(results[1].distance, 1.5, 1e-3);
+
+  // Ground plane
+  queries.resize(1);
+  queries[0] = Query(ignition::math::Vector3d(3, 3, 2),
+      ignition::math::Vector3d(3, 3, -1));
+  ASSERT_TRUE(mgr->Intersect(queries, results));
+  EXPECT_TRUE(results[0].hit);
+  EXPECT_NEAR(results[0].distance, 2.0, 1e-6);
+  EXPECT_NE(results[0].collisionName.find("ground_plane"), std::string::npos);
+
+  // The snapshot follows the world after a step
+  physics::ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+  box->SetWorldPose(ignition::math::Pose3d(1, 0, 0.5, 0, 0, 0));
+  queries[0] = Query(ignition::math::Vector3d(-5, 0, 0.5),
+      ignition::math::Vector3d(5, 0, 0.5));
+  world->Step(1);
+  ASSERT_TRUE(mgr->Intersect(queries, results));
+  EXPECT_TRUE(results[0].hit);
+  EXPECT_NEAR(results[0].distance, 5.5, 1e-6);
+
+  // Same result as the ray shape of the physics engine
+  physics::RayShapePtr ray = boost::dynamic_pointer_cast<physics::RayShape>(
+      world->Physics()->CreateShape("ray", physics::CollisionPtr()));
+  ASSERT_TRUE(ray != nullptr);
+  double dist;
+  std::string entity;
+  ray->SetPoints(queries[0].start, queries[0].end);
+  ray->GetIntersection(dist, entity);
+  EXPECT_NEAR(results[0].distance, dist, 1e-6);
+  EXPECT_EQ(results[0].collisionName, entity);
+
+  // Collisions that only collide with sensors, or with nothing, are
+  // ignored by rays
+  for (auto const &mode : {"sensors", "none"})
+  {
+    box->GetLink("link")->SetCollideMode(mode);
+    world->Step(1);
+    ASSERT_TRUE(mgr->Intersect(queries, results));
+    EXPECT_FALSE(results[0].hit) << mode;
+    ray->GetIntersection(dist, entity);
+    EXPECT_TRUE(entity.empty()) << mode;
+  }
+  box->GetLink("link")->SetCollideMode("all");
+  world->Step(1);
+  ASSERT_TRUE(mgr->Intersect(queries, results));
+  EXPECT_TRUE(results[0].hit);
+
+  // The snapshot is released with the last user
+  mgr->RemoveUser();
+  EXPECT_EQ(mgr->UserCount(), 0u);
+  EXPECT_FALSE(mgr->Intersect(queries, results));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
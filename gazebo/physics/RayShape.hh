@@ -164,6 +164,10 @@ namespace gazebo
       /// \brief ODEMultiRayShape needs to call SetCollisionName when it is
       /// updated
       protected: friend class ODEMultiRayShape;
+
+      /// \brief MultiRayShape needs to call SetCollisionName when its rays
+      /// are answered by the RayQueryManager
+      protected: friend class MultiRayShape;
     };
     /// \}
   }
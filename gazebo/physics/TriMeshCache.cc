@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/physics/TriMeshCache.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+//////////////////////////////////////////////////
+TriMeshData::TriMeshData(const common::Mesh *_mesh,
+    const common::SubMesh *_subMesh, const ignition::math::Vector3d &_scale)
+{
+  float *vertArr = nullptr;
+  int *indArr = nullptr;
+  unsigned int numVertices = 0;
+  unsigned int numIndices = 0;
+
+  if (_subMesh)
+  {
+    numVertices = _subMesh->GetVertexCount();
+    numIndices = _subMesh->GetIndexCount();
+    _subMesh->FillArrays(&vertArr, &indArr);
+  }
+  else if (_mesh)
+  {
+    numVertices = _mesh->GetVertexCount();
+    numIndices = _mesh->GetIndexCount();
+    _mesh->FillArrays(&vertArr, &indArr);
+  }
+
+  if (vertArr)
+  {
+    this->vertices.resize(numVertices * 3);
+    for (unsigned int i = 0; i < numVertices; ++i)
+    {
+      this->vertices[i*3+0] = vertArr[i*3+0] * _scale.X();
+      this->vertices[i*3+1] = vertArr[i*3+1] * _scale.Y();
+      this->vertices[i*3+2] = vertArr[i*3+2] * _scale.Z();
+    }
+  }
+
+  if (indArr)
+    this->indices.assign(indArr, indArr + numIndices);
+
+  delete [] vertArr;
+  delete [] indArr;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const TriMeshData> TriMeshData::Load(const std::string &_key,
+    const common::Mesh *_mesh, const common::SubMesh *_subMesh,
+    const ignition::math::Vector3d &_scale)
+{
+  return triMeshDataCache().Get(_key, [&]()
+      {
+        return std::make_shared<TriMeshData>(_mesh, _subMesh, _scale);
+      });
+}
+
+//////////////////////////////////////////////////
+unsigned int TriMeshData::VertexCount() const
+{
+  return this->vertices.size() / 3;
+}
+
+//////////////////////////////////////////////////
+unsigned int TriMeshData::IndexCount() const
+{
+  return this->indices.size();
+}
+
+//////////////////////////////////////////////////
+TriMeshCache<const TriMeshData> &physics::triMeshDataCache()
+{
+  static TriMeshCache<const TriMeshData> cache;
+  return cache;
+}
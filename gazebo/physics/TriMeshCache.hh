@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_TRIMESHCACHE_HH_
+#define GAZEBO_PHYSICS_TRIMESHCACHE_HH_
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/CommonTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class TriMeshData TriMeshCache.hh physics/physics.hh
+    /// \brief Vertex and index arrays of a triangle mesh, with a scale
+    /// applied to the vertices. Collisions using the same mesh with the same
+    /// scale share one instance, see TriMeshData::Load.
+    class GZ_PHYSICS_VISIBLE TriMeshData
+    {
+      /// \brief Constructor. Read the triangles of a submesh if _subMesh is
+      /// not null, otherwise the triangles of all the submeshes of _mesh.
+      /// \param[in] _mesh Mesh, used if _subMesh is null.
+      /// \param[in] _subMesh Submesh, can be null.
+      /// \param[in] _scale Scale applied to the vertices.
+      public: TriMeshData(const common::Mesh *_mesh,
+                  const common::SubMesh *_subMesh,
+                  const ignition::math::Vector3d &_scale);
+
+      /// \brief Get the triangles of a mesh from the process wide cache,
+      /// reading them if they are not cached yet.
+      /// \param[in] _key Cache key, see MeshShape::MeshCacheKey. If empty,
+      /// the triangles are read and not cached.
+      /// \param[in] _mesh Mesh, used if _subMesh is null.
+      /// \param[in] _subMesh Submesh, can be null.
+      /// \param[in] _scale Scale applied to the vertices.
+      /// \return The triangles, released from the cache with the last
+      /// reference.
+      public: static std::shared_ptr<const TriMeshData> Load(
+                  const std::string &_key, const common::Mesh *_mesh,
+                  const common::SubMesh *_subMesh,
+                  const ignition::math::Vector3d &_scale);
+
+      /// \brief Get the number of vertices.
+      /// \return Number of vertices.
+      public: unsigned int VertexCount() const;
+
+      /// \brief Get the number of indices.
+      /// \return Number of indices, three per triangle.
+      public: unsigned int IndexCount() const;
+
+      /// \brief Vertex coordinates, three per vertex.
+      public: std::vector<float> vertices;
+
+      /// \brief Vertex indices, three per triangle.
+      public: std::vector<int> indices;
+    };
+
+    /// \class TriMeshCache TriMeshCache.hh physics/physics.hh
+    /// \brief Thread safe cache of data built from triangle meshes, such as
+    /// the collision structures of a physics engine, so that collisions
+    /// using the same mesh share them.
+    ///
+    /// The cache only holds weak references: an entry is released when its
+    /// last user releases it, and is built again when it is requested next.
+    /// \tparam T Type of the cached data.
+    template<typename T>
+    class TriMeshCache
+    {
+      /// \brief Function building the data of an entry.
+      public: using CreateFn = std::function<std::shared_ptr<T>()>;
+
+      /// \brief Get the data of an entry, building it if the entry isn't
+      /// cached. The data is built without locking the cache, so entries
+      /// can be built concurrently.
+      /// \param[in] _key Key of the entry. If empty, the data is built and
+      /// not cached.
+      /// \param[in] _create Function building the data.
+      /// \return The data, or null if _create returned null.
+      public: std::shared_ptr<T> Get(const std::string &_key,
+                  const CreateFn &_create)
+      {
+        if (_key.empty())
+          return _create();
+
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+          auto iter = this->entries.find(_key);
+          if (iter != this->entries.end())
+          {
+            std::shared_ptr<T> data = iter->second.lock();
+            if (data)
+            {
+              ++this->hits;
+              return data;
+            }
+          }
+        }
+
+        std::shared_ptr<T> data = _create();
+        if (!data)
+          return data;
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        ++this->misses;
+
+        // Another thread may have built the same entry meanwhile, in which
+        // case its data is shared and ours is dropped.
+        std::weak_ptr<T> &entry = this->entries[_key];
+        std::shared_ptr<T> existing = entry.lock();
+        if (existing)
+          return existing;
+        entry = data;
+
+        // Forget the released entries
+        for (auto iter = this->entries.begin(); iter != this->entries.end();)
+        {
+          if (iter->second.expired())
+            iter = this->entries.erase(iter);
+          else
+            ++iter;
+        }
+
+        return data;
+      }
+
+      /// \brief Get the number of entries in use.
+      /// \return Number of entries which have at least one user.
+      public: std::size_t Size() const
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        std::size_t size = 0;
+        for (auto const &entry : this->entries)
+        {
+          if (!entry.second.expired())
+            ++size;
+        }
+        return size;
+      }
+
+      /// \brief Get the number of requests served from the cache.
+      /// \return Number of cache hits.
+      public: std::size_t Hits() const
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->hits;
+      }
+
+      /// \brief Get the number of requests which built their data.
+      /// \return Number of cache misses.
+      public: std::size_t Misses() const
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->misses;
+      }
+
+      /// \brief Protects the entries and the counters.
+      private: mutable std::mutex mutex;
+
+      /// \brief Entries, indexed by key.
+      private: std::map<std::string, std::weak_ptr<T>> entries;
+
+      /// \brief Number of cache hits.
+      private: std::size_t hits = 0;
+
+      /// \brief Number of cache misses.
+      private: std::size_t misses = 0;
+    };
+
+    /// \brief Get the process wide cache of the TriMeshData.
+    /// \return The cache used by TriMeshData::Load.
+    GZ_PHYSICS_VISIBLE
+    TriMeshCache<const TriMeshData> &triMeshDataCache();
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <string>
+
+#include <ignition/math/Vector2.hh>
+
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshManager.hh"
+#include "gazebo/physics/TriMeshCache.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class TriMeshCacheTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(TriMeshCacheTest, TriMeshData)
+{
+  common::MeshManager::Instance()->CreateBox("tri_mesh_cache_box",
+      ignition::math::Vector3d(1, 1, 1), ignition::math::Vector2d(1, 1));
+  const common::Mesh *mesh =
+    common::MeshManager::Instance()->GetMesh("tri_mesh_cache_box");
+  ASSERT_TRUE(mesh != nullptr);
+
+  const ignition::math::Vector3d scale(2, 3, 4);
+  physics::TriMeshData data(mesh, nullptr, scale);
+  EXPECT_EQ(data.VertexCount(), mesh->GetVertexCount());
+  EXPECT_EQ(data.IndexCount(), mesh->GetIndexCount());
+
+  // The scale is applied to the vertices
+  for (unsigned int i = 0; i < data.VertexCount(); ++i)
+  {
+    EXPECT_DOUBLE_EQ(std::abs(data.vertices[i*3+0]), 0.5 * scale.X());
+    EXPECT_DOUBLE_EQ(std::abs(data.vertices[i*3+1]), 0.5 * scale.Y());
+    EXPECT_DOUBLE_EQ(std::abs(data.vertices[i*3+2]), 0.5 * scale.Z());
+  }
+
+  // A submesh has priority over its mesh
+  physics::TriMeshData subData(mesh, mesh->GetSubMesh(0), scale);
+  EXPECT_EQ(subData.VertexCount(), mesh->GetSubMesh(0)->GetVertexCount());
+
+  // Shared through the cache
+  std::shared_ptr<const physics::TriMeshData> first =
+    physics::TriMeshData::Load("box", mesh, nullptr, scale);
+  std::shared_ptr<const physics::TriMeshData> second =
+    physics::TriMeshData::Load("box", mesh, nullptr, scale);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(first->vertices, data.vertices);
+  EXPECT_EQ(first->indices, data.indices);
+
+  // Not cached without a key
+  std::shared_ptr<const physics::TriMeshData> uncached =
+    physics::TriMeshData::Load("", mesh, nullptr, scale);
+  EXPECT_NE(first, uncached);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TriMeshCacheTest, Cache)
+{
+  physics::TriMeshCache<int> cache;
+  unsigned int created = 0;
+  auto create = [&]()
+    {
+      ++created;
+      return std::make_shared<int>(created);
+    };
+
+  std::shared_ptr<int> a = cache.Get("a", create);
+  std::shared_ptr<int> a2 = cache.Get("a", create);
+  std::shared_ptr<int> b = cache.Get("b", create);
+  EXPECT_EQ(a, a2);
+  EXPECT_NE(a, b);
+  EXPECT_EQ(created, 2u);
+  EXPECT_EQ(cache.Size(), 2u);
+  EXPECT_EQ(cache.Hits(), 1u);
+  EXPECT_EQ(cache.Misses(), 2u);
+
+  // An entry is released with its last user, and built again when needed
+  a.reset();
+  EXPECT_EQ(cache.Size(), 2u);
+  a2.reset();
+  EXPECT_EQ(cache.Size(), 1u);
+  a = cache.Get("a", create);
+  EXPECT_EQ(*a, 3);
+  EXPECT_EQ(created, 3u);
+
+  // Empty keys aren't cached
+  std::shared_ptr<int> c = cache.Get("", create);
+  std::shared_ptr<int> c2 = cache.Get("", create);
+  EXPECT_NE(c, c2);
+  EXPECT_EQ(cache.Size(), 2u);
+
+  // Nothing is cached if the data can't be built
+  EXPECT_TRUE(cache.Get("d", []() { return std::shared_ptr<int>(); }) ==
+      nullptr);
+  EXPECT_EQ(cache.Size(), 2u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
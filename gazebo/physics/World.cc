@@ -19,13 +19,16 @@
 
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
+#include <tbb/task_arena.h>
 
 #include <sdf/sdf.hh>
 
+#include <algorithm>
 #include <deque>
 #include <list>
 #include <set>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include <boost/algorithm/string/predicate.hpp>
@@ -53,6 +56,7 @@
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/MeshManager.hh"
 #include "gazebo/common/Plugin.hh"
 #include "gazebo/common/SdfFrameSemantics.hh"
 #include "gazebo/common/Time.hh"
@@ -74,6 +78,8 @@
 #include "gazebo/physics/Atmosphere.hh"
 #include "gazebo/physics/AtmosphereFactory.hh"
 #include "gazebo/physics/PresetManager.hh"
+#include "gazebo/physics/ModelSpatialIndex.hh"
+#include "gazebo/physics/RayQueryManager.hh"
 #include "gazebo/physics/UserCmdManager.hh"
 #include "gazebo/physics/Model.hh"
 #include "gazebo/physics/Light.hh"
@@ -96,18 +102,61 @@ bool g_clearModels;
 
 class ModelUpdate_TBB
 {
-  public: explicit ModelUpdate_TBB(Model_V *_models) : models(_models) {}
+  public: explicit ModelUpdate_TBB(const Base_V &_entities)
+          : entities(_entities) {}
   public: void operator() (const tbb::blocked_range<size_t> &_r) const
   {
     for (size_t i = _r.begin(); i != _r.end(); i++)
     {
-      (*models)[i]->Update();
+      this->entities[i]->Update();
     }
   }
 
-  private: Model_V *models;
+  private: const Base_V &entities;
 };
 
+//////////////////////////////////////////////////
+/// \brief Collect the URIs of the collision meshes of models, including
+/// their nested models, in the form used by MeshShape::Init.
+/// \param[in] _parent Element containing the models.
+/// \param[out] _uris The URIs are appended to it.
+static void collectCollisionMeshes(const sdf::ElementPtr &_parent,
+    std::vector<std::string> &_uris)
+{
+  if (!_parent->HasElement("model"))
+    return;
+
+  for (sdf::ElementPtr modelElem = _parent->GetElement("model"); modelElem;
+       modelElem = modelElem->GetNextElement("model"))
+  {
+    if (modelElem->HasElement("link"))
+    {
+      for (sdf::ElementPtr linkElem = modelElem->GetElement("link");
+           linkElem; linkElem = linkElem->GetNextElement("link"))
+      {
+        if (!linkElem->HasElement("collision"))
+          continue;
+
+        for (sdf::ElementPtr collisionElem =
+             linkElem->GetElement("collision"); collisionElem;
+             collisionElem = collisionElem->GetNextElement("collision"))
+        {
+          if (!collisionElem->HasElement("geometry"))
+            continue;
+          sdf::ElementPtr geomElem = collisionElem->GetElement("geometry");
+          if (!geomElem->HasElement("mesh"))
+            continue;
+          sdf::ElementPtr meshElem = geomElem->GetElement("mesh");
+          _uris.push_back(common::asFullPath(
+                meshElem->Get<std::string>("uri"), meshElem->FilePath()));
+        }
+      }
+    }
+
+    collectCollisionMeshes(modelElem, _uris);
+  }
+}
+
 //////////////////////////////////////////////////
 World::World(const std::string &_name)
   : dataPtr(new WorldPrivate)
@@ -120,9 +169,7 @@ World::World(const std::string &_name)
   // sdf::initFile causes disk access.
   this->dataPtr->factorySDF.reset(new sdf::SDF);
   sdf::initFile("root.sdf", this->dataPtr->factorySDF);
-
-  this->dataPtr->logPlayStateSDF.reset(new sdf::Element);
-  sdf::initFile("state.sdf", this->dataPtr->logPlayStateSDF);
+  this->dataPtr->factoryParser.reset(new FactoryParser);
 
   this->dataPtr->initialized = false;
   this->dataPtr->loaded = false;
@@ -134,7 +181,6 @@ World::World(const std::string &_name)
   this->dataPtr->sensorsInitialized = false;
 
   this->dataPtr->currentStateBuffer = 0;
-  this->dataPtr->stateToggle = 0;
 
   this->dataPtr->pluginsLoaded = false;
 
@@ -354,6 +400,13 @@ void World::Load(sdf::ElementPtr _sdf)
 
   this->dataPtr->physicsEngine->Load(physicsElem);
 
+  // This should come before loading of entities, since sensors register
+  // with it
+  this->dataPtr->rayQueryManager.reset(
+      new RayQueryManager(shared_from_this()));
+  this->dataPtr->modelSpatialIndex.reset(
+      new ModelSpatialIndex(shared_from_this()));
+
   // This should come before loading of entities
   sdf::ElementPtr windElem = this->dataPtr->sdf->GetElement("wind");
 
@@ -408,25 +461,46 @@ void World::Load(sdf::ElementPtr _sdf)
   this->dataPtr->rootElement.reset(new Base(BasePtr()));
   this->dataPtr->rootElement->SetName(this->Name());
   this->dataPtr->rootElement->SetWorld(shared_from_this());
+  this->IndexEntity(this->dataPtr->rootElement);
 
   // A special order is necessary when loading a world that contains state
   // information. The joints must be created last, otherwise they get
   // initialized improperly.
   {
+    this->PreloadAssets();
+
     // Create all the entities
+    common::Time startTime = common::Time::GetWallTime();
     this->LoadEntities(this->dataPtr->sdf, this->dataPtr->rootElement);
 
     for (unsigned int i = 0; i < this->ModelCount(); ++i)
       this->ModelByIndex(i)->LoadJoints();
+    this->dataPtr->loadEntitiesTime =
+      common::Time::GetWallTime() - startTime;
   }
 
-  // TODO: Performance test to see if TBB model updating is necessary
-  // Choose threaded or unthreaded model updating depending on the number of
-  // models in the scene
-  // if (this->ModelCount() < 20)
+  // Models are updated serially unless a parallel mode is requested with
+  // <gz:model_update> in the physics element.
   this->dataPtr->modelUpdateFunc = &World::ModelUpdateSingleLoop;
-  // else
-  // this->dataPtr->modelUpdateFunc = &World::ModelUpdateTBB;
+  const std::string kModelUpdate = "gz:model_update";
+  if (physicsElem->HasElement(kModelUpdate))
+  {
+    sdf::ElementPtr updateElem = physicsElem->GetElement(kModelUpdate);
+    if (updateElem->HasElement("grain_size"))
+    {
+      this->dataPtr->modelUpdateGrainSize = std::max(1u,
+          updateElem->Get<unsigned int>("grain_size"));
+    }
+    if (updateElem->HasElement("threads"))
+      this->SetModelUpdateThreads(updateElem->Get<unsigned int>("threads"));
+    if (updateElem->HasElement("mode") &&
+        !this->SetModelUpdateMode(updateElem->Get<std::string>("mode")))
+    {
+      gzerr << "Invalid <" << kModelUpdate << "><mode> ["
+            << updateElem->Get<std::string>("mode")
+            << "], using serial model updates.\n";
+    }
+  }
 
   event::Events::worldCreated(this->Name());
 
@@ -491,8 +565,17 @@ void World::Init(UpdateScenePosesFunc _func)
   }
 
   // Initialize all the entities (i.e. Model)
+  common::Time startTime = common::Time::GetWallTime();
   for (unsigned int i = 0; i < this->dataPtr->rootElement->GetChildCount(); ++i)
     this->dataPtr->rootElement->GetChild(i)->Init();
+  common::Time initEntitiesTime = common::Time::GetWallTime() - startTime;
+
+  gzmsg << "World [" << this->Name() << "] startup:\n"
+        << "\tpreload  [" << this->dataPtr->preloadTime.Double() << " s, "
+        << this->dataPtr->preloadedMeshes << " meshes]\n"
+        << "\tload     [" << this->dataPtr->loadEntitiesTime.Double()
+        << " s, " << this->ModelCount() << " models]\n"
+        << "\tinit     [" << initEntitiesTime.Double() << " s]\n";
 
   // Initialize the physics engine
   this->dataPtr->physicsEngine->Init();
@@ -503,12 +586,6 @@ void World::Init(UpdateScenePosesFunc _func)
   this->dataPtr->testRay = boost::dynamic_pointer_cast<RayShape>(
       this->Physics()->CreateShape("ray", CollisionPtr()));
 
-  this->dataPtr->prevStates[0].SetWorld(shared_from_this());
-  this->dataPtr->prevStates[1].SetWorld(shared_from_this());
-
-  this->dataPtr->prevStates[0].SetName(this->Name());
-  this->dataPtr->prevStates[1].SetName(this->Name());
-
   this->dataPtr->updateInfo.worldName = this->Name();
 
   this->dataPtr->iterations = 0;
@@ -614,9 +691,7 @@ void World::RunLoop()
   this->dataPtr->prevStepWallTime = common::Time::GetWallTime();
 
   // Get the first state
-  this->dataPtr->prevStates[0] = WorldState(shared_from_this());
-  this->dataPtr->prevStates[1] = WorldState(shared_from_this());
-  this->dataPtr->stateToggle = 0;
+  this->dataPtr->logRecordedState.Load(shared_from_this());
 
   this->dataPtr->logThread =
     new std::thread(std::bind(&World::LogWorker, this));
@@ -633,12 +708,20 @@ void World::RunLoop()
   else
   {
     this->dataPtr->enablePhysicsEngine = false;
+    this->dataPtr->logPlayPrefetcher.reset(new LogPlayPrefetcher);
+    this->dataPtr->logPlayPrefetcher->Start();
     for (this->dataPtr->iterations = 0; !this->dataPtr->stop &&
         (!this->dataPtr->stopIterations ||
          (this->dataPtr->iterations < this->dataPtr->stopIterations));)
     {
       this->LogStep();
     }
+
+    {
+      std::lock_guard<std::recursive_mutex> lk(
+          this->dataPtr->worldUpdateMutex);
+      this->dataPtr->logPlayPrefetcher.reset();
+    }
   }
 
   this->dataPtr->stop = true;
@@ -667,8 +750,9 @@ void World::LogStep()
       if (!this->IsPaused() && this->dataPtr->stepInc == 0)
         this->dataPtr->stepInc = 1;
 
-      std::string data;
-      if (!util::LogPlay::Instance()->Step(this->dataPtr->stepInc, data))
+      // The frame was read and parsed ahead by the prefetcher
+      if (!this->dataPtr->logPlayPrefetcher->Step(this->dataPtr->stepInc,
+            this->dataPtr->logPlayState))
       {
         // There are no more chunks, time to exit.
         this->SetPaused(true);
@@ -678,11 +762,6 @@ void World::LogStep()
       {
         this->dataPtr->stepInc = 1;
 
-        this->dataPtr->logPlayStateSDF->Clear();
-        sdf::readString(data, this->dataPtr->logPlayStateSDF);
-
-        this->dataPtr->logPlayState.Load(this->dataPtr->logPlayStateSDF);
-
         // If it's the first step, we're going back in time or
         // rt factor is close to zero, don't sleep.
         if ((this->dataPtr->logPlayRealTimeFactor > 1e-5) &&
@@ -982,6 +1061,23 @@ void World::Update()
     DIAG_TIMER_LAP("World::Update", "SetWorldPose(dirtyPoses)");
   }
 
+  if (this->dataPtr->rayQueryManager)
+  {
+    IGN_PROFILE_BEGIN("RayQueryManager::Update");
+    // Capture the poses set above for lock-free ray queries
+    this->dataPtr->rayQueryManager->Update();
+    IGN_PROFILE_END();
+    DIAG_TIMER_LAP("World::Update", "RayQueryManager::Update");
+  }
+
+  if (this->dataPtr->modelSpatialIndex)
+  {
+    IGN_PROFILE_BEGIN("ModelSpatialIndex::Update");
+    this->dataPtr->modelSpatialIndex->Update();
+    IGN_PROFILE_END();
+    DIAG_TIMER_LAP("World::Update", "ModelSpatialIndex::Update");
+  }
+
   IGN_PROFILE_BEGIN("LogRecordNotify");
   // Only update state information if logging data.
   if (util::LogRecord::Instance()->Running())
@@ -1031,7 +1127,7 @@ void World::Fini()
 
     this->dataPtr->deleteEntity.clear();
     this->dataPtr->requestMsgs.clear();
-    this->dataPtr->factoryMsgs.clear();
+    this->dataPtr->factoryParser->Fini();
     this->dataPtr->modelMsgs.clear();
     this->dataPtr->lightFactoryMsgs.clear();
     this->dataPtr->lightModifyMsgs.clear();
@@ -1089,9 +1185,6 @@ void World::Fini()
     this->dataPtr->rootElement->Fini();
     this->dataPtr->rootElement.reset();
   }
-  this->dataPtr->prevStates[0].SetWorld(WorldPtr());
-  this->dataPtr->prevStates[1].SetWorld(WorldPtr());
-  this->dataPtr->prevUnfilteredState.SetWorld(WorldPtr());
   this->dataPtr->logPlayState.SetWorld(WorldPtr());
   this->dataPtr->states[0].clear();
   this->dataPtr->states[1].clear();
@@ -1099,6 +1192,14 @@ void World::Fini()
   this->dataPtr->presetManager.reset();
   this->dataPtr->userCmdManager.reset();
 
+  if (this->dataPtr->rayQueryManager)
+    this->dataPtr->rayQueryManager->Fini();
+  this->dataPtr->rayQueryManager.reset();
+
+  if (this->dataPtr->modelSpatialIndex)
+    this->dataPtr->modelSpatialIndex->Fini();
+  this->dataPtr->modelSpatialIndex.reset();
+
   this->dataPtr->atmosphere.reset();
   this->dataPtr->wind.reset();
 
@@ -1182,6 +1283,18 @@ PresetManagerPtr World::PresetMgr() const
   return this->dataPtr->presetManager;
 }
 
+//////////////////////////////////////////////////
+RayQueryManagerPtr World::RayQueryMgr() const
+{
+  return this->dataPtr->rayQueryManager;
+}
+
+//////////////////////////////////////////////////
+ModelSpatialIndexPtr World::SpatialIndex() const
+{
+  return this->dataPtr->modelSpatialIndex;
+}
+
 //////////////////////////////////////////////////
 common::SphericalCoordinatesPtr World::SphericalCoords() const
 {
@@ -1223,17 +1336,145 @@ void World::SetMagneticField(const ignition::math::Vector3d &_mag)
 //////////////////////////////////////////////////
 BasePtr World::BaseByName(const std::string &_name) const
 {
-  if (this->dataPtr->rootElement)
-    return this->dataPtr->rootElement->GetByName(_name);
-  else
+  if (!this->dataPtr->rootElement)
     return BasePtr();
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->entityIndexMutex);
+
+    // Base::GetByName matches an entity by either its scoped name or its
+    // name. Collect the matches of both.
+    const Base *match = nullptr;
+    bool ambiguous = false;
+    auto scoped = this->dataPtr->entitiesByScopedName.equal_range(_name);
+    auto named = this->dataPtr->entitiesByName.equal_range(_name);
+    for (auto iter = scoped.first; iter != scoped.second && !ambiguous; ++iter)
+    {
+      ambiguous = match && match != iter->second;
+      match = iter->second;
+    }
+    for (auto iter = named.first; iter != named.second && !ambiguous; ++iter)
+    {
+      ambiguous = match && match != iter->second;
+      match = iter->second;
+    }
+
+    if (!match)
+      return BasePtr();
+
+    if (!ambiguous)
+      return this->dataPtr->indexedEntities.at(match).entity.lock();
+  }
+
+  // Several entities match, let the depth first search of the entity tree
+  // decide which one is returned.
+  return this->dataPtr->rootElement->GetByName(_name);
 }
 
 /////////////////////////////////////////////////
 ModelPtr World::ModelById(unsigned int _id) const
 {
-  return boost::dynamic_pointer_cast<Model>(
-      this->dataPtr->rootElement->GetByIdRecursive(_id));
+  BasePtr base;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->entityIndexMutex);
+    auto iter = this->dataPtr->entitiesById.find(_id);
+    if (iter != this->dataPtr->entitiesById.end())
+      base = this->dataPtr->indexedEntities.at(iter->second).entity.lock();
+  }
+
+  return boost::dynamic_pointer_cast<Model>(base);
+}
+
+/////////////////////////////////////////////////
+/// \brief Remove one value from a multimap entry.
+/// \param[in] _map Map to modify.
+/// \param[in] _key Key of the entry.
+/// \param[in] _entity Value to remove.
+static void EraseIndexEntry(
+    std::unordered_multimap<std::string, const Base *> &_map,
+    const std::string &_key, const Base *_entity)
+{
+  auto range = _map.equal_range(_key);
+  for (auto iter = range.first; iter != range.second; ++iter)
+  {
+    if (iter->second == _entity)
+    {
+      _map.erase(iter);
+      return;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void World::IndexEntity(const BasePtr &_entity)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->entityIndexMutex);
+
+  auto result = this->dataPtr->indexedEntities.emplace(
+      _entity.get(), WorldIndexedEntity());
+  WorldIndexedEntity &entry = result.first->second;
+  if (!result.second)
+  {
+    // Already indexed, for example because the entity was loaded twice.
+    EraseIndexEntry(this->dataPtr->entitiesByName, entry.name, _entity.get());
+    EraseIndexEntry(this->dataPtr->entitiesByScopedName, entry.scopedName,
+        _entity.get());
+  }
+
+  entry.entity = _entity;
+  entry.name = _entity->GetName();
+  entry.scopedName = _entity->GetScopedName();
+  entry.id = _entity->GetId();
+
+  this->dataPtr->entitiesByName.emplace(entry.name, _entity.get());
+  this->dataPtr->entitiesByScopedName.emplace(entry.scopedName,
+      _entity.get());
+  this->dataPtr->entitiesById[entry.id] = _entity.get();
+}
+
+/////////////////////////////////////////////////
+void World::ReindexEntity(const Base &_entity)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->entityIndexMutex);
+
+  auto iter = this->dataPtr->indexedEntities.find(&_entity);
+  if (iter == this->dataPtr->indexedEntities.end())
+    return;
+
+  WorldIndexedEntity &entry = iter->second;
+  EraseIndexEntry(this->dataPtr->entitiesByName, entry.name, &_entity);
+  EraseIndexEntry(this->dataPtr->entitiesByScopedName, entry.scopedName,
+      &_entity);
+
+  entry.name = _entity.GetName();
+  entry.scopedName = _entity.GetScopedName();
+
+  this->dataPtr->entitiesByName.emplace(entry.name, &_entity);
+  this->dataPtr->entitiesByScopedName.emplace(entry.scopedName, &_entity);
+}
+
+/////////////////////////////////////////////////
+void World::UnindexEntity(const Base &_entity)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->entityIndexMutex);
+
+  auto iter = this->dataPtr->indexedEntities.find(&_entity);
+  if (iter == this->dataPtr->indexedEntities.end())
+    return;
+
+  const WorldIndexedEntity &entry = iter->second;
+  EraseIndexEntry(this->dataPtr->entitiesByName, entry.name, &_entity);
+  EraseIndexEntry(this->dataPtr->entitiesByScopedName, entry.scopedName,
+      &_entity);
+
+  auto idIter = this->dataPtr->entitiesById.find(entry.id);
+  if (idIter != this->dataPtr->entitiesById.end() &&
+      idIter->second == &_entity)
+  {
+    this->dataPtr->entitiesById.erase(idIter);
+  }
+
+  this->dataPtr->indexedEntities.erase(iter);
 }
 
 //////////////////////////////////////////////////
@@ -1243,6 +1484,57 @@ ModelPtr World::ModelByName(const std::string &_name) const
   return boost::dynamic_pointer_cast<Model>(this->BaseByName(_name));
 }
 
+//////////////////////////////////////////////////
+/// \brief Add the models overlapping a box to a list, recursively.
+/// \param[in] _model The model.
+/// \param[in] _box The box.
+/// \param[out] _models The list.
+static void AddModelsInBox(const ModelPtr &_model,
+    const ignition::math::AxisAlignedBox &_box, Model_V &_models)
+{
+  if (!_model)
+    return;
+
+  // Same bounds as the spatial index: the bounding box extended to the
+  // origin of the model, or only the origin if it has no collisions.
+  const ignition::math::AxisAlignedBox modelBox = _model->BoundingBox();
+  const ignition::math::Vector3d origin = _model->WorldPose().Pos();
+  ignition::math::Vector3d min = origin;
+  ignition::math::Vector3d max = origin;
+  if (modelBox.Min().X() <= modelBox.Max().X() &&
+      modelBox.Min().Y() <= modelBox.Max().Y() &&
+      modelBox.Min().Z() <= modelBox.Max().Z())
+  {
+    min.Min(modelBox.Min());
+    max.Max(modelBox.Max());
+  }
+
+  if (min.X() <= _box.Max().X() && max.X() >= _box.Min().X() &&
+      min.Y() <= _box.Max().Y() && max.Y() >= _box.Min().Y() &&
+      min.Z() <= _box.Max().Z() && max.Z() >= _box.Min().Z())
+  {
+    _models.push_back(_model);
+  }
+
+  for (auto const &nested : _model->NestedModels())
+    AddModelsInBox(nested, _box, _models);
+}
+
+//////////////////////////////////////////////////
+Model_V World::ModelsInBox(const ignition::math::AxisAlignedBox &_box) const
+{
+  Model_V result;
+  if (this->dataPtr->modelSpatialIndex &&
+      this->dataPtr->modelSpatialIndex->ModelsInBox(_box, result))
+  {
+    return result;
+  }
+
+  for (auto const &model : this->Models())
+    AddModelsInBox(model, _box, result);
+  return result;
+}
+
 //////////////////////////////////////////////////
 LightPtr World::LightByName(const std::string &_name) const
 {
@@ -1298,6 +1590,65 @@ ModelPtr World::LoadModel(sdf::ElementPtr _sdf , BasePtr _parent)
   return model;
 }
 
+//////////////////////////////////////////////////
+Model_V World::LoadModels(const std::vector<sdf::ElementPtr> &_sdf,
+    BasePtr _parent)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->loadModelMutex);
+  Model_V result;
+
+  // Look up names in a set rather than going through all the models for
+  // each new one
+  std::unordered_set<std::string> names;
+  for (auto const &m : this->dataPtr->models)
+    names.insert(m->GetName());
+
+  for (auto const &elem : _sdf)
+  {
+    if (elem->GetName() != "model")
+    {
+      gzerr << "SDF is missing the <model> tag:\n";
+      continue;
+    }
+
+    std::string modelName = elem->Get<std::string>("name");
+    if (!names.insert(modelName).second)
+    {
+      gzwarn << "Model with name [" << modelName << "] already exists. "
+        << "Not inserting model.\n";
+      continue;
+    }
+
+    ModelPtr model;
+    try
+    {
+      model = this->dataPtr->physicsEngine->CreateModel(_parent);
+      model->SetWorld(shared_from_this());
+      model->Load(elem);
+    }
+    catch(...)
+    {
+      gzerr << "Loading model [" << modelName << "] failed\n";
+      continue;
+    }
+
+    event::Events::addEntity(model->GetScopedName());
+
+    msgs::Model msg;
+    model->FillMsg(msg);
+    this->dataPtr->modelPub->Publish(msg);
+
+    this->PublishModelPose(model);
+    this->dataPtr->models.push_back(model);
+    result.push_back(model);
+  }
+
+  if (!result.empty())
+    this->EnableAllModels();
+
+  return result;
+}
+
 //////////////////////////////////////////////////
 LightPtr World::LoadLight(const sdf::ElementPtr &_sdf, const BasePtr &_parent)
 {
@@ -1363,6 +1714,31 @@ RoadPtr World::LoadRoad(sdf::ElementPtr _sdf , BasePtr _parent)
   return road;
 }
 
+//////////////////////////////////////////////////
+void World::PreloadAssets()
+{
+  common::Time startTime = common::Time::GetWallTime();
+
+  std::vector<std::string> uris;
+  collectCollisionMeshes(this->dataPtr->sdf, uris);
+  if (this->dataPtr->sdf->HasElement("population"))
+  {
+    for (sdf::ElementPtr popElem = this->dataPtr->sdf->GetElement(
+         "population"); popElem;
+         popElem = popElem->GetNextElement("population"))
+    {
+      collectCollisionMeshes(popElem, uris);
+    }
+  }
+
+  // The meshes are loaded under the URI used by the mesh shapes, which then
+  // find them without resolving the URI again.
+  this->dataPtr->preloadedMeshes =
+    common::MeshManager::Instance()->Preload(uris);
+
+  this->dataPtr->preloadTime = common::Time::GetWallTime() - startTime;
+}
+
 //////////////////////////////////////////////////
 void World::LoadEntities(sdf::ElementPtr _sdf, BasePtr _parent)
 {
@@ -1596,8 +1972,7 @@ void World::SetPaused(const bool _p)
 //////////////////////////////////////////////////
 void World::OnFactoryMsg(ConstFactoryPtr &_msg)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
-  this->dataPtr->factoryMsgs.push_back(*_msg);
+  this->dataPtr->factoryParser->Push(*_msg);
 }
 
 //////////////////////////////////////////////////
@@ -1673,13 +2048,19 @@ void World::ProcessPlaybackControlMsgs()
     if (msg.has_seek())
     {
       common::Time targetSimTime = msgs::Convert(msg.seek());
-      util::LogPlay::Instance()->Seek(targetSimTime);
+      if (this->dataPtr->logPlayPrefetcher)
+        this->dataPtr->logPlayPrefetcher->Seek(targetSimTime);
+      else
+        util::LogPlay::Instance()->Seek(targetSimTime);
       this->dataPtr->stepInc = 1;
     }
 
     if (msg.has_rewind() && msg.rewind())
     {
-      util::LogPlay::Instance()->Rewind();
+      if (this->dataPtr->logPlayPrefetcher)
+        this->dataPtr->logPlayPrefetcher->Rewind();
+      else
+        util::LogPlay::Instance()->Rewind();
       this->dataPtr->stepInc = 1;
       if (!util::LogPlay::Instance()->HasIterations())
         this->dataPtr->iterations = 0;
@@ -1687,7 +2068,10 @@ void World::ProcessPlaybackControlMsgs()
 
     if (msg.has_forward() && msg.forward())
     {
-      util::LogPlay::Instance()->Forward();
+      if (this->dataPtr->logPlayPrefetcher)
+        this->dataPtr->logPlayPrefetcher->Forward();
+      else
+        util::LogPlay::Instance()->Forward();
       this->dataPtr->stepInc = -1;
       this->SetPaused(true);
       // ToDo: Update iterations if the log doesn't have it.
@@ -1763,12 +2147,77 @@ void World::BuildSceneMsg(msgs::Scene &_scene, BasePtr _entity)
 
 
 //////////////////////////////////////////////////
-// void World::ModelUpdateTBB()
-// {
-//   tbb::parallel_for (tbb::blocked_range<size_t>(0,
-//   this->dataPtr->models.size(), 10),
-//       ModelUpdate_TBB(&this->dataPtr->models));
-// }
+void World::PartitionModelUpdates()
+{
+  this->dataPtr->modelUpdateParallel.clear();
+  this->dataPtr->modelUpdateSerial.clear();
+
+  // Joint animations set joint positions and call their completion
+  // callback from Model::Update, neither of which is safe to run
+  // concurrently with other models, so those models are updated serially.
+  for (unsigned int i = 0; i < this->dataPtr->rootElement->GetChildCount(); ++i)
+  {
+    BasePtr child = this->dataPtr->rootElement->GetChild(i);
+    if (child->HasType(Base::MODEL) &&
+        boost::static_pointer_cast<Model>(child)->HasJointAnimation())
+    {
+      this->dataPtr->modelUpdateSerial.push_back(child);
+    }
+    else
+      this->dataPtr->modelUpdateParallel.push_back(child);
+  }
+}
+
+//////////////////////////////////////////////////
+void World::ModelUpdateTBB()
+{
+  this->PartitionModelUpdates();
+
+  tbb::blocked_range<size_t> range(0,
+      this->dataPtr->modelUpdateParallel.size(),
+      this->dataPtr->modelUpdateGrainSize);
+  ModelUpdate_TBB body(this->dataPtr->modelUpdateParallel);
+
+  if (this->dataPtr->modelUpdateArena)
+  {
+    this->dataPtr->modelUpdateArena->execute([&]()
+    {
+      tbb::parallel_for(range, body);
+    });
+  }
+  else
+    tbb::parallel_for(range, body);
+
+  for (auto &entity : this->dataPtr->modelUpdateSerial)
+    entity->Update();
+}
+
+//////////////////////////////////////////////////
+void World::ModelUpdateDeterministic()
+{
+  this->PartitionModelUpdates();
+
+  // The static partitioner hands each worker the same contiguous chunk of
+  // models every step and disables stealing, so a model is always updated
+  // by the same worker and in the same relative order as the serial loop.
+  tbb::blocked_range<size_t> range(0,
+      this->dataPtr->modelUpdateParallel.size(),
+      this->dataPtr->modelUpdateGrainSize);
+  ModelUpdate_TBB body(this->dataPtr->modelUpdateParallel);
+
+  if (this->dataPtr->modelUpdateArena)
+  {
+    this->dataPtr->modelUpdateArena->execute([&]()
+    {
+      tbb::parallel_for(range, body, tbb::static_partitioner());
+    });
+  }
+  else
+    tbb::parallel_for(range, body, tbb::static_partitioner());
+
+  for (auto &entity : this->dataPtr->modelUpdateSerial)
+    entity->Update();
+}
 
 //////////////////////////////////////////////////
 void World::ModelUpdateSingleLoop()
@@ -1909,8 +2358,7 @@ void World::ProcessRequestMsgs()
     }
     else if (requestMsg.request() == "entity_info")
     {
-      BasePtr entity(
-        this->dataPtr->rootElement->GetByName(requestMsg.data()));
+      BasePtr entity(this->BaseByName(requestMsg.data()));
       if (entity)
       {
         if (entity->HasType(Base::MODEL))
@@ -2168,57 +2616,24 @@ void World::ProcessLightFactoryMsgs()
 void World::ProcessFactoryMsgs()
 {
   IGN_PROFILE("World::ProcessFactoryMsgs");
-  std::list<sdf::ElementPtr> modelsToLoad, lightsToLoad;
+  std::vector<sdf::ElementPtr> modelsToLoad;
+  std::list<sdf::ElementPtr> lightsToLoad;
 
-  std::list<msgs::Factory> factoryMsgsCopy;
-  {
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  // The SDF of the messages was parsed in the background. Messages are
+  // handled in the order they were received, as soon as they are parsed.
+  msgs::Factory factoryMsg;
+  sdf::ElementPtr root;
 
-    std::copy(this->dataPtr->factoryMsgs.begin(),
-      this->dataPtr->factoryMsgs.end(),
-      std::back_inserter(factoryMsgsCopy));
-    this->dataPtr->factoryMsgs.clear();
-  }
+  // Names given to instances of bulk spawns, which aren't loaded yet
+  std::unordered_set<std::string> instanceNames;
 
-  for (auto const &factoryMsg : factoryMsgsCopy)
+  while (this->dataPtr->factoryParser->Pop(factoryMsg, root))
   {
-
-    this->dataPtr->factorySDF->Clear();
-
-    if (factoryMsg.has_sdf() && !factoryMsg.sdf().empty())
+    if (FactoryParser::HasSDF(factoryMsg))
     {
-      // SDF Parsing happens here
-      if (!sdf::readString(factoryMsg.sdf(), this->dataPtr->factorySDF))
-      {
-        gzerr << "Unable to read sdf string[" << factoryMsg.sdf() << "]\n";
+      // The parser printed the error
+      if (!root)
         continue;
-      }
-    }
-    else if (factoryMsg.has_sdf_filename() &&
-            !factoryMsg.sdf_filename().empty())
-    {
-      std::string filename;
-      // If http(s), look at Fuel
-      auto uri = ignition::common::URI(factoryMsg.sdf_filename());
-      if (uri.Valid() && (uri.Scheme() == "https" || uri.Scheme() == "http"))
-      {
-        filename = common::FuelModelDatabase::Instance()->ModelFile(
-            factoryMsg.sdf_filename());
-      }
-      // Otherwise, look at database
-      else
-      {
-        filename = common::ModelDatabase::Instance()->GetModelFile(
-            factoryMsg.sdf_filename());
-      }
-
-      if (!sdf::readFile(filename, this->dataPtr->factorySDF))
-      {
-        gzerr << "Unable to read sdf file [" << filename << "]\n";
-        continue;
-      }
-
-      common::convertToFullPaths(this->dataPtr->factorySDF->Root());
     }
     else if (factoryMsg.has_clone_model_name())
     {
@@ -2230,14 +2645,14 @@ void World::ProcessFactoryMsgs()
         continue;
       }
 
-      this->dataPtr->factorySDF->Root()->InsertElement(
-          model->GetSDF()->Clone());
+      this->dataPtr->factorySDF->Clear();
+      root = this->dataPtr->factorySDF->Root()->Clone();
+      root->InsertElement(model->GetSDF()->Clone());
 
       std::string newName = model->GetName() + "_clone";
       newName = this->UniqueModelName(newName);
 
-      this->dataPtr->factorySDF->Root()->GetElement("model")->GetAttribute(
-          "name")->Set(newName);
+      root->GetElement("model")->GetAttribute("name")->Set(newName);
     }
     else
     {
@@ -2248,15 +2663,14 @@ void World::ProcessFactoryMsgs()
 
     if (factoryMsg.has_edit_name())
     {
-      BasePtr base(
-        this->dataPtr->rootElement->GetByName(factoryMsg.edit_name()));
+      BasePtr base(this->BaseByName(factoryMsg.edit_name()));
       if (base)
       {
         sdf::ElementPtr elem;
-        if (this->dataPtr->factorySDF->Root()->GetName() == "sdf")
-          elem = this->dataPtr->factorySDF->Root()->GetFirstElement();
+        if (root->GetName() == "sdf")
+          elem = root->GetFirstElement();
         else
-          elem = this->dataPtr->factorySDF->Root();
+          elem = root;
 
         base->UpdateParameters(elem);
       }
@@ -2267,14 +2681,8 @@ void World::ProcessFactoryMsgs()
       bool isModel = false;
       bool isLight = false;
 
-      sdf::ElementPtr elem = this->dataPtr->factorySDF->Root()->Clone();
-
-      if (!elem)
-      {
-        gzerr << "Invalid SDF:";
-        this->dataPtr->factorySDF->Root()->PrintValues("");
-        continue;
-      }
+      // The root element belongs to this message, no need to clone it
+      sdf::ElementPtr elem = root;
 
       if (elem->HasElement("world"))
         elem = elem->GetElement("world");
@@ -2297,7 +2705,7 @@ void World::ProcessFactoryMsgs()
       else
       {
         gzerr << "Unable to find a model, light, or actor in:\n";
-        this->dataPtr->factorySDF->Root()->PrintValues("");
+        root->PrintValues("");
         continue;
       }
 
@@ -2308,6 +2716,11 @@ void World::ProcessFactoryMsgs()
         elem->GetElement("pose")->Set(msgs::ConvertIgn(factoryMsg.pose()));
       }
 
+      if (factoryMsg.instance_pose_size() > 0 && !isModel)
+      {
+        gzwarn << "Only models can be instanced, creating a single copy.\n";
+      }
+
       if (isActor)
       {
         ActorPtr actor = this->LoadActor(elem, this->dataPtr->rootElement);
@@ -2324,6 +2737,56 @@ void World::ProcessFactoryMsgs()
           continue;
         }
 
+        // Bulk spawn: one model per instance pose, all cloned from the same
+        // element
+        if (factoryMsg.instance_pose_size() > 0)
+        {
+          const int count = factoryMsg.instance_pose_size();
+          for (int i = 0; i < count; ++i)
+          {
+            sdf::ElementPtr instance = i + 1 < count ? elem->Clone() : elem;
+
+            std::string name;
+            if (i < factoryMsg.instance_name_size())
+              name = factoryMsg.instance_name(i);
+            if (name.empty())
+              name = entityName + "_" + std::to_string(i);
+
+            if (this->ModelByName(name) || instanceNames.count(name))
+            {
+              if (!factoryMsg.allow_renaming())
+              {
+                gzwarn << "A model named [" << name << "] already exists "
+                      << "and allow_renaming is false. Model won't be "
+                      << "inserted." << std::endl;
+                continue;
+              }
+
+              std::string unique;
+              int suffix = 0;
+              do
+              {
+                unique = name + "_" + std::to_string(suffix++);
+              }
+              while (this->ModelByName(unique) || instanceNames.count(unique));
+              name = unique;
+            }
+            instanceNames.insert(name);
+
+            instance->GetAttribute("name")->Set(name);
+            instance->GetElement("pose")->Set(
+                msgs::ConvertIgn(factoryMsg.instance_pose(i)));
+            if (instance != elem)
+            {
+              instance->SetParent(this->dataPtr->sdf);
+              this->dataPtr->sdf->InsertElement(instance);
+            }
+
+            modelsToLoad.push_back(instance);
+          }
+          continue;
+        }
+
         // Model with the given name already exists
         if (this->ModelByName(entityName))
         {
@@ -2349,23 +2812,24 @@ void World::ProcessFactoryMsgs()
     }
   }
 
-  // Load models
-  for (auto const &elem : modelsToLoad)
+  // Load models, all at once
+  if (!modelsToLoad.empty())
   {
-    try
-    {
-      std::lock_guard<std::mutex> lock(this->dataPtr->factoryDeleteMutex);
+    std::lock_guard<std::mutex> lock(this->dataPtr->factoryDeleteMutex);
 
-      ModelPtr model = this->LoadModel(elem, this->dataPtr->rootElement);
-      if (model != nullptr)
+    Model_V models = this->LoadModels(modelsToLoad,
+        this->dataPtr->rootElement);
+    for (auto const &model : models)
+    {
+      try
       {
         model->Init();
         model->LoadPlugins(this->dataPtr->modelPluginLoadingTimeout);
       }
-    }
-    catch(...)
-    {
-      gzerr << "Loading model from factory message failed\n";
+      catch(...)
+      {
+        gzerr << "Loading model from factory message failed\n";
+      }
     }
   }
 
@@ -2432,8 +2896,14 @@ void World::SetState(const WorldState &_state)
            << insertion
            << "</sdf>";
 
-    // SDF Parsing happens here
-    if (!sdf::readString(sdfStr.str(), this->dataPtr->factorySDF))
+    // SDF Parsing happens here. The log playback prefetcher and the
+    // factory parser may be parsing at the same time.
+    bool parsed;
+    {
+      std::lock_guard<std::mutex> lock(common::sdfParseMutex());
+      parsed = sdf::readString(sdfStr.str(), this->dataPtr->factorySDF);
+    }
+    if (!parsed)
     {
       gzerr << "Unable to read sdf string[" << insertion << "]" << std::endl;
       continue;
@@ -2549,28 +3019,42 @@ void World::SetState(const WorldState &_state)
 //////////////////////////////////////////////////
 void World::InsertModelFile(const std::string &_sdfFilename)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
   msgs::Factory msg;
   msg.set_sdf_filename(_sdfFilename);
-  this->dataPtr->factoryMsgs.push_back(msg);
+  this->dataPtr->factoryParser->Push(msg);
 }
 
 //////////////////////////////////////////////////
 void World::InsertModelSDF(const sdf::SDF &_sdf)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
   msgs::Factory msg;
   msg.set_sdf(_sdf.ToString());
-  this->dataPtr->factoryMsgs.push_back(msg);
+  this->dataPtr->factoryParser->Push(msg);
 }
 
 //////////////////////////////////////////////////
 void World::InsertModelString(const std::string &_sdfString)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
   msgs::Factory msg;
   msg.set_sdf(_sdfString);
-  this->dataPtr->factoryMsgs.push_back(msg);
+  this->dataPtr->factoryParser->Push(msg);
+}
+
+//////////////////////////////////////////////////
+void World::InsertModelInstances(const std::string &_sdfString,
+    const std::vector<ignition::math::Pose3d> &_poses,
+    const std::vector<std::string> &_names)
+{
+  if (_poses.empty())
+    return;
+
+  msgs::Factory msg;
+  msg.set_sdf(_sdfString);
+  for (auto const &pose : _poses)
+    msgs::Set(msg.add_instance_pose(), pose);
+  for (auto const &name : _names)
+    msg.add_instance_name(name);
+  this->dataPtr->factoryParser->Push(msg);
 }
 
 //////////////////////////////////////////////////
@@ -2733,7 +3217,7 @@ bool World::OnLog(std::ostringstream &_stream)
     for (auto const &worldState : this->dataPtr->states[bufferIndex])
     {
       _stream << "<sdf version='" << SDF_VERSION << "'>"
-              << worldState
+              << worldState.ToWorldState()
               << "</sdf>";
     }
 
@@ -2753,6 +3237,7 @@ bool World::OnLog(std::ostringstream &_stream)
     {
       _stream << "<sdf version='" << SDF_VERSION << "'>"
         << this->dataPtr->states[this->dataPtr->currentStateBuffer^1][i]
+           .ToWorldState()
         << "</sdf>";
     }
 
@@ -2762,15 +3247,14 @@ bool World::OnLog(std::ostringstream &_stream)
     {
       _stream << "<sdf version='" << SDF_VERSION << "'>"
         << this->dataPtr->states[this->dataPtr->currentStateBuffer][i]
+           .ToWorldState()
         << "</sdf>";
     }
 
     // Clear everything.
     this->dataPtr->states[0].clear();
     this->dataPtr->states[1].clear();
-    this->dataPtr->stateToggle = 0;
-    this->dataPtr->prevStates[0] = WorldState();
-    this->dataPtr->prevStates[1] = WorldState();
+    this->dataPtr->logRecordedState = WorldStateSnapshot();
   }
 
   this->LogModelResources();
@@ -3023,64 +3507,55 @@ void World::LogWorker()
 
   GZ_ASSERT(self, "Self pointer to World is invalid");
 
-  // Init the prevUnfilteredState
-  this->dataPtr->prevUnfilteredState.Load(self);
+  // Init the previous entities
+  this->dataPtr->logPrevEntities.LoadEntities(self);
+
+  std::vector<std::string> insertions;
+  std::vector<std::string> deletions;
 
   while (!this->dataPtr->stop)
   {
-    // get unfiltered world state
-    WorldState unfilteredState;
+    // Find out about insertions and deletions. Only model and light names
+    // are needed, poses are captured below at the log recording rate.
     {
       std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
-      unfilteredState.Load(self);
+      this->dataPtr->logEntities.LoadEntities(self);
     }
 
-    // compute world state diff and find out about insertions and deletions
-    std::vector<std::string> insertions;
-    std::vector<std::string> deletions;
-    bool insertDelete = false;
-
-    {
-      WorldState unfilteredDiffState = unfilteredState -
-          this->dataPtr->prevUnfilteredState;
-      if (!unfilteredDiffState.IsZero())
-      {
-        insertions = unfilteredDiffState.Insertions();
-        deletions = unfilteredDiffState.Deletions();
-        insertDelete = !insertions.empty() || !deletions.empty();
-      }
-    }
-    this->dataPtr->prevUnfilteredState = unfilteredState;
+    insertions.clear();
+    deletions.clear();
+    this->dataPtr->logEntities.EntityChanges(this->dataPtr->logPrevEntities,
+        self, insertions, deletions);
+    bool insertDelete = !insertions.empty() || !deletions.empty();
+    std::swap(this->dataPtr->logEntities, this->dataPtr->logPrevEntities);
 
     // Throttle state capture based on log recording frequency.
     auto simTime = this->SimTime();
     if ((simTime - this->dataPtr->logLastStateTime >=
         util::LogRecord::Instance()->Period()) || insertDelete)
     {
-      int currState = (this->dataPtr->stateToggle + 1) % 2;
-
-      std::string filterStr = util::LogRecord::Instance()->Filter();
-      // compute diff for filtered states
+      // The filter is only recompiled when it changes
+      this->dataPtr->logState.SetFilter(util::LogRecord::Instance()->Filter());
       {
         std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
-        this->dataPtr->prevStates[currState].LoadWithFilter(self, filterStr);
+        this->dataPtr->logState.Load(self);
       }
-      WorldState diffState = this->dataPtr->prevStates[currState] -
-          this->dataPtr->prevStates[this->dataPtr->stateToggle];
       this->dataPtr->logPrevIteration = this->dataPtr->iterations;
 
-      if (!diffState.IsZero() || insertDelete)
+      if (insertDelete ||
+          this->dataPtr->logState.Differs(this->dataPtr->logRecordedState))
       {
-        this->dataPtr->stateToggle = currState;
+        this->dataPtr->logState.SetInsertions(insertions);
+        this->dataPtr->logState.SetDeletions(deletions);
         {
           // Store the entire current state (instead of the diffState). A slow
           // moving link may never be captured if only diff state is recorded.
+          // The snapshot is converted to a WorldState by OnLog, outside of
+          // this thread.
           std::lock_guard<std::mutex> bLock(this->dataPtr->logBufferMutex);
 
-          this->dataPtr->prevStates[currState].SetInsertions(insertions);
-          this->dataPtr->prevStates[currState].SetDeletions(deletions);
           this->dataPtr->states[this->dataPtr->currentStateBuffer].push_back(
-              this->dataPtr->prevStates[currState]);
+              this->dataPtr->logState);
 
           // Tell the logger to update, once the number of states exceeds 1000
           if (this->dataPtr->states[this->dataPtr->currentStateBuffer].size() >
@@ -3089,6 +3564,10 @@ void World::LogWorker()
             util::LogRecord::Instance()->Notify();
           }
         }
+
+        // Keep the recorded state to compare against, and reuse the memory
+        // of the previous one for the next capture.
+        std::swap(this->dataPtr->logState, this->dataPtr->logRecordedState);
       }
 
       this->dataPtr->logLastStateTime = simTime;
@@ -3310,6 +3789,53 @@ void World::SetAtmosphereEnabled(const bool _enable)
   this->dataPtr->enableAtmosphere = _enable;
 }
 
+/////////////////////////////////////////////////
+bool World::SetModelUpdateMode(const std::string &_mode)
+{
+  void (World::*func)() = nullptr;
+  if (_mode == "serial")
+    func = &World::ModelUpdateSingleLoop;
+  else if (_mode == "parallel")
+    func = &World::ModelUpdateTBB;
+  else if (_mode == "deterministic")
+    func = &World::ModelUpdateDeterministic;
+  else
+  {
+    gzerr << "Unknown model update mode [" << _mode << "]\n";
+    return false;
+  }
+
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+  this->dataPtr->modelUpdateMode = _mode;
+  this->dataPtr->modelUpdateFunc = func;
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::string World::ModelUpdateMode() const
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+  return this->dataPtr->modelUpdateMode;
+}
+
+/////////////////////////////////////////////////
+void World::SetModelUpdateThreads(const unsigned int _threads)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+  this->dataPtr->modelUpdateThreads = _threads;
+  if (_threads == 0)
+    this->dataPtr->modelUpdateArena.reset();
+  else
+    this->dataPtr->modelUpdateArena.reset(new tbb::task_arena(_threads));
+}
+
+/////////////////////////////////////////////////
+unsigned int World::ModelUpdateThreads() const
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+  return this->dataPtr->modelUpdateThreads;
+}
+
 /////////////////////////////////////////////////
 void World::_AddDirty(Entity *_entity)
 {
@@ -26,6 +26,8 @@
 
 #include <boost/enable_shared_from_this.hpp>
 
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Pose3.hh>
 #include <sdf/sdf.hh>
 
 #include "gazebo/transport/TransportTypes.hh"
@@ -152,6 +154,16 @@ namespace gazebo
       /// \return Pointer to the preset manager.
       public: PresetManagerPtr PresetMgr() const;
 
+      /// \brief Return the ray query manager, which answers ray queries
+      /// from sensor threads without locking the physics engine.
+      /// \return Pointer to the ray query manager.
+      public: RayQueryManagerPtr RayQueryMgr() const;
+
+      /// \brief Return the spatial index of the model bounding boxes, used
+      /// by sensors and plugins that query regions of the world.
+      /// \return Pointer to the spatial index.
+      public: ModelSpatialIndexPtr SpatialIndex() const;
+
       /// \brief Get a reference to the wind used by the world.
       /// \return Reference to the wind.
       public: physics::Wind &Wind() const;
@@ -262,6 +274,15 @@ namespace gazebo
       /// \return A pointer to the Model, or NULL if no model was found.
       public: ModelPtr ModelByName(const std::string &_name) const;
 
+      /// \brief Get the models, nested models included, whose bounding box
+      /// or origin overlaps a box. The spatial index is used when it has
+      /// users, see SpatialIndex(), otherwise every model is tested.
+      /// \param[in] _box The box, in world coordinates.
+      /// \return The models, in the order of a depth first traversal of
+      /// Models().
+      public: Model_V ModelsInBox(
+                  const ignition::math::AxisAlignedBox &_box) const;
+
       /// \brief Get a light by name.
       /// This function is the same as BaseByName(), but limits the search to
       /// only lights.
@@ -313,6 +334,18 @@ namespace gazebo
       /// \param[in] _sdf A reference to an SDF object.
       public: void InsertModelSDF(const sdf::SDF &_sdf);
 
+      /// \brief Insert many copies of a model from an SDF string.
+      /// The string is parsed once, and all the copies are loaded in a
+      /// single batch.
+      /// \param[in] _sdfString A string containing valid SDF markup of a
+      /// model.
+      /// \param[in] _poses World pose of each copy.
+      /// \param[in] _names Name of each copy. If shorter than _poses, the
+      /// remaining copies are named after the model followed by their index.
+      public: void InsertModelInstances(const std::string &_sdfString,
+                  const std::vector<ignition::math::Pose3d> &_poses,
+                  const std::vector<std::string> &_names = {});
+
       /// \brief Return a version of the name with "<world_name>::" removed
       /// \param[in] _name Usually the name of an entity.
       /// \return The stripped world name.
@@ -372,6 +405,44 @@ namespace gazebo
       /// \param[in] _enable True to enable the atmosphere model.
       public: void SetAtmosphereEnabled(const bool _enable);
 
+      /// \brief Set the strategy used to update models every step.
+      /// Valid modes are:
+      ///   -# "serial" - update models one after another on the physics
+      ///      thread (default).
+      ///   -# "parallel" - partition models over a work-stealing TBB pool.
+      ///   -# "deterministic" - statically partition models over the pool
+      ///      so each model is always updated by the same worker, in index
+      ///      order. Provided models do not share state, the result is
+      ///      identical to the serial mode.
+      /// The parallel modes call Model::Update concurrently for different
+      /// models, so joint controllers and anything reached from them must
+      /// not share state across models. Models playing a joint animation
+      /// (Model::SetJointAnimation) are updated after the others on the
+      /// physics thread, since applying the animation and calling its
+      /// completion callback isn't thread-safe. Joint animations must not
+      /// be set while models are updated, but e.g. from a world update
+      /// callback or while the world is paused.
+      /// The mode can also be set from SDF with
+      /// <physics><gz:model_update><mode>.
+      /// \param[in] _mode Name of the model update mode.
+      /// \return True if the mode is valid and was applied.
+      public: bool SetModelUpdateMode(const std::string &_mode);
+
+      /// \brief Get the strategy used to update models every step.
+      /// \return Name of the model update mode.
+      /// \sa SetModelUpdateMode
+      public: std::string ModelUpdateMode() const;
+
+      /// \brief Set the number of threads used by the parallel model update
+      /// modes.
+      /// \param[in] _threads Number of threads, 0 lets TBB decide.
+      public: void SetModelUpdateThreads(const unsigned int _threads);
+
+      /// \brief Get the number of threads used by the parallel model update
+      /// modes.
+      /// \return Number of threads, 0 if TBB decides.
+      public: unsigned int ModelUpdateThreads() const;
+
       /// \brief Update the state SDF value from the current state.
       public: void UpdateStateSDF();
 
@@ -480,11 +551,31 @@ namespace gazebo
       private: ModelPtr ModelById(const unsigned int _id) const;
       /// \endcond
 
+      /// \brief Add an entity to the index used by BaseByName and
+      /// ModelById, or update its entry. Called by Base once the entity has
+      /// been added to the entity tree.
+      /// \param[in] _entity Entity to index.
+      private: void IndexEntity(const BasePtr &_entity);
+
+      /// \brief Update the entry of an entity whose name changed. Does
+      /// nothing if the entity is not indexed.
+      /// \param[in] _entity Renamed entity.
+      private: void ReindexEntity(const Base &_entity);
+
+      /// \brief Remove an entity from the index.
+      /// \param[in] _entity Entity to remove.
+      private: void UnindexEntity(const Base &_entity);
+
       /// \brief Load all plugins.
       ///
       /// Load all plugins specified in the SDF for the model.
       private: void LoadPlugins();
 
+      /// \brief Load the collision meshes of the world in parallel, before
+      /// the entities are created, so that the mesh shapes find them in the
+      /// MeshManager.
+      private: void PreloadAssets();
+
       /// \brief Create and load all entities.
       /// \param[in] _sdf SDF element.
       /// \param[in] _parent Parent of the model to load.
@@ -496,6 +587,14 @@ namespace gazebo
       /// \return Pointer to the newly created Model.
       private: ModelPtr LoadModel(sdf::ElementPtr _sdf, BasePtr _parent);
 
+      /// \brief Load a batch of models, as LoadModel does for each of them.
+      /// A model that fails to load is skipped.
+      /// \param[in] _sdf SDF elements containing the Model descriptions.
+      /// \param[in] _parent Parent of the models.
+      /// \return The newly created models, in order.
+      private: Model_V LoadModels(const std::vector<sdf::ElementPtr> &_sdf,
+                   BasePtr _parent);
+
       /// \brief Load a light.
       /// \param[in] _sdf SDF element containing the Light description.
       /// \param[in] _parent Parent of the light.
@@ -564,9 +663,17 @@ namespace gazebo
       /// \param[in] _msg The model message.
       private: void OnModelMsg(ConstModelPtr &_msg);
 
+      /// \brief Split the models between the ones that the parallel model
+      /// update modes may update concurrently and the ones they must update
+      /// afterwards on the physics thread.
+      private: void PartitionModelUpdates();
+
       /// \brief TBB version of model updating.
       private: void ModelUpdateTBB();
 
+      /// \brief TBB version of model updating with a static partition.
+      private: void ModelUpdateDeterministic();
+
       /// \brief Single loop version of model updating.
       private: void ModelUpdateSingleLoop();
 
@@ -706,6 +813,9 @@ namespace gazebo
 
       /// Friend SimbodyPhysics so that it has access to dataPtr->dirtyPoses
       private: friend class SimbodyPhysics;
+
+      /// Friend Base so that entities can maintain the entity index
+      private: friend class Base;
     };
     /// \}
   }
@@ -28,6 +28,9 @@
 #include <mutex>
 #include <thread>
 #include <condition_variable>
+#include <unordered_map>
+
+#include <tbb/task_arena.h>
 
 #include <ignition/transport.hh>
 
@@ -39,13 +42,32 @@
 
 #include "gazebo/transport/TransportTypes.hh"
 
+#include "gazebo/physics/FactoryParser.hh"
+#include "gazebo/physics/LogPlayPrefetcher.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/WorldState.hh"
+#include "gazebo/physics/WorldStateSnapshot.hh"
 
 namespace gazebo
 {
   namespace physics
   {
+    /// \brief Entry of the entity index kept by World.
+    class WorldIndexedEntity
+    {
+      /// \brief The indexed entity.
+      public: boost::weak_ptr<Base> entity;
+
+      /// \brief Name under which the entity is indexed.
+      public: std::string name;
+
+      /// \brief Scoped name under which the entity is indexed.
+      public: std::string scopedName;
+
+      /// \brief Id under which the entity is indexed.
+      public: uint32_t id = 0;
+    };
+
     /// \brief Private data class for World.
     class WorldPrivate
     {
@@ -158,6 +180,39 @@ namespace gazebo
       /// \brief Function pointer to the model update function.
       public: void (World::*modelUpdateFunc)();
 
+      /// \brief Name of the current model update mode.
+      /// \sa World::SetModelUpdateMode
+      public: std::string modelUpdateMode = "serial";
+
+      /// \brief Number of threads used by the parallel model update modes.
+      /// Zero lets TBB decide.
+      public: unsigned int modelUpdateThreads = 0;
+
+      /// \brief Minimum number of models handed to a worker at once by the
+      /// parallel model update modes.
+      public: unsigned int modelUpdateGrainSize = 1;
+
+      /// \brief Arena that bounds the number of threads used by the
+      /// parallel model update modes. Null if modelUpdateThreads is zero.
+      public: std::unique_ptr<tbb::task_arena> modelUpdateArena;
+
+      /// \brief Entities the parallel model update modes update
+      /// concurrently. Refilled every step by World::PartitionModelUpdates.
+      public: Base_V modelUpdateParallel;
+
+      /// \brief Models the parallel model update modes update after the
+      /// others, on the physics thread.
+      public: Base_V modelUpdateSerial;
+
+      /// \brief Wall time spent preloading the assets of the world.
+      public: common::Time preloadTime;
+
+      /// \brief Number of meshes loaded by the preload stage.
+      public: unsigned int preloadedMeshes = 0;
+
+      /// \brief Wall time spent loading the entities of the world.
+      public: common::Time loadEntitiesTime;
+
       /// \brief Last time a world statistics message was sent.
       public: common::Time prevStatTime;
 
@@ -208,8 +263,8 @@ namespace gazebo
       /// \brief Request message buffer.
       public: std::list<msgs::Request> requestMsgs;
 
-      /// \brief Factory message buffer.
-      public: std::list<msgs::Factory> factoryMsgs;
+      /// \brief Factory messages, parsed in the background.
+      public: std::unique_ptr<FactoryParser> factoryParser;
 
       /// \brief Model message buffer.
       public: std::list<msgs::Model> modelMsgs;
@@ -266,23 +321,28 @@ namespace gazebo
       public: common::Time processMsgsPeriod;
 
       /// \brief Alternating buffer of states.
-      public: std::deque<WorldState> states[2];
+      public: std::deque<WorldStateSnapshot> states[2];
 
       /// \brief Keep track of current state buffer being updated
       public: int currentStateBuffer;
 
-      /// \brief Buffer of prev states
-      public: WorldState prevStates[2];
+      /// \brief Last state stored in the state buffer.
+      public: WorldStateSnapshot logRecordedState;
+
+      /// \brief Filtered state captured by the log worker.
+      public: WorldStateSnapshot logState;
 
-      /// \brief Previous unfiltered state. Used for determining insertions
-      /// and deletions
-      public: WorldState prevUnfilteredState;
+      /// \brief Models and lights captured by the log worker in the current
+      /// iteration. Used for determining insertions and deletions
+      public: WorldStateSnapshot logEntities;
 
-      /// \brief Int used to toggle between prevStates
-      public: int stateToggle;
+      /// \brief Models and lights captured by the log worker in the
+      /// previous iteration.
+      public: WorldStateSnapshot logPrevEntities;
 
-      /// \brief State from from log file.
-      public: sdf::ElementPtr logPlayStateSDF;
+      /// \brief Reads and parses the frames of the log file ahead of
+      /// playback.
+      public: std::unique_ptr<LogPlayPrefetcher> logPlayPrefetcher;
 
       /// \brief Current state when playing from a log file.
       public: WorldState logPlayState;
@@ -352,6 +412,12 @@ namespace gazebo
       /// \brief Class to manage preset simulation parameter profiles.
       public: PresetManagerPtr presetManager;
 
+      /// \brief Lock-free ray queries against a snapshot of the world.
+      public: RayQueryManagerPtr rayQueryManager;
+
+      /// \brief Index of the model bounding boxes, for region queries.
+      public: ModelSpatialIndexPtr modelSpatialIndex;
+
       /// \brief Class to manage user commands.
       public: UserCmdManagerPtr userCmdManager;
 
@@ -404,6 +470,25 @@ namespace gazebo
 
       /// \brief Shininess values from scene SDF
       public: std::map<std::string, double> materialShininessMap;
+
+      /// \brief Every entity in the entity tree, keyed by its address.
+      /// Used by BaseByName and ModelById instead of walking the tree.
+      public: std::unordered_map<const Base *, WorldIndexedEntity>
+              indexedEntities;
+
+      /// \brief Indexed entities keyed by name.
+      public: std::unordered_multimap<std::string, const Base *>
+              entitiesByName;
+
+      /// \brief Indexed entities keyed by scoped name.
+      public: std::unordered_multimap<std::string, const Base *>
+              entitiesByScopedName;
+
+      /// \brief Indexed entities keyed by id.
+      public: std::unordered_map<uint32_t, const Base *> entitiesById;
+
+      /// \brief Protects the entity index.
+      public: std::mutex entityIndexMutex;
     };
   }
 }
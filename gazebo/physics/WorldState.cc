@@ -17,8 +17,11 @@
 /* Desc: A world state
  * Author: Nate Koenig
  */
+#include <mutex>
+
 #include <boost/algorithm/string.hpp>
 
+#include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/physics/World.hh"
@@ -354,6 +357,10 @@ const std::vector<std::string> &WorldState::Insertions() const
 /////////////////////////////////////////////////
 void WorldState::SetInsertions(const std::vector<std::string> &_insertions)
 {
+  // This is called from the log threads, while other threads may be
+  // parsing SDF too. The lock also protects rootSDF.
+  std::lock_guard<std::mutex> lock(common::sdfParseMutex());
+
   static sdf::SDFPtr rootSDF = nullptr;
   if (rootSDF == nullptr)
   {
@@ -460,13 +467,9 @@ WorldState &WorldState::operator=(const WorldState &_state)
           LightState(light.second)));
   }
 
-  // Copy the insertions
-  std::copy(_state.insertions.begin(),
-            _state.insertions.end(), this->insertions.begin());
-
-  // Copy the deletions
-  std::copy(_state.deletions.begin(),
-            _state.deletions.end(), this->deletions.begin());
+  // Copy the insertions and deletions
+  this->insertions = _state.insertions;
+  this->deletions = _state.deletions;
 
   return *this;
 }
@@ -260,6 +260,9 @@ namespace gazebo
         return _out;
       }
 
+      /// \brief WorldStateSnapshot fills states directly.
+      friend class WorldStateSnapshot;
+
       /// \brief State of all the models.
       private: ModelState_M modelStates;
 
@@ -0,0 +1,618 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <cmath>
+#include <list>
+#include <unordered_set>
+
+#include <boost/algorithm/string.hpp>
+
+#include "gazebo/physics/Light.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldStateSnapshotPrivate.hh"
+#include "gazebo/physics/WorldStateSnapshot.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief Tolerance of the comparison operators of ignition math vectors
+/// and quaternions, which WorldState::IsZero relies on.
+static const double kSnapshotTolerance = 1e-3;
+
+/////////////////////////////////////////////////
+/// \brief Store a value at an index of a vector, growing the vector by one
+/// if the index is its size. Assigning to existing elements reuses their
+/// memory, which matters for strings.
+template<typename T>
+static void Store(std::vector<T> &_values, const size_t _index,
+    const T &_value)
+{
+  if (_index < _values.size())
+    _values[_index] = _value;
+  else
+    _values.push_back(_value);
+}
+
+/////////////////////////////////////////////////
+static void Store(SnapshotVectors &_vectors, const size_t _index,
+    const ignition::math::Vector3d &_value)
+{
+  Store(_vectors.x, _index, _value.X());
+  Store(_vectors.y, _index, _value.Y());
+  Store(_vectors.z, _index, _value.Z());
+}
+
+/////////////////////////////////////////////////
+static void Store(SnapshotPoses &_poses, const size_t _index,
+    const ignition::math::Pose3d &_value)
+{
+  Store(_poses.pos, _index, _value.Pos());
+  Store(_poses.qw, _index, _value.Rot().W());
+  Store(_poses.qx, _index, _value.Rot().X());
+  Store(_poses.qy, _index, _value.Rot().Y());
+  Store(_poses.qz, _index, _value.Rot().Z());
+}
+
+/////////////////////////////////////////////////
+static void Resize(SnapshotVectors &_vectors, const size_t _size)
+{
+  _vectors.x.resize(_size);
+  _vectors.y.resize(_size);
+  _vectors.z.resize(_size);
+}
+
+/////////////////////////////////////////////////
+static void Resize(SnapshotPoses &_poses, const size_t _size)
+{
+  Resize(_poses.pos, _size);
+  _poses.qw.resize(_size);
+  _poses.qx.resize(_size);
+  _poses.qy.resize(_size);
+  _poses.qz.resize(_size);
+}
+
+/////////////////////////////////////////////////
+static ignition::math::Vector3d Get(const SnapshotVectors &_vectors,
+    const size_t _index)
+{
+  return ignition::math::Vector3d(
+      _vectors.x[_index], _vectors.y[_index], _vectors.z[_index]);
+}
+
+/////////////////////////////////////////////////
+static ignition::math::Pose3d Get(const SnapshotPoses &_poses,
+    const size_t _index)
+{
+  return ignition::math::Pose3d(Get(_poses.pos, _index),
+      ignition::math::Quaterniond(_poses.qw[_index], _poses.qx[_index],
+        _poses.qy[_index], _poses.qz[_index]));
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether any vector of _a differs from the vector with the
+/// same index in _b. Both must have the same size. The loop has no early
+/// exit, so that it can be vectorized.
+static bool Differs(const SnapshotVectors &_a, const SnapshotVectors &_b)
+{
+  const size_t size = _a.x.size();
+  const double *ax = _a.x.data();
+  const double *ay = _a.y.data();
+  const double *az = _a.z.data();
+  const double *bx = _b.x.data();
+  const double *by = _b.y.data();
+  const double *bz = _b.z.data();
+
+  bool result = false;
+  for (size_t i = 0; i < size; ++i)
+  {
+    result |= (std::abs(ax[i] - bx[i]) > kSnapshotTolerance) |
+              (std::abs(ay[i] - by[i]) > kSnapshotTolerance) |
+              (std::abs(az[i] - bz[i]) > kSnapshotTolerance);
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether any pose of _current moved relative to the pose
+/// with the same index in _previous. As in LinkState::operator-, the
+/// rotation difference is _previous.Rot().Inverse() * _current.Rot(),
+/// which must be close to identity.
+static bool Differs(const SnapshotPoses &_current,
+    const SnapshotPoses &_previous)
+{
+  if (Differs(_current.pos, _previous.pos))
+    return true;
+
+  const size_t size = _current.qw.size();
+  const double *aw = _current.qw.data();
+  const double *ax = _current.qx.data();
+  const double *ay = _current.qy.data();
+  const double *az = _current.qz.data();
+  const double *bw = _previous.qw.data();
+  const double *bx = _previous.qx.data();
+  const double *by = _previous.qy.data();
+  const double *bz = _previous.qz.data();
+
+  bool result = false;
+  for (size_t i = 0; i < size; ++i)
+  {
+    const double w = bw[i]*aw[i] + bx[i]*ax[i] + by[i]*ay[i] + bz[i]*az[i];
+    const double x = bw[i]*ax[i] - bx[i]*aw[i] - by[i]*az[i] + bz[i]*ay[i];
+    const double y = bw[i]*ay[i] + bx[i]*az[i] - by[i]*aw[i] - bz[i]*ax[i];
+    const double z = bw[i]*az[i] - bx[i]*ay[i] + by[i]*ax[i] - bz[i]*aw[i];
+    result |= (std::abs(w - 1.0) > kSnapshotTolerance) |
+              (std::abs(x) > kSnapshotTolerance) |
+              (std::abs(y) > kSnapshotTolerance) |
+              (std::abs(z) > kSnapshotTolerance);
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+/// \brief Capture a model, its links and its nested models.
+/// \param[in] _data Snapshot data.
+/// \param[in] _model Model to capture.
+/// \param[in] _parent Index of the parent model, -1 for top level models.
+/// \param[in,out] _modelCount Number of models captured so far.
+/// \param[in,out] _linkCount Number of links captured so far.
+static void LoadModel(WorldStateSnapshotPrivate &_data, const ModelPtr &_model,
+    const int _parent, size_t &_modelCount, size_t &_linkCount)
+{
+  const size_t index = _modelCount++;
+  Store(_data.modelIds, index, _model->GetId());
+  Store(_data.modelNames, index, _model->GetName());
+  Store(_data.modelParents, index, _parent);
+  Store(_data.modelPoses, index, _model->WorldPose());
+  Store(_data.modelScales, index, _model->Scale());
+
+  for (const auto &link : _model->GetLinks())
+  {
+    const size_t l = _linkCount++;
+    Store(_data.linkIds, l, link->GetId());
+    Store(_data.linkNames, l, link->GetName());
+    Store(_data.linkModels, l, static_cast<uint32_t>(index));
+    Store(_data.linkPoses, l, link->WorldPose());
+    Store(_data.linkLinearVels, l, link->WorldLinearVel());
+    Store(_data.linkAngularVels, l, link->WorldAngularVel());
+    Store(_data.linkLinearAccels, l, link->WorldLinearAccel());
+    Store(_data.linkAngularAccels, l, link->WorldAngularAccel());
+    Store(_data.linkForces, l, link->WorldForce());
+  }
+
+  for (const auto &nested : _model->NestedModels())
+  {
+    LoadModel(_data, nested, static_cast<int>(index), _modelCount,
+        _linkCount);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Set the size of every model, link and light array.
+/// \param[in] _data Snapshot data.
+/// \param[in] _modelCount Number of models.
+/// \param[in] _linkCount Number of links.
+/// \param[in] _lightCount Number of lights.
+static void Resize(WorldStateSnapshotPrivate &_data, const size_t _modelCount,
+    const size_t _linkCount, const size_t _lightCount)
+{
+  _data.modelIds.resize(_modelCount);
+  _data.modelNames.resize(_modelCount);
+  _data.modelParents.resize(_modelCount);
+  Resize(_data.modelPoses, _modelCount);
+  Resize(_data.modelScales, _modelCount);
+
+  _data.linkIds.resize(_linkCount);
+  _data.linkNames.resize(_linkCount);
+  _data.linkModels.resize(_linkCount);
+  Resize(_data.linkPoses, _linkCount);
+  Resize(_data.linkLinearVels, _linkCount);
+  Resize(_data.linkAngularVels, _linkCount);
+  Resize(_data.linkLinearAccels, _linkCount);
+  Resize(_data.linkAngularAccels, _linkCount);
+  Resize(_data.linkForces, _linkCount);
+
+  _data.lightIds.resize(_lightCount);
+  _data.lightNames.resize(_lightCount);
+  Resize(_data.lightPoses, _lightCount);
+}
+
+/////////////////////////////////////////////////
+/// \brief Capture the time information of a world.
+/// \param[in] _data Snapshot data.
+/// \param[in] _world World to capture.
+static void LoadTimes(WorldStateSnapshotPrivate &_data, const WorldPtr &_world)
+{
+  _data.name = _world->Name();
+  _data.wallTime = common::Time::GetWallTime();
+  _data.simTime = _world->SimTime();
+  _data.realTime = _world->RealTime();
+  _data.iterations = _world->Iterations();
+  _data.insertions.clear();
+  _data.deletions.clear();
+}
+
+/////////////////////////////////////////////////
+WorldStateSnapshot::WorldStateSnapshot()
+  : dataPtr(new WorldStateSnapshotPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+WorldStateSnapshot::WorldStateSnapshot(const WorldStateSnapshot &_snapshot)
+  : dataPtr(new WorldStateSnapshotPrivate(*_snapshot.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+WorldStateSnapshot::WorldStateSnapshot(WorldStateSnapshot &&_snapshot)
+  : dataPtr(std::move(_snapshot.dataPtr))
+{
+  _snapshot.dataPtr.reset(new WorldStateSnapshotPrivate);
+}
+
+/////////////////////////////////////////////////
+WorldStateSnapshot::~WorldStateSnapshot()
+{
+}
+
+/////////////////////////////////////////////////
+WorldStateSnapshot &WorldStateSnapshot::operator=(
+    const WorldStateSnapshot &_snapshot)
+{
+  if (this != &_snapshot)
+    *this->dataPtr = *_snapshot.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+WorldStateSnapshot &WorldStateSnapshot::operator=(
+    WorldStateSnapshot &&_snapshot)
+{
+  // Swap, so that the moved from snapshot stays valid and keeps memory
+  // that can be reused by its next Load.
+  std::swap(this->dataPtr, _snapshot.dataPtr);
+  return *this;
+}
+
+/////////////////////////////////////////////////
+void WorldStateSnapshot::SetFilter(const std::string &_filter)
+{
+  if (_filter == this->dataPtr->filter)
+    return;
+
+  this->dataPtr->filter = _filter;
+
+  // Same parsing as WorldState::Load. The first element of the filter
+  // must be a model name or a star.
+  std::list<std::string> mainParts, parts;
+  boost::split(mainParts, _filter, boost::is_any_of("/"));
+  if (!mainParts.empty())
+  {
+    boost::split(parts, mainParts.front(), boost::is_any_of("."));
+    if (parts.empty() && !mainParts.front().empty())
+      parts.push_back(mainParts.front());
+  }
+
+  this->dataPtr->filterAll = parts.empty() || parts.front().empty() ||
+      parts.front() == "*";
+
+  if (!this->dataPtr->filterAll)
+  {
+    std::string regexStr = parts.front();
+    boost::replace_all(regexStr, "*", ".*");
+    this->dataPtr->filterRegex = boost::regex(regexStr);
+  }
+}
+
+/////////////////////////////////////////////////
+const std::string &WorldStateSnapshot::Filter() const
+{
+  return this->dataPtr->filter;
+}
+
+/////////////////////////////////////////////////
+void WorldStateSnapshot::Load(const WorldPtr &_world)
+{
+  LoadTimes(*this->dataPtr, _world);
+
+  size_t modelCount = 0;
+  size_t linkCount = 0;
+  for (const auto &model : _world->Models())
+  {
+    if (!this->dataPtr->filterAll &&
+        !boost::regex_match(model->GetName(), this->dataPtr->filterRegex))
+    {
+      continue;
+    }
+
+    LoadModel(*this->dataPtr, model, -1, modelCount, linkCount);
+  }
+
+  size_t lightCount = 0;
+  for (const auto &light : _world->Lights())
+  {
+    Store(this->dataPtr->lightIds, lightCount, light->GetId());
+    Store(this->dataPtr->lightNames, lightCount, light->GetName());
+    Store(this->dataPtr->lightPoses, lightCount, light->WorldPose());
+    ++lightCount;
+  }
+
+  Resize(*this->dataPtr, modelCount, linkCount, lightCount);
+}
+
+/////////////////////////////////////////////////
+void WorldStateSnapshot::LoadEntities(const WorldPtr &_world)
+{
+  LoadTimes(*this->dataPtr, _world);
+
+  size_t modelCount = 0;
+  for (const auto &model : _world->Models())
+  {
+    Store(this->dataPtr->modelIds, modelCount, model->GetId());
+    Store(this->dataPtr->modelNames, modelCount, model->GetName());
+    Store(this->dataPtr->modelParents, modelCount, -1);
+    ++modelCount;
+  }
+
+  size_t lightCount = 0;
+  for (const auto &light : _world->Lights())
+  {
+    Store(this->dataPtr->lightIds, lightCount, light->GetId());
+    Store(this->dataPtr->lightNames, lightCount, light->GetName());
+    ++lightCount;
+  }
+
+  // Poses are not captured, so leave the pose arrays empty, and keep them
+  // consistent in size with the id arrays for Differs.
+  Resize(*this->dataPtr, modelCount, 0, lightCount);
+  Resize(this->dataPtr->modelPoses, 0);
+  Resize(this->dataPtr->modelScales, 0);
+  Resize(this->dataPtr->lightPoses, 0);
+}
+
+/////////////////////////////////////////////////
+bool WorldStateSnapshot::Differs(const WorldStateSnapshot &_snapshot) const
+{
+  const WorldStateSnapshotPrivate &current = *this->dataPtr;
+  const WorldStateSnapshotPrivate &previous = *_snapshot.dataPtr;
+
+  // Different entities, or entities in a different order
+  if (current.modelIds != previous.modelIds ||
+      current.linkIds != previous.linkIds ||
+      current.lightIds != previous.lightIds ||
+      current.modelPoses.qw.size() != previous.modelPoses.qw.size() ||
+      current.lightPoses.qw.size() != previous.lightPoses.qw.size())
+  {
+    return true;
+  }
+
+  return ::Differs(current.modelPoses, previous.modelPoses) ||
+         ::Differs(current.modelScales, previous.modelScales) ||
+         ::Differs(current.linkPoses, previous.linkPoses) ||
+         ::Differs(current.lightPoses, previous.lightPoses);
+}
+
+/////////////////////////////////////////////////
+void WorldStateSnapshot::EntityChanges(const WorldStateSnapshot &_previous,
+    const WorldPtr &_world, std::vector<std::string> &_insertions,
+    std::vector<std::string> &_deletions) const
+{
+  const WorldStateSnapshotPrivate &current = *this->dataPtr;
+  const WorldStateSnapshotPrivate &previous = *_previous.dataPtr;
+
+  // Nothing was inserted or deleted if the same entities are present.
+  if (current.modelIds == previous.modelIds &&
+      current.lightIds == previous.lightIds)
+  {
+    return;
+  }
+
+  auto topLevelModels = [](const WorldStateSnapshotPrivate &_data)
+  {
+    std::unordered_set<std::string> names;
+    for (size_t i = 0; i < _data.modelNames.size(); ++i)
+    {
+      if (_data.modelParents[i] < 0)
+        names.insert(_data.modelNames[i]);
+    }
+    return names;
+  };
+
+  const std::unordered_set<std::string> currentModels =
+      topLevelModels(current);
+  const std::unordered_set<std::string> previousModels =
+      topLevelModels(previous);
+  const std::unordered_set<std::string> currentLights(
+      current.lightNames.begin(), current.lightNames.end());
+  const std::unordered_set<std::string> previousLights(
+      previous.lightNames.begin(), previous.lightNames.end());
+
+  // Deleted models and lights
+  for (size_t i = 0; i < previous.modelNames.size(); ++i)
+  {
+    if (previous.modelParents[i] < 0 &&
+        currentModels.count(previous.modelNames[i]) == 0)
+    {
+      _deletions.push_back(previous.modelNames[i]);
+    }
+  }
+  for (const auto &light : previous.lightNames)
+  {
+    if (currentLights.count(light) == 0)
+      _deletions.push_back(light);
+  }
+
+  if (!_world)
+    return;
+
+  // Inserted models and lights
+  for (size_t i = 0; i < current.modelNames.size(); ++i)
+  {
+    if (current.modelParents[i] >= 0 ||
+        previousModels.count(current.modelNames[i]) > 0)
+    {
+      continue;
+    }
+
+    ModelPtr model = _world->ModelByName(current.modelNames[i]);
+    if (model)
+      _insertions.push_back(model->UnscaledSDF()->ToString(""));
+  }
+  for (const auto &light : current.lightNames)
+  {
+    if (previousLights.count(light) > 0)
+      continue;
+
+    LightPtr lightPtr = _world->LightByName(light);
+    if (lightPtr)
+      _insertions.push_back(lightPtr->GetSDF()->ToString(""));
+  }
+}
+
+/////////////////////////////////////////////////
+void WorldStateSnapshot::SetInsertions(
+    const std::vector<std::string> &_insertions)
+{
+  this->dataPtr->insertions = _insertions;
+}
+
+/////////////////////////////////////////////////
+void WorldStateSnapshot::SetDeletions(
+    const std::vector<std::string> &_deletions)
+{
+  this->dataPtr->deletions = _deletions;
+}
+
+/////////////////////////////////////////////////
+WorldState WorldStateSnapshot::ToWorldState() const
+{
+  const WorldStateSnapshotPrivate &data = *this->dataPtr;
+
+  WorldState result;
+  result.SetName(data.name);
+  result.SetWallTime(data.wallTime);
+  result.SetRealTime(data.realTime);
+  result.SetSimTime(data.simTime);
+  result.SetIterations(data.iterations);
+
+  const size_t modelCount = data.modelIds.size();
+  const bool hasPoses = data.modelPoses.qw.size() == modelCount;
+
+  std::vector<ModelState> models(modelCount);
+  for (size_t i = 0; i < modelCount; ++i)
+  {
+    ModelState &model = models[i];
+    model.SetName(data.modelNames[i]);
+    model.SetWallTime(data.wallTime);
+    model.SetRealTime(data.realTime);
+    model.SetSimTime(data.simTime);
+    model.SetIterations(data.iterations);
+    if (hasPoses)
+    {
+      model.pose = Get(data.modelPoses, i);
+      model.scale = Get(data.modelScales, i);
+    }
+  }
+
+  for (size_t i = 0; i < data.linkIds.size(); ++i)
+  {
+    LinkState link;
+    link.SetName(data.linkNames[i]);
+    link.SetWallTime(data.wallTime);
+    link.SetRealTime(data.realTime);
+    link.SetSimTime(data.simTime);
+    link.SetIterations(data.iterations);
+    link.pose = Get(data.linkPoses, i);
+    link.velocity.Set(Get(data.linkLinearVels, i),
+                      Get(data.linkAngularVels, i));
+    link.acceleration.Set(Get(data.linkLinearAccels, i),
+                          Get(data.linkAngularAccels, i));
+    link.wrench.Set(Get(data.linkForces, i),
+                    ignition::math::Quaterniond::Identity);
+
+    models[data.linkModels[i]].linkStates.insert(
+        std::make_pair(data.linkNames[i], link));
+  }
+
+  // Nested models follow their parent, so walking backwards completes every
+  // nested model before it is copied into its parent.
+  for (size_t i = modelCount; i-- > 0;)
+  {
+    if (data.modelParents[i] >= 0)
+    {
+      models[data.modelParents[i]].modelStates.insert(
+          std::make_pair(data.modelNames[i], models[i]));
+    }
+    else
+    {
+      result.modelStates.insert(std::make_pair(data.modelNames[i],
+            models[i]));
+    }
+  }
+
+  const bool hasLightPoses =
+      data.lightPoses.qw.size() == data.lightIds.size();
+  for (size_t i = 0; i < data.lightIds.size(); ++i)
+  {
+    LightState light;
+    light.SetName(data.lightNames[i]);
+    light.SetWallTime(data.wallTime);
+    light.SetRealTime(data.realTime);
+    light.SetSimTime(data.simTime);
+    light.SetIterations(data.iterations);
+    if (hasLightPoses)
+      light.pose = Get(data.lightPoses, i);
+
+    result.lightStates.insert(std::make_pair(data.lightNames[i], light));
+  }
+
+  result.SetInsertions(data.insertions);
+  result.SetDeletions(data.deletions);
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+common::Time WorldStateSnapshot::SimTime() const
+{
+  return this->dataPtr->simTime;
+}
+
+/////////////////////////////////////////////////
+uint64_t WorldStateSnapshot::Iterations() const
+{
+  return this->dataPtr->iterations;
+}
+
+/////////////////////////////////////////////////
+size_t WorldStateSnapshot::ModelCount() const
+{
+  return this->dataPtr->modelIds.size();
+}
+
+/////////////////////////////////////////////////
+size_t WorldStateSnapshot::LinkCount() const
+{
+  return this->dataPtr->linkIds.size();
+}
+
+/////////////////////////////////////////////////
+size_t WorldStateSnapshot::LightCount() const
+{
+  return this->dataPtr->lightIds.size();
+}
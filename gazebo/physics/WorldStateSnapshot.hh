@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_WORLDSTATESNAPSHOT_HH_
+#define GAZEBO_PHYSICS_WORLDSTATESNAPSHOT_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/WorldState.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class
+    class WorldStateSnapshotPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class WorldStateSnapshot WorldStateSnapshot.hh physics/physics.hh
+    /// \brief Compact capture of the state of a physics::World.
+    ///
+    /// A snapshot holds the same information as a WorldState, but stores
+    /// the poses, velocities and accelerations of every model, link and
+    /// light in contiguous arrays indexed by entity, instead of trees of
+    /// maps keyed by name. Loading a snapshot into an existing instance
+    /// reuses its memory, and comparing two snapshots of the same set of
+    /// entities is a linear pass over those arrays. It is meant for code
+    /// that captures the world every iteration, such as state logging, and
+    /// can be converted to a WorldState with ToWorldState.
+    class GZ_PHYSICS_VISIBLE WorldStateSnapshot
+    {
+      /// \brief Constructor.
+      public: WorldStateSnapshot();
+
+      /// \brief Copy constructor.
+      /// \param[in] _snapshot Snapshot to copy.
+      public: WorldStateSnapshot(const WorldStateSnapshot &_snapshot);
+
+      /// \brief Move constructor.
+      /// \param[in] _snapshot Snapshot to move.
+      public: WorldStateSnapshot(WorldStateSnapshot &&_snapshot);
+
+      /// \brief Destructor.
+      public: ~WorldStateSnapshot();
+
+      /// \brief Copy assignment operator.
+      /// \param[in] _snapshot Snapshot to copy.
+      /// \return Reference to this snapshot.
+      public: WorldStateSnapshot &operator=(
+                  const WorldStateSnapshot &_snapshot);
+
+      /// \brief Move assignment operator.
+      /// \param[in] _snapshot Snapshot to move.
+      /// \return Reference to this snapshot.
+      public: WorldStateSnapshot &operator=(WorldStateSnapshot &&_snapshot);
+
+      /// \brief Set the filter applied by Load. The filter uses the syntax
+      /// of util::LogRecord::Filter. Only its model name part is used, as
+      /// in WorldState::LoadWithFilter. The filter is compiled once, and
+      /// not again until it changes.
+      /// \param[in] _filter Filter string. An empty string, or "*", selects
+      /// all models.
+      public: void SetFilter(const std::string &_filter);
+
+      /// \brief Get the filter applied by Load.
+      /// \return The filter string.
+      public: const std::string &Filter() const;
+
+      /// \brief Capture the state of all the models, with their nested
+      /// models and links, and all the lights of a world. Models which do
+      /// not match the filter are skipped.
+      /// \param[in] _world World to capture.
+      public: void Load(const WorldPtr &_world);
+
+      /// \brief Capture only the names and ids of the top level models and
+      /// lights of a world, which is enough to compute insertions and
+      /// deletions with EntityChanges. The filter is not applied.
+      /// \param[in] _world World to capture.
+      public: void LoadEntities(const WorldPtr &_world);
+
+      /// \brief Check whether the state differs from another snapshot.
+      ///
+      /// Two snapshots differ if they do not hold the same models, links
+      /// and lights, or if the pose of any of them, or the scale of any
+      /// model, moved by more than the tolerance used by the comparison
+      /// operators of ignition math. This matches !(a - b).IsZero() for
+      /// two WorldState instances, without the insertions and deletions.
+      /// \param[in] _snapshot Snapshot to compare against.
+      /// \return True if the snapshots differ.
+      public: bool Differs(const WorldStateSnapshot &_snapshot) const;
+
+      /// \brief Compute the top level models and the lights that were
+      /// inserted or deleted since a previous snapshot. Entities are
+      /// matched by name, as with WorldState::operator-.
+      /// \param[in] _previous Previous snapshot.
+      /// \param[in] _world World used to look up the SDF of inserted
+      /// entities.
+      /// \param[out] _insertions SDF of every inserted entity.
+      /// \param[out] _deletions Name of every deleted entity.
+      public: void EntityChanges(const WorldStateSnapshot &_previous,
+                  const WorldPtr &_world,
+                  std::vector<std::string> &_insertions,
+                  std::vector<std::string> &_deletions) const;
+
+      /// \brief Set the insertions, which are copied to the WorldState
+      /// generated by ToWorldState. Load clears them.
+      /// \param[in] _insertions SDF of every inserted entity.
+      public: void SetInsertions(const std::vector<std::string> &_insertions);
+
+      /// \brief Set the deletions, which are copied to the WorldState
+      /// generated by ToWorldState. Load clears them.
+      /// \param[in] _deletions Name of every deleted entity.
+      public: void SetDeletions(const std::vector<std::string> &_deletions);
+
+      /// \brief Convert to a WorldState.
+      /// \return World state with the same content as this snapshot.
+      public: WorldState ToWorldState() const;
+
+      /// \brief Get the simulation time of the capture.
+      /// \return Simulation time.
+      public: common::Time SimTime() const;
+
+      /// \brief Get the number of iterations at the time of the capture.
+      /// \return Number of iterations.
+      public: uint64_t Iterations() const;
+
+      /// \brief Get the number of captured models, including nested models.
+      /// \return Number of models.
+      public: size_t ModelCount() const;
+
+      /// \brief Get the number of captured links.
+      /// \return Number of links.
+      public: size_t LinkCount() const;
+
+      /// \brief Get the number of captured lights.
+      /// \return Number of lights.
+      public: size_t LightCount() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<WorldStateSnapshotPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
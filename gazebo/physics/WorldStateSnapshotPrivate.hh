@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_WORLDSTATESNAPSHOTPRIVATE_HH_
+#define GAZEBO_PHYSICS_WORLDSTATESNAPSHOTPRIVATE_HH_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/regex.hpp>
+
+#include "gazebo/common/Time.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Vectors of a set of entities, one array per component.
+    class SnapshotVectors
+    {
+      /// \brief X components.
+      public: std::vector<double> x;
+
+      /// \brief Y components.
+      public: std::vector<double> y;
+
+      /// \brief Z components.
+      public: std::vector<double> z;
+    };
+
+    /// \internal
+    /// \brief Poses of a set of entities, one array per component.
+    class SnapshotPoses
+    {
+      /// \brief Positions.
+      public: SnapshotVectors pos;
+
+      /// \brief W components of the orientations.
+      public: std::vector<double> qw;
+
+      /// \brief X components of the orientations.
+      public: std::vector<double> qx;
+
+      /// \brief Y components of the orientations.
+      public: std::vector<double> qy;
+
+      /// \brief Z components of the orientations.
+      public: std::vector<double> qz;
+    };
+
+    /// \internal
+    /// \brief Private data for the WorldStateSnapshot class.
+    class WorldStateSnapshotPrivate
+    {
+      /// \brief Name of the world.
+      public: std::string name;
+
+      /// \brief Wall time of the capture.
+      public: common::Time wallTime;
+
+      /// \brief Real time of the capture.
+      public: common::Time realTime;
+
+      /// \brief Simulation time of the capture.
+      public: common::Time simTime;
+
+      /// \brief Iterations at the time of the capture.
+      public: uint64_t iterations = 0;
+
+      /// \brief Filter string.
+      public: std::string filter;
+
+      /// \brief True if the filter selects every model.
+      public: bool filterAll = true;
+
+      /// \brief Compiled model name part of the filter.
+      public: boost::regex filterRegex;
+
+      /// \brief Ids of the models. Nested models follow their parent.
+      public: std::vector<uint32_t> modelIds;
+
+      /// \brief Names of the models.
+      public: std::vector<std::string> modelNames;
+
+      /// \brief Index of the parent of each model, -1 for top level
+      /// models.
+      public: std::vector<int> modelParents;
+
+      /// \brief World poses of the models.
+      public: SnapshotPoses modelPoses;
+
+      /// \brief Scales of the models.
+      public: SnapshotVectors modelScales;
+
+      /// \brief Ids of the links.
+      public: std::vector<uint32_t> linkIds;
+
+      /// \brief Names of the links.
+      public: std::vector<std::string> linkNames;
+
+      /// \brief Index of the model of each link.
+      public: std::vector<uint32_t> linkModels;
+
+      /// \brief World poses of the links.
+      public: SnapshotPoses linkPoses;
+
+      /// \brief World linear velocities of the links.
+      public: SnapshotVectors linkLinearVels;
+
+      /// \brief World angular velocities of the links.
+      public: SnapshotVectors linkAngularVels;
+
+      /// \brief World linear accelerations of the links.
+      public: SnapshotVectors linkLinearAccels;
+
+      /// \brief World angular accelerations of the links.
+      public: SnapshotVectors linkAngularAccels;
+
+      /// \brief World forces of the links.
+      public: SnapshotVectors linkForces;
+
+      /// \brief Ids of the lights.
+      public: std::vector<uint32_t> lightIds;
+
+      /// \brief Names of the lights.
+      public: std::vector<std::string> lightNames;
+
+      /// \brief World poses of the lights.
+      public: SnapshotPoses lightPoses;
+
+      /// \brief SDF of the inserted entities.
+      public: std::vector<std::string> insertions;
+
+      /// \brief Names of the deleted entities.
+      public: std::vector<std::string> deletions;
+    };
+  }
+}
+#endif
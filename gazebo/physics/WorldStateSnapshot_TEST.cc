@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <string>
+#include <vector>
+
+#include "gazebo/test/ServerFixture.hh"
+#include "test/util.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldState.hh"
+#include "gazebo/physics/WorldStateSnapshot.hh"
+
+using namespace gazebo;
+
+class WorldStateSnapshotTest : public ServerFixture { };
+
+//////////////////////////////////////////////////
+TEST_F(WorldStateSnapshotTest, ToWorldState)
+{
+  this->Load("worlds/shapes.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::WorldStateSnapshot snapshot;
+  snapshot.Load(world);
+  EXPECT_EQ(snapshot.ModelCount(), world->ModelCount());
+  EXPECT_EQ(snapshot.LightCount(), world->Lights().size());
+  EXPECT_EQ(snapshot.SimTime(), world->SimTime());
+  EXPECT_EQ(snapshot.Iterations(), world->Iterations());
+
+  // The converted state must match a state loaded directly
+  physics::WorldState expected(world);
+  physics::WorldState state = snapshot.ToWorldState();
+  EXPECT_EQ(state.GetName(), expected.GetName());
+  EXPECT_EQ(state.GetSimTime(), expected.GetSimTime());
+  ASSERT_EQ(state.GetModelStateCount(), expected.GetModelStateCount());
+  ASSERT_EQ(state.LightStateCount(), expected.LightStateCount());
+
+  for (auto const &model : expected.GetModelStates())
+  {
+    ASSERT_TRUE(state.HasModelState(model.first));
+    physics::ModelState modelState = state.GetModelState(model.first);
+    EXPECT_EQ(modelState.Pose(), model.second.Pose());
+    EXPECT_EQ(modelState.Scale(), model.second.Scale());
+    ASSERT_EQ(modelState.GetLinkStateCount(),
+        model.second.GetLinkStateCount());
+    for (auto const &link : model.second.GetLinkStates())
+    {
+      EXPECT_EQ(modelState.GetLinkState(link.first).Pose(),
+          link.second.Pose());
+    }
+  }
+
+  for (auto const &light : expected.LightStates())
+  {
+    ASSERT_TRUE(state.HasLightState(light.first));
+    EXPECT_EQ(state.GetLightState(light.first).Pose(), light.second.Pose());
+  }
+
+  // Nothing moved
+  EXPECT_TRUE((state - expected).IsZero());
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldStateSnapshotTest, Differs)
+{
+  this->Load("worlds/shapes.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::WorldStateSnapshot previous;
+  previous.Load(world);
+
+  physics::WorldStateSnapshot current(previous);
+  EXPECT_FALSE(current.Differs(previous));
+
+  // A tiny motion is within tolerance, as for WorldState
+  physics::ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+  ignition::math::Pose3d pose = box->WorldPose();
+  box->SetWorldPose(pose + ignition::math::Pose3d(1e-5, 0, 0, 0, 0, 0));
+  current.Load(world);
+  EXPECT_FALSE(current.Differs(previous));
+
+  // Translation
+  box->SetWorldPose(ignition::math::Pose3d(pose.Pos() +
+      ignition::math::Vector3d(0.5, 0, 0), pose.Rot()));
+  current.Load(world);
+  EXPECT_TRUE(current.Differs(previous));
+
+  // Rotation
+  box->SetWorldPose(ignition::math::Pose3d(pose.Pos(),
+      pose.Rot() * ignition::math::Quaterniond(0, 0, 0.1)));
+  current.Load(world);
+  EXPECT_TRUE(current.Differs(previous));
+
+  box->SetWorldPose(pose);
+  current.Load(world);
+  EXPECT_FALSE(current.Differs(previous));
+
+  // Only models matching the filter are captured
+  current.SetFilter("box");
+  EXPECT_EQ(current.Filter(), "box");
+  current.Load(world);
+  EXPECT_EQ(current.ModelCount(), 1u);
+  EXPECT_TRUE(current.Differs(previous));
+  EXPECT_EQ(current.ToWorldState().GetModelStateCount(), 1u);
+  EXPECT_TRUE(current.ToWorldState().HasModelState("box"));
+
+  current.SetFilter("*");
+  current.Load(world);
+  EXPECT_EQ(current.ModelCount(), previous.ModelCount());
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldStateSnapshotTest, EntityChanges)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::WorldStateSnapshot previous;
+  previous.LoadEntities(world);
+  EXPECT_EQ(previous.ModelCount(), 1u);
+  EXPECT_EQ(previous.LinkCount(), 0u);
+
+  std::vector<std::string> insertions;
+  std::vector<std::string> deletions;
+  physics::WorldStateSnapshot current;
+  current.LoadEntities(world);
+  current.EntityChanges(previous, world, insertions, deletions);
+  EXPECT_TRUE(insertions.empty());
+  EXPECT_TRUE(deletions.empty());
+
+  // Insertion
+  SpawnBox("box", ignition::math::Vector3d(1, 1, 1),
+      ignition::math::Vector3d(0, 0, 0.5));
+  current.LoadEntities(world);
+  current.EntityChanges(previous, world, insertions, deletions);
+  ASSERT_EQ(insertions.size(), 1u);
+  EXPECT_NE(insertions[0].find("<model name='box'>"), std::string::npos);
+  EXPECT_TRUE(deletions.empty());
+
+  // Deletion
+  previous = current;
+  world->RemoveModel("box");
+  current.LoadEntities(world);
+  insertions.clear();
+  current.EntityChanges(previous, world, insertions, deletions);
+  EXPECT_TRUE(insertions.empty());
+  ASSERT_EQ(deletions.size(), 1u);
+  EXPECT_EQ(deletions[0], "box");
+
+  // Insertions and deletions are carried to the WorldState
+  current.SetDeletions(deletions);
+  physics::WorldState state = current.ToWorldState();
+  ASSERT_EQ(state.Deletions().size(), 1u);
+  EXPECT_EQ(state.Deletions()[0], "box");
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
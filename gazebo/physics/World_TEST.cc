@@ -15,6 +15,9 @@
  *
 */
 
+#include <string>
+#include <vector>
+
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/test/ServerFixture.hh"
@@ -195,6 +198,131 @@ TEST_F(WorldTest, EditName)
   }
 }
 
+//////////////////////////////////////////////////
+/// \brief Test that name lookups follow insertion, renaming and removal of
+/// entities.
+TEST_F(WorldTest, EntityIndex)
+{
+  this->Load("worlds/blank.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // The world itself can be found by name
+  auto root = world->BaseByName("default");
+  ASSERT_TRUE(root != nullptr);
+  EXPECT_TRUE(root->GetParent() == nullptr);
+
+  SpawnBox("box_a", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 0.5));
+  SpawnBox("box_b", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(2, 0, 0.5));
+
+  auto boxA = world->ModelByName("box_a");
+  auto boxB = world->ModelByName("box_b");
+  ASSERT_TRUE(boxA != nullptr);
+  ASSERT_TRUE(boxB != nullptr);
+  EXPECT_EQ(world->BaseByName("box_a"), boxA);
+  EXPECT_EQ(world->EntityByName("box_b"), boxB);
+
+  // Lookup by scoped name
+  auto link = world->EntityByName("box_b::body");
+  ASSERT_TRUE(link != nullptr);
+  EXPECT_EQ(link->GetParent(), boxB);
+  EXPECT_EQ(world->EntityByName("box_b::body::geom"),
+      boxB->GetLink("body")->GetCollision("geom"));
+
+  // Both models have a link named "body". The first one found by walking
+  // the entity tree is returned.
+  EXPECT_EQ(world->EntityByName("body"), root->GetByName("body"));
+
+  // Wrong type
+  EXPECT_TRUE(world->ModelByName("box_b::body") == nullptr);
+  EXPECT_TRUE(world->LightByName("box_a") == nullptr);
+
+  // Rename
+  boxA->SetName("box_c");
+  EXPECT_TRUE(world->ModelByName("box_a") == nullptr);
+  EXPECT_EQ(world->ModelByName("box_c"), boxA);
+
+  // Remove
+  world->RemoveModel("box_b");
+  EXPECT_TRUE(world->ModelByName("box_b") == nullptr);
+  EXPECT_TRUE(world->EntityByName("box_b::body") == nullptr);
+  EXPECT_EQ(world->EntityByName("body"), boxA->GetLink("body"));
+}
+
+//////////////////////////////////////////////////
+/// \brief Test inserting many copies of a model at once.
+TEST_F(WorldTest, InsertModelInstances)
+{
+  this->Load("worlds/blank.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  msgs::Model msg;
+  msg.set_name("crate");
+  msg.add_link();
+  msg.mutable_link(0)->set_name("l");
+  std::string modelSDFStr(
+    "<sdf version='" + std::string(SDF_VERSION) + "'>"
+    + msgs::ModelToSDF(msg)->ToString("")
+    + "</sdf>");
+
+  // Some names are given, one of them twice
+  std::vector<ignition::math::Pose3d> poses;
+  for (int i = 0; i < 100; ++i)
+    poses.push_back(ignition::math::Pose3d(i, 2 * i, 0, 0, 0, 0.1 * i));
+  std::vector<std::string> names = {"first", "", "first"};
+  world->InsertModelInstances(modelSDFStr, poses, names);
+
+  int sleep = 0;
+  int maxSleep = 50;
+  while (sleep < maxSleep && world->ModelCount() < 100u)
+  {
+    common::Time::MSleep(100);
+    sleep++;
+  }
+  ASSERT_EQ(world->ModelCount(), 100u);
+
+  auto first = world->ModelByName("first");
+  ASSERT_TRUE(first != nullptr);
+  EXPECT_EQ(first->WorldPose(), poses[0]);
+  EXPECT_TRUE(world->ModelByName("crate_1") != nullptr);
+
+  // The duplicate name was made unique
+  auto renamed = world->ModelByName("first_0");
+  ASSERT_TRUE(renamed != nullptr);
+  EXPECT_EQ(renamed->WorldPose(), poses[2]);
+
+  for (int i = 3; i < 100; ++i)
+  {
+    auto model = world->ModelByName("crate_" + std::to_string(i));
+    ASSERT_TRUE(model != nullptr) << i;
+    EXPECT_EQ(model->WorldPose(), poses[i]);
+    ASSERT_TRUE(model->GetLink("l") != nullptr);
+  }
+
+  // Without renaming, taken names are skipped
+  msgs::Factory facMsg;
+  facMsg.set_sdf(modelSDFStr);
+  facMsg.set_allow_renaming(false);
+  msgs::Set(facMsg.add_instance_pose(), poses[0]);
+  msgs::Set(facMsg.add_instance_pose(), poses[1]);
+  facMsg.add_instance_name("first");
+  facMsg.add_instance_name("last");
+  this->factoryPub->Publish(facMsg);
+
+  sleep = 0;
+  while (sleep < maxSleep && !world->ModelByName("last"))
+  {
+    common::Time::MSleep(100);
+    sleep++;
+  }
+  ASSERT_TRUE(world->ModelByName("last") != nullptr);
+  EXPECT_EQ(world->ModelCount(), 101u);
+  EXPECT_EQ(world->ModelByName("first"), first);
+}
+
 //////////////////////////////////////////////////
 TEST_F(WorldTest, Stop)
 {
@@ -34,6 +34,7 @@ BulletCollision::BulletCollision(LinkPtr _parent)
   this->SetName("Bullet_Collision");
   this->collisionShape = nullptr;
   this->surface.reset(new BulletSurfaceParams());
+  this->categoryBits = GZ_ALL_COLLIDE;
   this->collideBits = GZ_ALL_COLLIDE;
 }
 
@@ -116,8 +117,7 @@ void BulletCollision::SetCollideBits(unsigned int _bits)
 //////////////////////////////////////////////////
 unsigned int BulletCollision::GetCategoryBits() const
 {
-  gzwarn << "GetCategoryBits is not implemented" << std::endl;
-  // Prevent unused variable warning
+  // Category bits aren't used by bullet, return the value last set
   return this->categoryBits;
 }
 
@@ -15,8 +15,12 @@
  *
 */
 
+#include <string>
+#include <vector>
+
 #include "gazebo/common/Mesh.hh"
 
+#include "gazebo/physics/TriMeshCache.hh"
 #include "gazebo/physics/bullet/BulletTypes.hh"
 #include "gazebo/physics/bullet/BulletCollision.hh"
 #include "gazebo/physics/bullet/BulletPhysics.hh"
@@ -25,6 +29,37 @@
 using namespace gazebo;
 using namespace physics;
 
+/////////////////////////////////////////////////
+/// \brief Build a Bullet trimesh.
+/// \param[in] _data The triangles.
+/// \return The Bullet trimesh.
+static std::shared_ptr<btTriangleMesh> createTriMesh(const TriMeshData &_data)
+{
+  std::shared_ptr<btTriangleMesh> triMesh = std::make_shared<btTriangleMesh>();
+  const std::vector<float> &v = _data.vertices;
+  const std::vector<int> &ind = _data.indices;
+
+  for (unsigned int j = 0; j + 2 < ind.size(); j += 3)
+  {
+    btVector3 bv0(v[ind[j]*3+0], v[ind[j]*3+1], v[ind[j]*3+2]);
+    btVector3 bv1(v[ind[j+1]*3+0], v[ind[j+1]*3+1], v[ind[j+1]*3+2]);
+    btVector3 bv2(v[ind[j+2]*3+0], v[ind[j+2]*3+1], v[ind[j+2]*3+2]);
+    triMesh->addTriangle(bv0, bv1, bv2);
+  }
+
+  return triMesh;
+}
+
+/////////////////////////////////////////////////
+/// \brief Bullet trimeshes of the mesh shapes, shared by the shapes using
+/// the same mesh and scale.
+/// \return The cache.
+static TriMeshCache<btTriangleMesh> &bulletTriMeshCache()
+{
+  static TriMeshCache<btTriangleMesh> cache;
+  return cache;
+}
+
 //////////////////////////////////////////////////
 BulletMesh::BulletMesh()
 {
@@ -40,20 +75,8 @@ void BulletMesh::Init(const common::SubMesh *_subMesh,
                       BulletCollisionPtr _collision,
                       const ignition::math::Vector3d &_scale)
 {
-  float *vertices = nullptr;
-  int *indices = nullptr;
-
-  unsigned int numVertices = _subMesh->GetVertexCount();
-  unsigned int numIndices = _subMesh->GetIndexCount();
-
-  // Get all the vertex and index data
-  _subMesh->FillArrays(&vertices, &indices);
-
-  this->CreateMesh(vertices, indices, numVertices,
-                   numIndices, _collision, _scale);
-
-  delete [] vertices;
-  delete [] indices;
+  this->CreateMesh(createTriMesh(TriMeshData(nullptr, _subMesh, _scale)),
+      _collision);
 }
 
 //////////////////////////////////////////////////
@@ -61,57 +84,34 @@ void BulletMesh::Init(const common::Mesh *_mesh,
                       BulletCollisionPtr _collision,
                       const ignition::math::Vector3d &_scale)
 {
-  float *vertices = nullptr;
-  int *indices = nullptr;
-
-  unsigned int numVertices = _mesh->GetVertexCount();
-  unsigned int numIndices = _mesh->GetIndexCount();
-
-  // Get all the vertex and index data
-  _mesh->FillArrays(&vertices, &indices);
-
-  this->CreateMesh(vertices, indices, numVertices,
-                   numIndices, _collision, _scale);
+  this->CreateMesh(createTriMesh(TriMeshData(_mesh, nullptr, _scale)),
+      _collision);
+}
 
-  delete [] vertices;
-  delete [] indices;
+//////////////////////////////////////////////////
+void BulletMesh::Init(const MeshShape &_shape, BulletCollisionPtr _collision)
+{
+  const common::Mesh *mesh = _shape.CollisionMesh();
+  const common::SubMesh *subMesh = _shape.CollisionSubMesh();
+  const std::string key = _shape.MeshCacheKey();
+  const ignition::math::Vector3d scale = _shape.Size();
+
+  this->CreateMesh(bulletTriMeshCache().Get(key, [&]()
+      {
+        return createTriMesh(*TriMeshData::Load(key, mesh, subMesh, scale));
+      }), _collision);
 }
 
 /////////////////////////////////////////////////
-void BulletMesh::CreateMesh(float *_vertices, int *_indices,
-    unsigned int _numVertices, unsigned int _numIndices,
-    BulletCollisionPtr _collision, const ignition::math::Vector3d &_scale)
+void BulletMesh::CreateMesh(std::shared_ptr<btTriangleMesh> _triMesh,
+    BulletCollisionPtr _collision)
 {
-  btTriangleMesh *mTriMesh = new btTriangleMesh();
-
-  // Scale the vertex data
-  for (unsigned int j = 0;  j < _numVertices; ++j)
-  {
-    _vertices[j*3+0] = _vertices[j*3+0] * _scale.X();
-    _vertices[j*3+1] = _vertices[j*3+1] * _scale.Y();
-    _vertices[j*3+2] = _vertices[j*3+2] * _scale.Z();
-  }
-
-  // Create the Bullet trimesh
-  for (unsigned int j = 0; j < _numIndices; j += 3)
-  {
-    btVector3 bv0(_vertices[_indices[j]*3+0],
-                  _vertices[_indices[j]*3+1],
-                  _vertices[_indices[j]*3+2]);
-
-    btVector3 bv1(_vertices[_indices[j+1]*3+0],
-                  _vertices[_indices[j+1]*3+1],
-                  _vertices[_indices[j+1]*3+2]);
-
-    btVector3 bv2(_vertices[_indices[j+2]*3+0],
-                  _vertices[_indices[j+2]*3+1],
-                  _vertices[_indices[j+2]*3+2]);
-
-    mTriMesh->addTriangle(bv0, bv1, bv2);
-  }
+  // The GImpact shape only reads the triangles, so the trimesh can be
+  // shared. It must outlive the shape, which is deleted by the collision.
+  this->triMesh = _triMesh;
 
   btGImpactMeshShape *gimpactMeshShape =
-    new btGImpactMeshShape(mTriMesh);
+    new btGImpactMeshShape(this->triMesh.get());
   gimpactMeshShape->updateBound();
 
   _collision->SetCollisionShape(gimpactMeshShape);
@@ -18,11 +18,16 @@
 #ifndef GAZEBO_PHYSICS_BULLET_BULLETMESH_HH_
 #define GAZEBO_PHYSICS_BULLET_BULLETMESH_HH_
 
+#include <memory>
+
 #include <ignition/math/Vector3.hh>
 
+#include "gazebo/physics/MeshShape.hh"
 #include "gazebo/physics/bullet/BulletTypes.hh"
 #include "gazebo/util/system.hh"
 
+class btTriangleMesh;
+
 namespace gazebo
 {
   namespace physics
@@ -56,17 +61,23 @@ namespace gazebo
                       BulletCollisionPtr _collision,
                       const ignition::math::Vector3d &_scale);
 
+      /// \brief Create a mesh collision shape using the mesh of a shape.
+      /// The triangles are shared by all the shapes using the same mesh with
+      /// the same scale.
+      /// \param[in] _shape The mesh shape.
+      /// \param[in] _collision Pointer to the collision object.
+      public: void Init(const MeshShape &_shape,
+                  BulletCollisionPtr _collision);
+
       /// \brief Helper function to create the collision shape.
-      /// \param[in] _vertices Array of vertices.
-      /// \param[in] _indices Array of indices.
-      /// \param[in] _numVertices Number of vertices.
-      /// \param[in] _numIndices Number of indices.
+      /// \param[in] _triMesh The triangles.
       /// \param[in] _collision Pointer to the collision object.
-      /// \param[in] _scale Scaling factor.
-      private: void CreateMesh(float *_vertices, int *_indices,
-                   unsigned int _numVertices, unsigned int _numIndices,
-                   BulletCollisionPtr _collision,
-                   const ignition::math::Vector3d &_scale);
+      private: void CreateMesh(std::shared_ptr<btTriangleMesh> _triMesh,
+                   BulletCollisionPtr _collision);
+
+      /// \brief Triangles of the collision shape, possibly shared with
+      /// other meshes.
+      private: std::shared_ptr<btTriangleMesh> triMesh;
     };
     /// \}
   }
@@ -15,9 +15,13 @@
  *
 */
 
+#include <string>
+
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Mesh.hh"
 
+#include "gazebo/physics/TriMeshCache.hh"
+
 #include "gazebo/physics/dart/DARTCollision.hh"
 #include "gazebo/physics/dart/DARTPhysics.hh"
 #include "gazebo/physics/dart/DARTMesh.hh"
@@ -27,6 +31,64 @@
 using namespace gazebo;
 using namespace physics;
 
+/////////////////////////////////////////////////
+/// \brief Create a DART mesh shape.
+/// \param[in] _data The triangles, with their scale applied.
+/// \return The DART mesh shape.
+static dart::dynamics::ShapePtr createShape(const TriMeshData &_data)
+{
+  const unsigned int numVertices = _data.VertexCount();
+
+  // Create new aiScene (aiMesh)
+  aiScene *assimpScene = new aiScene;
+  aiMesh *assimpMesh = new aiMesh;
+  assimpScene->mNumMeshes = 1;
+  assimpScene->mMeshes = new aiMesh*[1];
+  assimpScene->mMeshes[0] = assimpMesh;
+  assimpScene->mRootNode = new aiNode();
+
+  // Set vertices and normals
+  assimpMesh->mNumVertices = numVertices;
+  assimpMesh->mVertices = new aiVector3D[numVertices];
+  assimpMesh->mNormals = new aiVector3D[numVertices];
+  aiVector3D itAIVector3d;
+
+  for (unsigned int i = 0; i < numVertices; ++i)
+  {
+    itAIVector3d.Set(_data.vertices[i*3 + 0], _data.vertices[i*3 + 1],
+      _data.vertices[i*3 + 2]);
+    assimpMesh->mVertices[i] = itAIVector3d;
+    assimpMesh->mNormals[i]  = itAIVector3d;
+  }
+
+  // Set faces
+  assimpMesh->mNumFaces = _data.IndexCount()/3;
+  assimpMesh->mFaces = new aiFace[assimpMesh->mNumFaces];
+  for (unsigned int i = 0; i < assimpMesh->mNumFaces; ++i)
+  {
+    aiFace* itAIFace = &assimpMesh->mFaces[i];
+    itAIFace->mNumIndices = 3;
+    itAIFace->mIndices = new unsigned int[3];
+    itAIFace->mIndices[0] = _data.indices[i*3 + 0];
+    itAIFace->mIndices[1] = _data.indices[i*3 + 1];
+    itAIFace->mIndices[2] = _data.indices[i*3 + 2];
+  }
+
+  // The scale is already applied to the vertices
+  return dart::dynamics::ShapePtr(new dart::dynamics::MeshShape(
+      Eigen::Vector3d::Ones(), assimpScene));
+}
+
+/////////////////////////////////////////////////
+/// \brief DART shapes of the mesh shapes, shared by the shapes using the
+/// same mesh and scale.
+/// \return The cache.
+static TriMeshCache<dart::dynamics::Shape> &dartMeshShapeCache()
+{
+  static TriMeshCache<dart::dynamics::Shape> cache;
+  return cache;
+}
+
 //////////////////////////////////////////////////
 DARTMesh::DARTMesh() : dataPtr(new DARTMeshPrivate())
 {
@@ -44,20 +106,8 @@ void DARTMesh::Init(const common::SubMesh *_subMesh,
                     DARTCollisionPtr _collision,
                     const ignition::math::Vector3d &_scale)
 {
-  float *vertices = nullptr;
-  int *indices = nullptr;
-
-  unsigned int numVertices = _subMesh->GetVertexCount();
-  unsigned int numIndices = _subMesh->GetIndexCount();
-
-  // Get all the vertex and index data
-  _subMesh->FillArrays(&vertices, &indices);
-
-  this->CreateMesh(vertices, indices, numVertices, numIndices,
-                   _collision, _scale);
-
-  delete [] vertices;
-  delete [] indices;
+  this->CreateMesh(createShape(TriMeshData(nullptr, _subMesh, _scale)),
+      _collision);
 }
 
 //////////////////////////////////////////////////
@@ -65,73 +115,39 @@ void DARTMesh::Init(const common::Mesh *_mesh,
                     DARTCollisionPtr _collision,
                     const ignition::math::Vector3d &_scale)
 {
-  float *vertices = nullptr;
-  int *indices = nullptr;
-
-  unsigned int numVertices = _mesh->GetVertexCount();
-  unsigned int numIndices = _mesh->GetIndexCount();
-
-  // Get all the vertex and index data
-  _mesh->FillArrays(&vertices, &indices);
+  this->CreateMesh(createShape(TriMeshData(_mesh, nullptr, _scale)),
+      _collision);
+}
 
-  this->CreateMesh(vertices, indices, numVertices, numIndices,
-                   _collision, _scale);
-  delete [] vertices;
-  delete [] indices;
+//////////////////////////////////////////////////
+void DARTMesh::Init(const MeshShape &_shape, DARTCollisionPtr _collision)
+{
+  const common::Mesh *mesh = _shape.CollisionMesh();
+  const common::SubMesh *subMesh = _shape.CollisionSubMesh();
+  const std::string key = _shape.MeshCacheKey();
+  const ignition::math::Vector3d scale = _shape.Size();
+
+  this->CreateMesh(dartMeshShapeCache().Get(key, [&]()
+      {
+        return createShape(*TriMeshData::Load(key, mesh, subMesh, scale));
+      }), _collision);
 }
 
 /////////////////////////////////////////////////
-void DARTMesh::CreateMesh(float *_vertices, int *_indices,
-    unsigned int _numVertices, unsigned int _numIndices,
-    DARTCollisionPtr _collision, const ignition::math::Vector3d &_scale)
+void DARTMesh::CreateMesh(dart::dynamics::ShapePtr _shape,
+    DARTCollisionPtr _collision)
 {
   GZ_ASSERT(_collision, "DART collision is null");
-
-  // Create new aiScene (aiMesh)
-  aiScene *assimpScene = new aiScene;
-  aiMesh *assimpMesh = new aiMesh;
-  assimpScene->mNumMeshes = 1;
-  assimpScene->mMeshes = new aiMesh*[1];
-  assimpScene->mMeshes[0] = assimpMesh;
-  assimpScene->mRootNode = new aiNode();
-
-  // Set _vertices and normals
-  assimpMesh->mNumVertices = _numVertices;
-  assimpMesh->mVertices = new aiVector3D[_numVertices];
-  assimpMesh->mNormals = new aiVector3D[_numVertices];
-  aiVector3D itAIVector3d;
-
-  for (unsigned int i = 0; i < _numVertices; ++i)
-  {
-    itAIVector3d.Set(_vertices[i*3 + 0], _vertices[i*3 + 1],
-      _vertices[i*3 + 2]);
-    assimpMesh->mVertices[i] = itAIVector3d;
-    assimpMesh->mNormals[i]  = itAIVector3d;
-  }
-
-  // Set faces
-  assimpMesh->mNumFaces = _numIndices/3;
-  assimpMesh->mFaces = new aiFace[assimpMesh->mNumFaces];
-  for (unsigned int i = 0; i < assimpMesh->mNumFaces; ++i)
-  {
-    aiFace* itAIFace = &assimpMesh->mFaces[i];
-    itAIFace->mNumIndices = 3;
-    itAIFace->mIndices = new unsigned int[3];
-    itAIFace->mIndices[0] = _indices[i*3 + 0];
-    itAIFace->mIndices[1] = _indices[i*3 + 1];
-    itAIFace->mIndices[2] = _indices[i*3 + 2];
-  }
-
-  dart::dynamics::ShapePtr dtMeshShape(new dart::dynamics::MeshShape(
-      DARTTypes::ConvVec3(_scale), assimpScene));
   GZ_ASSERT(_collision->DARTBodyNode(),
             "DART _collision->DARTBodyNode() is null");
 
+  // A DART shape can be used by several shape nodes, which then also share
+  // the collision structures built by the collision detector for the shape.
   dart::dynamics::ShapeNode *node =
     _collision->DARTBodyNode()->createShapeNodeWith<
       dart::dynamics::VisualAspect,
       dart::dynamics::CollisionAspect,
-      dart::dynamics::DynamicsAspect>(dtMeshShape);
+      dart::dynamics::DynamicsAspect>(_shape);
 
   this->dataPtr->dtMeshShape.set(node);
 }
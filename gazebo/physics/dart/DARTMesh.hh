@@ -20,6 +20,7 @@
 
 #include <ignition/math/Vector3.hh>
 
+#include "gazebo/physics/MeshShape.hh"
 #include "gazebo/physics/dart/DARTTypes.hh"
 #include "gazebo/util/system.hh"
 
@@ -59,19 +60,21 @@ namespace gazebo
                       DARTCollisionPtr _collision,
                       const ignition::math::Vector3d &_scale);
 
+      /// \brief Create a mesh collision shape using the mesh of a shape.
+      /// The DART shape is shared by all the shapes using the same mesh with
+      /// the same scale.
+      /// \param[in] _shape The mesh shape.
+      /// \param[in] _collision Pointer to the collision object.
+      public: void Init(const MeshShape &_shape, DARTCollisionPtr _collision);
+
       /// \brief Returns the DART mesh shape node
       public: dart::dynamics::ShapeNodePtr ShapeNode() const;
 
-      /// \brief Helper function to create the collision shape.
-      /// \param[in] _vertices Array of vertices.
-      /// \param[in] _indices Array of indices.
-      /// \param[in] _numVertices Number of vertices.
-      /// \param[in] _numIndices Number of indices.
+      /// \brief Helper function to create the collision shape node.
+      /// \param[in] _shape The DART mesh shape.
       /// \param[in] _collision Pointer to the collision object.
-      private: void CreateMesh(float *_vertices, int *_indices,
-                   unsigned int _numVertices, unsigned int _numIndices,
-                   DARTCollisionPtr _collision,
-                   const ignition::math::Vector3d &_scale);
+      private: void CreateMesh(dart::dynamics::ShapePtr _shape,
+                   DARTCollisionPtr _collision);
 
       /// \internal
       /// \brief Pointer to private data
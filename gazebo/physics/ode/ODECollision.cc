@@ -285,6 +285,38 @@ void ODECollision::SetCollideBits(unsigned int _bits)
     dGeomSetCollideBits((dGeomID)this->spaceId, _bits);
 }
 
+//////////////////////////////////////////////////
+unsigned int ODECollision::GetCategoryBits() const
+{
+  if (this->collisionId)
+  {
+    return static_cast<unsigned int>(
+        dGeomGetCategoryBits(this->collisionId));
+  }
+  if (this->spaceId)
+  {
+    return static_cast<unsigned int>(
+        dGeomGetCategoryBits((dGeomID)this->spaceId));
+  }
+  return GZ_ALL_COLLIDE;
+}
+
+//////////////////////////////////////////////////
+unsigned int ODECollision::GetCollideBits() const
+{
+  if (this->collisionId)
+  {
+    return static_cast<unsigned int>(
+        dGeomGetCollideBits(this->collisionId));
+  }
+  if (this->spaceId)
+  {
+    return static_cast<unsigned int>(
+        dGeomGetCollideBits((dGeomID)this->spaceId));
+  }
+  return GZ_ALL_COLLIDE;
+}
+
 //////////////////////////////////////////////////
 ignition::math::AxisAlignedBox ODECollision::BoundingBox() const
 {
@@ -89,6 +89,12 @@ namespace gazebo
       // Documentation inherited.
       public: virtual void SetCollideBits(unsigned int bits);
 
+      // Documentation inherited.
+      public: virtual unsigned int GetCategoryBits() const;
+
+      // Documentation inherited.
+      public: virtual unsigned int GetCollideBits() const;
+
       // Documentation inherited.
       public: virtual ignition::math::AxisAlignedBox BoundingBox() const;
 
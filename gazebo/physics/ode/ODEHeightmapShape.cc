@@ -14,18 +14,37 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+#include <ignition/math/AxisAlignedBox.hh>
+
+#include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/World.hh"
 #include "gazebo/physics/ode/ODECollision.hh"
 #include "gazebo/physics/ode/ODEHeightmapShape.hh"
 
 using namespace gazebo;
 using namespace physics;
 
+/// \brief Number of world updates between two prefetches of the tiles
+/// under the moving links.
+static const unsigned int kPrefetchInterval = 10;
+
 //////////////////////////////////////////////////
 ODEHeightmapShape::ODEHeightmapShape(CollisionPtr _parent)
     : HeightmapShape(_parent)
 {
   this->flipY = false;
+
+  // ODE reads tiled heights through GetHeightCallback
+  this->tileSupport = true;
 }
 
 //////////////////////////////////////////////////
@@ -110,19 +129,41 @@ void ODEHeightmapShape::Init()
 
 
   // Step 3: Setup a callback method for ODE
-  setOdeHeightfieldDetails(
-      this->odeData,
-      this->heights.data(),
-      // in meters
-      this->Size().X(),
-      // in meters
-      this->Size().Y(),
-      // number of vertices
-      this->vertSize,
-      // vertical (z-axis) offset
-      this->Pos().Z(),
-      // vertical thickness for closing the height map mesh
-      1.0);
+  if (this->Tiled())
+  {
+    // The heights are paged from the tiles by the callback
+    dGeomHeightfieldDataBuildCallback(
+        this->odeData,
+        this,
+        &ODEHeightmapShape::GetHeightCallback,
+        this->Size().X(),   // width (in meters)
+        this->Size().Y(),   // height (in meters)
+        this->vertSize,     // width (sampling size)
+        this->vertSize,     // height (sampling size)
+        1.0,                // vertical (z-axis) scaling
+        this->Pos().Z(),    // vertical (z-axis) offset
+        1.0,                // vertical thickness for closing the mesh
+        0);                 // wrap mode
+
+    this->updateConnection = event::Events::ConnectWorldUpdateBegin(
+        std::bind(&ODEHeightmapShape::OnUpdate, this));
+  }
+  else
+  {
+    setOdeHeightfieldDetails(
+        this->odeData,
+        this->heights.data(),
+        // in meters
+        this->Size().X(),
+        // in meters
+        this->Size().Y(),
+        // number of vertices
+        this->vertSize,
+        // vertical (z-axis) offset
+        this->Pos().Z(),
+        // vertical thickness for closing the height map mesh
+        1.0);
+  }
 
   // Step 4: Restrict the bounds of the AABB to improve efficiency
   dGeomHeightfieldDataSetBounds(this->odeData, this->GetMinHeight(),
@@ -160,3 +201,73 @@ void ODEHeightmapShape::Init()
   // dGeomSetOffsetQuaternion(oParent->getCollisionId(), q);
   dGeomSetQuaternion(oParent->GetCollisionId(), q);
 }
+
+//////////////////////////////////////////////////
+void ODEHeightmapShape::OnUpdate()
+{
+  if (!this->tileCache || this->vertSize < 2)
+    return;
+
+  // Computing the bounding boxes of all the links is too costly to do on
+  // every update, so the boxes are extended by the distance the links
+  // travel until the next prefetch. A tile that is missed anyway is read
+  // when ODE needs it.
+  if (this->updateCount++ % kPrefetchInterval != 0)
+    return;
+  const double lookahead =
+      kPrefetchInterval * this->world->Physics()->GetMaxStepSize();
+
+  const ignition::math::Pose3d pose = this->collisionParent->WorldPose();
+  const ignition::math::Vector3d size = this->Size();
+  const double last = this->vertSize - 1;
+
+  for (auto const &model : this->world->Models())
+  {
+    if (model->IsStatic())
+      continue;
+
+    for (auto const &link : model->GetLinks())
+    {
+      if (!link->GetEnabled())
+        continue;
+
+      // Vertices under the corners of the bounding box of the link. The
+      // rows of ODE heightfields go along -Y, see the rotation in Init.
+      ignition::math::AxisAlignedBox box = link->BoundingBox();
+      const ignition::math::Vector3d travel =
+          link->WorldLinearVel() * lookahead;
+      box.Min() += ignition::math::Vector3d(std::min(travel.X(), 0.0),
+          std::min(travel.Y(), 0.0), std::min(travel.Z(), 0.0));
+      box.Max() += ignition::math::Vector3d(std::max(travel.X(), 0.0),
+          std::max(travel.Y(), 0.0), std::max(travel.Z(), 0.0));
+      double x0 = std::numeric_limits<double>::max();
+      double y0 = x0;
+      double x1 = -x0;
+      double y1 = -x0;
+      for (const double x : {box.Min().X(), box.Max().X()})
+      {
+        for (const double y : {box.Min().Y(), box.Max().Y()})
+        {
+          const ignition::math::Vector3d local = pose.Rot().RotateVectorReverse(
+              ignition::math::Vector3d(x, y, box.Min().Z()) - pose.Pos());
+          const double vx = (local.X() / size.X() + 0.5) * last;
+          const double vy = (-local.Y() / size.Y() + 0.5) * last;
+          x0 = std::min(x0, vx);
+          y0 = std::min(y0, vy);
+          x1 = std::max(x1, vx);
+          y1 = std::max(y1, vy);
+        }
+      }
+
+      // Skip links outside of the heightmap, with a margin of a vertex
+      if (x1 < -1 || y1 < -1 || x0 > last + 1 || y0 > last + 1)
+        continue;
+
+      this->tileCache->Prefetch(
+          static_cast<unsigned int>(std::max(0.0, std::floor(x0) - 1)),
+          static_cast<unsigned int>(std::max(0.0, std::floor(y0) - 1)),
+          static_cast<unsigned int>(std::min(last, std::ceil(x1) + 1)),
+          static_cast<unsigned int>(std::min(last, std::ceil(y1) + 1)));
+    }
+  }
+}
@@ -44,6 +44,12 @@ namespace gazebo
       // Documentation inerited.
       public: virtual void Init();
 
+      /// \brief Read the tiles of the heights under the moving links
+      /// before they collide, when the heights are tiled. This is only
+      /// done every few updates, for the region the links may reach
+      /// until the next time.
+      private: void OnUpdate();
+
       /// \brief Called by ODE to get the height at a vertex.
       /// \param[in] _data Pointer to the heightmap data.
       /// \param[in] _x X location.
@@ -52,6 +58,13 @@ namespace gazebo
 
       /// \brief The heightmap data.
       private: dHeightfieldDataID odeData;
+
+      /// \brief Connection to the world update begin event, only used
+      /// when the heights are tiled.
+      private: event::ConnectionPtr updateConnection;
+
+      /// \brief Number of world updates since the heights were tiled.
+      private: unsigned int updateCount = 0;
     };
     /// \}
   }
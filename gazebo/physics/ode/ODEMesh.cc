@@ -14,10 +14,13 @@
  * limitations under the License.
  *
 */
+#include <utility>
+
 #include "gazebo/common/Mesh.hh"
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 
+#include "gazebo/physics/TriMeshCache.hh"
 #include "gazebo/physics/ode/ODECollision.hh"
 #include "gazebo/physics/ode/ODEPhysics.hh"
 #include "gazebo/physics/ode/ODEMesh.hh"
@@ -25,20 +28,63 @@
 using namespace gazebo;
 using namespace physics;
 
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief ODE trimesh data, with the OPCODE tree of the triangles.
+    /// ODE geoms can share trimesh data, the last transform of a geom is
+    /// stored in the geom.
+    class ODETriMeshData
+    {
+      /// \brief Constructor. Build the trimesh data.
+      /// \param[in] _triangles The triangles, referenced by the trimesh
+      /// data.
+      public: explicit ODETriMeshData(
+                  std::shared_ptr<const TriMeshData> _triangles)
+        : triangles(std::move(_triangles))
+      {
+        this->odeData = dGeomTriMeshDataCreate();
+        dGeomTriMeshDataBuildSingle(this->odeData,
+            this->triangles->vertices.data(), 3*sizeof(float),
+            this->triangles->VertexCount(),
+            this->triangles->indices.data(), this->triangles->IndexCount(),
+            3*sizeof(int));
+      }
+
+      /// \brief Destructor.
+      public: ~ODETriMeshData()
+      {
+        dGeomTriMeshDataDestroy(this->odeData);
+      }
+
+      /// \brief The triangles.
+      public: std::shared_ptr<const TriMeshData> triangles;
+
+      /// \brief ODE trimesh data.
+      public: dTriMeshDataID odeData = nullptr;
+    };
+
+    /// \brief Trimesh data of the mesh shapes, shared by the shapes using
+    /// the same mesh and scale.
+    static TriMeshCache<ODETriMeshData> &odeTriMeshCache()
+    {
+      static TriMeshCache<ODETriMeshData> cache;
+      return cache;
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 ODEMesh::ODEMesh()
 {
-  this->odeData = nullptr;
-  this->vertices = nullptr;
-  this->indices = nullptr;
+  this->collisionId = nullptr;
 }
 
 //////////////////////////////////////////////////
 ODEMesh::~ODEMesh()
 {
-  delete [] this->vertices;
-  delete [] this->indices;
-  dGeomTriMeshDataDestroy(this->odeData);
 }
 
 //////////////////////////////////////////////////
@@ -86,18 +132,9 @@ void ODEMesh::Init(const common::SubMesh *_subMesh, ODECollisionPtr _collision,
   if (!_subMesh)
     return;
 
-  unsigned int numVertices = _subMesh->GetVertexCount();
-  unsigned int numIndices = _subMesh->GetIndexCount();
-
-  this->vertices = nullptr;
-  this->indices = nullptr;
-
-  // Get all the vertex and index data
-  _subMesh->FillArrays(&this->vertices, &this->indices);
-
-  this->collisionId = _collision->GetCollisionId();
-
-  this->CreateMesh(numVertices, numIndices, _collision, _scale);
+  this->CreateMesh(std::make_shared<ODETriMeshData>(
+        std::make_shared<TriMeshData>(nullptr, _subMesh, _scale)),
+      _collision);
 }
 
 //////////////////////////////////////////////////
@@ -107,51 +144,49 @@ void ODEMesh::Init(const common::Mesh *_mesh, ODECollisionPtr _collision,
   if (!_mesh)
     return;
 
-  unsigned int numVertices = _mesh->GetVertexCount();
-  unsigned int numIndices = _mesh->GetIndexCount();
-
-  this->vertices = nullptr;
-  this->indices = nullptr;
-
-  // Get all the vertex and index data
-  _mesh->FillArrays(&this->vertices, &this->indices);
-
-  this->collisionId = _collision->GetCollisionId();
-  this->CreateMesh(numVertices, numIndices, _collision, _scale);
+  this->CreateMesh(std::make_shared<ODETriMeshData>(
+        std::make_shared<TriMeshData>(_mesh, nullptr, _scale)),
+      _collision);
 }
 
 //////////////////////////////////////////////////
-void ODEMesh::CreateMesh(unsigned int _numVertices, unsigned int _numIndices,
-    ODECollisionPtr _collision, const ignition::math::Vector3d &_scale)
+void ODEMesh::Init(const MeshShape &_shape, ODECollisionPtr _collision)
 {
-  /// This will hold the vertex data of the triangle mesh
-  if (this->odeData == nullptr)
-    this->odeData = dGeomTriMeshDataCreate();
+  const common::Mesh *mesh = _shape.CollisionMesh();
+  const common::SubMesh *subMesh = _shape.CollisionSubMesh();
+  if (!mesh && !subMesh)
+    return;
 
-  // Scale the vertex data
-  for (unsigned int j = 0;  j < _numVertices; j++)
-  {
-    this->vertices[j*3+0] = this->vertices[j*3+0] * _scale.X();
-    this->vertices[j*3+1] = this->vertices[j*3+1] * _scale.Y();
-    this->vertices[j*3+2] = this->vertices[j*3+2] * _scale.Z();
-  }
+  const std::string key = _shape.MeshCacheKey();
+  const ignition::math::Vector3d scale = _shape.Size();
+  std::shared_ptr<ODETriMeshData> data = odeTriMeshCache().Get(key, [&]()
+      {
+        return std::make_shared<ODETriMeshData>(
+            TriMeshData::Load(key, mesh, subMesh, scale));
+      });
 
-  // Build the ODE triangle mesh
-  dGeomTriMeshDataBuildSingle(this->odeData,
-      this->vertices, 3*sizeof(this->vertices[0]), _numVertices,
-      this->indices, _numIndices, 3*sizeof(this->indices[0]));
+  this->CreateMesh(data, _collision);
+}
 
+//////////////////////////////////////////////////
+void ODEMesh::CreateMesh(std::shared_ptr<ODETriMeshData> _data,
+    ODECollisionPtr _collision)
+{
   if (_collision->GetCollisionId() == nullptr)
   {
     _collision->SetSpaceId(dSimpleSpaceCreate(_collision->GetSpaceId()));
     _collision->SetCollision(dCreateTriMesh(_collision->GetSpaceId(),
-          this->odeData, 0, 0, 0), true);
+          _data->odeData, 0, 0, 0), true);
   }
   else
   {
-    dGeomTriMeshSetData(_collision->GetCollisionId(), this->odeData);
+    dGeomTriMeshSetData(_collision->GetCollisionId(), _data->odeData);
   }
 
+  // Release the previous data only once the geom doesn't use it anymore
+  this->meshData = _data;
+  this->collisionId = _collision->GetCollisionId();
+
   memset(this->transform, 0, 32*sizeof(dReal));
   this->transformIndex = 0;
 }
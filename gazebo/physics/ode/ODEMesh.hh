@@ -18,6 +18,8 @@
 #ifndef GAZEBO_PHYSICS_ODE_ODEMESH_HH_
 #define GAZEBO_PHYSICS_ODE_ODEMESH_HH_
 
+#include <memory>
+
 #include <ignition/math/Vector3.hh>
 
 #include "gazebo/physics/ode/ODETypes.hh"
@@ -29,6 +31,9 @@ namespace gazebo
 {
   namespace physics
   {
+    // Forward declare the shared trimesh data
+    class ODETriMeshData;
+
     /// \addtogroup gazebo_physics_ode
     /// \{
 
@@ -57,16 +62,21 @@ namespace gazebo
                       ODECollisionPtr _collision,
                       const ignition::math::Vector3d &_scale);
 
+      /// \brief Create a mesh collision shape using the mesh of a shape.
+      /// The vertex data and the ODE trimesh data are shared by all the
+      /// shapes using the same mesh with the same scale.
+      /// \param[in] _shape The mesh shape.
+      /// \param[in] _collision Pointer to the collision object.
+      public: void Init(const MeshShape &_shape, ODECollisionPtr _collision);
+
       /// \brief Update the collision mesh.
       public: virtual void Update();
 
       /// \brief Helper function to create the collision shape.
-      /// \param[in] _numVertices Number of vertices.
-      /// \param[in] _numIndices Number of indices.
+      /// \param[in] _data The trimesh data.
       /// \param[in] _collision Pointer to the collision object.
-      private: void CreateMesh(unsigned int _numVertices,
-                   unsigned int _numIndices, ODECollisionPtr _collision,
-                   const ignition::math::Vector3d &_scale);
+      private: void CreateMesh(std::shared_ptr<ODETriMeshData> _data,
+                   ODECollisionPtr _collision);
 
       /// \brief Transform matrix.
       private: dReal transform[16*2];
@@ -74,14 +84,8 @@ namespace gazebo
       /// \brief Transform matrix index.
       private: int transformIndex;
 
-      /// \brief Array of vertex values.
-      private: float *vertices;
-
-      /// \brief Array of index values.
-      private: int *indices;
-
-      /// \brief ODE trimesh data.
-      private: dTriMeshDataID odeData;
+      /// \brief Trimesh data, possibly shared with other meshes.
+      private: std::shared_ptr<ODETriMeshData> meshData;
 
       /// \brief The collision id that this mesh is attached to.
       private: dGeomID collisionId;
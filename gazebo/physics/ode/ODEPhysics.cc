@@ -17,6 +17,7 @@
 
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
+#include <tbb/task_arena.h>
 
 #include <sdf/sdf.hh>
 
@@ -85,6 +86,14 @@ using namespace physics;
 
 GZ_REGISTER_PHYSICS_ENGINE("ode", ODEPhysics)
 
+/// \brief Minimum number of collision pairs for which the parallel narrow
+/// phase is used. Below this the serial loop is faster.
+static const unsigned int kParallelNarrowPhaseMinPairs = 32;
+
+/// \brief Number of collision pairs handed to a worker at once by the
+/// parallel narrow phase.
+static const unsigned int kParallelNarrowPhaseGrainSize = 8;
+
 /*
 class ContactUpdate_TBB
 {
@@ -103,36 +112,66 @@ class ContactUpdate_TBB
 };
 */
 
-class Colliders_TBB
+//////////////////////////////////////////////////
+extern "C" void dMessageQuiet(int, const char *, va_list)
 {
-  public: Colliders_TBB(
-              std::vector<std::pair<ODECollision*, ODECollision*> > *_colliders,
-              ODEPhysics *_engine,
-              dContactGeom* _contactCollisions) :
-    colliders(_colliders),
-              engine(_engine), contactCollisions(_contactCollisions)
-  {
-    // dAllocateODEDataForThread(dAllocateMaskAll);
-  }
-
-  public: void operator() (const tbb::blocked_range<size_t> &_r) const
-  {
-    for (size_t i = _r.begin(); i != _r.end(); i++)
-    {
-      ODECollision *collision1 = (*this->colliders)[i].first;
-      ODECollision *collision2 = (*this->colliders)[i].second;
-      this->engine->Collide(collision1, collision2, contactCollisions);
-    }
-  }
+}
 
-  private: std::vector< std::pair<ODECollision*, ODECollision*> > *colliders;
-  private: ODEPhysics *engine;
-  private: dContactGeom* contactCollisions;
-};
+//////////////////////////////////////////////////
+/// \brief Convert an axis order of the sweep and prune space.
+/// \param[in] _order Axis order, such as "xyz".
+/// \return The ODE axis order, or -1 if _order is invalid.
+static int SAPAxisOrder(const std::string &_order)
+{
+  if (_order == "xyz")
+    return dSAP_AXES_XYZ;
+  else if (_order == "xzy")
+    return dSAP_AXES_XZY;
+  else if (_order == "yxz")
+    return dSAP_AXES_YXZ;
+  else if (_order == "yzx")
+    return dSAP_AXES_YZX;
+  else if (_order == "zxy")
+    return dSAP_AXES_ZXY;
+  else if (_order == "zyx")
+    return dSAP_AXES_ZYX;
+  return -1;
+}
 
 //////////////////////////////////////////////////
-extern "C" void dMessageQuiet(int, const char *, va_list)
+/// \brief Create a top-level collision space.
+/// \param[in] _data Broadphase parameters.
+/// \return The new space.
+static dSpaceID CreateSpace(const ODEPhysicsPrivate &_data)
 {
+  dSpaceID space;
+  if (_data.broadphase == "simple")
+  {
+    space = dSimpleSpaceCreate(0);
+  }
+  else if (_data.broadphase == "sap")
+  {
+    space = dSweepAndPruneSpaceCreate(0, SAPAxisOrder(_data.sapAxisOrder));
+  }
+  else if (_data.broadphase == "quadtree")
+  {
+    dVector3 center = {_data.quadTreeCenter.X(), _data.quadTreeCenter.Y(),
+        _data.quadTreeCenter.Z(), 0};
+    dVector3 extents = {_data.quadTreeExtents.X(),
+        _data.quadTreeExtents.Y(), _data.quadTreeExtents.Z(), 0};
+    space = dQuadTreeSpaceCreate(0, center, extents, _data.quadTreeDepth);
+  }
+  else if (_data.broadphase == "aabb_tree")
+  {
+    space = dAABBTreeSpaceCreate(0);
+    dAABBTreeSpaceSetMargin(space, _data.aabbTreeMargin);
+  }
+  else
+  {
+    space = dHashSpaceCreate(0);
+    dHashSpaceSetLevels(space, _data.hashMinLevel, _data.hashMaxLevel);
+  }
+  return space;
 }
 
 //////////////////////////////////////////////////
@@ -149,8 +188,7 @@ ODEPhysics::ODEPhysics(WorldPtr _world)
 
   this->dataPtr->worldId = dWorldCreate();
 
-  this->dataPtr->spaceId = dHashSpaceCreate(0);
-  dHashSpaceSetLevels(this->dataPtr->spaceId, -2, 8);
+  this->dataPtr->spaceId = CreateSpace(*this->dataPtr);
 
   this->dataPtr->contactGroup = dJointGroupCreate(0);
 
@@ -239,6 +277,96 @@ void ODEPhysics::Load(sdf::ElementPtr _sdf)
   this->SetStepType(this->dataPtr->stepType);
   if (this->dataPtr->physicsStepFunc == nullptr)
     gzthrow(std::string("Invalid step type[") + this->dataPtr->stepType);
+
+  // Optional parallel narrow phase. This is not part of the SDFormat spec,
+  // so it is read from the original element rather than this->sdf.
+  const std::string kNarrowPhase = "gz:narrow_phase";
+  if (_sdf->HasElement("ode") &&
+      _sdf->GetElement("ode")->HasElement(kNarrowPhase))
+  {
+    sdf::ElementPtr narrowElem =
+        _sdf->GetElement("ode")->GetElement(kNarrowPhase);
+    if (narrowElem->HasElement("threads"))
+      this->SetParam("narrow_phase_threads", narrowElem->Get<int>("threads"));
+    if (narrowElem->HasElement("parallel"))
+    {
+      this->SetParam("parallel_narrow_phase",
+          narrowElem->Get<bool>("parallel"));
+    }
+  }
+
+  // Optional broadphase, also not part of the SDFormat spec.
+  const std::string kBroadphase = "gz:broadphase";
+  if (_sdf->HasElement("ode") &&
+      _sdf->GetElement("ode")->HasElement(kBroadphase))
+  {
+    sdf::ElementPtr broadElem =
+        _sdf->GetElement("ode")->GetElement(kBroadphase);
+    if (broadElem->HasElement("min_level"))
+    {
+      this->SetParam("broadphase_hash_min_level",
+          broadElem->Get<int>("min_level"));
+    }
+    if (broadElem->HasElement("max_level"))
+    {
+      this->SetParam("broadphase_hash_max_level",
+          broadElem->Get<int>("max_level"));
+    }
+    if (broadElem->HasElement("axis_order"))
+    {
+      this->SetParam("broadphase_sap_axis_order",
+          broadElem->Get<std::string>("axis_order"));
+    }
+    if (broadElem->HasElement("center"))
+    {
+      this->SetParam("broadphase_quadtree_center",
+          broadElem->Get<ignition::math::Vector3d>("center"));
+    }
+    if (broadElem->HasElement("extents"))
+    {
+      this->SetParam("broadphase_quadtree_extents",
+          broadElem->Get<ignition::math::Vector3d>("extents"));
+    }
+    if (broadElem->HasElement("depth"))
+    {
+      this->SetParam("broadphase_quadtree_depth",
+          broadElem->Get<int>("depth"));
+    }
+    if (broadElem->HasElement("margin"))
+    {
+      this->SetParam("broadphase_aabb_tree_margin",
+          broadElem->Get<double>("margin"));
+    }
+    if (broadElem->HasElement("type"))
+    {
+      this->SetParam("broadphase", broadElem->Get<std::string>("type"));
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::ResetSpace()
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  dSpaceID oldSpace = this->dataPtr->spaceId;
+  dSpaceID newSpace = CreateSpace(*this->dataPtr);
+
+  // Link spaces, and geoms created directly in the top-level space such as
+  // rays, keep their ids, so nothing else refers to the old space.
+  if (oldSpace)
+  {
+    while (dSpaceGetNumGeoms(oldSpace) > 0)
+    {
+      dGeomID geom = dSpaceGetGeom(oldSpace, 0);
+      dSpaceRemove(oldSpace, geom);
+      dSpaceAdd(newSpace, geom);
+    }
+    dSpaceSetCleanup(oldSpace, 0);
+    dSpaceDestroy(oldSpace);
+  }
+
+  this->dataPtr->spaceId = newSpace;
 }
 
 /////////////////////////////////////////////////
@@ -387,10 +515,19 @@ void ODEPhysics::UpdateCollision()
 
   IGN_PROFILE_BEGIN("collideShapes");
   // Generate non-trimesh collisions.
-  for (i = 0; i < this->dataPtr->collidersCount; ++i)
+  if (this->dataPtr->parallelNarrowPhase &&
+      this->dataPtr->collidersCount >= kParallelNarrowPhaseMinPairs)
   {
-    this->Collide(this->dataPtr->colliders[i].first,
-        this->dataPtr->colliders[i].second, this->dataPtr->contactCollisions);
+    this->CollideParallel();
+  }
+  else
+  {
+    for (i = 0; i < this->dataPtr->collidersCount; ++i)
+    {
+      this->Collide(this->dataPtr->colliders[i].first,
+          this->dataPtr->colliders[i].second,
+          this->dataPtr->contactCollisions);
+    }
   }
   DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "collideShapes");
   IGN_PROFILE_END();
@@ -1017,11 +1154,104 @@ void ODEPhysics::CollisionCallback(void *_data, dGeomID _o1, dGeomID _o2)
 //////////////////////////////////////////////////
 void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
                          dContactGeom *_contactCollisions)
+{
+  unsigned int numc = this->NarrowPhase(_collision1, _collision2,
+      _contactCollisions);
+
+  // Return if no contacts.
+  if (numc == 0)
+    return;
+
+  this->AddContactJoints(_collision1, _collision2, _contactCollisions, numc);
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::CollideParallel()
+{
+  const unsigned int count = this->dataPtr->collidersCount;
+  auto &colliders = this->dataPtr->colliders;
+  auto &results = this->dataPtr->narrowPhaseResults;
+  if (results.size() < count)
+    results.resize(count);
+
+  // dSpaceCollide has already refreshed the pose and AABB of every geom, so
+  // dCollide only reads shared geom data for the pairs handled here.
+  auto collideRange = [&](const tbb::blocked_range<unsigned int> &_r)
+  {
+    std::vector<dContactGeom> &scratch =
+        this->dataPtr->narrowPhaseScratch.local();
+    if (scratch.empty())
+    {
+      dAllocateODEDataForThread(dAllocateMaskAll);
+      scratch.resize(MAX_COLLIDE_RETURNS);
+    }
+
+    for (unsigned int i = _r.begin(); i != _r.end(); ++i)
+    {
+      ODENarrowPhaseResult &result = results[i];
+      result.contacts.clear();
+      result.serial =
+          !ParallelNarrowPhaseSafe(colliders[i].first->GetCollisionId()) ||
+          !ParallelNarrowPhaseSafe(colliders[i].second->GetCollisionId());
+      if (result.serial)
+        continue;
+
+      unsigned int numc = this->NarrowPhase(colliders[i].first,
+          colliders[i].second, scratch.data());
+      result.contacts.assign(scratch.begin(), scratch.begin() + numc);
+    }
+  };
+
+  tbb::blocked_range<unsigned int> range(0, count,
+      kParallelNarrowPhaseGrainSize);
+  if (this->dataPtr->narrowPhaseArena)
+  {
+    this->dataPtr->narrowPhaseArena->execute([&]()
+    {
+      tbb::parallel_for(range, collideRange);
+    });
+  }
+  else
+    tbb::parallel_for(range, collideRange);
+
+  // Merge in pair order, so contact joints, joint feedbacks and
+  // ContactManager entries are created exactly as in the serial path.
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    ODENarrowPhaseResult &result = results[i];
+    if (result.serial)
+    {
+      this->Collide(colliders[i].first, colliders[i].second,
+          this->dataPtr->contactCollisions);
+    }
+    else if (!result.contacts.empty())
+    {
+      this->AddContactJoints(colliders[i].first, colliders[i].second,
+          result.contacts.data(), result.contacts.size());
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+bool ODEPhysics::ParallelNarrowPhaseSafe(dGeomID _geom)
+{
+  // Trimesh colliders use per-thread caches, heightfields use per-geom
+  // scratch buffers and transforms temporarily rewrite the pose of their
+  // encapsulated geom. None of them can be collided concurrently.
+  int geomClass = dGeomGetClass(_geom);
+  return geomClass != dTriMeshClass &&
+         geomClass != dHeightfieldClass &&
+         geomClass != dGeomTransformClass;
+}
+
+//////////////////////////////////////////////////
+unsigned int ODEPhysics::NarrowPhase(ODECollision *_collision1,
+    ODECollision *_collision2, dContactGeom *_contactCollisions) const
 {
   // Filter collisions based on collide bitmask.
   if ((_collision1->GetSurface()->collideBitmask &
         _collision2->GetSurface()->collideBitmask) == 0)
-    return;
+    return 0;
 
   // Filter collisions based on contact bitmask if collide_without_contact is
   // on.The bitmask is set mainly for speed improvements otherwise a collision
@@ -1033,32 +1263,22 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     if ((_collision1->GetSurface()->collideWithoutContactBitmask &
          _collision2->GetSurface()->collideWithoutContactBitmask) == 0)
     {
-      return;
+      return 0;
     }
   }
 
-  /*
-  if (_collision1->GetCollisionId() && _collision2->GetCollisionId())
-  {
-    const dVector3 *pos1 =
-      (const dVector3*)dGeomGetPosition(_collision1->GetCollisionId());
-    const dVector3 *pos2 =
-      (const dVector3*)dGeomGetPosition(_collision2->GetCollisionId());
-    std::cout << "1[" << (*pos1)[0]<< " " << (*pos1)[1] << " "
-              << (*pos1)[2] << "] "
-      << "2[" << (*pos2)[0]<< " " << (*pos2)[1] << " " << (*pos2)[2] << "]\n";
-  }*/
-
   unsigned int numc = 0;
-  dContact contact;
 
-  // maxCollide must less than the size of this->dataPtr->indices
+  // maxCollide must less than the size of Contact::depths
   // Check the header
   unsigned int maxCollide = MAX_CONTACT_JOINTS;
 
   // max_contacts specified globally
-  if (this->GetMaxContacts() > 0 && this->GetMaxContacts() < MAX_CONTACT_JOINTS)
-    maxCollide = this->GetMaxContacts();
+  if (this->dataPtr->maxContacts > 0 &&
+      this->dataPtr->maxContacts < MAX_CONTACT_JOINTS)
+  {
+    maxCollide = this->dataPtr->maxContacts;
+  }
 
   // over-ride with minimum of max_contacts from both collisions
   if (_collision1->GetMaxContacts() < maxCollide)
@@ -1071,31 +1291,37 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   numc = dCollide(_collision1->GetCollisionId(), _collision2->GetCollisionId(),
       MAX_COLLIDE_RETURNS, _contactCollisions, sizeof(_contactCollisions[0]));
 
-  // Return if no contacts.
-  if (numc == 0)
-    return;
-
-  // Store the indices of the contacts.
-  for (int i = 0; i < MAX_CONTACT_JOINTS; i++)
-    this->dataPtr->indices[i] = i;
-
-  // Choose only the best contacts if too many were generated.
+  // Choose only the best contacts if too many were generated. The first
+  // maxCollide - 1 contacts are kept and the deepest of the remaining
+  // contacts is moved into the last slot.
   if (maxCollide > 0 && numc > maxCollide)
   {
+    unsigned int deepest = maxCollide - 1;
     double max = _contactCollisions[maxCollide-1].depth;
     for (unsigned int i = maxCollide; i < numc; ++i)
     {
       if (_contactCollisions[i].depth > max)
       {
         max = _contactCollisions[i].depth;
-        this->dataPtr->indices[maxCollide-1] = i;
+        deepest = i;
       }
     }
+    _contactCollisions[maxCollide-1] = _contactCollisions[deepest];
 
     // Make sure numc has the valid number of contacts.
     numc = maxCollide;
   }
 
+  return numc;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::AddContactJoints(ODECollision *_collision1,
+    ODECollision *_collision2, dContactGeom *_contactCollisions,
+    unsigned int _numc)
+{
+  dContact contact;
+
   // Set the contact surface parameter flags.
   contact.surface.mode = dContactBounce |
                          dContactMu2 |
@@ -1205,11 +1431,11 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
       ignition::math::Vector3d fdir1 = fd.Normalized();
       ignition::math::Vector3d contactNormalCopy, contactPositionCopy;
       // for each pair of contact point and normal
-      for (unsigned int c = 0; c < numc; ++c)
+      for (unsigned int c = 0; c < _numc; ++c)
       {
         // Copy the contact normal
         dReal *contactNormal =
-          _contactCollisions[this->dataPtr->indices[c]].normal;
+          _contactCollisions[c].normal;
         contactNormalCopy.Set(
           contactNormal[0], contactNormal[1], contactNormal[2]);
 
@@ -1239,7 +1465,7 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
 
         // Construct displacement vector from wheel center to contact point
         dReal *contactPosition =
-          _contactCollisions[this->dataPtr->indices[c]].pos;
+          _contactCollisions[c].pos;
         contactPositionCopy.Set(contactPosition[0] - wheelPosition[0],
                                 contactPosition[1] - wheelPosition[1],
                                 contactPosition[2] - wheelPosition[2]);
@@ -1274,9 +1500,9 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   // number of contact points (numc).
   // To eliminate this dependence on numc, the inverse damping
   // is multipled by numc.
-  contact.surface.slip1 *= numc;
-  contact.surface.slip2 *= numc;
-  contact.surface.slip3 *= numc;
+  contact.surface.slip1 *= _numc;
+  contact.surface.slip2 *= _numc;
+  contact.surface.slip3 *= _numc;
 
   // Combine torsional friction patch radius values
   contact.surface.patch_radius =
@@ -1381,9 +1607,9 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   }
 
   // Create a joint for each contact
-  for (unsigned int j = 0; j < numc; ++j)
+  for (unsigned int j = 0; j < _numc; ++j)
   {
-    contact.geom = _contactCollisions[this->dataPtr->indices[j]];
+    contact.geom = _contactCollisions[j];
 
     // Create the contact joint. This introduces the contact constraint to
     // ODE
@@ -1395,19 +1621,19 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     {
       // Store the contact depth
       contactFeedback->depths[j] =
-        _contactCollisions[this->dataPtr->indices[j]].depth;
+        _contactCollisions[j].depth;
 
       // Store the contact position
       contactFeedback->positions[j].Set(
-          _contactCollisions[this->dataPtr->indices[j]].pos[0],
-          _contactCollisions[this->dataPtr->indices[j]].pos[1],
-          _contactCollisions[this->dataPtr->indices[j]].pos[2]);
+          _contactCollisions[j].pos[0],
+          _contactCollisions[j].pos[1],
+          _contactCollisions[j].pos[2]);
 
       // Store the contact normal
       contactFeedback->normals[j].Set(
-          _contactCollisions[this->dataPtr->indices[j]].normal[0],
-          _contactCollisions[this->dataPtr->indices[j]].normal[1],
-          _contactCollisions[this->dataPtr->indices[j]].normal[2]);
+          _contactCollisions[j].normal[0],
+          _contactCollisions[j].normal[1],
+          _contactCollisions[j].normal[2]);
 
       // Set the joint feedback.
       dJointSetFeedback(contactJoint, &(jointFeedback->feedbacks[j]));
@@ -1648,6 +1874,133 @@ bool ODEPhysics::SetParam(const std::string &_key, const boost::any &_value)
       }
       dWorldSetIslandThreads(this->dataPtr->worldId, value);
     }
+    else if (_key == "parallel_narrow_phase")
+    {
+      bool value;
+      try
+      {
+        value = any_cast<bool>(_value);
+      }
+      catch(std::bad_any_cast &)
+      {
+        // Preset profiles pass values not in the SDFormat spec as strings.
+        sdf::Param strParam("key", "string", "false", false, "description");
+        strParam.Set(any_cast<std::string>(_value));
+        strParam.Get<bool>(value);
+      }
+      this->dataPtr->parallelNarrowPhase = value;
+    }
+    else if (_key == "narrow_phase_threads")
+    {
+      int value = any_cast<int>(_value);
+      if (value < 0)
+      {
+        gzerr << "narrow_phase_threads must be non-negative\n";
+        return false;
+      }
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      this->dataPtr->narrowPhaseThreads = value;
+      if (value == 0)
+        this->dataPtr->narrowPhaseArena.reset();
+      else
+        this->dataPtr->narrowPhaseArena.reset(new tbb::task_arena(value));
+    }
+    else if (_key == "broadphase")
+    {
+      const std::string value = any_cast<std::string>(_value);
+      if (value != "hash" && value != "sap" && value != "quadtree" &&
+          value != "aabb_tree" && value != "simple")
+      {
+        gzerr << "Invalid broadphase[" << value << "], must be one of "
+              << "hash, sap, quadtree, aabb_tree or simple\n";
+        return false;
+      }
+      if (value != this->dataPtr->broadphase)
+      {
+        this->dataPtr->broadphase = value;
+        this->ResetSpace();
+      }
+    }
+    else if (_key == "broadphase_hash_min_level" ||
+             _key == "broadphase_hash_max_level")
+    {
+      const int value = any_cast<int>(_value);
+      int minLevel = this->dataPtr->hashMinLevel;
+      int maxLevel = this->dataPtr->hashMaxLevel;
+      if (_key == "broadphase_hash_min_level")
+        minLevel = value;
+      else
+        maxLevel = value;
+      if (minLevel > maxLevel)
+      {
+        gzerr << "broadphase_hash_min_level[" << minLevel << "] must not be "
+              << "greater than broadphase_hash_max_level[" << maxLevel
+              << "]\n";
+        return false;
+      }
+      this->dataPtr->hashMinLevel = minLevel;
+      this->dataPtr->hashMaxLevel = maxLevel;
+      if (this->dataPtr->broadphase == "hash")
+        dHashSpaceSetLevels(this->dataPtr->spaceId, minLevel, maxLevel);
+    }
+    else if (_key == "broadphase_sap_axis_order")
+    {
+      const std::string value = any_cast<std::string>(_value);
+      if (SAPAxisOrder(value) < 0)
+      {
+        gzerr << "Invalid broadphase_sap_axis_order[" << value
+              << "], must be a permutation of xyz\n";
+        return false;
+      }
+      this->dataPtr->sapAxisOrder = value;
+      if (this->dataPtr->broadphase == "sap")
+        this->ResetSpace();
+    }
+    else if (_key == "broadphase_quadtree_center" ||
+             _key == "broadphase_quadtree_extents")
+    {
+      const ignition::math::Vector3d value =
+          any_cast<ignition::math::Vector3d>(_value);
+      if (_key == "broadphase_quadtree_center")
+      {
+        this->dataPtr->quadTreeCenter = value;
+      }
+      else
+      {
+        if (value.X() <= 0 || value.Y() <= 0)
+        {
+          gzerr << "broadphase_quadtree_extents must be positive\n";
+          return false;
+        }
+        this->dataPtr->quadTreeExtents = value;
+      }
+      if (this->dataPtr->broadphase == "quadtree")
+        this->ResetSpace();
+    }
+    else if (_key == "broadphase_quadtree_depth")
+    {
+      const int value = any_cast<int>(_value);
+      if (value < 1)
+      {
+        gzerr << "broadphase_quadtree_depth must be positive\n";
+        return false;
+      }
+      this->dataPtr->quadTreeDepth = value;
+      if (this->dataPtr->broadphase == "quadtree")
+        this->ResetSpace();
+    }
+    else if (_key == "broadphase_aabb_tree_margin")
+    {
+      const double value = any_cast<double>(_value);
+      if (value < 0)
+      {
+        gzerr << "broadphase_aabb_tree_margin must be non-negative\n";
+        return false;
+      }
+      this->dataPtr->aabbTreeMargin = value;
+      if (this->dataPtr->broadphase == "aabb_tree")
+        dAABBTreeSpaceSetMargin(this->dataPtr->spaceId, value);
+    }
     else if (_key == "ode_quiet")
     {
       bool odeQuiet;
@@ -1773,6 +2126,26 @@ bool ODEPhysics::GetParam(const std::string &_key, boost::any &_value) const
     _value = this->GetFrictionModel();
   else if (_key == "island_threads")
     _value = dWorldGetIslandThreads(this->dataPtr->worldId);
+  else if (_key == "parallel_narrow_phase")
+    _value = this->dataPtr->parallelNarrowPhase;
+  else if (_key == "narrow_phase_threads")
+    _value = this->dataPtr->narrowPhaseThreads;
+  else if (_key == "broadphase")
+    _value = this->dataPtr->broadphase;
+  else if (_key == "broadphase_hash_min_level")
+    _value = this->dataPtr->hashMinLevel;
+  else if (_key == "broadphase_hash_max_level")
+    _value = this->dataPtr->hashMaxLevel;
+  else if (_key == "broadphase_sap_axis_order")
+    _value = this->dataPtr->sapAxisOrder;
+  else if (_key == "broadphase_quadtree_center")
+    _value = this->dataPtr->quadTreeCenter;
+  else if (_key == "broadphase_quadtree_extents")
+    _value = this->dataPtr->quadTreeExtents;
+  else if (_key == "broadphase_quadtree_depth")
+    _value = this->dataPtr->quadTreeDepth;
+  else if (_key == "broadphase_aabb_tree_margin")
+    _value = this->dataPtr->aabbTreeMargin;
   else if (_key == "ode_quiet")
     _value = dGetMessageHandler() != 0;
   else if (_key == "world_step_solver")
@@ -315,6 +315,44 @@ namespace gazebo
       private: void AddCollider(ODECollision *_collision1,
                                 ODECollision *_collision2);
 
+      /// \brief Generate and select the contacts between two collision
+      /// objects. This does not modify the physics engine, so it can run
+      /// concurrently for pairs accepted by ParallelNarrowPhaseSafe.
+      /// \param[in] _collision1 First collision object.
+      /// \param[in] _collision2 Second collision object.
+      /// \param[out] _contactCollisions Array of at least
+      /// MAX_COLLIDE_RETURNS contacts. The selected contacts are stored at
+      /// the front of the array.
+      /// \return Number of selected contacts.
+      private: unsigned int NarrowPhase(ODECollision *_collision1,
+                   ODECollision *_collision2,
+                   dContactGeom *_contactCollisions) const;
+
+      /// \brief Create contact joints, and contact feedback if requested,
+      /// for contacts generated by NarrowPhase.
+      /// \param[in] _collision1 First collision object.
+      /// \param[in] _collision2 Second collision object.
+      /// \param[in,out] _contactCollisions Array of contacts.
+      /// \param[in] _numc Number of contacts in _contactCollisions.
+      private: void AddContactJoints(ODECollision *_collision1,
+                   ODECollision *_collision2,
+                   dContactGeom *_contactCollisions,
+                   unsigned int _numc);
+
+      /// \brief Run the narrow phase for all normal colliders on a thread
+      /// pool, then create the contact joints in collider order.
+      private: void CollideParallel();
+
+      /// \brief Check if dCollide can be called on a geom from several
+      /// threads at once.
+      /// \param[in] _geom The geom to check.
+      /// \return True if the geom can be collided concurrently.
+      private: static bool ParallelNarrowPhaseSafe(dGeomID _geom);
+
+      /// \brief Replace the top-level collision space with a space using
+      /// the current broadphase parameters, moving every geom to it.
+      private: void ResetSpace();
+
       /// \internal
       /// \brief Private data pointer.
       private: ODEPhysicsPrivate *dataPtr;
@@ -19,10 +19,16 @@
 #define _ODEPHYSICS_PRIVATE_HH_
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 #include <utility>
 
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/task_arena.h>
+
+#include <ignition/math/Vector3.hh>
+
 #include "gazebo/physics/Contact.hh"
 #include "gazebo/physics/ode/ODETypes.hh"
 
@@ -45,6 +51,18 @@ namespace gazebo
       public: dJointFeedback feedbacks[MAX_CONTACT_JOINTS];
     };
 
+    /// \brief Contacts generated for one collider by the parallel narrow
+    /// phase.
+    class ODENarrowPhaseResult
+    {
+      /// \brief Selected contacts for the collider.
+      public: std::vector<dContactGeom> contacts;
+
+      /// \brief True if the collider must be collided on the physics
+      /// thread instead.
+      public: bool serial = false;
+    };
+
     class ODEPhysicsPrivate
     {
       /// \brief Top-level world for all bodies
@@ -78,8 +96,52 @@ namespace gazebo
       /// \brief Array of contact collisions.
       public: dContactGeom contactCollisions[MAX_COLLIDE_RETURNS];
 
-      /// \brief Indices used during creation of contact joints.
-      public: int indices[MAX_CONTACT_JOINTS];
+      /// \brief True to run the narrow phase of normal colliders in
+      /// parallel.
+      public: bool parallelNarrowPhase = false;
+
+      /// \brief Number of threads used by the parallel narrow phase, 0 to
+      /// let TBB decide.
+      public: int narrowPhaseThreads = 0;
+
+      /// \brief Arena that bounds the number of threads used by the
+      /// parallel narrow phase. Null if narrowPhaseThreads is zero.
+      public: std::unique_ptr<tbb::task_arena> narrowPhaseArena;
+
+      /// \brief Per collider results of the parallel narrow phase. Kept
+      /// between steps to reuse the allocated contact buffers.
+      public: std::vector<ODENarrowPhaseResult> narrowPhaseResults;
+
+      /// \brief Per thread dCollide output buffers for the parallel narrow
+      /// phase.
+      public: tbb::enumerable_thread_specific<std::vector<dContactGeom>>
+              narrowPhaseScratch;
+
+      /// \brief Broadphase of the top-level collision space: "hash",
+      /// "sap", "quadtree", "aabb_tree" or "simple".
+      public: std::string broadphase = "hash";
+
+      /// \brief Smallest cell size of the hash space, as a power of two.
+      public: int hashMinLevel = -2;
+
+      /// \brief Largest cell size of the hash space, as a power of two.
+      public: int hashMaxLevel = 8;
+
+      /// \brief Sorting axes of the sweep and prune space, such as "xyz".
+      public: std::string sapAxisOrder = "xyz";
+
+      /// \brief Center of the quadtree space.
+      public: ignition::math::Vector3d quadTreeCenter;
+
+      /// \brief Half size of the quadtree space.
+      public: ignition::math::Vector3d quadTreeExtents =
+              ignition::math::Vector3d(500, 500, 500);
+
+      /// \brief Depth of the quadtree space.
+      public: int quadTreeDepth = 6;
+
+      /// \brief Margin added to the AABBs stored in the AABB tree space.
+      public: double aabbTreeMargin = 0.05;
 
       /// \brief Current index into the contactFeedbacks buffer
       public: unsigned int jointFeedbackIndex;
@@ -15,6 +15,10 @@
  *
 */
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "gazebo/physics/physics.hh"
@@ -490,6 +494,130 @@ TEST_F(ODEPhysics_TEST, PhysicsMsgParam)
   PhysicsMsgParam();
 }
 
+/////////////////////////////////////////////////
+/// Test switching the broadphase of the top-level collision space
+TEST_F(ODEPhysics_TEST, Broadphase)
+{
+  Load("worlds/shapes.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+
+  boost::any value;
+  EXPECT_TRUE(odePhysics->GetParam("broadphase", value));
+  EXPECT_EQ(boost::any_cast<std::string>(value), "hash");
+  EXPECT_EQ(dSpaceGetClass(odePhysics->GetSpaceId()), dHashSpaceClass);
+  const int geomCount = dSpaceGetNumGeoms(odePhysics->GetSpaceId());
+  EXPECT_GT(geomCount, 0);
+
+  ModelPtr box = world->ModelByName("box");
+  ModelPtr sphere = world->ModelByName("sphere");
+  ASSERT_TRUE(box != nullptr);
+  ASSERT_TRUE(sphere != nullptr);
+  const ignition::math::Pose3d boxPose = box->WorldPose();
+  const ignition::math::Pose3d spherePose = sphere->WorldPose();
+
+  const std::vector<std::pair<std::string, int>> broadphases = {
+      {"simple", dSimpleSpaceClass},
+      {"sap", dSweepAndPruneSpaceClass},
+      {"quadtree", dQuadTreeSpaceClass},
+      {"aabb_tree", dAABBTreeSpaceClass},
+      {"hash", dHashSpaceClass}};
+  for (auto const &broadphase : broadphases)
+  {
+    EXPECT_TRUE(odePhysics->SetParam("broadphase",
+        std::string(broadphase.first)));
+    EXPECT_TRUE(odePhysics->GetParam("broadphase", value));
+    EXPECT_EQ(boost::any_cast<std::string>(value), broadphase.first);
+
+    // Every geom was moved to the new space
+    dSpaceID space = odePhysics->GetSpaceId();
+    EXPECT_EQ(dSpaceGetClass(space), broadphase.second);
+    EXPECT_EQ(dSpaceGetNumGeoms(space), geomCount);
+
+    // The shapes still rest on the ground plane
+    world->Step(100);
+    EXPECT_NEAR(box->WorldPose().Pos().Z(), boxPose.Pos().Z(), 1e-2);
+    EXPECT_NEAR(sphere->WorldPose().Pos().Z(), spherePose.Pos().Z(), 1e-2);
+  }
+
+  // Invalid values are rejected
+  EXPECT_FALSE(odePhysics->SetParam("broadphase", std::string("octree")));
+  EXPECT_FALSE(odePhysics->SetParam("broadphase_sap_axis_order",
+      std::string("xxy")));
+  EXPECT_FALSE(odePhysics->SetParam("broadphase_hash_min_level", 10));
+  EXPECT_FALSE(odePhysics->SetParam("broadphase_aabb_tree_margin", -1.0));
+  EXPECT_TRUE(odePhysics->GetParam("broadphase", value));
+  EXPECT_EQ(boost::any_cast<std::string>(value), "hash");
+
+  // Parameters
+  EXPECT_TRUE(odePhysics->SetParam("broadphase_hash_min_level", -4));
+  EXPECT_TRUE(odePhysics->GetParam("broadphase_hash_min_level", value));
+  EXPECT_EQ(boost::any_cast<int>(value), -4);
+  int minLevel, maxLevel;
+  dHashSpaceGetLevels(odePhysics->GetSpaceId(), &minLevel, &maxLevel);
+  EXPECT_EQ(minLevel, -4);
+  EXPECT_EQ(maxLevel, 8);
+
+  EXPECT_TRUE(odePhysics->SetParam("broadphase_aabb_tree_margin", 0.2));
+  EXPECT_TRUE(odePhysics->SetParam("broadphase", std::string("aabb_tree")));
+  EXPECT_DOUBLE_EQ(dAABBTreeSpaceGetMargin(odePhysics->GetSpaceId()), 0.2);
+}
+
+/////////////////////////////////////////////////
+/// Test every broadphase with islands stepped by several threads, which
+/// dirty the geoms of the top-level space concurrently
+TEST_F(ODEPhysics_TEST, BroadphaseIslandThreads)
+{
+  Load("worlds/shapes.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+  EXPECT_TRUE(odePhysics->SetParam("island_threads", 4));
+  const int geomCount = dSpaceGetNumGeoms(odePhysics->GetSpaceId());
+
+  // Each shape is its own island
+  std::vector<ModelPtr> models;
+  std::vector<ignition::math::Pose3d> poses;
+  for (auto const &name : {"box", "sphere", "cylinder"})
+  {
+    ModelPtr model = world->ModelByName(name);
+    ASSERT_TRUE(model != nullptr);
+    models.push_back(model);
+    poses.push_back(model->WorldPose());
+  }
+
+  for (auto const &broadphase : {"simple", "sap", "quadtree", "aabb_tree",
+                                 "hash"})
+  {
+    EXPECT_TRUE(odePhysics->SetParam("broadphase", std::string(broadphase)));
+
+    // Drop the shapes, so that they move at every step until they rest on
+    // the ground plane again
+    for (size_t i = 0; i < models.size(); ++i)
+    {
+      ignition::math::Pose3d pose = poses[i];
+      pose.Pos().Z() += 0.5;
+      models[i]->SetWorldPose(pose);
+    }
+    world->Step(1000);
+
+    EXPECT_EQ(dSpaceGetNumGeoms(odePhysics->GetSpaceId()), geomCount)
+        << broadphase;
+    for (size_t i = 0; i < models.size(); ++i)
+    {
+      EXPECT_NEAR(models[i]->WorldPose().Pos().Z(), poses[i].Pos().Z(),
+          1e-2) << broadphase << " " << models[i]->GetName();
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
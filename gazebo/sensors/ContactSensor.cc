@@ -14,8 +14,12 @@
  * limitations under the License.
  *
 */
-#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <functional>
 #include <sstream>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
 
 #include <ignition/common/Profiler.hh>
 
@@ -109,17 +113,20 @@ void ContactSensor::Load(const std::string &_worldName)
     collisionElem = collisionElem->GetNextElement("collision");
   }
 
+  this->dataPtr->worldName = this->world->Name();
+
   if (!this->dataPtr->collisions.empty())
   {
-    // request the contact manager to publish messages to a custom topic for
-    // this sensor
+    // request the contact manager to hand the contacts of the monitored
+    // collisions directly to this sensor. The contact manager still
+    // publishes them to the filter topic when someone listens.
     physics::ContactManager *mgr = this->world->Physics()->GetContactManager();
-    std::string topic = mgr->CreateFilter(this->dataPtr->filterName,
-        this->dataPtr->collisions);
-    if (!this->dataPtr->contactSub)
+    if (!mgr->HasFilter(this->dataPtr->filterName))
     {
-      this->dataPtr->contactSub = this->node->Subscribe(topic,
-          &ContactSensor::OnContacts, this);
+      mgr->CreateCallbackFilter(this->dataPtr->filterName,
+          this->dataPtr->collisions,
+          std::bind(&ContactSensor::OnContacts, this,
+            std::placeholders::_1, std::placeholders::_2));
     }
   }
 }
@@ -139,72 +146,27 @@ bool ContactSensor::UpdateImpl(const bool /*_force*/)
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   // Don't do anything if there is no new data to process.
-  if (this->dataPtr->incomingContacts.empty())
+  if (this->dataPtr->incomingSteps.empty())
     return false;
 
-  std::vector<std::string>::iterator collIter;
-  std::string collision1;
+  // The contacts received since the last update become the measurement.
+  // The previous measurement is kept to reuse its memory.
+  std::swap(this->dataPtr->contacts, this->dataPtr->incomingContacts);
+  this->dataPtr->contactCount = this->dataPtr->incomingCount;
+  this->dataPtr->incomingCount = 0;
+  this->dataPtr->incomingSteps.clear();
+  this->dataPtr->msgDirty = true;
 
-  // Clear the outgoing contact message.
-  this->dataPtr->contactsMsg.clear_contact();
-
-  // Iterate over all the contact messages
-  for (auto iter = this->dataPtr->incomingContacts.begin();
-       iter != this->dataPtr->incomingContacts.end(); ++iter)
-  {
-    // Iterate over all the contacts in the message
-    for (int i = 0; i < (*iter)->contact_size(); ++i)
-    {
-      collision1 = (*iter)->contact(i).collision1();
-
-      // Try to find the first collision's name
-      collIter = std::find(this->dataPtr->collisions.begin(),
-          this->dataPtr->collisions.end(), collision1);
-
-      // If unable to find the first collision's name, try the second
-      if (collIter == this->dataPtr->collisions.end())
-      {
-        collision1 = (*iter)->contact(i).collision2();
-        collIter = std::find(this->dataPtr->collisions.begin(),
-            this->dataPtr->collisions.end(), collision1);
-      }
-
-      // If this sensor is monitoring one of the collision's in the
-      // contact, then add the contact to our outgoing message.
-      if (collIter != this->dataPtr->collisions.end())
-      {
-        int count = (*iter)->contact(i).position_size();
-
-        // Check to see if the contact arrays all have the same size.
-        if (count != (*iter)->contact(i).normal_size() ||
-            count != (*iter)->contact(i).wrench_size() ||
-            count != (*iter)->contact(i).depth_size())
-        {
-          gzerr << "Contact message has invalid array sizes\n";
-          continue;
-        }
-
-        // Copy the contact message.
-        msgs::Contact *contactMsg = this->dataPtr->contactsMsg.add_contact();
-        contactMsg->CopyFrom((*iter)->contact(i));
-      }
-    }
-  }
+  this->lastMeasurementTime = this->world->SimTime();
 
   IGN_PROFILE_END();
   IGN_PROFILE_BEGIN("Publish");
 
-  // Clear the incoming contact list.
-  this->dataPtr->incomingContacts.clear();
-
-  this->lastMeasurementTime = this->world->SimTime();
-  msgs::Set(this->dataPtr->contactsMsg.mutable_time(),
-            this->lastMeasurementTime);
-
   // Generate a outgoing message only if someone is listening.
   if (this->dataPtr->contactsPub &&
       this->dataPtr->contactsPub->HasConnections())
   {
+    this->UpdateContactsMsg();
     this->dataPtr->contactsPub->Publish(this->dataPtr->contactsMsg);
   }
 
@@ -212,17 +174,62 @@ bool ContactSensor::UpdateImpl(const bool /*_force*/)
   return true;
 }
 
+//////////////////////////////////////////////////
+void ContactSensor::UpdateContactsMsg() const
+{
+  if (!this->dataPtr->msgDirty)
+    return;
+
+  // Clearing the contacts keeps their memory for the next message.
+  msgs::Contacts &msg = this->dataPtr->contactsMsg;
+  msg.clear_contact();
+  for (size_t i = 0; i < this->dataPtr->contactCount; ++i)
+  {
+    const ContactSensorContact &contact = this->dataPtr->contacts[i];
+    msgs::Contact *contactMsg = msg.add_contact();
+    contactMsg->set_world(this->dataPtr->worldName);
+    contactMsg->set_collision1(contact.collision1);
+    contactMsg->set_collision2(contact.collision2);
+    msgs::Set(contactMsg->mutable_time(), contact.time);
+
+    for (auto const &point : contact.points)
+    {
+      contactMsg->add_depth(point.depth);
+      msgs::Set(contactMsg->add_position(), point.position);
+      msgs::Set(contactMsg->add_normal(), point.normal);
+
+      msgs::JointWrench *jntWrench = contactMsg->add_wrench();
+      jntWrench->set_body_1_name(contact.collision1);
+      jntWrench->set_body_1_id(contact.id1);
+      jntWrench->set_body_2_name(contact.collision2);
+      jntWrench->set_body_2_id(contact.id2);
+
+      msgs::Wrench *wrenchMsg = jntWrench->mutable_body_1_wrench();
+      msgs::Set(wrenchMsg->mutable_force(), point.wrench.body1Force);
+      msgs::Set(wrenchMsg->mutable_torque(), point.wrench.body1Torque);
+
+      wrenchMsg = jntWrench->mutable_body_2_wrench();
+      msgs::Set(wrenchMsg->mutable_force(), point.wrench.body2Force);
+      msgs::Set(wrenchMsg->mutable_torque(), point.wrench.body2Torque);
+    }
+  }
+
+  msgs::Set(msg.mutable_time(), this->lastMeasurementTime);
+  this->dataPtr->msgDirty = false;
+}
+
 //////////////////////////////////////////////////
 void ContactSensor::Fini()
 {
-  if (this->world && this->world->Running())
+  // The filter must be removed even if the world is stopped, since it
+  // calls back into this sensor.
+  if (this->world && this->world->Physics())
   {
     physics::ContactManager *mgr =
         this->world->Physics()->GetContactManager();
     mgr->RemoveFilter(this->dataPtr->filterName);
   }
 
-  this->dataPtr->contactSub.reset();
   this->dataPtr->contactsPub.reset();
   Sensor::Fini();
 }
@@ -251,12 +258,13 @@ unsigned int ContactSensor::GetCollisionContactCount(
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   unsigned int result = 0;
 
-  for (int i = 0; i < this->dataPtr->contactsMsg.contact_size(); ++i)
+  for (size_t i = 0; i < this->dataPtr->contactCount; ++i)
   {
-    if (this->dataPtr->contactsMsg.contact(i).collision1() == _collisionName ||
-        this->dataPtr->contactsMsg.contact(i).collision2() == _collisionName)
+    const ContactSensorContact &contact = this->dataPtr->contacts[i];
+    if (contact.collision1 == _collisionName ||
+        contact.collision2 == _collisionName)
     {
-      result += this->dataPtr->contactsMsg.contact(i).position_size();
+      result += contact.points.size();
     }
   }
 
@@ -267,6 +275,7 @@ unsigned int ContactSensor::GetCollisionContactCount(
 msgs::Contacts ContactSensor::Contacts() const
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->UpdateContactsMsg();
   return this->dataPtr->contactsMsg;
 }
 
@@ -275,6 +284,7 @@ std::map<std::string, gazebo::physics::Contact> ContactSensor::Contacts(
     const std::string &_collisionName) const
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->UpdateContactsMsg();
 
   std::map<std::string, gazebo::physics::Contact> result;
 
@@ -304,19 +314,57 @@ std::map<std::string, gazebo::physics::Contact> ContactSensor::Contacts(
 }
 
 //////////////////////////////////////////////////
-void ContactSensor::OnContacts(ConstContactsPtr &_msg)
+void ContactSensor::OnContacts(
+    const std::vector<physics::Contact *> &_contacts,
+    const common::Time &/*_time*/)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   // Only store information if the sensor is active
-  if (this->IsActive())
+  if (!this->IsActive())
+    return;
+
+  // Copy the contacts for processing in UpdateImpl. The filter only hands
+  // out contacts of the monitored collisions.
+  size_t added = 0;
+  for (auto const *physicsContact : _contacts)
   {
-    // Store the contacts message for processing in UpdateImpl
-    this->dataPtr->incomingContacts.push_back(_msg);
+    if (physicsContact->count <= 0)
+      continue;
 
-    // Prevent the incomingContacts list to grow indefinitely.
-    if (this->dataPtr->incomingContacts.size() > 100)
-      this->dataPtr->incomingContacts.pop_front();
+    if (this->dataPtr->incomingCount == this->dataPtr->incomingContacts.size())
+      this->dataPtr->incomingContacts.emplace_back();
+    ContactSensorContact &contact =
+        this->dataPtr->incomingContacts[this->dataPtr->incomingCount++];
+
+    contact.collision1 = physicsContact->collision1->GetScopedName();
+    contact.collision2 = physicsContact->collision2->GetScopedName();
+    contact.id1 = physicsContact->collision1->GetId();
+    contact.id2 = physicsContact->collision2->GetId();
+    contact.time = physicsContact->time;
+    contact.points.resize(physicsContact->count);
+    for (int i = 0; i < physicsContact->count; ++i)
+    {
+      ContactSensorPoint &point = contact.points[i];
+      point.position = physicsContact->positions[i];
+      point.normal = physicsContact->normals[i];
+      point.depth = physicsContact->depths[i];
+      point.wrench = physicsContact->wrench[i];
+    }
+    ++added;
+  }
+  this->dataPtr->incomingSteps.push_back(added);
+
+  // Prevent the incoming contacts to grow indefinitely, by dropping the
+  // oldest physics update.
+  if (this->dataPtr->incomingSteps.size() > 100)
+  {
+    const size_t dropped = this->dataPtr->incomingSteps.front();
+    this->dataPtr->incomingSteps.pop_front();
+    auto begin = this->dataPtr->incomingContacts.begin();
+    std::rotate(begin, begin + dropped,
+        begin + this->dataPtr->incomingCount);
+    this->dataPtr->incomingCount -= dropped;
   }
 }
 
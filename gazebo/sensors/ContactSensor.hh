@@ -20,6 +20,7 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "gazebo/msgs/msgs.hh"
 
@@ -133,8 +134,16 @@ namespace gazebo
       // Documentation inherited.
       public: virtual bool IsActive() const;
 
-      /// \brief Callback for contact messages from the physics engine.
-      private: void OnContacts(ConstContactsPtr &_msg);
+      /// \brief Callback for contacts from the contact manager, called
+      /// from the physics thread after every physics update.
+      /// \param[in] _contacts Contacts of the monitored collisions.
+      /// \param[in] _time Simulation time.
+      private: void OnContacts(const std::vector<physics::Contact *> &_contacts,
+                   const common::Time &_time);
+
+      /// \brief Build the contacts message from the last measurement, if
+      /// it is out of date. The mutex must be locked.
+      private: void UpdateContactsMsg() const;
 
       /// \internal
       /// \brief Private data pointer
@@ -17,11 +17,16 @@
 #ifndef _GAZEBO_SENSORS_CONTACTSENSOR_PRIVATE_HH_
 #define _GAZEBO_SENSORS_CONTACTSENSOR_PRIVATE_HH_
 
+#include <cstdint>
+#include <deque>
 #include <vector>
-#include <list>
 #include <string>
 #include <mutex>
 
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/JointWrench.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/msgs/msgs.hh"
 
@@ -29,6 +34,47 @@ namespace gazebo
 {
   namespace sensors
   {
+    /// \internal
+    /// \brief A contact point, copied from a physics::Contact.
+    class ContactSensorPoint
+    {
+      /// \brief Position of the contact point.
+      public: ignition::math::Vector3d position;
+
+      /// \brief Normal of the contact point.
+      public: ignition::math::Vector3d normal;
+
+      /// \brief Penetration depth.
+      public: double depth = 0;
+
+      /// \brief Forces and torques applied to the links of the collisions.
+      public: physics::JointWrench wrench;
+    };
+
+    /// \internal
+    /// \brief A contact between two collisions, copied from a
+    /// physics::Contact, which only holds the contact points in use.
+    class ContactSensorContact
+    {
+      /// \brief Scoped name of the first collision.
+      public: std::string collision1;
+
+      /// \brief Scoped name of the second collision.
+      public: std::string collision2;
+
+      /// \brief Id of the first collision.
+      public: uint32_t id1 = 0;
+
+      /// \brief Id of the second collision.
+      public: uint32_t id2 = 0;
+
+      /// \brief Time at which the contact occurred.
+      public: common::Time time;
+
+      /// \brief Contact points.
+      public: std::vector<ContactSensorPoint> points;
+    };
+
     /// \internal
     /// \brief Contact sensor private data.
     class ContactSensorPrivate
@@ -39,21 +85,37 @@ namespace gazebo
       /// \brief Output contact information.
       public: transport::PublisherPtr contactsPub;
 
-      /// \brief Subscription to contact messages from the physics engine
-      public: transport::SubscriberPtr contactSub;
-
       /// \brief Mutex to protect reads and writes.
       public: mutable std::mutex mutex;
 
-      /// \brief Contacts message used to output sensor data.
+      /// \brief Contacts message used to output sensor data. Only built
+      /// when it is published or requested, see msgDirty.
       public: msgs::Contacts contactsMsg;
 
-      /// \type ContactMsgs_L
-      /// List of contact messages
-      typedef std::list<boost::shared_ptr<msgs::Contacts const> > ContactMsgs_L;
+      /// \brief True if contactsMsg doesn't hold the last measurement yet.
+      public: bool msgDirty = false;
+
+      /// \brief Contacts received from the contact manager since the last
+      /// update. Only the first incomingCount elements are valid, the others
+      /// are kept to reuse their memory.
+      public: std::vector<ContactSensorContact> incomingContacts;
+
+      /// \brief Number of valid elements of incomingContacts.
+      public: size_t incomingCount = 0;
+
+      /// \brief Number of contacts received at each physics update since
+      /// the last sensor update.
+      public: std::deque<size_t> incomingSteps;
+
+      /// \brief Contacts of the last measurement. Only the first
+      /// contactCount elements are valid.
+      public: std::vector<ContactSensorContact> contacts;
+
+      /// \brief Number of valid elements of contacts.
+      public: size_t contactCount = 0;
 
-      /// \brief List of incoming messages.
-      public: ContactMsgs_L incomingContacts;
+      /// \brief Name of the world, set in the contact messages.
+      public: std::string worldName;
 
       /// \brief Name of filter used to filter contact messages.
       public: std::string filterName;
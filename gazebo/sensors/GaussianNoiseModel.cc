@@ -14,8 +14,8 @@
  * limitations under the License.
  *
 */
+#include <functional>
 #include <ignition/math/Helpers.hh>
-#include <ignition/math/Rand.hh>
 
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
@@ -31,9 +31,13 @@ namespace gazebo
     : public Ogre::CompositorInstance::Listener
   {
     /// \brief Constructor, setting mean and standard deviation.
+    /// \param[in] _mean Mean of the noise.
+    /// \param[in] _stddev Standard deviation of the noise.
+    /// \param[in] _uniform Function which samples the uniform distribution
+    /// on (0, 1), with the generator of the noise model.
     public: GaussianNoiseCompositorListener(const double &_mean,
-                                            const double &_stddev):
-        mean(_mean), stddev(_stddev) {}
+                const double &_stddev, std::function<double()> _uniform):
+        mean(_mean), stddev(_stddev), uniform(_uniform) {}
 
     /// \brief Callback that OGRE will invoke for us on each render call
     /// \param[in] _passID OGRE material pass ID.
@@ -48,9 +52,8 @@ namespace gazebo
       // Sample three values within the range [0,1.0] and set them for use in
       // the fragment shader, which will interpret them as offsets from (0,0)
       // to use when computing pseudo-random values.
-      Ogre::Vector3 offsets(ignition::math::Rand::DblUniform(0.0, 1.0),
-                            ignition::math::Rand::DblUniform(0.0, 1.0),
-                            ignition::math::Rand::DblUniform(0.0, 1.0));
+      Ogre::Vector3 offsets(this->uniform(), this->uniform(),
+                            this->uniform());
       // These calls are setting parameters that are declared in two places:
       // 1. media/materials/scripts/gazebo.material, in
       //    fragment_program Gazebo/GaussianCameraNoiseFS
@@ -73,6 +76,9 @@ namespace gazebo
     /// \brief Standard deviation that we'll pass down to the GLSL fragment
     /// shader.
     private: const double &stddev;
+
+    /// \brief Samples the uniform distribution on (0, 1).
+    private: std::function<double()> uniform;
   };
 }  // namespace gazebo
 
@@ -148,8 +154,52 @@ void GaussianNoiseModel::Fini()
 double GaussianNoiseModel::ApplyImpl(double _in, double _dt)
 {
   // Add independent (uncorrelated) Gaussian noise to each input value.
-  double whiteNoise = ignition::math::Rand::DblNormal(this->mean, this->stdDev);
+  double whiteNoise = this->SampleNormal(this->mean, this->stdDev);
+
+  this->UpdateDynamicBias(_dt);
+
+  double output = _in + this->bias + whiteNoise;
+  if (this->quantized)
+  {
+    // Apply this->precision
+    if (!ignition::math::equal(this->precision, 0.0, 1e-6))
+    {
+      output = std::round(output / this->precision) * this->precision;
+    }
+  }
+  return output;
+}
+
+//////////////////////////////////////////////////
+void GaussianNoiseModel::ApplyBatchImpl(const double *_in, double *_out,
+    const size_t _count, const double _dt)
+{
+  if (_count == 0)
+    return;
+
+  // Sample the white noise first, _out may be the same array as _in.
+  this->whiteNoise.resize(_count);
+  this->SampleNormal(this->mean, this->stdDev, this->whiteNoise.data(),
+      _count);
+
+  this->UpdateDynamicBias(_dt);
 
+  const double b = this->bias;
+  const double *noise = this->whiteNoise.data();
+  for (size_t i = 0; i < _count; ++i)
+    _out[i] = _in[i] + b + noise[i];
+
+  if (this->quantized && !ignition::math::equal(this->precision, 0.0, 1e-6))
+  {
+    const double p = this->precision;
+    for (size_t i = 0; i < _count; ++i)
+      _out[i] = std::round(_out[i] / p) * p;
+  }
+}
+
+//////////////////////////////////////////////////
+void GaussianNoiseModel::UpdateDynamicBias(const double _dt)
+{
   // Generate varying (correlated) bias for each input value.
   // This implementation is based on the one available in Rotors:
   // https://github.com/ethz-asl/rotors_simulator/blob/master/rotors_gazebo_plugins/src/gazebo_imu_plugin.cpp
@@ -168,20 +218,8 @@ double GaussianNoiseModel::ApplyImpl(double _in, double _dt)
         tau / 2 * expm1(-2 * _dt / tau));
 
     const double phiD = exp(-_dt / tau);
-    this->bias = phiD * this->bias +
-      ignition::math::Rand::DblNormal(0, sigmaBD);
-  }
-
-  double output = _in + this->bias + whiteNoise;
-  if (this->quantized)
-  {
-    // Apply this->precision
-    if (!ignition::math::equal(this->precision, 0.0, 1e-6))
-    {
-      output = std::round(output / this->precision) * this->precision;
-    }
+    this->bias = phiD * this->bias + this->SampleNormal(0, sigmaBD);
   }
-  return output;
 }
 
 //////////////////////////////////////////////////
@@ -221,12 +259,11 @@ void GaussianNoiseModel::SampleBias()
 {
   if(!ignition::math::equal(0.0, this->biasStdDev, 1e-6))
   {
-    this->bias =
-        ignition::math::Rand::DblNormal(this->biasMean, this->biasStdDev);
+    this->bias = this->SampleNormal(this->biasMean, this->biasStdDev);
     // With equal probability, we pick a negative bias (by convention,
     // rateBiasMean should be positive, though it would work fine if
     // negative).
-    if (ignition::math::Rand::DblUniform() < 0.5)
+    if (this->SampleUniform() < 0.5)
       this->bias = -this->bias;
   }
 }
@@ -266,7 +303,8 @@ void ImageGaussianNoiseModel::SetCamera(rendering::CameraPtr _camera)
   GZ_ASSERT(_camera, "Unable to apply gaussian noise, camera is null");
 
   this->gaussianNoiseCompositorListener.reset(new
-        GaussianNoiseCompositorListener(this->mean, this->stdDev));
+        GaussianNoiseCompositorListener(this->mean, this->stdDev,
+          [this]() { return this->SampleUniform(); }));
 
   this->gaussianNoiseInstance =
     Ogre::CompositorManager::getSingleton().addCompositor(
@@ -57,6 +57,17 @@ namespace gazebo
         // Documentation inherited.
         public: double ApplyImpl(double _in, double _dt);
 
+        /// \brief Apply noise to a batch of input data values. The
+        /// dynamic bias is updated once for the batch, and the same bias is
+        /// added to every value.
+        /// \param[in] _in Input data values.
+        /// \param[out] _out Data with noise applied. It can be the same
+        /// array as _in.
+        /// \param[in] _count Number of values.
+        /// \param[in] _dt Time elapsed since the previous batch.
+        public: virtual void ApplyBatchImpl(const double *_in, double *_out,
+                    const size_t _count, const double _dt);
+
         /// \brief Accessor for mean.
         /// \return Mean of Gaussian noise.
         public: double GetMean() const;
@@ -99,6 +110,10 @@ namespace gazebo
         /// \brief Sample the bias.
         private: void SampleBias();
 
+        /// \brief Update the dynamic bias, if enabled.
+        /// \param[in] _dt Time elapsed since the last update.
+        private: void UpdateDynamicBias(const double _dt);
+
         /// \brief If type starts with GAUSSIAN, the mean of the distribution
         /// from which we sample when adding noise.
         protected: double mean;
@@ -132,6 +147,10 @@ namespace gazebo
         /// \biref If type starts with GAUSSIAN, the correlation time of the
         /// process from which the dynamic bias will be driven.
         private: double dynamicBiasCorrTime;
+
+        /// \brief White noise samples of the last batch, reused between
+        /// batches.
+        private: std::vector<double> whiteNoise;
     };
 
     /// \class GaussianNoiseModel
@@ -750,6 +750,14 @@ bool GpuRaySensor::UpdateImpl(const bool /*_force*/)
     }
   }
 
+  // Noise is applied to the whole scan at once, after the ranges are read.
+  NoisePtr noise;
+  auto noiseIter = this->noises.find(GPU_RAY_NOISE);
+  if (noiseIter != this->noises.end())
+    noise = noiseIter->second;
+  this->dataPtr->noiseRanges.clear();
+  this->dataPtr->noiseIndices.clear();
+
   auto dataIter = this->dataPtr->laserCam->LaserDataBegin();
   auto dataEnd = this->dataPtr->laserCam->LaserDataEnd();
   for (int i = 0; dataIter != dataEnd; ++dataIter, ++i)
@@ -767,11 +775,10 @@ bool GpuRaySensor::UpdateImpl(const bool /*_force*/)
     {
       range = -ignition::math::INF_D;
     }
-    else if (this->noises.find(GPU_RAY_NOISE) != this->noises.end())
+    else if (noise && !ignition::math::isnan(range))
     {
-      range = this->noises[GPU_RAY_NOISE]->Apply(range);
-      range = ignition::math::clamp(range,
-          this->dataPtr->rangeMin, this->dataPtr->rangeMax);
+      this->dataPtr->noiseIndices.push_back(i);
+      this->dataPtr->noiseRanges.push_back(range);
     }
 
     range = ignition::math::isnan(range) ? this->dataPtr->rangeMax : range;
@@ -779,6 +786,18 @@ bool GpuRaySensor::UpdateImpl(const bool /*_force*/)
     scan->set_intensities(i, intensity);
   }
 
+  if (!this->dataPtr->noiseRanges.empty())
+  {
+    std::vector<double> &ranges = this->dataPtr->noiseRanges;
+    noise->Apply(ranges.data(), ranges.data(), ranges.size());
+    for (size_t k = 0; k < ranges.size(); ++k)
+    {
+      scan->set_ranges(this->dataPtr->noiseIndices[k],
+          ignition::math::clamp(ranges[k],
+            this->dataPtr->rangeMin, this->dataPtr->rangeMax));
+    }
+  }
+
   if (this->dataPtr->scanPub && this->dataPtr->scanPub->HasConnections())
     this->dataPtr->scanPub->Publish(this->dataPtr->laserMsg);
 
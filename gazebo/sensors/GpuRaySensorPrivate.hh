@@ -19,6 +19,7 @@
 
 #include <limits>
 #include <mutex>
+#include <vector>
 #include <sdf/sdf.hh>
 
 #include "gazebo/rendering/RenderTypes.hh"
@@ -94,6 +95,13 @@ namespace gazebo
       /// \brief Timestamp of the forthcoming rendering
       public: double nextRenderingTime
                            = std::numeric_limits<double>::quiet_NaN();
+
+      /// \brief Ranges of the last scan to which noise is applied, reused
+      /// between scans.
+      public: std::vector<double> noiseRanges;
+
+      /// \brief Index in the scan of each of the noiseRanges.
+      public: std::vector<int> noiseIndices;
     };
   }
 }
@@ -20,6 +20,7 @@
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/Model.hh"
+#include "gazebo/physics/ModelSpatialIndex.hh"
 
 #include "gazebo/sensors/SensorFactory.hh"
 #include "gazebo/sensors/LogicalCameraSensorPrivate.hh"
@@ -58,6 +59,11 @@ void LogicalCameraSensor::Load(const std::string &_worldName,
   // Store parent model's name for use in the UpdateImpl function.
   this->dataPtr->modelName =
     this->dataPtr->parentLink->GetModel()->GetScopedName();
+
+  // Keep the spatial index of the world up to date
+  this->dataPtr->spatialIndex = this->world->SpatialIndex();
+  if (this->dataPtr->spatialIndex)
+    this->dataPtr->spatialIndex->AddUser();
 }
 
 //////////////////////////////////////////////////
@@ -107,6 +113,10 @@ void LogicalCameraSensor::Init()
 //////////////////////////////////////////////////
 void LogicalCameraSensor::Fini()
 {
+  if (this->dataPtr->spatialIndex)
+    this->dataPtr->spatialIndex->RemoveUser();
+  this->dataPtr->spatialIndex.reset();
+
   Sensor::Fini();
 }
 
@@ -158,8 +168,29 @@ bool LogicalCameraSensor::UpdateImpl(const bool _force)
     // Set the camera's pose in the message.
     msgs::Set(this->dataPtr->msg.mutable_pose(), myPose);
 
-    // Recursively check if models and nested models are in the frustum.
-    this->dataPtr->AddVisibleModels(myPose, this->world->Models());
+    // Find the models and nested models in the frustum with the spatial
+    // index, or recursively check every model if it isn't available.
+    if (this->dataPtr->spatialIndex &&
+        this->dataPtr->spatialIndex->ModelsInFrustum(
+          this->dataPtr->frustum, this->dataPtr->visibleModels))
+    {
+      for (auto const &model : this->dataPtr->visibleModels)
+      {
+        auto const &scopedName = model->GetScopedName();
+        if (this->dataPtr->modelName == scopedName)
+          continue;
+
+        msgs::LogicalCameraImage::Model *modelMsg =
+          this->dataPtr->msg.add_model();
+        modelMsg->set_name(scopedName);
+        msgs::Set(modelMsg->mutable_pose(), model->WorldPose() - myPose);
+      }
+      this->dataPtr->visibleModels.clear();
+    }
+    else
+    {
+      this->dataPtr->AddVisibleModels(myPose, this->world->Models());
+    }
     IGN_PROFILE_END();
 
     IGN_PROFILE_BEGIN("Publish");
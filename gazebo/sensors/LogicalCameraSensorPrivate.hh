@@ -23,6 +23,7 @@
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/Link.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
 
 namespace gazebo
 {
@@ -55,6 +56,13 @@ namespace gazebo
 
       /// \brief Name of the parent model.
       public: std::string modelName;
+
+      /// \brief Spatial index of the world, used to find the models in the
+      /// frustum.
+      public: physics::ModelSpatialIndexPtr spatialIndex;
+
+      /// \brief Models found in the frustum, kept to avoid allocations.
+      public: physics::Model_V visibleModels;
     };
   }
 }
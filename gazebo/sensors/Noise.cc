@@ -15,7 +15,13 @@
  *
 */
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <boost/function.hpp>
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Rand.hh>
+
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 
@@ -25,6 +31,33 @@
 using namespace gazebo;
 using namespace sensors;
 
+/// \brief Number of noise models created, used to derive their default
+/// seeds.
+static std::atomic<uint64_t> g_noiseCount(0);
+
+//////////////////////////////////////////////////
+/// \brief Hash a counter with a key. This is the SplitMix64 generator,
+/// evaluated at an arbitrary index of its sequence.
+/// \param[in] _key Key, the seed of the generator.
+/// \param[in] _counter Index of the value.
+/// \return Uniformly distributed 64 bit value.
+static inline uint64_t NoiseHash(const uint64_t _key, const uint64_t _counter)
+{
+  uint64_t z = _key + (_counter + 1) * 0x9E3779B97F4A7C15ull;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+//////////////////////////////////////////////////
+/// \brief Convert a random 64 bit value to a double in (0, 1).
+/// \param[in] _bits Random value.
+/// \return Double in (0, 1), never 0 so that its log is finite.
+static inline double NoiseUnit(const uint64_t _bits)
+{
+  return ((_bits >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
 //////////////////////////////////////////////////
 NoisePtr NoiseFactory::NewNoiseModel(sdf::ElementPtr _sdf,
     const std::string &_sensorType)
@@ -73,7 +106,8 @@ NoisePtr NoiseFactory::NewNoiseModel(sdf::ElementPtr _sdf,
 
 //////////////////////////////////////////////////
 Noise::Noise(NoiseType _type)
-  : type(_type)
+  : type(_type),
+    seed(NoiseHash(ignition::math::Rand::Seed(), g_noiseCount++))
 {
 }
 
@@ -124,6 +158,98 @@ double Noise::ApplyImpl(double _in, double /*_dt*/)
   return _in;
 }
 
+//////////////////////////////////////////////////
+void Noise::Apply(const double *_in, double *_out, const size_t _count,
+    const double _dt)
+{
+  if (_count == 0)
+    return;
+
+  if (this->type == NONE)
+  {
+    if (_out != _in)
+      std::copy(_in, _in + _count, _out);
+  }
+  else if (this->type == CUSTOM)
+  {
+    for (size_t i = 0; i < _count; ++i)
+      _out[i] = this->Apply(_in[i], _dt);
+  }
+  else
+    this->ApplyBatchImpl(_in, _out, _count, _dt);
+}
+
+//////////////////////////////////////////////////
+void Noise::ApplyBatchImpl(const double *_in, double *_out,
+    const size_t _count, const double _dt)
+{
+  for (size_t i = 0; i < _count; ++i)
+    _out[i] = this->ApplyImpl(_in[i], _dt);
+}
+
+//////////////////////////////////////////////////
+void Noise::SetSeed(const uint64_t _seed)
+{
+  this->seed = _seed;
+  this->counter = 0;
+}
+
+//////////////////////////////////////////////////
+uint64_t Noise::Seed() const
+{
+  return this->seed;
+}
+
+//////////////////////////////////////////////////
+double Noise::SampleUniform()
+{
+  return NoiseUnit(NoiseHash(this->seed, this->counter++));
+}
+
+//////////////////////////////////////////////////
+double Noise::SampleNormal(const double _mean, const double _stdDev)
+{
+  double sample;
+  this->SampleNormal(_mean, _stdDev, &sample, 1);
+  return sample;
+}
+
+//////////////////////////////////////////////////
+void Noise::SampleNormal(const double _mean, const double _stdDev,
+    double *_out, const size_t _count)
+{
+  // Box-Muller transform. Each pair of uniform values gives two normal
+  // values, the first written to the first half of _out and the second to
+  // the second half, so that the loop has no dependency between
+  // iterations and contiguous stores, which compilers vectorize.
+  const size_t half = (_count + 1) / 2;
+  const size_t second = _count / 2;
+  const uint64_t key = this->seed;
+  const uint64_t base = this->counter;
+  const double twoPi = 2.0 * IGN_PI;
+
+  for (size_t i = 0; i < second; ++i)
+  {
+    const double u1 = NoiseUnit(NoiseHash(key, base + 2 * i));
+    const double u2 = NoiseUnit(NoiseHash(key, base + 2 * i + 1));
+    const double r = _stdDev * std::sqrt(-2.0 * std::log(u1));
+    const double theta = twoPi * u2;
+    _out[i] = _mean + r * std::cos(theta);
+    _out[half + i] = _mean + r * std::sin(theta);
+  }
+
+  // The last value of an odd count
+  if (half != second)
+  {
+    const double u1 = NoiseUnit(NoiseHash(key, base + 2 * second));
+    const double u2 = NoiseUnit(NoiseHash(key, base + 2 * second + 1));
+    _out[second] = _mean +
+        _stdDev * std::sqrt(-2.0 * std::log(u1)) * std::cos(twoPi * u2);
+  }
+
+  this->counter += 2 * half;
+}
+
 //////////////////////////////////////////////////
 Noise::NoiseType Noise::GetNoiseType() const
 {
@@ -18,6 +18,8 @@
 #ifndef _GAZEBO_NOISE_HH_
 #define _GAZEBO_NOISE_HH_
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -88,6 +90,43 @@ namespace gazebo
       /// \return Data with noise applied.
       public: virtual double ApplyImpl(double _in, double _dt = 0.0);
 
+      /// \brief Apply noise to a batch of input data values, such as the
+      /// ranges of a laser scan, which are measured at the same time.
+      /// This is faster than calling Apply for each value.
+      /// \param[in] _in Input data values.
+      /// \param[out] _out Data with noise applied. It can be the same
+      /// array as _in.
+      /// \param[in] _count Number of values.
+      /// \param[in] _dt Time elapsed since the previous batch.
+      public: void Apply(const double *_in, double *_out,
+                  const size_t _count, const double _dt = 0.0);
+
+      /// \brief Apply noise to a batch of input data values. This gets
+      /// overriden by derived classes, and called by the batch version of
+      /// Apply. The default implementation calls ApplyImpl for each
+      /// value.
+      /// \param[in] _in Input data values.
+      /// \param[out] _out Data with noise applied. It can be the same
+      /// array as _in.
+      /// \param[in] _count Number of values.
+      /// \param[in] _dt Time elapsed since the previous batch.
+      public: virtual void ApplyBatchImpl(const double *_in, double *_out,
+                  const size_t _count, const double _dt);
+
+      /// \brief Set the seed of the random number generator of this noise
+      /// model, and restart its sequence. Each noise model has its own
+      /// generator, so that sensors updated by different threads don't
+      /// share one. The default seed is derived from the global seed of
+      /// ignition::math::Rand, set with --seed, and from the number of
+      /// noise models created before this one.
+      /// \param[in] _seed Seed.
+      /// \sa Sensor::Init
+      public: void SetSeed(const uint64_t _seed);
+
+      /// \brief Get the seed of the random number generator.
+      /// \return Seed.
+      public: uint64_t Seed() const;
+
       /// \brief Finalize the noise model
       public: virtual void Fini();
 
@@ -123,6 +162,28 @@ namespace gazebo
       /// \param[in] _out Output stream
       public: virtual void Print(std::ostream &_out) const;
 
+      /// \brief Draw a sample from the uniform distribution on (0, 1),
+      /// using the generator of this noise model.
+      /// \return Sample.
+      protected: double SampleUniform();
+
+      /// \brief Draw a sample from a normal distribution, using the
+      /// generator of this noise model.
+      /// \param[in] _mean Mean of the distribution.
+      /// \param[in] _stdDev Standard deviation of the distribution.
+      /// \return Sample.
+      protected: double SampleNormal(const double _mean,
+                     const double _stdDev);
+
+      /// \brief Draw samples from a normal distribution, using the
+      /// generator of this noise model.
+      /// \param[in] _mean Mean of the distribution.
+      /// \param[in] _stdDev Standard deviation of the distribution.
+      /// \param[out] _out Samples.
+      /// \param[in] _count Number of samples.
+      protected: void SampleNormal(const double _mean, const double _stdDev,
+                     double *_out, const size_t _count);
+
       /// \brief Which type of noise we're applying
       private: NoiseType type;
 
@@ -134,6 +195,14 @@ namespace gazebo
 
       /// \brief Callback function for applying custom noise to sensor data.
       private: std::function<double (double, double)> customNoiseCallbackTime;
+
+      /// \brief Seed of the random number generator.
+      private: uint64_t seed;
+
+      /// \brief Number of random values drawn since the generator was
+      /// seeded. The generator is counter based, each value is a hash of
+      /// the seed and of its index.
+      private: uint64_t counter = 0;
     };
     /// \}
   }
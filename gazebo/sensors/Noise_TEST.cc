@@ -16,6 +16,7 @@
 */
 
 #include <gtest/gtest.h>
+#include <vector>
 
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics/stats.hpp>
@@ -374,6 +375,104 @@ TEST_F(NoiseTest, OnApplyNoise)
   }
 }
 
+//////////////////////////////////////////////////
+// Test batch noise application
+TEST_F(NoiseTest, ApplyBatch)
+{
+  const size_t count = 10001;
+  std::vector<double> in(count, 42.0);
+  std::vector<double> out(count);
+
+  // NONE copies the input
+  {
+    sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+        NoiseSdf("none", 0, 0, 0, 0, 0));
+    noise->Apply(in.data(), out.data(), count);
+    EXPECT_EQ(in, out);
+  }
+
+  // CUSTOM calls the callback for each value
+  {
+    sensors::NoisePtr noise(new sensors::Noise(sensors::Noise::CUSTOM));
+    using namespace boost::placeholders;
+    noise->SetCustomNoiseCallback(boost::bind(&OnApplyCustomNoise, _1));
+    noise->Apply(in.data(), out.data(), count);
+    for (size_t i = 0; i < count; ++i)
+      EXPECT_DOUBLE_EQ(out[i], 84.0);
+  }
+
+  // GAUSSIAN, the statistics must match those of the scalar version
+  const double mean = 10.0;
+  const double stddev = 5.0;
+  sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian", mean, stddev, 0, 0, 0));
+  noise->Apply(in.data(), out.data(), count);
+
+  boost::accumulators::accumulator_set<double,
+    boost::accumulators::stats<boost::accumulators::tag::mean,
+                               boost::accumulators::tag::variance > > acc;
+  for (auto const &y : out)
+    acc(y);
+
+  // See comments in GaussianNoise function to explain these calculations.
+  EXPECT_NEAR(boost::accumulators::mean(acc), 42.0 + mean,
+      g_sigma * stddev / sqrt(count));
+  double variance = stddev*stddev;
+  EXPECT_NEAR(boost::accumulators::variance(acc), variance,
+      g_sigma * sqrt(2 * variance * variance / (count - 1)));
+
+  // The output may be the input
+  std::vector<double> inPlace(in);
+  noise->Apply(inPlace.data(), inPlace.data(), count);
+  for (size_t i = 0; i < count; ++i)
+    EXPECT_NE(inPlace[i], 42.0);
+}
+
+//////////////////////////////////////////////////
+// Test that the noise is reproducible for a given seed
+TEST_F(NoiseTest, Seed)
+{
+  sensors::NoisePtr noise1 = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian", 0, 1, 0, 0, 0));
+  sensors::NoisePtr noise2 = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian", 0, 1, 0, 0, 0));
+
+  // Each noise model has its own sequence by default
+  EXPECT_NE(noise1->Seed(), noise2->Seed());
+
+  noise1->SetSeed(1234u);
+  noise2->SetSeed(1234u);
+  EXPECT_EQ(noise1->Seed(), 1234u);
+
+  const size_t count = 7;
+  std::vector<double> in(count, 0.0);
+  std::vector<double> out1(count);
+  std::vector<double> out2(count);
+  noise1->Apply(in.data(), out1.data(), count);
+  noise2->Apply(in.data(), out2.data(), count);
+  EXPECT_EQ(out1, out2);
+
+  // The sequence continues from one call to the next
+  noise1->Apply(in.data(), out2.data(), count);
+  EXPECT_NE(out1, out2);
+
+  // Restart the sequence
+  noise1->SetSeed(1234u);
+  noise1->Apply(in.data(), out2.data(), count);
+  EXPECT_EQ(out1, out2);
+
+  // Another seed gives another sequence
+  noise2->SetSeed(4321u);
+  noise2->Apply(in.data(), out2.data(), count);
+  EXPECT_NE(out1, out2);
+
+  // Scalar calls are reproducible as well
+  noise1->SetSeed(1234u);
+  noise2->SetSeed(1234u);
+  for (unsigned int i = 0; i < g_applyCount; ++i)
+    EXPECT_DOUBLE_EQ(noise1->Apply(0.0), noise2->Apply(0.0));
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
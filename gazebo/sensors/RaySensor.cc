@@ -417,6 +417,15 @@ bool RaySensor::UpdateImpl(const bool /*_force*/)
   bool interp =
     ((rayCount != rangeCount) || (verticalRayCount != verticalRangeCount));
 
+  // Noise is applied to the whole scan at once, after the ranges are read.
+  // currently supports only one noise model per laser sensor
+  NoisePtr noise;
+  auto noiseIter = this->noises.find(RAY_NOISE);
+  if (noiseIter != this->noises.end())
+    noise = noiseIter->second;
+  this->dataPtr->noiseRanges.clear();
+  this->dataPtr->noiseIndices.clear();
+
   // interpolate in vertical direction
   for (unsigned int j = 0; j < verticalRangeCount; ++j)
   {
@@ -487,19 +496,28 @@ bool RaySensor::UpdateImpl(const bool /*_force*/)
       {
         range = -ignition::math::INF_D;
       }
-      else if (this->noises.find(RAY_NOISE) !=
-               this->noises.end())
+      else if (noise)
       {
-        // currently supports only one noise model per laser sensor
-        range = this->noises[RAY_NOISE]->Apply(range);
-        range = ignition::math::clamp(range,
-            this->RangeMin(), this->RangeMax());
+        this->dataPtr->noiseIndices.push_back(scan->ranges_size());
+        this->dataPtr->noiseRanges.push_back(range);
       }
 
       scan->add_ranges(range);
       scan->add_intensities(intensity);
     }
   }
+
+  if (!this->dataPtr->noiseRanges.empty())
+  {
+    std::vector<double> &ranges = this->dataPtr->noiseRanges;
+    noise->Apply(ranges.data(), ranges.data(), ranges.size());
+    for (size_t k = 0; k < ranges.size(); ++k)
+    {
+      scan->set_ranges(this->dataPtr->noiseIndices[k],
+          ignition::math::clamp(ranges[k],
+            this->RangeMin(), this->RangeMax()));
+    }
+  }
   IGN_PROFILE_END();
 
   IGN_PROFILE_BEGIN("Publish");
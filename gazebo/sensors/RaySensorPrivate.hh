@@ -18,6 +18,7 @@
 #define _GAZEBO_SENSORS_RAYSENSOR_PRIVATE_HH_
 
 #include <mutex>
+#include <vector>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
@@ -48,6 +49,13 @@ namespace gazebo
 
       /// \brief Laser message.
       public: msgs::LaserScanStamped laserMsg;
+
+      /// \brief Ranges of the last scan to which noise is applied, reused
+      /// between scans.
+      public: std::vector<double> noiseRanges;
+
+      /// \brief Index in the scan of each of the noiseRanges.
+      public: std::vector<int> noiseIndices;
     };
   }
 }
@@ -14,6 +14,7 @@
  * limitations under the License.
  *
 */
+#include <ignition/math/Rand.hh>
 #include "ignition/common/Profiler.hh"
 
 #include "gazebo/transport/transport.hh"
@@ -47,6 +48,10 @@ using namespace sensors;
 
 sdf::ElementPtr SensorPrivate::sdfSensor;
 
+/// \brief Weight of the last update in the moving average of the update
+/// durations.
+static const double kUpdateDurationWeight = 0.1;
+
 bool Sensor::useStrictRate = false;
 
 //////////////////////////////////////////////////
@@ -162,6 +167,24 @@ void Sensor::Init()
 {
   this->SetUpdateRate(this->sdf->Get<double>("update_rate"));
 
+  // Seed the noise models. FNV-1a is used to hash the name rather than
+  // std::hash, which differs between standard libraries.
+  uint64_t nameHash = 14695981039346656037ull;
+  for (const char c : this->ScopedName())
+  {
+    nameHash ^= static_cast<unsigned char>(c);
+    nameHash *= 1099511628211ull;
+  }
+  for (auto &noise : this->noises)
+  {
+    if (noise.second)
+    {
+      noise.second->SetSeed(nameHash ^
+          (static_cast<uint64_t>(ignition::math::Rand::Seed()) << 16) ^
+          static_cast<uint64_t>(noise.first));
+    }
+  }
+
   // Load the plugins
   if (this->sdf->HasElement("plugin"))
   {
@@ -238,7 +261,7 @@ void Sensor::Update(const bool _force)
   {
     if (this->useStrictRate)
     {
-      if (this->UpdateImpl(_force))
+      if (this->TimedUpdateImpl(_force))
         this->updated();
     }
     else
@@ -276,7 +299,7 @@ void Sensor::Update(const bool _force)
           this->dataPtr->updateDelay = common::Time::Zero;
       }
 
-      if (this->UpdateImpl(_force))
+      if (this->TimedUpdateImpl(_force))
       {
         std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
         this->lastUpdateTime = simTime;
@@ -286,6 +309,45 @@ void Sensor::Update(const bool _force)
   }
 }
 
+//////////////////////////////////////////////////
+bool Sensor::TimedUpdateImpl(const bool _force)
+{
+  common::Timer timer;
+  timer.Start();
+  const bool result = this->UpdateImpl(_force);
+  const common::Time elapsed = timer.GetElapsed();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
+  this->dataPtr->lastUpdateDuration = elapsed;
+  if (this->dataPtr->avgUpdateDuration == common::Time::Zero)
+  {
+    this->dataPtr->avgUpdateDuration = elapsed;
+  }
+  else
+  {
+    this->dataPtr->avgUpdateDuration = common::Time(
+        this->dataPtr->avgUpdateDuration.Double() +
+        kUpdateDurationWeight * (elapsed.Double() -
+          this->dataPtr->avgUpdateDuration.Double()));
+  }
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+common::Time Sensor::LastUpdateDuration() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
+  return this->dataPtr->lastUpdateDuration;
+}
+
+//////////////////////////////////////////////////
+common::Time Sensor::AvgUpdateDuration() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
+  return this->dataPtr->avgUpdateDuration;
+}
+
 //////////////////////////////////////////////////
 void Sensor::Fini()
 {
@@ -68,7 +68,10 @@ namespace gazebo
       /// \param[in] _worldName Name of world to load from.
       public: virtual void Load(const std::string &_worldName);
 
-      /// \brief Initialize the sensor.
+      /// \brief Initialize the sensor. This also seeds the noise models
+      /// of the sensor from its scoped name and from the global seed, so
+      /// that the noise of a sensor is reproducible with --seed, whatever
+      /// the order in which the sensors are updated.
       public: virtual void Init();
 
       /// \brief Set the sensor's parent.
@@ -134,6 +137,16 @@ namespace gazebo
       /// \return Time of last measurement.
       public: common::Time LastMeasurementTime() const;
 
+      /// \brief Get the wall clock time spent by the last update of the
+      /// sensor data, which is a call to UpdateImpl.
+      /// \return Duration of the last update.
+      public: common::Time LastUpdateDuration() const;
+
+      /// \brief Get a moving average of the wall clock time spent by an
+      /// update of the sensor data. Recent updates weigh the most.
+      /// \return Average duration of an update.
+      public: common::Time AvgUpdateDuration() const;
+
       /// \brief Return true if user requests the sensor to be visualized
       ///        via tag:  <visualize>true</visualize> in SDF.
       /// \return True if visualized, false if not.
@@ -201,6 +214,11 @@ namespace gazebo
       /// \return True when sensor should be updated.
       protected: virtual bool NeedsUpdate();
 
+      /// \brief Call UpdateImpl and record how long it took.
+      /// \param[in] _force True if update is forced, false if not
+      /// \return The result of UpdateImpl.
+      private: bool TimedUpdateImpl(const bool _force);
+
       /// \brief Load a plugin for this sensor.
       /// \param[in] _sdf SDF parameters.
       private: void LoadPlugin(sdf::ElementPtr _sdf);
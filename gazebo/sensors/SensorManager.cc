@@ -15,8 +15,19 @@
  *
 */
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
 #include <functional>
+#include <mutex>
+#include <string>
 #include <boost/bind/bind.hpp>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_scheduler_observer.h>
 
 #include "gazebo/physics/Link.hh"
 #include "gazebo/physics/Model.hh"
@@ -68,6 +79,13 @@ struct sensorPerformanceMetricsType
   /// window size, whereas the sensorSimUpdateRate stores the instantaneous
   /// update rate and it is filled by all sensors.
   double sensorAvgFPS;
+
+  /// \brief Wall clock time spent by the last update of the sensor.
+  double sensorLastUpdateDuration = 0;
+
+  /// \brief Moving average of the wall clock time spent by an update of
+  /// the sensor.
+  double sensorAvgUpdateDuration = 0;
 };
 
 /// \brief A map of sensor name to its performance metrics data
@@ -86,18 +104,250 @@ common::Time lastSimTime;
 /// \brief Last real time measured for performance metrics
 common::Time lastRealTime;
 
+namespace gazebo
+{
+  namespace sensors
+  {
+    /// \internal
+    /// \brief Prepares the threads of a SensorUpdatePool for the physics
+    /// engine, as SensorContainer::RunLoop does for its own thread.
+    class SensorThreadObserver : public tbb::task_scheduler_observer
+    {
+      /// \brief Constructor.
+      /// \param[in] _arena Arena to observe.
+      public: explicit SensorThreadObserver(tbb::task_arena &_arena)
+        : tbb::task_scheduler_observer(_arena)
+      {
+        physics::WorldPtr world = physics::get_world();
+        if (world)
+          this->engine = world->Physics();
+        this->observe(true);
+      }
+
+      /// \brief Destructor.
+      public: virtual ~SensorThreadObserver()
+      {
+        this->observe(false);
+      }
+
+      /// \brief Called by each thread that joins the arena.
+      public: virtual void on_scheduler_entry(bool /*_isWorker*/) override
+      {
+        physics::PhysicsEnginePtr physicsEngine = this->engine.lock();
+        if (physicsEngine)
+          physicsEngine->InitForThread();
+      }
+
+      /// \brief The physics engine.
+      private: boost::weak_ptr<physics::PhysicsEngine> engine;
+    };
+
+    /// \brief Container whose sensors are being updated by the current
+    /// thread of a SensorUpdatePool, null on any other thread.
+    static thread_local const void *updatingContainer = nullptr;
+
+    /// \internal
+    /// \brief Thread pool used to update the sensors of a container.
+    class SensorUpdatePool
+    {
+      /// \brief Constructor.
+      /// \param[in] _threads Number of threads.
+      public: explicit SensorUpdatePool(const unsigned int _threads)
+        : threads(_threads), arena(_threads), observer(arena)
+      {
+      }
+
+      /// \brief Number of threads.
+      public: const unsigned int threads;
+
+      /// \brief Arena that bounds the number of threads.
+      public: tbb::task_arena arena;
+
+      /// \brief Prepares the threads for the physics engine.
+      public: SensorThreadObserver observer;
+    };
+
+    /// \internal
+    /// \brief Next rendering time of a sensor, stored in the heap of a
+    /// SensorLockstepBarrier.
+    class SensorLockstepEntry
+    {
+      /// \brief Compare the rendering times, used to order the heap.
+      /// \param[in] _other Entry to compare to.
+      /// \return True if this entry is due after _other.
+      public: bool operator>(const SensorLockstepEntry &_other) const
+      {
+        return this->time > _other.time;
+      }
+
+      /// \brief Simulation time at which the sensor renders next.
+      public: double time;
+
+      /// \brief The sensor.
+      public: SensorPtr sensor;
+    };
+
+    /// \internal
+    /// \brief Blocks the world in lockstep mode until the image sensors
+    /// have caught up with it.
+    ///
+    /// The next rendering time of the image sensors only changes while
+    /// they are updated by the rendering thread, which then publishes the
+    /// times to a min-heap with Update and wakes up the world. The world
+    /// only compares its clock to the top of the heap, instead of polling
+    /// every sensor.
+    class SensorLockstepBarrier
+    {
+      /// \brief Replace the rendering times with the ones of the given
+      /// sensors, and wake up the world.
+      /// \param[in] _sensors The image sensors.
+      public: void Update(const Sensor_V &_sensors)
+      {
+        std::vector<SensorLockstepEntry> entries;
+        for (auto const &sensor : _sensors)
+        {
+          if (!sensor->IsActive())
+            continue;
+
+          const double time = sensor->NextRequiredTimestamp();
+          if (!std::isnan(time))
+            entries.push_back({time, sensor});
+        }
+        std::make_heap(entries.begin(), entries.end(),
+            std::greater<SensorLockstepEntry>());
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->heap.swap(entries);
+        this->condition.notify_all();
+      }
+
+      /// \brief Release the world and the sensors, when the sensors stop.
+      public: void Clear()
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->heap.clear();
+        this->condition.notify_all();
+      }
+
+      /// \brief Block until no sensor needs the current world tick.
+      /// \param[in] _clk Simulated clock of the world.
+      /// \param[in] _dt World time step.
+      public: void Wait(const double _clk, const double _dt)
+      {
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        SensorPtr blocker;
+        auto start = std::chrono::steady_clock::now();
+
+        while (physics::worlds_running())
+        {
+          // Sensors deactivated since the last update don't hold the world
+          while (!this->heap.empty() && !this->heap.front().sensor->IsActive())
+          {
+            std::pop_heap(this->heap.begin(), this->heap.end(),
+                std::greater<SensorLockstepEntry>());
+            this->heap.pop_back();
+          }
+
+          if (this->heap.empty() || !ignition::math::lessOrNearEqual(
+                this->heap.front().time - _dt / 2.0, _clk))
+          {
+            break;
+          }
+
+          if (blocker != this->heap.front().sensor)
+          {
+            const auto now = std::chrono::steady_clock::now();
+            this->Record(blocker, now - start);
+            blocker = this->heap.front().sensor;
+            start = now;
+          }
+
+          // The timeout only lets the world notice that it was stopped
+          this->condition.wait_for(lock, std::chrono::milliseconds(100));
+        }
+
+        this->Record(blocker, std::chrono::steady_clock::now() - start);
+      }
+
+      /// \brief Get the time spent waiting for each sensor.
+      /// \return Statistics indexed by scoped sensor name.
+      public: std::map<std::string, SensorWaitStatistics> Statistics() const
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->statistics;
+      }
+
+      /// \brief Clear the statistics.
+      public: void ResetStatistics()
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->statistics.clear();
+      }
+
+      /// \brief Add a wait to the statistics of a sensor. The mutex must
+      /// be locked.
+      /// \param[in] _sensor The sensor, nothing is recorded if null.
+      /// \param[in] _elapsed Duration of the wait.
+      private: void Record(const SensorPtr &_sensor,
+                   const std::chrono::steady_clock::duration &_elapsed)
+      {
+        if (!_sensor)
+          return;
+
+        const common::Time elapsed(
+            std::chrono::duration<double>(_elapsed).count());
+        SensorWaitStatistics &stats =
+            this->statistics[_sensor->ScopedName()];
+        ++stats.count;
+        stats.total += elapsed;
+        stats.max = std::max(stats.max, elapsed);
+      }
+
+      /// \brief Protects the heap and the statistics.
+      private: mutable std::mutex mutex;
+
+      /// \brief Notified when the heap changes.
+      private: std::condition_variable condition;
+
+      /// \brief Next rendering time of the active image sensors, the
+      /// earliest one first.
+      private: std::vector<SensorLockstepEntry> heap;
+
+      /// \brief Time spent waiting, indexed by scoped sensor name.
+      private: std::map<std::string, SensorWaitStatistics> statistics;
+    };
+  }
+}
+
 //////////////////////////////////////////////////
 SensorManager::SensorManager()
-  : initialized(false), removeAllSensors(false)
+  : initialized(false), removeAllSensors(false),
+    lockstepBarrier(new SensorLockstepBarrier)
 {
   // sensors::IMAGE container
-  this->sensorContainers.push_back(new ImageSensorContainer());
+  this->sensorContainers.push_back(
+      new ImageSensorContainer(this->lockstepBarrier.get()));
 
   // sensors::RAY container
   this->sensorContainers.push_back(new SensorContainer());
 
   // sensors::OTHER container
   this->sensorContainers.push_back(new SensorContainer());
+
+  const char *threadsEnv = std::getenv("GAZEBO_SENSOR_UPDATE_THREADS");
+  if (threadsEnv)
+  {
+    try
+    {
+      this->SetUpdateThreads(std::stoul(threadsEnv));
+    }
+    catch(...)
+    {
+      gzerr << "Invalid GAZEBO_SENSOR_UPDATE_THREADS [" << threadsEnv
+            << "], sensors will be updated serially.\n";
+    }
+  }
 }
 
 //////////////////////////////////////////////////
@@ -144,6 +394,9 @@ void SensorManager::Stop()
     (*iter)->Stop();
   }
 
+  // Don't leave a world waiting for sensors that won't render anymore
+  this->lockstepBarrier->Clear();
+
   if (!physics::worlds_running())
     this->worlds.clear();
 }
@@ -162,15 +415,27 @@ bool SensorManager::Running() const
 //////////////////////////////////////////////////
 void SensorManager::WaitForSensors(double _clk, double _dt)
 {
-  double tnext = this->NextRequiredTimestamp();
+  this->lockstepBarrier->Wait(_clk, _dt);
+}
 
-  while (!std::isnan(tnext)
-      && ignition::math::lessOrNearEqual(tnext - _dt / 2.0, _clk)
-      && physics::worlds_running())
-  {
-    this->WaitForPrerendered(0.001);
-    tnext = this->NextRequiredTimestamp();
-  }
+//////////////////////////////////////////////////
+std::map<std::string, SensorWaitStatistics>
+SensorManager::WaitStatistics() const
+{
+  return this->lockstepBarrier->Statistics();
+}
+
+//////////////////////////////////////////////////
+void SensorManager::ResetWaitStatistics()
+{
+  this->lockstepBarrier->ResetStatistics();
+}
+
+//////////////////////////////////////////////////
+void SensorManager::UpdateLockstepBarrier()
+{
+  static_cast<ImageSensorContainer *>(
+      this->sensorContainers[sensors::IMAGE])->UpdateBarrier();
 }
 
 void PublishPerformanceMetrics()
@@ -253,6 +518,10 @@ void PublishPerformanceMetrics()
               ret2.first->second.sensorRealUpdateRate =
                   1.0/updateRealRate;
               worldLastMeasurementTime[name] = world->RealTime();
+              ret2.first->second.sensorLastUpdateDuration =
+                  sensor->LastUpdateDuration().Double();
+              ret2.first->second.sensorAvgUpdateDuration =
+                  sensor->AvgUpdateDuration().Double();
 
               // Special case for stereo cameras
               sensors::CameraSensorPtr cameraSensor =
@@ -287,6 +556,10 @@ void PublishPerformanceMetrics()
       performanceSensorMetricsMsg->set_fps(
         sensorPerformanceMetric.second.sensorAvgFPS);
     }
+    performanceSensorMetricsMsg->set_last_update_duration(
+      sensorPerformanceMetric.second.sensorLastUpdateDuration);
+    performanceSensorMetricsMsg->set_avg_update_duration(
+      sensorPerformanceMetric.second.sensorAvgUpdateDuration);
   }
 
   // Publish data
@@ -368,6 +641,8 @@ void SensorManager::Update(bool _force)
   // Only update if there are sensors
   if (this->sensorContainers[sensors::IMAGE]->sensors.size() > 0)
     this->sensorContainers[sensors::IMAGE]->Update(_force);
+  else
+    this->UpdateLockstepBarrier();
 
   PublishPerformanceMetrics();
 }
@@ -390,6 +665,31 @@ void SensorManager::ResetLastUpdateTimes()
     GZ_ASSERT((*iter) != nullptr, "SensorContainer is null");
     (*iter)->ResetLastUpdateTimes();
   }
+
+  // The rendering times were cleared
+  this->UpdateLockstepBarrier();
+}
+
+//////////////////////////////////////////////////
+void SensorManager::SetUpdateThreads(const unsigned int _threads)
+{
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  this->updateThreads = std::max(1u, _threads);
+
+  // The image sensors are updated by the thread which owns the rendering
+  // engine, so only the other containers use threads.
+  for (unsigned int i = 0; i < this->sensorContainers.size(); ++i)
+  {
+    if (i != sensors::IMAGE)
+      this->sensorContainers[i]->SetUpdateThreads(this->updateThreads);
+  }
+}
+
+//////////////////////////////////////////////////
+unsigned int SensorManager::UpdateThreads() const
+{
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  return this->updateThreads;
 }
 
 //////////////////////////////////////////////////
@@ -466,6 +766,8 @@ void SensorManager::Fini()
   delete this->simTimeEventHandler;
   this->simTimeEventHandler = nullptr;
 
+  this->lockstepBarrier->Clear();
+
   this->initialized = false;
 }
 
@@ -620,16 +922,6 @@ void SensorManager::RemoveSensor(const std::string &_name)
   }
 }
 
-//////////////////////////////////////////////////
-bool SensorManager::WaitForPrerendered(double _timeoutsec)
-{
-  if (this->sensorContainers[sensors::IMAGE]->sensors.size() > 0)
-    return ((ImageSensorContainer*)this->sensorContainers[sensors::IMAGE])
-                ->WaitForPrerendered(_timeoutsec);
-
-  return true;
-}
-
 //////////////////////////////////////////////////
 void SensorManager::RemoveSensors()
 {
@@ -708,6 +1000,16 @@ void SensorManager::SensorContainer::Stop()
     delete this->runThread;
     this->runThread = nullptr;
   }
+
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  this->updatePool.reset();
+}
+
+//////////////////////////////////////////////////
+void SensorManager::SensorContainer::SetUpdateThreads(
+    const unsigned int _threads)
+{
+  this->updateThreads = std::max(1u, _threads);
 }
 
 //////////////////////////////////////////////////
@@ -855,6 +1157,48 @@ void SensorManager::SensorContainer::Update(bool _force)
   if (this->sensors.empty())
     gzlog << "Updating a sensor container without any sensors.\n";
 
+  // Update the sensors concurrently if requested. Each sensor still
+  // decides whether it is due, and this function returns once every
+  // sensor is updated, as with the serial loop below.
+  const unsigned int threads = this->updateThreads;
+  if (threads > 1 && this->sensors.size() > 1)
+  {
+    if (!this->updatePool || this->updatePool->threads != threads)
+    {
+      this->updatePool.reset();
+      this->updatePool.reset(new SensorUpdatePool(threads));
+    }
+
+    this->updatePool->arena.execute([&]()
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, this->sensors.size()),
+          [&](const tbb::blocked_range<size_t> &_r)
+          {
+            // Pool threads may run tasks of another container in between
+            const void *previous = updatingContainer;
+            updatingContainer = this;
+            try
+            {
+              for (size_t i = _r.begin(); i != _r.end(); ++i)
+              {
+                GZ_ASSERT(this->sensors[i] != nullptr, "Sensor is null");
+                IGN_PROFILE_BEGIN(this->sensors[i]->Name().c_str());
+                this->sensors[i]->Update(_force);
+                IGN_PROFILE_END();
+              }
+            }
+            catch(...)
+            {
+              updatingContainer = previous;
+              throw;
+            }
+            updatingContainer = previous;
+          });
+    });
+    return;
+  }
+  this->updatePool.reset();
+
   // Update all the sensors in this container.
   for (Sensor_V::iterator iter = this->sensors.begin();
        iter != this->sensors.end(); ++iter)
@@ -870,7 +1214,13 @@ void SensorManager::SensorContainer::Update(bool _force)
 SensorPtr SensorManager::SensorContainer::GetSensor(const std::string &_name,
                                                     bool _useLeafName) const
 {
-  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  // During a parallel update the mutex is held by the updating thread, and
+  // the sensors cannot change. Sensors updated by the pool may look up
+  // other sensors from their update callbacks, so pool threads don't wait
+  // for the mutex then, which would deadlock. Any other thread locks it.
+  boost::recursive_mutex::scoped_lock lock(this->mutex, boost::defer_lock);
+  if (updatingContainer != this)
+    lock.lock();
 
   SensorPtr result;
 
@@ -973,6 +1323,20 @@ void SensorManager::SensorContainer::RemoveSensors()
   this->sensors.clear();
 }
 
+//////////////////////////////////////////////////
+SensorManager::ImageSensorContainer::ImageSensorContainer(
+    SensorLockstepBarrier *_barrier)
+  : barrier(_barrier)
+{
+}
+
+//////////////////////////////////////////////////
+void SensorManager::ImageSensorContainer::UpdateBarrier()
+{
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  this->barrier->Update(this->sensors);
+}
+
 //////////////////////////////////////////////////
 void SensorManager::ImageSensorContainer::Update(bool _force)
 {
@@ -982,8 +1346,9 @@ void SensorManager::ImageSensorContainer::Update(bool _force)
   // Signals end of prerender phase
   event::Events::preRenderEnded();
 
-  // Notify that prerender is over
-  this->conditionPrerendered.notify_all();
+  // The prerender phase computed the next rendering times, the world
+  // can step while the cameras render
+  this->UpdateBarrier();
 
   // Tell all the cameras to render
   event::Events::render();
@@ -992,17 +1357,9 @@ void SensorManager::ImageSensorContainer::Update(bool _force)
 
   // Update the sensors, which will produce data messages.
   SensorContainer::Update(_force);
-}
 
-//////////////////////////////////////////////////
-bool SensorManager::ImageSensorContainer::WaitForPrerendered(double _timeoutsec)
-{
-  std::cv_status ret;
-  std::mutex mtx;
-  std::unique_lock<std::mutex> lck(mtx);
-  ret = this->conditionPrerendered.wait_for(lck,
-      std::chrono::duration<double>(_timeoutsec));
-  return (ret == std::cv_status::no_timeout);
+  // Sensors may schedule their first rendering while they are updated
+  this->UpdateBarrier();
 }
 
 //////////////////////////////////////////////////
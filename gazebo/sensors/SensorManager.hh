@@ -18,6 +18,9 @@
 #define _GAZEBO_SENSORMANAGER_HH_
 
 #include <boost/thread.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 #include <list>
@@ -28,6 +31,7 @@
 
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/common/SingletonT.hh"
+#include "gazebo/common/Time.hh"
 #include "gazebo/common/UpdateInfo.hh"
 #include "gazebo/sensors/SensorTypes.hh"
 #include "gazebo/sensors/Sensor.hh"
@@ -84,8 +88,30 @@ namespace gazebo
       /// \brief Connect to the World::UpdateBegin event.
       private: event::ConnectionPtr updateConnection;
     };
+
+    /// \brief Thread pool used to update the sensors of a container.
+    class SensorUpdatePool;
+
+    /// \brief Blocks the world in lockstep mode until the image sensors
+    /// have caught up with it.
+    class SensorLockstepBarrier;
     /// \endcond
 
+    /// \class SensorWaitStatistics SensorManager.hh sensors/sensors.hh
+    /// \brief Wall clock time spent by a world in lockstep mode waiting
+    /// for a sensor.
+    class GZ_SENSORS_VISIBLE SensorWaitStatistics
+    {
+      /// \brief Number of times the world waited for the sensor.
+      public: uint64_t count = 0;
+
+      /// \brief Total time spent waiting.
+      public: common::Time total;
+
+      /// \brief Longest single wait.
+      public: common::Time max;
+    };
+
     /// \addtogroup gazebo_sensors
     /// \{
     /// \class SensorManager SensorManager.hh sensors/sensors.hh
@@ -179,15 +205,43 @@ namespace gazebo
       /// \brief Reset last update times in all sensors.
       public: void ResetLastUpdateTimes();
 
+      /// \brief Set the number of threads used to update the sensors of
+      /// each of the non-image sensor categories. With more than one
+      /// thread, the sensors of a category are updated concurrently, and
+      /// an update of a category completes when all its sensors are
+      /// updated. Image sensors are always updated serially by the thread
+      /// which owns the rendering engine. The initial value is read from
+      /// the GAZEBO_SENSOR_UPDATE_THREADS environment variable, and is 1
+      /// if it is not set.
+      /// \param[in] _threads Number of threads. 0 and 1 both select serial
+      /// updates.
+      public: void SetUpdateThreads(const unsigned int _threads);
+
+      /// \brief Get the number of threads used to update the sensors of
+      /// each of the non-image sensor categories.
+      /// \return Number of threads.
+      /// \sa SetUpdateThreads
+      public: unsigned int UpdateThreads() const;
+
+      /// \brief Get the time the world spent waiting for each image
+      /// sensor in lockstep mode. A wait is attributed to the sensor with
+      /// the earliest rendering time while the world is blocked.
+      /// \return Statistics indexed by the scoped name of the sensors.
+      /// Sensors the world never waited for are not listed.
+      public: std::map<std::string, SensorWaitStatistics>
+              WaitStatistics() const;
+
+      /// \brief Clear the statistics returned by WaitStatistics.
+      public: void ResetWaitStatistics();
+
       /// \brief Block until all sensors do not need current world tick
       /// \param[in] _clk simulated clock of the world
       /// \param[in] _dt world time step
       private: void WaitForSensors(double _clk, double _dt);
 
-      /// \brief Wait until pre-rendering phase is over.
-      /// \param[in] _timeoutsec timeout expressed in seconds
-      /// \return True if timeout has NOT been met
-      private: bool WaitForPrerendered(double _timeoutsec);
+      /// \brief Publish the next rendering times of the image sensors to
+      /// the lockstep barrier.
+      private: void UpdateLockstepBarrier();
 
       /// \brief Add a new sensor to a sensor container.
       /// \param[in] _sensor Pointer to a sensor to add.
@@ -254,6 +308,11 @@ namespace gazebo
                  /// \brief Reset last update times in all sensors.
                  public: void ResetLastUpdateTimes();
 
+                 /// \brief Set the number of threads used by Update.
+                 /// \param[in] _threads Number of threads, 0 and 1 select
+                 /// serial updates.
+                 public: void SetUpdateThreads(const unsigned int _threads);
+
                  /// \brief A loop to update the sensor. Used by the
                  /// runThread.
                  private: void RunLoop();
@@ -272,11 +331,18 @@ namespace gazebo
                  private: boost::thread *runThread;
 
                  /// \brief A mutex to manage access to the sensors vector.
-                 private: mutable boost::recursive_mutex mutex;
+                 protected: mutable boost::recursive_mutex mutex;
 
                  /// \brief Condition used to block the RunLoop if no
                  /// sensors are present.
                  private: boost::condition_variable runCondition;
+
+                 /// \brief Number of threads used by Update.
+                 private: std::atomic<unsigned int> updateThreads{1};
+
+                 /// \brief Thread pool used by Update, created on the
+                 /// first parallel update.
+                 private: std::unique_ptr<SensorUpdatePool> updatePool;
                };
       /// \endcond
 
@@ -285,18 +351,24 @@ namespace gazebo
       /// the SensorContainer.
       private: class ImageSensorContainer : public SensorContainer
                {
-                 /// \brief Wait until pre-rendering phase is over.
-                 /// \param[in] _timeoutsec timeout expressed in seconds
-                 /// \return True if timeout has NOT been met
-                 public: bool WaitForPrerendered(double _timeoutsec);
+                 /// \brief Constructor.
+                 /// \param[in] _barrier Barrier notified when the
+                 /// rendering times of the sensors change.
+                 public: explicit ImageSensorContainer(
+                             SensorLockstepBarrier *_barrier);
+
+                 /// \brief Publish the next rendering times of the
+                 /// sensors to the barrier, and wake up the world if it
+                 /// waits for them.
+                 public: void UpdateBarrier();
 
                  /// \brief The special update for image based sensors.
                  /// \param[in] _force True to force the sensors to update,
                  /// even if they are not active.
                  public: virtual void Update(bool _force = false);
 
-                 /// \brief used to wait for the end of prerendering
-                 private: std::condition_variable conditionPrerendered;
+                 /// \brief Barrier the world waits on in lockstep mode.
+                 private: SensorLockstepBarrier *barrier;
                };
       /// \endcond
 
@@ -343,6 +415,12 @@ namespace gazebo
 
       /// \brief Connect to the remove sensor event.
       private: event::ConnectionPtr removeSensorConnection;
+
+      /// \brief Number of threads used to update non-image sensors.
+      private: unsigned int updateThreads = 1;
+
+      /// \brief Barrier the worlds wait on in lockstep mode.
+      private: std::unique_ptr<SensorLockstepBarrier> lockstepBarrier;
     };
     /// \}
   }
@@ -159,6 +159,78 @@ TEST_F(SensorManager_TEST, InitRemove)
   printf("Done done\n");
 }
 
+/////////////////////////////////////////////////
+/// \brief Test that sensors are updated by the thread pool, and that their
+/// update durations are measured.
+TEST_F(SensorManager_TEST, UpdateThreads)
+{
+  Load("worlds/test_camera_laser.world");
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+  EXPECT_TRUE(mgr->SensorsInitialized());
+
+  mgr->SetUpdateThreads(4);
+  EXPECT_EQ(mgr->UpdateThreads(), 4u);
+
+  common::Time time = physics::get_world()->SimTime();
+
+  // Wait for 1 second
+  for (unsigned int i = 0; i < 10; ++i)
+    common::Time::MSleep(100);
+
+  for (auto const &name : {"default::laser_1::link::laser",
+                           "default::laser_2::link::laser"})
+  {
+    sensors::SensorPtr sensor = mgr->GetSensor(name);
+    ASSERT_TRUE(sensor != nullptr);
+    EXPECT_TRUE(sensor->LastMeasurementTime() > time);
+    EXPECT_GT(sensor->LastUpdateDuration(), common::Time::Zero);
+    EXPECT_GT(sensor->AvgUpdateDuration(), common::Time::Zero);
+  }
+
+  // 0 means serial updates
+  mgr->SetUpdateThreads(0);
+  EXPECT_EQ(mgr->UpdateThreads(), 1u);
+}
+
+/////////////////////////////////////////////////
+/// \brief Test that a world in lockstep mode keeps stepping with a strict
+/// rate camera, and that the time spent waiting for it is measured.
+TEST_F(SensorManager_TEST, LockstepWait)
+{
+  LoadArgs(" --lockstep worlds/camera_strict_rate.world");
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+
+  sensors::SensorPtr sensor = mgr->GetSensor("camera_sensor");
+  ASSERT_TRUE(sensor != nullptr);
+  EXPECT_TRUE(sensor->StrictRate());
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // The world is released by the camera renderings
+  common::Time time = world->SimTime();
+  int i = 0;
+  while (world->SimTime() < time + common::Time(0.5) && i < 200)
+  {
+    common::Time::MSleep(100);
+    ++i;
+  }
+  EXPECT_LT(i, 200);
+
+  // Whether the world had to wait depends on the speed of the rendering
+  for (auto const &stats : mgr->WaitStatistics())
+  {
+    EXPECT_NE(stats.first.find("camera_sensor"), std::string::npos);
+    EXPECT_GT(stats.second.count, 0u);
+    EXPECT_GE(stats.second.total, stats.second.max);
+  }
+
+  world->SetPaused(true);
+  common::Time::MSleep(100);
+  mgr->ResetWaitStatistics();
+  EXPECT_TRUE(mgr->WaitStatistics().empty());
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
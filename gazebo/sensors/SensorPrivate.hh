@@ -51,6 +51,14 @@ namespace gazebo
       /// \brief The sensors unique ID.
       public: uint32_t id;
 
+      /// \brief Wall clock time spent by the last call to UpdateImpl.
+      /// Protected by mutexLastUpdateTime.
+      public: common::Time lastUpdateDuration;
+
+      /// \brief Moving average of the wall clock time spent by UpdateImpl.
+      /// Protected by mutexLastUpdateTime.
+      public: common::Time avgUpdateDuration;
+
       /// \brief An SDF pointer that allows us to only read the sensor.sdf
       /// file once, which in turns limits disk reads.
       public: static sdf::ElementPtr sdfSensor;
@@ -14,6 +14,8 @@
  * limitations under the License.
  *
 */
+#include <vector>
+
 #include <ignition/math/Rand.hh>
 
 #include "gazebo/msgs/msgs.hh"
@@ -47,6 +49,8 @@ WirelessTransmitter::WirelessTransmitter()
 /////////////////////////////////////////////////
 WirelessTransmitter::~WirelessTransmitter()
 {
+  if (this->dataPtr->rayQueryManager)
+    this->dataPtr->rayQueryManager->RemoveUser();
 }
 
 /////////////////////////////////////////////////
@@ -83,6 +87,12 @@ void WirelessTransmitter::Init()
   // between the transmitter and a given point.
   this->dataPtr->testRay = boost::dynamic_pointer_cast<RayShape>(
       this->world->Physics()->CreateShape("ray", CollisionPtr()));
+
+  if (!this->dataPtr->rayQueryManager && this->world->RayQueryMgr())
+  {
+    this->dataPtr->rayQueryManager = this->world->RayQueryMgr();
+    this->dataPtr->rayQueryManager->AddUser();
+  }
 }
 
 //////////////////////////////////////////////////
@@ -160,16 +170,30 @@ double WirelessTransmitter::SignalStrength(
     end.Z() += 0.00001;
   }
 
-  // Acquire the mutex for avoiding race condition with the physics engine
-  boost::recursive_mutex::scoped_lock lock(*(
-        this->world->Physics()->GetPhysicsUpdateMutex()));
-
   // Compute the value of n depending on the obstacles between Tx and Rx
   double n = WirelessTransmitterPrivate::NEmpty;
 
-  // Looking for obstacles between start and end points
-  this->dataPtr->testRay->SetPoints(start, end);
-  this->dataPtr->testRay->GetIntersection(dist, entityName);
+  // Looking for obstacles between start and end points, in the last
+  // snapshot of the world if possible. Receivers may call this function
+  // concurrently, so the query is not shared.
+  std::vector<RayQuery> query(1);
+  std::vector<RayQueryResult> result;
+  query[0].start = start;
+  query[0].end = end;
+  if (this->dataPtr->rayQueryManager &&
+      this->dataPtr->rayQueryManager->Intersect(query, result))
+  {
+    entityName = result[0].collisionName;
+  }
+  else
+  {
+    // Acquire the mutex for avoiding race condition with the physics engine
+    boost::recursive_mutex::scoped_lock lock(*(
+          this->world->Physics()->GetPhysicsUpdateMutex()));
+
+    this->dataPtr->testRay->SetPoints(start, end);
+    this->dataPtr->testRay->GetIntersection(dist, entityName);
+  }
 
   // ToDo: The ray intersects with my own collision model. Fix it.
   if (entityName != "")
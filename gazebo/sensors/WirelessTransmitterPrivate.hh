@@ -59,6 +59,10 @@ namespace gazebo
 
       // \brief Ray used to test for collisions when placing entities
       public: physics::RayShapePtr testRay;
+
+      /// \brief Manager used to check for obstacles without locking the
+      /// physics engine.
+      public: physics::RayQueryManagerPtr rayQueryManager;
     };
   }
 }
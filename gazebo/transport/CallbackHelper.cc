@@ -39,6 +39,14 @@ std::string CallbackHelper::GetMsgType() const
   return std::string();
 }
 
+/////////////////////////////////////////////////
+bool CallbackHelper::HandleSharedData(
+    const boost::shared_ptr<const std::string> &_newdata,
+    boost::function<void(uint32_t)> _cb, uint32_t _id)
+{
+  return this->HandleData(*_newdata, _cb, _id);
+}
+
 /////////////////////////////////////////////////
 bool CallbackHelper::GetLatching() const
 {
@@ -64,6 +64,18 @@ namespace gazebo
       public: virtual bool HandleData(const std::string &_newdata,
                   boost::function<void(uint32_t)> _cb, uint32_t _id) = 0;
 
+      /// \brief Process new incoming data, which may be shared with other
+      /// callbacks and must not be modified. The default implementation
+      /// calls HandleData.
+      /// \param[in] _newdata Incoming data to be processed
+      /// \return true if successfully processed; false otherwise
+      /// \param[in] _cb If non-null, callback to be invoked which signals
+      /// that transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      public: virtual bool HandleSharedData(
+                  const boost::shared_ptr<const std::string> &_newdata,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id);
+
       /// \brief Process new incoming message
       /// \param[in] _newMsg Incoming message to be processed
       /// \return true if successfully processed; false otherwise
@@ -49,9 +49,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <algorithm>
+#include <cstring>
+
 #include <boost/bind/bind.hpp>
 #include <boost/function.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/make_shared.hpp>
 
 #include "gazebo/common/Console.hh"
 #include "gazebo/msgs/msgs.hh"
@@ -65,7 +69,11 @@ using namespace transport;
 
 extern void dummy_callback_fn(uint32_t);
 
-unsigned int Connection::idCounter = 0;
+std::atomic<unsigned int> Connection::idCounter(0);
+
+/// \brief Initial size of the inbound buffer of a connection, which is
+/// enlarged for larger messages.
+static const std::size_t kInboundBufferSize = 65536;
 IOManager *Connection::iomanager = NULL;
 
 // Version 1.52 of boost has an address::is_unspecfied function, but
@@ -94,6 +102,7 @@ Connection::Connection()
     iomanager = new IOManager();
 
   this->socket = new boost::asio::ip::tcp::socket(iomanager->GetIO());
+  this->strand.reset(new boost::asio::io_service::strand(iomanager->GetIO()));
 
   iomanager->IncCount();
   this->id = idCounter++;
@@ -126,6 +135,9 @@ Connection::~Connection()
 {
   this->Shutdown();
 
+  // The strand must be destroyed before the IO service
+  this->strand.reset();
+
   if (iomanager)
   {
     iomanager->DecCount();
@@ -186,8 +198,9 @@ bool Connection::Connect(const std::string &_host, unsigned int _port)
   // Use async connect so that we can use a custom timeout. This is useful
   // when trying to detect network errors.
   this->socket->async_connect(*endpointIter++,
-      common::weakBind(&Connection::OnConnect, this->shared_from_this(),
-        boost::asio::placeholders::error, endpointIter));
+      this->strand->wrap(
+        common::weakBind(&Connection::OnConnect, this->shared_from_this(),
+          boost::asio::placeholders::error, endpointIter)));
 
   // Wait for at most 60 seconds for a connection to be established.
   // The connectionCondition notification occurs in ::OnConnect.
@@ -233,8 +246,9 @@ void Connection::Listen(unsigned int port, const AcceptCallback &_acceptCB)
   this->acceptConn = ConnectionPtr(new Connection());
 
   this->acceptor->async_accept(*this->acceptConn->socket,
-      common::weakBind(&Connection::OnAccept, this->shared_from_this(),
-                  boost::asio::placeholders::error));
+      this->strand->wrap(
+        common::weakBind(&Connection::OnAccept, this->shared_from_this(),
+          boost::asio::placeholders::error)));
 }
 
 //////////////////////////////////////////////////
@@ -262,8 +276,9 @@ void Connection::OnAccept(const boost::system::error_code &e)
     this->acceptConn = ConnectionPtr(new Connection());
 
     this->acceptor->async_accept(*this->acceptConn->socket,
-        common::weakBind(&Connection::OnAccept, this->shared_from_this(),
-          boost::asio::placeholders::error));
+        this->strand->wrap(
+          common::weakBind(&Connection::OnAccept, this->shared_from_this(),
+            boost::asio::placeholders::error)));
   }
   else
   {
@@ -303,26 +318,56 @@ void Connection::EnqueueMsg(const std::string &_buffer,
     return;
   }
 
+  this->EnqueueMsg(boost::make_shared<const std::string>(_buffer), _cb, _id,
+      _force);
+}
+
+//////////////////////////////////////////////////
+void Connection::EnqueueMsg(const boost::shared_ptr<const std::string> &_buffer,
+    boost::function<void(uint32_t)> _cb, uint32_t _id, bool _force)
+{
+  // Don't enqueue empty messages
+  if (!_buffer || _buffer->empty() || !this->IsOpen())
+  {
+    return;
+  }
+
+  ConnectionWriteMsg msg;
   char headerBuffer[HEADER_LENGTH + 1];
   snprintf(headerBuffer, HEADER_LENGTH + 1, "%08x",
-      static_cast<unsigned int>(_buffer.size()));
+      static_cast<unsigned int>(_buffer->size()));
+  std::memcpy(msg.header, headerBuffer, HEADER_LENGTH);
+  msg.data = _buffer;
+  msg.cb = _cb;
+  msg.id = _id;
 
   {
     boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+    this->writeQueueBytes += HEADER_LENGTH + _buffer->size();
+    this->writeQueue.push_back(std::move(msg));
 
-    if (this->writeQueue.empty() ||
-        (this->writeCount > 0 && this->writeQueue.size() == 1) ||
-        (this->writeQueue.back().size() + HEADER_LENGTH + _buffer.size() >
-         4096))
+    // Drop the oldest messages if the client doesn't keep up
+    while (this->writeQueueBytes > this->writeQueueLimit &&
+           this->writeQueue.size() > 1)
     {
-      this->writeQueue.push_back(std::string(headerBuffer) + _buffer);
-      this->callbacks.push_back({std::make_pair(_cb, _id)});
-    }
-    else
-    {
-      this->writeQueue.back() += std::string(headerBuffer) + _buffer;
-      this->callbacks.back().push_back(std::make_pair(_cb, _id));
+      if (!this->dropMsgLogged)
+      {
+        gzwarn << "Connection[" << this->id << "] to ["
+               << this->remoteURI << "] is not keeping up, "
+               << "dropping its oldest queued messages\n";
+        this->dropMsgLogged = true;
+      }
+
+      ConnectionWriteMsg &dropped = this->writeQueue.front();
+      this->writeQueueBytes -= HEADER_LENGTH + dropped.data->size();
+      if (!dropped.cb.empty())
+        dropped.cb(dropped.id);
+      this->writeQueue.pop_front();
+      ++this->messagesDropped;
     }
+
+    this->maxWriteQueueDepth =
+      std::max(this->maxWriteQueueDepth, this->writeQueue.size());
   }
 
   if (_force)
@@ -355,24 +400,49 @@ void Connection::ProcessWriteQueue(bool _blocking)
 
   this->writeCount++;
 
-  // Write the serialized data to the socket. We use
-  // "gather-write" to send both the head and the data in
-  // a single write operation
+  // Take a batch of messages out of the queue. The batch keeps the data
+  // alive until it is written, even if the connection is closed.
+  std::size_t batchBytes = 0;
+  this->writeBatch.clear();
+  while (!this->writeQueue.empty() &&
+         this->writeBatch.size() < this->writeBatchMaxMsgs)
+  {
+    std::size_t msgBytes =
+      HEADER_LENGTH + this->writeQueue.front().data->size();
+    if (!this->writeBatch.empty() &&
+        batchBytes + msgBytes > this->writeBatchMaxBytes)
+    {
+      break;
+    }
+
+    batchBytes += msgBytes;
+    this->writeQueueBytes -= msgBytes;
+    this->writeBatch.push_back(std::move(this->writeQueue.front()));
+    this->writeQueue.pop_front();
+  }
+
+  // Write the headers and the data of the batch to the socket in a single
+  // "gather-write" operation
+  this->writeBuffers.clear();
+  for (auto const &msg : this->writeBatch)
+  {
+    this->writeBuffers.push_back(
+        boost::asio::buffer(msg.header, HEADER_LENGTH));
+    this->writeBuffers.push_back(boost::asio::buffer(*msg.data));
+  }
+
   if (!_blocking)
   {
-    boost::asio::async_write(*this->socket,
-        boost::asio::buffer(this->writeQueue.front().c_str(),
-          this->writeQueue.front().size()),
-          common::weakBind(&Connection::OnWrite, this->shared_from_this(),
-            boost::asio::placeholders::error));
+    boost::asio::async_write(*this->socket, this->writeBuffers,
+          this->strand->wrap(
+            common::weakBind(&Connection::OnWrite, this->shared_from_this(),
+              boost::asio::placeholders::error)));
   }
   else
   {
     try
     {
-      boost::asio::write(*this->socket,
-          boost::asio::buffer(this->writeQueue.front().c_str(),
-            this->writeQueue.front().size()));
+      boost::asio::write(*this->socket, this->writeBuffers);
     }
     catch(...)
     {
@@ -383,6 +453,73 @@ void Connection::ProcessWriteQueue(bool _blocking)
   }
 }
 
+//////////////////////////////////////////////////
+void Connection::SetWriteBatchLimits(const std::size_t _maxMsgs,
+    const std::size_t _maxBytes)
+{
+  boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+  this->writeBatchMaxMsgs = std::max<std::size_t>(_maxMsgs, 1);
+  this->writeBatchMaxBytes = _maxBytes;
+}
+
+//////////////////////////////////////////////////
+void Connection::SetWriteQueueLimit(const std::size_t _bytes)
+{
+  boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+  this->writeQueueLimit = _bytes;
+}
+
+//////////////////////////////////////////////////
+std::size_t Connection::WriteQueueLimit() const
+{
+  boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+  return this->writeQueueLimit;
+}
+
+//////////////////////////////////////////////////
+uint64_t Connection::MessagesDropped() const
+{
+  return this->messagesDropped;
+}
+
+//////////////////////////////////////////////////
+uint64_t Connection::BytesWritten() const
+{
+  return this->bytesWritten;
+}
+
+//////////////////////////////////////////////////
+uint64_t Connection::MessagesWritten() const
+{
+  return this->messagesWritten;
+}
+
+//////////////////////////////////////////////////
+uint64_t Connection::BytesRead() const
+{
+  return this->bytesRead;
+}
+
+//////////////////////////////////////////////////
+uint64_t Connection::MessagesRead() const
+{
+  return this->messagesRead;
+}
+
+//////////////////////////////////////////////////
+std::size_t Connection::WriteQueueDepth() const
+{
+  boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+  return this->writeQueue.size();
+}
+
+//////////////////////////////////////////////////
+std::size_t Connection::MaxWriteQueueDepth() const
+{
+  boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+  return this->maxWriteQueueDepth;
+}
+
 //////////////////////////////////////////////////
 std::string Connection::GetLocalURI() const
 {
@@ -399,16 +536,17 @@ std::string Connection::GetRemoteURI() const
 void Connection::PostWrite()
 {
   // Call the callbacks, if not NULL
-  if (!this->callbacks.empty())
+  for (auto const &msg : this->writeBatch)
   {
-    for (auto const &callback : this->callbacks.front())
-      if (!callback.first.empty())
-        callback.first(callback.second);
-    this->callbacks.pop_front();
+    if (!msg.cb.empty())
+      msg.cb(msg.id);
+
+    this->bytesWritten += HEADER_LENGTH + msg.data->size();
   }
+  this->messagesWritten += this->writeBatch.size();
 
-  if (!this->writeQueue.empty())
-    this->writeQueue.pop_front();
+  this->writeBatch.clear();
+  this->writeBuffers.clear();
   this->writeCount--;
 }
 
@@ -426,6 +564,12 @@ void Connection::OnWrite(const boost::system::error_code &_e)
     // It will reach this point if the remote connection disconnects.
     this->Shutdown();
   }
+  else
+  {
+    // Write the next batch now, rather than on the next update of the
+    // ConnectionManager, so that each connection writes at its own pace.
+    this->ProcessWriteQueue();
+  }
 }
 
 //////////////////////////////////////////////////
@@ -490,7 +634,7 @@ void Connection::Close()
 
   boost::recursive_mutex::scoped_lock lock2(this->writeMutex);
   this->writeQueue.clear();
-  this->callbacks.clear();
+  this->writeQueueBytes = 0;
 }
 
 //////////////////////////////////////////////////
@@ -530,17 +674,20 @@ void Connection::Cancel()
 //////////////////////////////////////////////////
 bool Connection::Read(std::string &data)
 {
-  bool result = false;
-  char header[HEADER_LENGTH];
-  std::vector<char> incoming;
+  boost::recursive_mutex::scoped_lock lock(this->readMutex);
 
-  std::size_t incoming_size;
-  boost::system::error_code error;
+  // Messages received by a previous asynchronous read come first
+  {
+    boost::mutex::scoped_lock socketLock(this->socketMutex);
+    if (this->inboundEnd > this->inboundBegin && this->PopInbound(data))
+      return !data.empty();
+  }
 
-  boost::recursive_mutex::scoped_lock lock(this->readMutex);
+  char header[HEADER_LENGTH];
+  boost::system::error_code error;
 
   // First read the header
-  this->socket->read_some(boost::asio::buffer(header), error);
+  boost::asio::read(*this->socket, boost::asio::buffer(header), error);
 
   if (error)
   {
@@ -549,33 +696,64 @@ bool Connection::Read(std::string &data)
   }
 
   // Parse the header to get the size of the incoming data packet
-  incoming_size = this->ParseHeader(std::string(header, HEADER_LENGTH));
-  if (incoming_size > 0)
-  {
-    incoming.resize(incoming_size);
+  std::size_t incomingSize =
+    this->ParseHeader(std::string(header, HEADER_LENGTH));
+  if (incomingSize == 0)
+    return false;
 
-    std::size_t len = 0;
-    do
-    {
-      // Read in the actual data
-      len += this->socket->read_some(boost::asio::buffer(&incoming[len],
-            incoming_size - len), error);
-    } while (len < incoming_size && !error && !this->readQuit);
+  // Read the data directly into the output
+  data.resize(incomingSize);
+  boost::asio::read(*this->socket,
+      boost::asio::buffer(&data[0], incomingSize), error);
+
+  if (error)
+    throw boost::system::system_error(error);
+
+  this->bytesRead += HEADER_LENGTH + incomingSize;
+  ++this->messagesRead;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Connection::PopInbound(std::string &_data)
+{
+  std::size_t available = this->inboundEnd - this->inboundBegin;
+  std::size_t needed = HEADER_LENGTH;
+
+  if (available >= HEADER_LENGTH)
+  {
+    needed += this->ParseHeader(
+        std::string(&this->inbound[this->inboundBegin], HEADER_LENGTH));
 
-    if (len != incoming_size)
+    if (available >= needed)
     {
-      gzerr << "Did not read everying. Read[" << len
-        << "] Needed[" << incoming_size << "]\n";
+      this->bytesRead += needed;
+      ++this->messagesRead;
+      _data.assign(&this->inbound[this->inboundBegin + HEADER_LENGTH],
+          needed - HEADER_LENGTH);
+
+      this->inboundBegin += needed;
+      if (this->inboundBegin == this->inboundEnd)
+        this->inboundBegin = this->inboundEnd = 0;
+      return true;
     }
+  }
 
-    if (error)
-      throw boost::system::system_error(error);
-
-    data = std::string(&incoming[0], incoming.size());
-    result = true;
+  // Move the start of the message to the front of the buffer, and make
+  // room for the rest of it.
+  if (this->inboundBegin > 0)
+  {
+    std::copy(this->inbound.begin() + this->inboundBegin,
+        this->inbound.begin() + this->inboundEnd, this->inbound.begin());
+    this->inboundEnd = available;
+    this->inboundBegin = 0;
   }
 
-  return result;
+  needed = std::max(needed, kInboundBufferSize);
+  if (this->inbound.size() < needed)
+    this->inbound.resize(needed);
+
+  return false;
 }
 
 //////////////////////////////////////////////////
@@ -630,16 +808,27 @@ unsigned int Connection::GetRemotePort() const
 //////////////////////////////////////////////////
 std::size_t Connection::ParseHeader(const std::string &header)
 {
-  std::size_t data_size = 0;
-  std::istringstream is(header);
-
-  if (!(is >> std::hex >> data_size))
+  // The header is the size of the data, as hexadecimal digits. This is
+  // parsed by hand since it is done for every message.
+  std::size_t dataSize = 0;
+  for (const char c : header)
   {
-    // Header doesn't seem to be valid. Inform the caller
-    boost::system::error_code error(boost::asio::error::invalid_argument);
+    std::size_t digit;
+    if (c >= '0' && c <= '9')
+      digit = c - '0';
+    else if (c >= 'a' && c <= 'f')
+      digit = c - 'a' + 10;
+    else if (c >= 'A' && c <= 'F')
+      digit = c - 'A' + 10;
+    else if (c == ' ' && dataSize == 0)
+      continue;
+    else
+      break;
+
+    dataSize = dataSize * 16 + digit;
   }
 
-  return data_size;
+  return dataSize;
 }
 
 //////////////////////////////////////////////////
@@ -652,18 +841,10 @@ void Connection::ReadLoop(const ReadCallback &cb)
   {
     try
     {
-      if (this->socket->available() >= HEADER_LENGTH)
-      {
-        if (this->Read(data))
-        {
-          (cb)(data);
-        }
-      }
-      else
-      {
-        common::Time::MSleep(10);
-        continue;
-      }
+      // Read blocks until a message is received, so each message is
+      // passed on as soon as it arrives.
+      if (this->Read(data))
+        (cb)(data);
     }
     catch(std::exception &e)
     {
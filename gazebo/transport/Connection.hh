@@ -36,14 +36,18 @@
 #include <boost/asio.hpp>
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
 #include <boost/thread.hpp>
 #include <boost/tuple/tuple.hpp>
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <iostream>
 #include <iomanip>
 #include <deque>
+#include <memory>
 #include <utility>
 
 #include "gazebo/common/Event.hh"
@@ -82,9 +86,9 @@ namespace gazebo
       /// \param[in] _data Data to send to the boost function pointer.
       public: ConnectionReadTask(
                   boost::function<void (const std::string &)> _func,
-                  const std::string &_data) :
+                  std::string _data) :
                 func(_func),
-                data(_data)
+                data(std::move(_data))
               {
               }
 
@@ -107,6 +111,23 @@ namespace gazebo
       /// \brief The data to send to the boost function pointer
       private: std::string data;
     };
+
+    /// \brief A message waiting to be written to a connection.
+    class ConnectionWriteMsg
+    {
+      /// \brief Header, the size of the data as hexadecimal digits.
+      public: char header[HEADER_LENGTH];
+
+      /// \brief The data, which may be shared with other connections.
+      public: boost::shared_ptr<const std::string> data;
+
+      /// \brief Callback to invoke once the message is written, may be
+      /// empty.
+      public: boost::function<void(uint32_t)> cb;
+
+      /// \brief ID passed to the callback.
+      public: uint32_t id = 0;
+    };
     /// \endcond
 
     /// \addtogroup gazebo_transport Transport
@@ -193,6 +214,75 @@ namespace gazebo
       /// to the socket, otherwise just enqueue the data for asynchronous write
       public: void EnqueueMsg(const std::string &_buffer, bool _force = false);
 
+      /// \brief Write shared data to the socket. The data is not copied, so
+      /// the same buffer can be queued on several connections. It must not
+      /// be modified until it is written.
+      /// \param[in] _buffer Data to write
+      /// \param[in] _cb If non-null, callback to be invoked after
+      /// transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      /// \param[in] _force If true, start writing the queued messages now,
+      /// otherwise they are written on the next update of the
+      /// ConnectionManager.
+      public: void EnqueueMsg(
+                  const boost::shared_ptr<const std::string> &_buffer,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id,
+                  bool _force = false);
+
+      /// \brief Set how queued messages are grouped. Each write sends a
+      /// batch of queued messages, with their headers, in a single gather
+      /// operation, without copying them.
+      /// \param[in] _maxMsgs Maximum number of messages in a batch. 1
+      /// sends each message with its own write.
+      /// \param[in] _maxBytes Maximum size of a batch in bytes, headers
+      /// included. A larger message is sent alone.
+      public: void SetWriteBatchLimits(const std::size_t _maxMsgs,
+                  const std::size_t _maxBytes);
+
+      /// \brief Set the maximum size of the messages waiting to be written.
+      /// When a new message would exceed it, the oldest waiting messages
+      /// are dropped, so that a client that doesn't keep up neither uses
+      /// unbounded memory nor receives stale data. The callbacks of
+      /// dropped messages are still invoked.
+      /// \param[in] _bytes Maximum size in bytes. The newest message is
+      /// always kept, even if it is larger.
+      public: void SetWriteQueueLimit(const std::size_t _bytes);
+
+      /// \brief Get the maximum size of the messages waiting to be written.
+      /// \return Maximum size in bytes.
+      /// \sa SetWriteQueueLimit
+      public: std::size_t WriteQueueLimit() const;
+
+      /// \brief Get the number of messages dropped because the write
+      /// queue was full.
+      /// \return Number of messages.
+      public: uint64_t MessagesDropped() const;
+
+      /// \brief Get the number of bytes written, headers included.
+      /// \return Number of bytes.
+      public: uint64_t BytesWritten() const;
+
+      /// \brief Get the number of messages written.
+      /// \return Number of messages.
+      public: uint64_t MessagesWritten() const;
+
+      /// \brief Get the number of bytes read, headers included.
+      /// \return Number of bytes.
+      public: uint64_t BytesRead() const;
+
+      /// \brief Get the number of messages read.
+      /// \return Number of messages.
+      public: uint64_t MessagesRead() const;
+
+      /// \brief Get the number of messages waiting to be written.
+      /// \return Number of messages.
+      public: std::size_t WriteQueueDepth() const;
+
+      /// \brief Get the largest number of messages that waited to be
+      /// written since the connection was created.
+      /// \return Number of messages.
+      public: std::size_t MaxWriteQueueDepth() const;
+
       /// \brief Get the local URI
       /// \return The local URI
       public: std::string GetLocalURI() const;
@@ -226,126 +316,92 @@ namespace gazebo
       public: static std::string GetLocalHostname();
 
       /// \brief Peform an asyncronous read
+      ///
+      /// The handler is called with the next message received on the
+      /// connection. Data is read from the socket into a reusable buffer,
+      /// as much as is available, so a single read often receives several
+      /// messages. Messages that are already buffered are dispatched
+      /// without waiting for the socket.
       /// param[in] _handler Callback to invoke on received data
       public: template<typename Handler>
               void AsyncRead(Handler _handler)
               {
-                boost::mutex::scoped_lock lock(this->socketMutex);
-                if (!this->IsOpen())
+                std::string data;
                 {
-                  gzerr << "AsyncRead on a closed socket\n";
-                  return;
-                }
-
-                void (Connection::*f)(const boost::system::error_code &,
-                    boost::tuple<Handler>) = &Connection::OnReadHeader<Handler>;
+                  boost::mutex::scoped_lock lock(this->socketMutex);
+                  if (!this->IsOpen())
+                  {
+                    gzerr << "AsyncRead on a closed socket\n";
+                    return;
+                  }
 
-                this->inboundHeader.resize(HEADER_LENGTH);
-                boost::asio::async_read(*this->socket,
-                    boost::asio::buffer(this->inboundHeader),
-                    common::weakBind(f, this->shared_from_this(),
-                                boost::asio::placeholders::error,
-                                boost::make_tuple(_handler)));
-              }
+                  if (!this->PopInbound(data))
+                  {
+                    // Wait for the rest of the message
+                    void (Connection::*f)(const boost::system::error_code &,
+                        std::size_t, boost::tuple<Handler>) =
+                      &Connection::OnReadSome<Handler>;
+
+                    this->socket->async_read_some(
+                        boost::asio::buffer(&this->inbound[this->inboundEnd],
+                          this->inbound.size() - this->inboundEnd),
+                        this->strand->wrap(
+                          common::weakBind(f, this->shared_from_this(),
+                            boost::asio::placeholders::error,
+                            boost::asio::placeholders::bytes_transferred,
+                            boost::make_tuple(_handler))));
+                    return;
+                  }
+                }
 
-      /// \brief Handle a completed read of a message header.
-      ///
-      /// The handler is passed using a tuple since boost::bind seems to
-      /// have trouble binding a function object created using boost::bind
-      /// as a parameter
-      /// \param[in] _e Error code, if any, associated with the read
-      /// \param[in] _handler Callback to invoke on received data
-      private: template<typename Handler>
-               void OnReadHeader(const boost::system::error_code &_e,
-                                 boost::tuple<Handler> _handler)
-              {
-                if (_e)
+                if (data.empty())
                 {
-                  if (_e.value() == boost::asio::error::eof)
-                    this->isOpen = false;
+                  gzerr << "Header is empty\n";
+                  _handler("");
                 }
-                else
+                else if (!transport::is_stopped())
                 {
-                  std::size_t inboundData_size = 0;
-                  std::string header(&this->inboundHeader[0],
-                                      this->inboundHeader.size());
-                  this->inboundHeader.clear();
-
-                  inboundData_size = this->ParseHeader(header);
+#if TBB_VERSION_MAJOR < 2021
+                  ConnectionReadTask *task = new(tbb::task::allocate_root())
+                        ConnectionReadTask(_handler, std::move(data));
+                  tbb::task::enqueue(*task);
 
-                 if (inboundData_size > 0)
-                  {
-                    // Start the asynchronous call to receive data
-                    this->inboundData.resize(inboundData_size);
-
-                    void (Connection::*f)(const boost::system::error_code &e,
-                        boost::tuple<Handler>) =
-                      &Connection::OnReadData<Handler>;
-
-                    boost::asio::async_read(*this->socket,
-                        boost::asio::buffer(this->inboundData),
-                        common::weakBind(f, this->shared_from_this(),
-                                    boost::asio::placeholders::error,
-                                    _handler));
-                  }
-                  else
-                  {
-                    gzerr << "Header is empty\n";
-                    boost::get<0>(_handler)("");
-                    // This code tries to read the header again. We should
-                    // never get here.
-                    // this->inboundHeader.resize(HEADER_LENGTH);
-
-                    // void (Connection::*f)(const boost::system::error_code &,
-                    // boost::tuple<Handler>) =
-                    // &Connection::OnReadHeader<Handler>;
-
-                    // boost::asio::async_read(*this->socket,
-                    //    boost::asio::buffer(this->inboundHeader),
-                    //    common::weakBind(f, this->shared_from_this(),
-                    //      boost::asio::placeholders::error, _handler));
-                  }
+                  // Non-tbb version:
+                  // _handler(data);
+#else
+                  this->taskGroup.run<ConnectionReadTask>(_handler,
+                      std::move(data));
+#endif
                 }
               }
 
-      /// \brief Handle a completed read of a message body.
+      /// \brief Handle a completed read of data from the socket.
       ///
       /// The handler is passed using a tuple since boost::bind seems to
       /// have trouble binding a function object created using boost::bind
       /// as a parameter
       /// \param[in] _e Error code, if any, associated with the read
+      /// \param[in] _size Number of bytes read
       /// \param[in] _handler Callback to invoke on received data
       private: template<typename Handler>
-               void OnReadData(const boost::system::error_code &_e,
-                              boost::tuple<Handler> _handler)
+               void OnReadSome(const boost::system::error_code &_e,
+                               std::size_t _size,
+                               boost::tuple<Handler> _handler)
               {
                 if (_e)
                 {
                   if (_e.value() == boost::asio::error::eof)
                     this->isOpen = false;
+                  return;
                 }
 
-                // Inform caller that data has been received
-                std::string data(&this->inboundData[0],
-                                  this->inboundData.size());
-                this->inboundData.clear();
-
-                if (data.empty())
-                  gzerr << "OnReadData got empty data!!!\n";
-
-                if (!_e && !transport::is_stopped())
                 {
-#if TBB_VERSION_MAJOR < 2021
-                  ConnectionReadTask *task = new(tbb::task::allocate_root())
-                        ConnectionReadTask(boost::get<0>(_handler), data);
-                  tbb::task::enqueue(*task);
-
-                  // Non-tbb version:
-                  // boost::get<0>(_handler)(data);
-#else
-                  this->taskGroup.run<ConnectionReadTask>(boost::get<0>(_handler), data);
-#endif
+                  boost::mutex::scoped_lock lock(this->socketMutex);
+                  this->inboundEnd += _size;
                 }
+
+                // Dispatch the message if it is complete, or read more
+                this->AsyncRead(boost::get<0>(_handler));
               }
 
       /// \brief Register a function to be called when the connection is shut
@@ -389,6 +445,13 @@ namespace gazebo
       /// \param[in] _header Header as a string
       private: std::size_t ParseHeader(const std::string &_header);
 
+      /// \brief Take the next complete message out of the inbound buffer.
+      /// If the buffer doesn't hold a complete message, make room at its
+      /// end for the rest of the message. The socketMutex must be locked.
+      /// \param[out] _data Content of the message.
+      /// \return True if a complete message was buffered.
+      private: bool PopInbound(std::string &_data);
+
       /// \brief the read thread
       private: void ReadLoop(const ReadCallback &_cb);
 
@@ -417,20 +480,54 @@ namespace gazebo
       /// \brief Accepts new connections.
       private: boost::asio::ip::tcp::acceptor *acceptor;
 
-      /// \brief Outgoing data queue
-      private: std::deque<std::string> writeQueue;
+      /// \brief Outgoing messages, not written yet.
+      private: std::deque<ConnectionWriteMsg> writeQueue;
+
+      /// \brief Messages being written.
+      private: std::vector<ConnectionWriteMsg> writeBatch;
+
+      /// \brief Headers and data of writeBatch, sent with a gather write.
+      private: std::vector<boost::asio::const_buffer> writeBuffers;
+
+      /// \brief Maximum number of messages in writeBatch.
+      private: std::size_t writeBatchMaxMsgs = 64;
+
+      /// \brief Maximum number of bytes in writeBatch.
+      private: std::size_t writeBatchMaxBytes = 4 * 1024 * 1024;
 
-      /// \brief List of callbacks, paired with writeQueue. The callbacks
-      /// are used to notify a publisher when a message is successfully sent.
-      private: std::deque< std::vector<
-               std::pair<boost::function<void(uint32_t)>, uint32_t> > >
-                 callbacks;
+      /// \brief Largest size of writeQueue.
+      private: std::size_t maxWriteQueueDepth = 0;
+
+      /// \brief Size in bytes of the messages in writeQueue.
+      private: std::size_t writeQueueBytes = 0;
+
+      /// \brief Maximum of writeQueueBytes.
+      private: std::size_t writeQueueLimit = 256 * 1024 * 1024;
+
+      /// \brief Number of messages dropped from writeQueue.
+      private: std::atomic<uint64_t> messagesDropped{0};
+
+      /// \brief Serializes the handlers of the connection, which are run
+      /// by the threads of the IOManager.
+      private: std::unique_ptr<boost::asio::io_service::strand> strand;
+
+      /// \brief Number of bytes written.
+      private: std::atomic<uint64_t> bytesWritten{0};
+
+      /// \brief Number of messages written.
+      private: std::atomic<uint64_t> messagesWritten{0};
+
+      /// \brief Number of bytes read.
+      private: std::atomic<uint64_t> bytesRead{0};
+
+      /// \brief Number of messages read.
+      private: std::atomic<uint64_t> messagesRead{0};
 
       /// \brief Mutex to protect new connections.
       private: boost::mutex connectMutex;
 
       /// \brief Mutex to protect write.
-      private: boost::recursive_mutex writeMutex;
+      private: mutable boost::recursive_mutex writeMutex;
 
       /// \brief Mutex to protect reads.
       private: boost::recursive_mutex readMutex;
@@ -444,11 +541,16 @@ namespace gazebo
       /// \brief Called when a new connection is received
       private: AcceptCallback acceptCB;
 
-      /// \brief Header data from a new message.
-      private: std::vector<char> inboundHeader;
+      /// \brief Data received on the socket and not dispatched yet. The
+      /// buffer is reused for every read, and only grows when a message
+      /// doesn't fit in it.
+      private: std::vector<char> inbound;
+
+      /// \brief Offset of the first byte not dispatched yet in inbound.
+      private: std::size_t inboundBegin = 0;
 
-      /// \brief Content data from a new message.
-      private: std::vector<char> inboundData;
+      /// \brief Offset of the end of the data received in inbound.
+      private: std::size_t inboundEnd = 0;
 
       /// \brief Set to true to stop reading on the connection.
       private: bool readQuit;
@@ -456,8 +558,9 @@ namespace gazebo
       /// \brief Integer id of the connection.
       private: unsigned int id;
 
-      /// \brief ID counter, used to create unique ids
-      private: static unsigned int idCounter;
+      /// \brief ID counter, used to create unique ids. Atomic because
+      /// connections are created by the threads of the IO manager.
+      private: static std::atomic<unsigned int> idCounter;
 
       /// \brief Created when a new connection is accepted.
       private: ConnectionPtr acceptConn;
@@ -14,6 +14,8 @@
  * limitations under the License.
  *
 */
+#include <vector>
+
 #include <boost/bind/bind.hpp>
 
 #include "gazebo/msgs/msgs.hh"
@@ -284,24 +286,33 @@ void ConnectionManager::RunUpdate()
   if (this->masterConn)
     this->masterConn->ProcessWriteQueue();
 
-  boost::recursive_mutex::scoped_lock lock(this->connectionMutex);
+  std::vector<ConnectionPtr> openConnections;
+  {
+    boost::recursive_mutex::scoped_lock lock(this->connectionMutex);
 
-  TopicManager::Instance()->ProcessNodes();
-  iter = this->connections.begin();
-  endIter = this->connections.end();
+    TopicManager::Instance()->ProcessNodes();
+    iter = this->connections.begin();
+    endIter = this->connections.end();
 
-  while (iter != endIter)
-  {
-    if ((*iter)->IsOpen())
-    {
-      (*iter)->ProcessWriteQueue();
-      ++iter;
-    }
-    else
+    while (iter != endIter)
     {
-      iter = this->connections.erase(iter);
+      if ((*iter)->IsOpen())
+      {
+        openConnections.push_back(*iter);
+        ++iter;
+      }
+      else
+      {
+        iter = this->connections.erase(iter);
+      }
     }
   }
+
+  // Start writing on the connections which are idle. The connections which
+  // are writing continue on their own, and are skipped. The connection list
+  // isn't locked, so new connections can be accepted meanwhile.
+  for (auto const &conn : openConnections)
+    conn->ProcessWriteQueue();
 }
 
 //////////////////////////////////////////////////
@@ -16,8 +16,14 @@
 */
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 #include <stdlib.h>
+#include <boost/make_shared.hpp>
 
 #include "gazebo/transport/Connection.hh"
 #include "test/util.hh"
@@ -64,6 +70,146 @@ TEST_F(Connection, IPWhiteList)
     setenv("GAZEBO_IP_WHITE_LIST", ipEnv, 1);
 }
 
+/////////////////////////////////////////////////
+TEST_F(Connection, WriteBatch)
+{
+  std::mutex mutex;
+  std::condition_variable cond;
+  transport::ConnectionPtr accepted;
+
+  transport::ConnectionPtr server(new transport::Connection());
+  server->Listen(0, [&](const transport::ConnectionPtr &_conn)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        accepted = _conn;
+        cond.notify_all();
+      });
+
+  transport::ConnectionPtr client(new transport::Connection());
+  ASSERT_TRUE(client->Connect(server->GetLocalAddress(),
+        server->GetLocalPort()));
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(cond.wait_for(lock, std::chrono::seconds(5),
+          [&]() { return accepted != nullptr; }));
+  }
+
+  // Queue large shared buffers and small copied ones
+  const unsigned int msgCount = 10;
+  boost::shared_ptr<const std::string> shared =
+    boost::make_shared<const std::string>(100000, 'a');
+  std::vector<std::string> expected;
+  uint64_t expectedBytes = 0;
+  unsigned int written = 0;
+  for (unsigned int i = 0; i < msgCount; ++i)
+  {
+    auto cb = [&](uint32_t _id)
+      {
+        EXPECT_EQ(_id, written);
+        ++written;
+      };
+    if (i % 2 == 0)
+    {
+      client->EnqueueMsg(shared, cb, i);
+      expected.push_back(*shared);
+    }
+    else
+    {
+      expected.push_back("message " + std::to_string(i));
+      client->EnqueueMsg(expected.back(), cb, i);
+    }
+    expectedBytes += HEADER_LENGTH + expected.back().size();
+  }
+  EXPECT_EQ(client->WriteQueueDepth(), msgCount);
+  EXPECT_EQ(client->MaxWriteQueueDepth(), msgCount);
+
+  std::vector<std::string> received;
+  std::thread reader([&]()
+      {
+        std::string data;
+        while (received.size() < msgCount && accepted->Read(data))
+          received.push_back(data);
+      });
+
+  // At most 4 messages per write
+  client->SetWriteBatchLimits(4, 1024 * 1024);
+  unsigned int writeCount = 0;
+  while (client->WriteQueueDepth() > 0)
+  {
+    client->ProcessWriteQueue(true);
+    ++writeCount;
+  }
+  reader.join();
+
+  EXPECT_EQ(writeCount, 3u);
+  EXPECT_EQ(written, msgCount);
+  EXPECT_EQ(received, expected);
+  EXPECT_EQ(client->MessagesWritten(), msgCount);
+  EXPECT_EQ(client->BytesWritten(), expectedBytes);
+  EXPECT_EQ(accepted->MessagesRead(), msgCount);
+  EXPECT_EQ(accepted->BytesRead(), expectedBytes);
+
+  client->Shutdown();
+  accepted->Shutdown();
+  server->Shutdown();
+}
+
+/////////////////////////////////////////////////
+TEST_F(Connection, SlowConsumer)
+{
+  std::mutex mutex;
+  std::condition_variable cond;
+  transport::ConnectionPtr accepted;
+
+  transport::ConnectionPtr server(new transport::Connection());
+  server->Listen(0, [&](const transport::ConnectionPtr &_conn)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        accepted = _conn;
+        cond.notify_all();
+      });
+
+  // The client never reads
+  transport::ConnectionPtr client(new transport::Connection());
+  ASSERT_TRUE(client->Connect(server->GetLocalAddress(),
+        server->GetLocalPort()));
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(cond.wait_for(lock, std::chrono::seconds(5),
+          [&]() { return accepted != nullptr; }));
+  }
+
+  const std::size_t limit = 8 * 1024 * 1024;
+  accepted->SetWriteQueueLimit(limit);
+  EXPECT_EQ(accepted->WriteQueueLimit(), limit);
+
+  // Queue many more messages than the socket and the queue can hold
+  const unsigned int msgCount = 64;
+  const std::size_t msgSize = 1024 * 1024;
+  boost::shared_ptr<const std::string> data =
+    boost::make_shared<const std::string>(msgSize, 'a');
+  std::atomic<unsigned int> callbacks(0);
+  for (unsigned int i = 0; i < msgCount; ++i)
+  {
+    accepted->EnqueueMsg(data, [&](uint32_t) { ++callbacks; }, i, true);
+
+    // The queue never grows past its limit
+    EXPECT_LE(accepted->WriteQueueDepth() * (msgSize + HEADER_LENGTH),
+        limit + msgSize + HEADER_LENGTH);
+  }
+
+  // Old messages were dropped, and their callbacks were still called
+  EXPECT_GT(accepted->MessagesDropped(), 0u);
+  EXPECT_LE(accepted->MaxWriteQueueDepth(), limit / msgSize + 1);
+  EXPECT_GE(callbacks, accepted->MessagesDropped());
+  EXPECT_LT(accepted->MessagesWritten(), msgCount);
+
+  client->Shutdown();
+  accepted->Shutdown();
+  server->Shutdown();
+}
+
+/////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
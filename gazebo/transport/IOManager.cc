@@ -14,10 +14,15 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
 #include <atomic>
+#include <cstdlib>
+#include <string>
+#include <thread>
 #include <boost/bind/bind.hpp>
 #include <boost/thread/thread.hpp>
 #include <iostream>
+#include "gazebo/common/Console.hh"
 #include "gazebo/transport/IOManager.hh"
 
 namespace gazebo
@@ -36,20 +41,71 @@ class IOManagerPrivate
   /// \brief Reference count of connections using this IOManager.
   public: std::atomic_int count;
 
-  /// \brief Thread for IOManager.
-  public: boost::thread *thread = nullptr;
+  /// \brief Threads running the IO service.
+  public: boost::thread_group threads;
+
+  /// \brief Number of threads.
+  public: unsigned int threadCount = 1;
 };
 
+/////////////////////////////////////////////////
+/// \brief Maximum number of IO threads.
+static const unsigned int kMaxThreadCount = 64;
+
+/////////////////////////////////////////////////
+/// \brief Get the default number of IO threads.
+/// \return GAZEBO_TRANSPORT_IO_THREADS if set, otherwise the number of
+/// cores, up to 4. The result is between 1 and kMaxThreadCount.
+static unsigned int defaultThreadCount()
+{
+  const char *threadsEnv = std::getenv("GAZEBO_TRANSPORT_IO_THREADS");
+  if (threadsEnv)
+  {
+    try
+    {
+      // Parse as signed so that negative values are rejected instead of
+      // wrapping around
+      const long long threads = std::stoll(threadsEnv);
+      if (threads >= 1 && threads <= kMaxThreadCount)
+        return static_cast<unsigned int>(threads);
+
+      gzwarn << "GAZEBO_TRANSPORT_IO_THREADS [" << threadsEnv
+             << "] is out of range, it must be between 1 and "
+             << kMaxThreadCount << "\n";
+      return threads < 1 ? 1u : kMaxThreadCount;
+    }
+    catch(...)
+    {
+      gzerr << "Invalid GAZEBO_TRANSPORT_IO_THREADS [" << threadsEnv
+            << "]\n";
+    }
+  }
+
+  // hardware_concurrency returns 0 if the number of cores is unknown
+  return std::max(1u, std::min(4u, std::thread::hardware_concurrency()));
+}
+
 /////////////////////////////////////////////////
 IOManager::IOManager()
+  : IOManager(defaultThreadCount())
+{
+}
+
+/////////////////////////////////////////////////
+IOManager::IOManager(const unsigned int _threads)
   : dataPtr(new IOManagerPrivate)
 {
   this->dataPtr->io_service = new boost::asio::io_service;
   this->dataPtr->work = new boost::asio::io_service::work(
       *this->dataPtr->io_service);
   this->dataPtr->count = 0;
-  this->dataPtr->thread = new boost::thread(boost::bind(
-      &boost::asio::io_service::run, this->dataPtr->io_service));
+  this->dataPtr->threadCount =
+      std::min(std::max(1u, _threads), kMaxThreadCount);
+  for (unsigned int i = 0; i < this->dataPtr->threadCount; ++i)
+  {
+    this->dataPtr->threads.create_thread(boost::bind(
+        &boost::asio::io_service::run, this->dataPtr->io_service));
+  }
 }
 
 /////////////////////////////////////////////////
@@ -72,12 +128,7 @@ void IOManager::Stop()
 {
   this->dataPtr->io_service->reset();
   this->dataPtr->io_service->stop();
-  if (this->dataPtr->thread)
-  {
-    this->dataPtr->thread->join();
-    delete this->dataPtr->thread;
-    this->dataPtr->thread = nullptr;
-  }
+  this->dataPtr->threads.join_all();
 }
 
 /////////////////////////////////////////////////
@@ -103,5 +154,11 @@ unsigned int IOManager::GetCount() const
 {
   return this->dataPtr->count;
 }
+
+/////////////////////////////////////////////////
+unsigned int IOManager::ThreadCount() const
+{
+  return this->dataPtr->threadCount;
+}
 }
 }
@@ -32,11 +32,23 @@ namespace gazebo
 
     /// \class IOManager IOManager.hh transport/transport.hh
     /// \brief Manages boost::asio IO
+    ///
+    /// The IO service is run by a pool of threads, so that the connections
+    /// are served concurrently. Each connection runs its handlers through
+    /// its own strand, so the handlers of a connection never run
+    /// concurrently.
     class GZ_TRANSPORT_VISIBLE IOManager
     {
-      /// \brief Constructor
+      /// \brief Constructor. The number of threads is read from the
+      /// GAZEBO_TRANSPORT_IO_THREADS environment variable. If it is not
+      /// set, one thread per core is used, up to 4.
       public: IOManager();
 
+      /// \brief Constructor
+      /// \param[in] _threads Number of threads running the IO service,
+      /// clamped between 1 and 64.
+      public: explicit IOManager(const unsigned int _threads);
+
       /// \brief Destructor
       public: ~IOManager();
 
@@ -54,6 +66,10 @@ namespace gazebo
       /// \return The event count
       public: unsigned int GetCount() const;
 
+      /// \brief Get the number of threads running the IO service.
+      /// \return Number of threads.
+      public: unsigned int ThreadCount() const;
+
       /// \brief Stop the IO service
       public: void Stop();
 
@@ -17,7 +17,9 @@
 
 #include <boost/bind/bind.hpp>
 #include <boost/function.hpp>
+#include <boost/make_shared.hpp>
 #include "gazebo/common/WeakBind.hh"
+#include "gazebo/msgs/MsgFactory.hh"
 #include "SubscriptionTransport.hh"
 #include "Publication.hh"
 #include "Node.hh"
@@ -253,11 +255,29 @@ void Publication::LocalPublish(const std::string &_data)
   {
     boost::mutex::scoped_lock lock(this->nodeMutex);
 
+    // Parse the incoming data once and share the message with every local
+    // node, rather than having each node callback parse its own copy. Nodes
+    // with raw subscribers, and message types unknown to the factory, still
+    // receive the serialized data.
+    MessagePtr msg;
+    if (!this->nodes.empty())
+    {
+      msg = msgs::MsgFactory::NewMsg(this->msgType);
+      if (msg && !msg->ParseFromString(_data))
+        msg.reset();
+    }
+
     iter = this->nodes.begin();
     endIter = this->nodes.end();
     while (iter != endIter)
     {
-      if ((*iter)->HandleData(this->topic, _data))
+      bool handled;
+      if (msg && (*iter)->GetMsgType(this->topic) != "raw")
+        handled = (*iter)->HandleMessage(this->topic, msg);
+      else
+        handled = (*iter)->HandleData(this->topic, _data);
+
+      if (handled)
         ++iter;
       else
         this->nodes.erase(iter++);
@@ -321,14 +341,33 @@ int Publication::Publish(MessagePtr _msg, boost::function<void(uint32_t)> _cb,
 
     if (!this->callbacks.empty())
     {
-      std::string data;
-      _msg->SerializeToString(&data);
+      // Only serialize the message if it has to go over the wire. Local
+      // callbacks share the message itself, and remote ones share the
+      // serialized data.
+      boost::shared_ptr<std::string> data;
       std::list<CallbackHelperPtr>::iterator cbIter;
       cbIter = this->callbacks.begin();
 
       while (cbIter != this->callbacks.end())
       {
-        if ((*cbIter)->HandleData(data, _cb, _id))
+        bool handled;
+        if ((*cbIter)->IsLocal())
+        {
+          handled = (*cbIter)->HandleMessage(_msg);
+          if (handled && !_cb.empty())
+            _cb(_id);
+        }
+        else
+        {
+          if (!data)
+          {
+            data = boost::make_shared<std::string>();
+            _msg->SerializeToString(data.get());
+          }
+          handled = (*cbIter)->HandleSharedData(data, _cb, _id);
+        }
+
+        if (handled)
         {
           ++result;
           ++cbIter;
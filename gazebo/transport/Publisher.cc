@@ -85,6 +85,37 @@ bool Publisher::WaitForConnection(const common::Time &_timeout) const
 //////////////////////////////////////////////////
 void Publisher::PublishImpl(const google::protobuf::Message &_message,
                             bool _block)
+{
+  if (!this->AcceptMessage(_message))
+    return;
+
+  // Save the latest message
+  MessagePtr msgPtr(_message.New());
+  msgPtr->CopyFrom(_message);
+
+  this->Enqueue(msgPtr, _block);
+}
+
+//////////////////////////////////////////////////
+void Publisher::PublishImpl(const ConstMessagePtr &_message, bool _block)
+{
+  if (!_message)
+  {
+    gzerr << "Publishing a null message on topic[" << this->topic << "]\n";
+    return;
+  }
+
+  if (!this->AcceptMessage(*_message))
+    return;
+
+  // The transport never modifies queued messages, so the caller's instance
+  // is shared with local subscribers instead of being copied.
+  this->Enqueue(boost::const_pointer_cast<google::protobuf::Message>(
+        _message), _block);
+}
+
+//////////////////////////////////////////////////
+bool Publisher::AcceptMessage(const google::protobuf::Message &_message)
 {
   if (_message.GetTypeName() != this->msgType)
     gzthrow("Invalid message type\n");
@@ -94,7 +125,7 @@ void Publisher::PublishImpl(const google::protobuf::Message &_message,
     gzerr << "Publishing an uninitialized message on topic[" <<
       this->topic << "]. Required field [" <<
       _message.InitializationErrorString() << "] missing.\n";
-    return;
+    return false;
   }
 
   // Check if a throttling rate has been set
@@ -108,23 +139,25 @@ void Publisher::PublishImpl(const google::protobuf::Message &_message,
         (this->currentTime - this->prevPublishTime).Double() <
         this->updatePeriod)
     {
-      return;
+      return false;
     }
 
     // Set the previous time a message was published
     this->prevPublishTime = this->currentTime;
   }
 
-  // Save the latest message
-  MessagePtr msgPtr(_message.New());
-  msgPtr->CopyFrom(_message);
+  return true;
+}
 
-  this->publication->SetPrevMsg(this->id, msgPtr);
+//////////////////////////////////////////////////
+void Publisher::Enqueue(const MessagePtr &_msgPtr, bool _block)
+{
+  this->publication->SetPrevMsg(this->id, _msgPtr);
 
   {
     boost::mutex::scoped_lock lock(this->mutex);
 
-    this->messages.push_back(msgPtr);
+    this->messages.push_back(_msgPtr);
 
     if (this->messages.size() > this->queueLimit)
     {
@@ -101,6 +101,28 @@ namespace gazebo
               void Publish(M _message, bool _block = false)
               { this->PublishImpl(_message, _block); }
 
+      /// \brief Publish a shared message on the topic without copying it.
+      /// Subscribers in this process receive this exact instance, and the
+      /// message is only serialized for remote subscribers. The message
+      /// must not be modified after it has been published.
+      /// \param[in] _message Message to be published
+      /// \param[in] _block Whether to block until the message is actually
+      /// written into the local message buffer, and SendMessage() is called.
+      public: template<typename M>
+              void Publish(const boost::shared_ptr<M const> &_message,
+                           bool _block = false)
+              { this->PublishImpl(ConstMessagePtr(_message), _block); }
+
+      /// \brief Publish a shared message on the topic without copying it.
+      /// \param[in] _message Message to be published
+      /// \param[in] _block Whether to block until the message is actually
+      /// written into the local message buffer, and SendMessage() is called.
+      /// \sa Publish(const boost::shared_ptr<M const> &, bool)
+      public: template<typename M>
+              void Publish(const boost::shared_ptr<M> &_message,
+                           bool _block = false)
+              { this->PublishImpl(ConstMessagePtr(_message), _block); }
+
       /// \brief Get the number of outgoing messages
       /// \return The number of outgoing messages
       public: unsigned int GetOutgoingCount() const;
@@ -147,6 +169,25 @@ namespace gazebo
       private: void PublishImpl(const google::protobuf::Message &_message,
                                 bool _block);
 
+      /// \brief Implementation of Publish for shared messages.
+      /// \param[in] _message Message to be published.
+      /// \param[in] _block Whether to block until the message is actually
+      /// written out.
+      private: void PublishImpl(const ConstMessagePtr &_message, bool _block);
+
+      /// \brief Check that a message can be published now. This validates
+      /// the message and applies the publisher's rate limit.
+      /// \param[in] _message Message to be published.
+      /// \return True if the message should be published.
+      private: bool AcceptMessage(const google::protobuf::Message &_message);
+
+      /// \brief Queue a message for publication.
+      /// \param[in] _msgPtr Message to queue. It must not be modified
+      /// afterwards.
+      /// \param[in] _block Whether to block until the message is actually
+      /// written out.
+      private: void Enqueue(const MessagePtr &_msgPtr, bool _block);
+
       /// \brief Callback when a publish is completed
       /// \param[in] _id ID associated with the publication.
       private: void OnPublishComplete(uint32_t _id);
@@ -68,6 +68,23 @@ bool SubscriptionTransport::HandleData(const std::string &_newdata,
   return result;
 }
 
+//////////////////////////////////////////////////
+bool SubscriptionTransport::HandleSharedData(
+    const boost::shared_ptr<const std::string> &_newdata,
+    boost::function<void(uint32_t)> _cb, uint32_t _id)
+{
+  bool result = false;
+  if (this->connection->IsOpen())
+  {
+    this->connection->EnqueueMsg(_newdata, _cb, _id);
+    result = true;
+  }
+  else
+    this->connection.reset();
+
+  return result;
+}
+
 //////////////////////////////////////////////////
 const ConnectionPtr &SubscriptionTransport::GetConnection() const
 {
@@ -59,6 +59,16 @@ namespace gazebo
       public: virtual bool HandleData(const std::string &_newdata,
                   boost::function<void(uint32_t)> _cb, uint32_t _id);
 
+      /// \brief Output a message to a connection, without copying it.
+      /// \param[in] _newdata The message to be handled
+      /// \return true if the message was handled successfully, false otherwise
+      /// \param[in] _cb If non-null, callback to be invoked after
+      /// transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      public: virtual bool HandleSharedData(
+                  const boost::shared_ptr<const std::string> &_newdata,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id);
+
       // Documentation inherited
       public: virtual bool HandleMessage(MessagePtr _newMsg);
 
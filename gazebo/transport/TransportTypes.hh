@@ -44,6 +44,10 @@ namespace gazebo
     /// \brief Shared_ptr to protobuf message
     typedef boost::shared_ptr<google::protobuf::Message> MessagePtr;
 
+    /// \def ConstMessagePtr
+    /// \brief Shared_ptr to an immutable protobuf message
+    typedef boost::shared_ptr<google::protobuf::Message const> ConstMessagePtr;
+
     /// \def PublisherPtr
     /// \brief Shared_ptr to Publisher object
     typedef boost::shared_ptr<Publisher> PublisherPtr;
@@ -15,6 +15,9 @@
  *
 */
 
+#include <mutex>
+
+#include "gazebo/common/CommonIface.hh"
 #include "gazebo/util/IgnMsgSdf.hh"
 
 namespace gazebo
@@ -44,7 +47,10 @@ namespace gazebo
       tmp += _msg.innerxml();
       tmp += "</plugin></sdf>";
 
-      sdf::readString(tmp, pluginSDF);
+      {
+        std::lock_guard<std::mutex> lock(common::sdfParseMutex());
+        sdf::readString(tmp, pluginSDF);
+      }
 
       return pluginSDF;
     }
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef _GAZEBO_UTIL_LOGFORMAT_PRIVATE_HH_
+#define _GAZEBO_UTIL_LOGFORMAT_PRIVATE_HH_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace gazebo
+{
+  namespace util
+  {
+    /// \internal
+    /// \brief Layout of log files recorded with the "binary" encoding.
+    ///
+    /// A binary log starts with kBinaryLogMagic, followed by a uint32 byte
+    /// count and the XML <gazebo_log><header> block used by text logs.
+    /// Each chunk is then stored as a BinaryLogChunkHeader followed by the
+    /// zlib compressed chunk. When recording stops, an index with one
+    /// BinaryLogIndexEntry per chunk is written, followed by a
+    /// BinaryLogTrailer. All values are stored in host byte order.
+    namespace binarylog
+    {
+      /// \brief Magic bytes at the start of a binary log file.
+      static const char kMagic[] = "GZLOGBIN";
+
+      /// \brief Magic bytes at the end of a binary log file that was
+      /// closed cleanly.
+      static const char kIndexMagic[] = "GZLOGIDX";
+
+      /// \brief Number of magic bytes.
+      static const size_t kMagicSize = 8u;
+
+      /// \brief The trailer has a valid log start time.
+      static const uint32_t kHasStartTime = 0x1;
+
+      /// \brief The trailer has a valid log end time.
+      static const uint32_t kHasEndTime = 0x2;
+
+      /// \brief The trailer has a valid initial iteration count.
+      static const uint32_t kHasIterations = 0x4;
+
+      /// \brief Header preceding every compressed chunk.
+      class ChunkHeader
+      {
+        /// \brief Size of the compressed chunk in bytes.
+        public: uint32_t compressedSize = 0;
+
+        /// \brief Size of the uncompressed chunk in bytes.
+        public: uint32_t size = 0;
+
+        /// \brief Seconds of the first <sim_time> in the chunk.
+        public: int32_t sec = 0;
+
+        /// \brief Nanoseconds of the first <sim_time> in the chunk.
+        public: int32_t nsec = 0;
+      };
+
+      /// \brief Entry of the chunk index.
+      class IndexEntry
+      {
+        /// \brief File offset of the chunk header.
+        public: uint64_t offset = 0;
+
+        /// \brief Seconds of the first <sim_time> in the chunk.
+        public: int32_t sec = 0;
+
+        /// \brief Nanoseconds of the first <sim_time> in the chunk.
+        public: int32_t nsec = 0;
+      };
+
+      /// \brief Fixed size block at the very end of the file.
+      class Trailer
+      {
+        /// \brief File offset of the first index entry.
+        public: uint64_t indexOffset = 0;
+
+        /// \brief Number of chunks, and index entries.
+        public: uint64_t chunkCount = 0;
+
+        /// \brief Seconds of the first <sim_time> in the log.
+        public: int32_t startSec = 0;
+
+        /// \brief Nanoseconds of the first <sim_time> in the log.
+        public: int32_t startNsec = 0;
+
+        /// \brief Seconds of the last <sim_time> in the log.
+        public: int32_t endSec = 0;
+
+        /// \brief Nanoseconds of the last <sim_time> in the log.
+        public: int32_t endNsec = 0;
+
+        /// \brief First <iterations> value in the log.
+        public: uint64_t initialIterations = 0;
+
+        /// \brief Combination of kHasStartTime, kHasEndTime and
+        /// kHasIterations.
+        public: uint32_t flags = 0;
+
+        /// \brief Unused, keeps the magic bytes 8 byte aligned.
+        public: uint32_t reserved = 0;
+
+        /// \brief Must be kIndexMagic.
+        public: char magic[kMagicSize] = {0};
+      };
+
+      static_assert(sizeof(ChunkHeader) == 16, "Unexpected chunk header size");
+      static_assert(sizeof(IndexEntry) == 16, "Unexpected index entry size");
+      static_assert(sizeof(Trailer) == 56, "Unexpected trailer size");
+
+      /// \brief Append the raw bytes of a value to a buffer.
+      /// \param[in] _value Value to append.
+      /// \param[out] _buffer Buffer to append to.
+      template<typename T>
+      void Append(const T &_value, std::string &_buffer)
+      {
+        _buffer.append(reinterpret_cast<const char *>(&_value), sizeof(T));
+      }
+
+      /// \brief Read a value from a possibly unaligned memory location.
+      /// \param[in] _data Pointer to the raw bytes of the value.
+      /// \return The value.
+      template<typename T>
+      T Read(const char *_data)
+      {
+        T value;
+        std::memcpy(&value, _data, sizeof(T));
+        return value;
+      }
+    }
+  }
+}
+#endif
@@ -23,6 +23,8 @@
 #endif
 
 #include <algorithm>
+#include <cstring>
+#include <fstream>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/iostreams/filter/bzip2.hpp>
@@ -72,6 +74,13 @@ void LogPlay::Open(const std::string &_logFile)
   if (boost::filesystem::is_directory(path))
     gzthrow("Invalid logfile [" + _logFile + "]. This is a directory.");
 
+  this->dataPtr->CloseBinary();
+  if (LogPlayPrivate::IsBinary(_logFile))
+  {
+    this->OpenBinary(_logFile);
+    return;
+  }
+
   // Flag use to indicate if a parser failure has occurred
   bool xmlParserFail = this->dataPtr->xmlDoc.LoadFile(_logFile.c_str()) !=
     tinyxml2::XML_SUCCESS;
@@ -172,6 +181,57 @@ void LogPlay::Open(const std::string &_logFile)
   this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
 }
 
+/////////////////////////////////////////////////
+void LogPlay::OpenBinary(const std::string &_logFile)
+{
+  this->dataPtr->OpenBinary(_logFile);
+
+  this->dataPtr->logStartXml =
+    this->dataPtr->xmlDoc.FirstChildElement("gazebo_log");
+
+  if (!this->dataPtr->logStartXml)
+    gzthrow("Log file is missing the <gazebo_log> element");
+
+  this->dataPtr->filename = _logFile;
+
+  this->ReadHeader();
+
+  this->dataPtr->encoding.clear();
+
+  // A cleanly closed log stores its times in the trailer, so no chunk
+  // needs to be decompressed.
+  const binarylog::Trailer &trailer = this->dataPtr->trailer;
+  if (trailer.flags & binarylog::kHasStartTime)
+  {
+    this->dataPtr->logStartTime.Set(trailer.startSec, trailer.startNsec);
+  }
+  if (trailer.flags & binarylog::kHasEndTime)
+  {
+    this->dataPtr->logEndTime.Set(trailer.endSec, trailer.endNsec);
+  }
+  if (trailer.flags & binarylog::kHasIterations)
+  {
+    this->dataPtr->initialIterations = trailer.initialIterations;
+    this->dataPtr->iterationsFound = true;
+  }
+
+  if (!(trailer.flags & (binarylog::kHasStartTime | binarylog::kHasEndTime)))
+    this->ReadLogTimes();
+
+  if (!(trailer.flags & binarylog::kHasIterations))
+    this->dataPtr->iterationsFound = this->ReadIterations();
+
+  if (this->dataPtr->binaryChunkCount == 0)
+    gzthrow("Unable to find the first chunk");
+
+  this->dataPtr->binaryChunk = 0;
+  if (!this->dataPtr->BinaryChunkData(0, this->dataPtr->currentChunk))
+    gzthrow("Unable to decode log file");
+
+  this->dataPtr->start = 0;
+  this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
+}
+
 /////////////////////////////////////////////////
 std::string LogPlay::Header() const
 {
@@ -261,23 +321,18 @@ void LogPlay::ReadLogTimes()
   std::string chunk;
   bool found = false;
 
-  auto chunkXml = this->dataPtr->logStartXml->FirstChildElement("chunk");
-
   // Try to read the start time of the log.
   auto numChunksToTry =
     std::min(this->ChunkCount(), this->dataPtr->kNumChunksToTry);
 
   for (unsigned int i = 0; i < numChunksToTry; ++i)
   {
-    if (!chunkXml)
+    if (!this->Chunk(i, chunk))
     {
       gzerr << "Unable to find the first chunk" << std::endl;
       return;
     }
 
-    if (!this->dataPtr->ChunkData(chunkXml, chunk))
-      return;
-
     // Find the first <sim_time> of the log.
     auto from = chunk.find(this->dataPtr->kStartTime);
     auto to = chunk.find(this->dataPtr->kEndTime,
@@ -292,24 +347,19 @@ void LogPlay::ReadLogTimes()
       found = true;
       break;
     }
-
-    chunkXml = chunkXml->NextSiblingElement("chunk");
   }
 
   if (!found)
     gzwarn << "Unable to find <sim_time> tags in any chunk." << std::endl;
 
   // Jump to the last chunk for finding the last <sim_time>.
-  auto lastChunk = this->dataPtr->logStartXml->LastChildElement("chunk");
-  if (!lastChunk)
+  auto chunkCount = this->ChunkCount();
+  if (chunkCount == 0 || !this->Chunk(chunkCount - 1, chunk))
   {
     gzerr << "Unable to jump to the last chunk of the log file\n";
     return;
   }
 
-  if (!this->dataPtr->ChunkData(lastChunk, chunk))
-    return;
-
   // Update the last <sim_time> of the log.
   auto to = chunk.rfind(this->dataPtr->kEndTime);
   auto from = chunk.rfind(this->dataPtr->kStartTime, to - 1);
@@ -336,24 +386,19 @@ bool LogPlay::ReadIterations()
   const std::string kStartDelim = "<iterations>";
   const std::string kEndDelim = "</iterations>";
 
-  auto chunkXml = this->dataPtr->logStartXml->FirstChildElement("chunk");
-
   // Read the first "iterations" value of the log from the first chunk.
   auto numChunksToTry =
     std::min(this->ChunkCount(), this->dataPtr->kNumChunksToTry);
 
   for (unsigned int i = 0; i < numChunksToTry; ++i)
   {
-    if (!chunkXml)
+    std::string chunk;
+    if (!this->Chunk(i, chunk))
     {
       gzerr << "Unable to find the first chunk" << std::endl;
       return false;
     }
 
-    std::string chunk;
-    if (!this->dataPtr->ChunkData(chunkXml, chunk))
-      return false;
-
     // Find the first <iterations> of the log.
     auto from = chunk.find(kStartDelim);
     auto to = chunk.find(kEndDelim, from + kStartDelim.size());
@@ -365,8 +410,6 @@ bool LogPlay::ReadIterations()
       ss >> this->dataPtr->initialIterations;
       return true;
     }
-
-    chunkXml = chunkXml->NextSiblingElement("chunk");
   }
 
   gzwarn << "Unable to find <iterations>...</iterations> tags in the first "
@@ -536,19 +579,29 @@ bool LogPlay::Rewind()
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   this->dataPtr->currentChunk.clear();
-  this->dataPtr->logCurrXml =
-    this->dataPtr->logStartXml->FirstChildElement("chunk");
 
-  if (!this->dataPtr->logCurrXml)
+  if (this->dataPtr->binary)
   {
-    gzerr << "Unable to jump to the beginning of the log file\n";
-    return false;
+    this->dataPtr->binaryChunk = 0;
+    if (!this->dataPtr->BinaryChunkData(0, this->dataPtr->currentChunk))
+      return false;
   }
-
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
-                                this->dataPtr->currentChunk))
+  else
   {
-    return false;
+    this->dataPtr->logCurrXml =
+      this->dataPtr->logStartXml->FirstChildElement("chunk");
+
+    if (!this->dataPtr->logCurrXml)
+    {
+      gzerr << "Unable to jump to the beginning of the log file\n";
+      return false;
+    }
+
+    if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
+                                  this->dataPtr->currentChunk))
+    {
+      return false;
+    }
   }
 
   // Skip first <sdf> block (it doesn't have a world state).
@@ -575,20 +628,32 @@ bool LogPlay::Forward()
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-  // Get the last chunk.
-  this->dataPtr->logCurrXml =
-    this->dataPtr->logStartXml->LastChildElement("chunk");
-
-  if (!this->dataPtr->logCurrXml)
+  if (this->dataPtr->binary)
   {
-    gzerr << "Unable to jump to the end of the log file\n";
-    return false;
+    this->dataPtr->binaryChunk = this->dataPtr->binaryChunkCount - 1;
+    if (!this->dataPtr->BinaryChunkData(this->dataPtr->binaryChunk,
+                                        this->dataPtr->currentChunk))
+    {
+      return false;
+    }
   }
-
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
-                                this->dataPtr->currentChunk))
+  else
   {
-    return false;
+    // Get the last chunk.
+    this->dataPtr->logCurrXml =
+      this->dataPtr->logStartXml->LastChildElement("chunk");
+
+    if (!this->dataPtr->logCurrXml)
+    {
+      gzerr << "Unable to jump to the end of the log file\n";
+      return false;
+    }
+
+    if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
+                                  this->dataPtr->currentChunk))
+    {
+      return false;
+    }
   }
 
   this->dataPtr->start = this->dataPtr->currentChunk.size() - 1;
@@ -611,7 +676,61 @@ bool LogPlay::Seek(const common::Time &_time)
   common::Time logTime = this->dataPtr->logStartTime;
 
   // 1st step: Locate the chunk: We're looking for the first chunk that has
-  // a time greater than the target time.
+  // a time greater than the target time. Binary logs have an index of chunk
+  // times, so the chunk can be looked up directly.
+  if (this->dataPtr->binary)
+  {
+    uint64_t next = this->dataPtr->BinaryChunkAfter(_time);
+    if (next >= this->dataPtr->binaryChunkCount)
+    {
+      this->Forward();
+    }
+    else
+    {
+      if (!this->Chunk(next, this->dataPtr->currentChunk))
+        return false;
+      this->dataPtr->start = 0;
+      this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
+    }
+  }
+  else if (!this->SeekChunk(_time))
+  {
+    return false;
+  }
+
+  // 2nd step: Locate the frame in the previous chunk.
+  while (true)
+  {
+    std::string frame;
+    if (!this->StepBack(frame))
+      break;
+
+    // Search the <sim_time> in the frame of the current chunk.
+    auto from = frame.find(this->dataPtr->kStartTime);
+    auto to = frame.find(
+        this->dataPtr->kEndTime, from + this->dataPtr->kStartTime.size());
+    if (from != std::string::npos && to != std::string::npos)
+    {
+      auto length = to - from - this->dataPtr->kStartTime.size();
+      auto logTimeStr = frame.substr(
+          from + this->dataPtr->kStartTime.size(), length);
+      std::stringstream ss(logTimeStr);
+      ss >> logTime;
+
+      // frame found.
+      if (logTime < _time)
+        break;
+    }
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool LogPlay::SeekChunk(const common::Time &_time)
+{
+  common::Time logTime = this->dataPtr->logStartTime;
+
   int64_t imin = 0;
   int64_t imax = this->ChunkCount() - 1;
   while (imin <= imax)
@@ -659,37 +778,21 @@ bool LogPlay::Seek(const common::Time &_time)
       this->Forward();
   }
 
-  // 2nd step: Locate the frame in the previous chunk.
-  while (true)
-  {
-    std::string frame;
-    if (!this->StepBack(frame))
-      break;
-
-    // Search the <sim_time> in the frame of the current chunk.
-    auto from = frame.find(this->dataPtr->kStartTime);
-    auto to = frame.find(
-        this->dataPtr->kEndTime, from + this->dataPtr->kStartTime.size());
-    if (from != std::string::npos && to != std::string::npos)
-    {
-      auto length = to - from - this->dataPtr->kStartTime.size();
-      auto logTimeStr = frame.substr(
-          from + this->dataPtr->kStartTime.size(), length);
-      std::stringstream ss(logTimeStr);
-      ss >> logTime;
-
-      // frame found.
-      if (logTime < _time)
-        break;
-    }
-  }
-
   return true;
 }
 
 /////////////////////////////////////////////////
 bool LogPlay::Chunk(unsigned int _index, std::string &_data) const
 {
+  if (this->dataPtr->binary)
+  {
+    if (_index >= this->dataPtr->binaryChunkCount)
+      return false;
+
+    this->dataPtr->binaryChunk = _index;
+    return this->dataPtr->BinaryChunkData(_index, _data);
+  }
+
   unsigned int count = 0;
   this->dataPtr->logCurrXml =
     this->dataPtr->logStartXml->FirstChildElement("chunk");
@@ -778,6 +881,213 @@ bool LogPlayPrivate::ChunkData(
   return true;
 }
 
+/////////////////////////////////////////////////
+bool LogPlayPrivate::IsBinary(const std::string &_logFile)
+{
+  std::ifstream inFile(_logFile, std::ios::binary);
+  char magic[binarylog::kMagicSize];
+  if (!inFile.read(magic, binarylog::kMagicSize))
+    return false;
+
+  return std::memcmp(magic, binarylog::kMagic, binarylog::kMagicSize) == 0;
+}
+
+/////////////////////////////////////////////////
+void LogPlayPrivate::OpenBinary(const std::string &_logFile)
+{
+  this->logStartXml = nullptr;
+
+  try
+  {
+    this->mappedFile.open(_logFile);
+  }
+  catch(std::exception &_e)
+  {
+    gzthrow("Unable to map log file[" + _logFile + "]: " + _e.what());
+  }
+
+  const char *data = this->mappedFile.data();
+  const size_t size = this->mappedFile.size();
+  const size_t headerOffset = binarylog::kMagicSize + sizeof(uint32_t);
+
+  if (size < headerOffset)
+    gzthrow("Log file[" + _logFile + "] is truncated");
+
+  const uint32_t headerSize = binarylog::Read<uint32_t>(
+      data + binarylog::kMagicSize);
+  if (size - headerOffset < headerSize)
+    gzthrow("Log file[" + _logFile + "] has a truncated header");
+
+  if (this->xmlDoc.Parse(data + headerOffset, headerSize) !=
+      tinyxml2::XML_SUCCESS)
+  {
+    gzthrow("Error parsing the header of log file[" + _logFile + "]");
+  }
+
+  this->binary = true;
+  this->trailer = binarylog::Trailer();
+
+  // Use the index written when the recording stopped, if it is intact.
+  const size_t chunksOffset = headerOffset + headerSize;
+  if (size - chunksOffset >= sizeof(binarylog::Trailer))
+  {
+    binarylog::Trailer fileTrailer = binarylog::Read<binarylog::Trailer>(
+        data + size - sizeof(binarylog::Trailer));
+
+    const uint64_t indexSize =
+      fileTrailer.chunkCount * sizeof(binarylog::IndexEntry);
+    if (std::memcmp(fileTrailer.magic, binarylog::kIndexMagic,
+          binarylog::kMagicSize) == 0 &&
+        fileTrailer.indexOffset >= chunksOffset &&
+        fileTrailer.indexOffset + indexSize + sizeof(binarylog::Trailer) ==
+        size)
+    {
+      this->trailer = fileTrailer;
+      this->binaryIndex = data + fileTrailer.indexOffset;
+      this->binaryChunkCount = fileTrailer.chunkCount;
+      return;
+    }
+  }
+
+  gzwarn << "Log file[" << _logFile << "] has no chunk index, probably "
+         << "because the recording was interrupted. Rebuilding the index.\n";
+  this->RebuildBinaryIndex();
+}
+
+/////////////////////////////////////////////////
+void LogPlayPrivate::CloseBinary()
+{
+  if (this->mappedFile.is_open())
+    this->mappedFile.close();
+
+  this->binary = false;
+  this->binaryIndex = nullptr;
+  this->rebuiltIndex.clear();
+  this->binaryChunkCount = 0;
+  this->binaryChunk = 0;
+  this->trailer = binarylog::Trailer();
+}
+
+/////////////////////////////////////////////////
+void LogPlayPrivate::RebuildBinaryIndex()
+{
+  const char *data = this->mappedFile.data();
+  const size_t size = this->mappedFile.size();
+
+  this->rebuiltIndex.clear();
+  this->binaryChunkCount = 0;
+
+  // Walk the chunk headers, stopping at the first incomplete chunk.
+  size_t offset = binarylog::kMagicSize + sizeof(uint32_t) +
+    binarylog::Read<uint32_t>(data + binarylog::kMagicSize);
+  while (size - offset >= sizeof(binarylog::ChunkHeader))
+  {
+    binarylog::ChunkHeader header =
+      binarylog::Read<binarylog::ChunkHeader>(data + offset);
+    if (size - offset - sizeof(header) < header.compressedSize)
+      break;
+
+    binarylog::IndexEntry entry;
+    entry.offset = offset;
+    entry.sec = header.sec;
+    entry.nsec = header.nsec;
+    binarylog::Append(entry, this->rebuiltIndex);
+    ++this->binaryChunkCount;
+
+    offset += sizeof(header) + header.compressedSize;
+  }
+
+  this->binaryIndex = this->rebuiltIndex.data();
+}
+
+/////////////////////////////////////////////////
+binarylog::IndexEntry LogPlayPrivate::BinaryIndexEntry(
+    const uint64_t _index) const
+{
+  return binarylog::Read<binarylog::IndexEntry>(
+      this->binaryIndex + _index * sizeof(binarylog::IndexEntry));
+}
+
+/////////////////////////////////////////////////
+bool LogPlayPrivate::BinaryChunkData(const uint64_t _index,
+    std::string &_data)
+{
+  if (_index >= this->binaryChunkCount)
+  {
+    gzerr << "Invalid chunk index[" << _index << "] in log file["
+      << this->filename << "]\n";
+    return false;
+  }
+
+  const char *data = this->mappedFile.data();
+  const size_t size = this->mappedFile.size();
+  const binarylog::IndexEntry entry = this->BinaryIndexEntry(_index);
+
+  if (entry.offset > size ||
+      size - entry.offset < sizeof(binarylog::ChunkHeader))
+  {
+    gzerr << "Chunk[" << _index << "] is outside of log file["
+      << this->filename << "]\n";
+    return false;
+  }
+
+  const binarylog::ChunkHeader header =
+    binarylog::Read<binarylog::ChunkHeader>(data + entry.offset);
+  const char *chunkStart = data + entry.offset + sizeof(header);
+  if (size - entry.offset - sizeof(header) < header.compressedSize)
+  {
+    gzerr << "Chunk[" << _index << "] is truncated in log file["
+      << this->filename << "]\n";
+    return false;
+  }
+
+  this->encoding = "binary";
+
+  _data.clear();
+  _data.reserve(header.size);
+  try
+  {
+    boost::iostreams::filtering_ostream out;
+    out.push(boost::iostreams::zlib_decompressor());
+    out.push(std::back_inserter(_data));
+    boost::iostreams::copy(boost::make_iterator_range(
+          chunkStart, chunkStart + header.compressedSize), out);
+  }
+  catch(boost::iostreams::zlib_error &_e)
+  {
+    gzerr << "Unable to decompress chunk[" << _index << "] in log file["
+      << this->filename << "]: " << _e.what() << "\n";
+    return false;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+uint64_t LogPlayPrivate::BinaryChunkAfter(const common::Time &_time) const
+{
+  // Binary search for the first chunk with a time greater than _time.
+  uint64_t first = 0;
+  uint64_t count = this->binaryChunkCount;
+  while (count > 0)
+  {
+    uint64_t step = count / 2;
+    uint64_t mid = first + step;
+    binarylog::IndexEntry entry = this->BinaryIndexEntry(mid);
+    if (common::Time(entry.sec, entry.nsec) <= _time)
+    {
+      first = mid + 1;
+      count -= step + 1;
+    }
+    else
+    {
+      count = step;
+    }
+  }
+
+  return first;
+}
+
 /////////////////////////////////////////////////
 std::string LogPlay::Encoding() const
 {
@@ -787,6 +1097,9 @@ std::string LogPlay::Encoding() const
 /////////////////////////////////////////////////
 unsigned int LogPlay::ChunkCount() const
 {
+  if (this->dataPtr->binary)
+    return this->dataPtr->binaryChunkCount;
+
   unsigned int count = 0;
   auto xml = this->dataPtr->logStartXml->FirstChildElement("chunk");
 
@@ -802,6 +1115,24 @@ unsigned int LogPlay::ChunkCount() const
 /////////////////////////////////////////////////
 bool LogPlay::NextChunk()
 {
+  if (this->dataPtr->binary)
+  {
+    if (this->dataPtr->binaryChunk + 1 >= this->dataPtr->binaryChunkCount)
+      return false;
+
+    ++this->dataPtr->binaryChunk;
+    if (!this->dataPtr->BinaryChunkData(this->dataPtr->binaryChunk,
+                                        this->dataPtr->currentChunk))
+    {
+      return false;
+    }
+
+    this->dataPtr->start = 0;
+    this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
+
+    return true;
+  }
+
   auto next = this->dataPtr->logCurrXml->NextSiblingElement("chunk");
   if (!next)
     return false;
@@ -822,6 +1153,24 @@ bool LogPlay::NextChunk()
 /////////////////////////////////////////////////
 bool LogPlay::PrevChunk()
 {
+  if (this->dataPtr->binary)
+  {
+    if (this->dataPtr->binaryChunk == 0)
+      return false;
+
+    --this->dataPtr->binaryChunk;
+    if (!this->dataPtr->BinaryChunkData(this->dataPtr->binaryChunk,
+                                        this->dataPtr->currentChunk))
+    {
+      return false;
+    }
+
+    this->dataPtr->start = this->dataPtr->currentChunk.size() - 1;
+    this->dataPtr->end = this->dataPtr->currentChunk.size() - 1;
+
+    return true;
+  }
+
   auto prev = this->dataPtr->logCurrXml->PreviousSiblingElement("chunk");
   if (!prev)
     return false;
@@ -161,6 +161,17 @@ namespace gazebo
       /// false otherwise.
       public: bool HasIterations() const;
 
+      /// \brief Open a log file that was recorded with the binary encoding.
+      /// \param[in] _logFile The file to load
+      /// \throws Exception When the log file is malformed.
+      private: void OpenBinary(const std::string &_logFile);
+
+      /// \brief Locate the first chunk that has a time greater than a
+      /// given time by bisecting the chunks of an XML log.
+      /// \param[in] _time Target simulation time.
+      /// \return True if the operation succeed or false otherwise.
+      private: bool SeekChunk(const common::Time &_time);
+
       /// \brief Read the header from the log file.
       private: void ReadHeader();
 
@@ -28,7 +28,10 @@
 #include <mutex>
 #include <string>
 
+#include <boost/iostreams/device/mapped_file.hpp>
+
 #include "gazebo/common/Time.hh"
+#include "gazebo/util/LogFormatPrivate.hh"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
@@ -47,6 +50,43 @@ namespace gazebo
                   tinyxml2::XMLElement *_xml,
                   std::string &_data);
 
+      /// \brief Check whether a file was recorded with the binary encoding.
+      /// \param[in] _logFile Path to the log file.
+      /// \return True if the file starts with the binary log magic bytes.
+      public: static bool IsBinary(const std::string &_logFile);
+
+      /// \brief Memory map a binary log file, parse its header into xmlDoc
+      /// and locate its chunk index.
+      /// \param[in] _logFile Path to the log file.
+      /// \throws Exception When the file can't be mapped or is malformed.
+      public: void OpenBinary(const std::string &_logFile);
+
+      /// \brief Unmap the current binary log file, if any.
+      public: void CloseBinary();
+
+      /// \brief Rebuild the chunk index of a binary log that is missing its
+      /// trailer, for example because the recording was interrupted.
+      public: void RebuildBinaryIndex();
+
+      /// \brief Get an entry of the chunk index of a binary log.
+      /// \param[in] _index Index of the chunk.
+      /// \return The index entry.
+      public: binarylog::IndexEntry BinaryIndexEntry(
+                  const uint64_t _index) const;
+
+      /// \brief Helper function to get chunk data from a binary log.
+      /// \param[in] _index Index of the chunk.
+      /// \param[out] _data Storage for the chunk's data.
+      /// \return True if the chunk was successfully decompressed.
+      public: bool BinaryChunkData(const uint64_t _index, std::string &_data);
+
+      /// \brief Find the first chunk of a binary log whose first frame is
+      /// later than a given time.
+      /// \param[in] _time Simulation time.
+      /// \return Index of the chunk, or the number of chunks if there is no
+      /// such chunk.
+      public: uint64_t BinaryChunkAfter(const common::Time &_time) const;
+
       /// \brief Max number of chunks to inspect when looking for XML elements.
       public: const unsigned int kNumChunksToTry = 2u;
 
@@ -113,6 +153,29 @@ namespace gazebo
 
       /// \brief A mutex to avoid race conditions.
       public: std::mutex mutex;
+
+      /// \brief True if the open log file uses the binary encoding.
+      public: bool binary = false;
+
+      /// \brief Memory mapped binary log file.
+      public: boost::iostreams::mapped_file_source mappedFile;
+
+      /// \brief Pointer to the first chunk index entry of a binary log.
+      /// This points either into mappedFile or into rebuiltIndex.
+      public: const char *binaryIndex = nullptr;
+
+      /// \brief Chunk index rebuilt by scanning a binary log that has no
+      /// trailer.
+      public: std::string rebuiltIndex;
+
+      /// \brief Number of chunks in the binary log.
+      public: uint64_t binaryChunkCount = 0;
+
+      /// \brief Index of the current chunk in the binary log.
+      public: uint64_t binaryChunk = 0;
+
+      /// \brief Trailer of the binary log.
+      public: binarylog::Trailer trailer;
     };
   }
 }
@@ -17,11 +17,14 @@
 
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
+#include <atomic>
 #include <string>
 #include <thread>
 #include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/Console.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/util/LogPlay.hh"
+#include "gazebo/util/LogRecord.hh"
 #include "test_config.h"
 #include "test/util.hh"
 
@@ -457,6 +460,125 @@ TEST_F(LogPlay_TEST, NoEndTag)
 #endif
 }
 
+/////////////////////////////////////////////////
+/// \brief Test recording a log with the binary encoding, and reading it
+/// back with and without its index.
+TEST_F(LogPlay_TEST, Binary)
+{
+  // \todo Make temporary files work in windows.
+#ifndef _WIN32
+  gazebo::util::LogRecord *recorder = gazebo::util::LogRecord::Instance();
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+
+  std::ostringstream stream;
+  stream << "/tmp/__gz_binary_log_test" << std::this_thread::get_id();
+  boost::filesystem::path tmpPath(stream.str());
+  boost::filesystem::path logFilename = tmpPath / "state.log";
+
+  // The first frame is a world description, the following frames are
+  // states one second apart.
+  std::atomic<int> frameCount(0);
+  EXPECT_TRUE(recorder->Init("test"));
+  recorder->Add("binary_test", "state.log",
+      [&frameCount](std::ostringstream &_stream)
+      {
+        int i = frameCount++;
+        if (i == 0)
+        {
+          _stream << "<sdf version ='1.6'><world name='default'/></sdf>\n";
+        }
+        else
+        {
+          _stream << "<sdf version='1.6'><state world_name='default'>"
+                  << "<sim_time>" << i << " 0</sim_time>"
+                  << "<iterations>" << i * 1000 << "</iterations>"
+                  << "</state></sdf>";
+        }
+        return true;
+      });
+
+  EXPECT_TRUE(recorder->Start("binary", tmpPath.string()));
+  EXPECT_EQ(recorder->Encoding(), std::string("binary"));
+
+  int i = 0;
+  while (frameCount < 10 && i++ < 500)
+  {
+    recorder->Notify();
+    gazebo::common::Time::MSleep(10);
+  }
+  recorder->Stop();
+
+  i = 0;
+  while (!recorder->IsReadyToStart())
+  {
+    gazebo::common::Time::MSleep(100);
+    if ((++i % 50) == 0)
+      gzdbg << "Waiting for recorder->IsReadyToStart()" << std::endl;
+  }
+  EXPECT_TRUE(recorder->Remove("binary_test"));
+
+  const int count = frameCount;
+  ASSERT_GE(count, 10);
+
+  // Every chunk holds a single frame.
+  EXPECT_NO_THROW(player->Open(logFilename.string()));
+  EXPECT_TRUE(player->IsOpen());
+  EXPECT_EQ(player->LogVersion(), GZ_LOG_VERSION);
+  EXPECT_EQ(player->ChunkCount(), static_cast<unsigned int>(count));
+  EXPECT_EQ(player->LogStartTime(), gazebo::common::Time(1, 0));
+  EXPECT_EQ(player->LogEndTime(), gazebo::common::Time(count - 1, 0));
+  EXPECT_TRUE(player->HasIterations());
+  EXPECT_EQ(player->InitialIterations(), 1000u);
+
+  std::string frame;
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_NE(frame.find("<world name='default'/>"), std::string::npos);
+  EXPECT_EQ(player->Encoding(), "binary");
+
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_NE(frame.find("<sim_time>1 0</sim_time>"), std::string::npos);
+
+  EXPECT_TRUE(player->Seek(gazebo::common::Time(4.5)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_NE(frame.find("<sim_time>5 0</sim_time>"), std::string::npos);
+
+  EXPECT_TRUE(player->StepBack(frame));
+  EXPECT_NE(frame.find("<sim_time>4 0</sim_time>"), std::string::npos);
+
+  EXPECT_TRUE(player->Rewind());
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_NE(frame.find("<sim_time>1 0</sim_time>"), std::string::npos);
+
+  // Drop the index, trailer and the end of the last chunk, as if the
+  // recording had been interrupted.
+  const uintmax_t indexSize = count * 16u + 56u;
+  std::string truncatedFilename = stream.str() + "_truncated.log";
+  {
+    std::ifstream srcFile(logFilename.string(), std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(srcFile)),
+        std::istreambuf_iterator<char>());
+    ASSERT_GT(data.size(), indexSize + 3);
+
+    std::ofstream destFile(truncatedFilename, std::ios::binary);
+    destFile.write(data.data(), data.size() - indexSize - 3);
+  }
+
+  EXPECT_NO_THROW(player->Open(truncatedFilename));
+  EXPECT_EQ(player->ChunkCount(), static_cast<unsigned int>(count - 1));
+  EXPECT_EQ(player->LogStartTime(), gazebo::common::Time(1, 0));
+  EXPECT_EQ(player->LogEndTime(), gazebo::common::Time(count - 2, 0));
+  EXPECT_TRUE(player->HasIterations());
+  EXPECT_EQ(player->InitialIterations(), 1000u);
+
+  EXPECT_TRUE(player->Seek(gazebo::common::Time(4.5)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_NE(frame.find("<sim_time>5 0</sim_time>"), std::string::npos);
+
+  std::remove(truncatedFilename.c_str());
+  boost::filesystem::remove_all(tmpPath);
+#endif
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -52,6 +52,7 @@
 #include "gazebo/common/SystemPaths.hh"
 #include "gazebo/gazebo_config.h"
 #include "gazebo/transport/transport.hh"
+#include "gazebo/util/LogFormatPrivate.hh"
 #include "gazebo/util/LogRecordPrivate.hh"
 #include "gazebo/util/LogRecord.hh"
 
@@ -186,9 +187,12 @@ bool LogRecord::Start(const std::string &_encoding, const std::string &_path)
   if (!boost::filesystem::exists(this->dataPtr->logCompletePath))
     boost::filesystem::create_directories(this->dataPtr->logCompletePath);
 
-  if (_encoding != "bz2" && _encoding != "txt" && _encoding != "zlib")
+  if (_encoding != "bz2" && _encoding != "txt" && _encoding != "zlib" &&
+      _encoding != "binary")
+  {
     gzthrow("Invalid log encoding[" + _encoding +
-            "]. Must be one of [bz2, zlib, txt]");
+            "]. Must be one of [bz2, zlib, txt, binary]");
+  }
 
   this->dataPtr->encoding = _encoding;
 
@@ -792,7 +796,11 @@ unsigned int LogRecordPrivate::Log::Update()
   if (this->logCB(stream))
   {
     std::string data = stream.str();
-    if (!data.empty())
+    if (!data.empty() && this->binary)
+    {
+      this->AppendBinaryChunk(data);
+    }
+    else if (!data.empty())
     {
       const std::string &encodingLocal = this->parent->Encoding();
 
@@ -845,6 +853,109 @@ unsigned int LogRecordPrivate::Log::Update()
   return this->buffer.size();
 }
 
+//////////////////////////////////////////////////
+/// \brief Get the text of the first or last occurrence of an element.
+/// \param[in] _data Data to search.
+/// \param[in] _tag Name of the element.
+/// \param[in] _last True to find the last occurrence of the element.
+/// \param[out] _text Text of the element.
+/// \return True if the element was found.
+static bool ElementText(const std::string &_data, const std::string &_tag,
+    const bool _last, std::string &_text)
+{
+  const std::string startTag = "<" + _tag + ">";
+  const std::string endTag = "</" + _tag + ">";
+
+  size_t from;
+  size_t to;
+  if (_last)
+  {
+    to = _data.rfind(endTag);
+    if (to == std::string::npos)
+      return false;
+    from = _data.rfind(startTag, to);
+  }
+  else
+  {
+    from = _data.find(startTag);
+    if (from == std::string::npos)
+      return false;
+    to = _data.find(endTag, from + startTag.size());
+  }
+
+  if (from == std::string::npos || to == std::string::npos)
+    return false;
+
+  from += startTag.size();
+  _text = _data.substr(from, to - from);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::Log::AppendBinaryChunk(const std::string &_data)
+{
+  std::string compressed;
+  {
+    boost::iostreams::filtering_ostream out;
+    out.push(boost::iostreams::zlib_compressor());
+    out.push(std::back_inserter(compressed));
+    boost::iostreams::copy(boost::make_iterator_range(_data), out);
+  }
+
+  // Keep track of the times and iterations that LogPlay would otherwise
+  // have to decompress chunks to find.
+  std::string text;
+  if (ElementText(_data, "sim_time", false, text))
+  {
+    std::stringstream ss(text);
+    ss >> this->chunkTime;
+
+    if (!(this->trailer.flags & binarylog::kHasStartTime))
+    {
+      this->trailer.startSec = this->chunkTime.sec;
+      this->trailer.startNsec = this->chunkTime.nsec;
+      this->trailer.flags |= binarylog::kHasStartTime;
+    }
+  }
+
+  if (ElementText(_data, "sim_time", true, text))
+  {
+    common::Time endTime;
+    std::stringstream ss(text);
+    ss >> endTime;
+    this->trailer.endSec = endTime.sec;
+    this->trailer.endNsec = endTime.nsec;
+    this->trailer.flags |= binarylog::kHasEndTime;
+  }
+
+  if (!(this->trailer.flags & binarylog::kHasIterations) &&
+      ElementText(_data, "iterations", false, text))
+  {
+    std::stringstream ss(text);
+    ss >> this->trailer.initialIterations;
+    this->trailer.flags |= binarylog::kHasIterations;
+  }
+
+  // Chunks without a <sim_time>, such as the initial world description,
+  // inherit the time of the previous chunk so the index stays sorted.
+  binarylog::ChunkHeader header;
+  header.compressedSize = compressed.size();
+  header.size = _data.size();
+  header.sec = this->chunkTime.sec;
+  header.nsec = this->chunkTime.nsec;
+
+  binarylog::IndexEntry entry;
+  entry.offset = this->offset;
+  entry.sec = header.sec;
+  entry.nsec = header.nsec;
+  binarylog::Append(entry, this->index);
+  this->trailer.chunkCount++;
+
+  binarylog::Append(header, this->buffer);
+  this->buffer.append(compressed);
+  this->offset += sizeof(header) + compressed.size();
+}
+
 //////////////////////////////////////////////////
 void LogRecordPrivate::Log::ClearBuffer()
 {
@@ -877,8 +988,22 @@ void LogRecordPrivate::Log::Stop()
     this->Update();
     this->Write();
 
-    std::string xmlEnd = "</gazebo_log>";
-    this->logFile.write(xmlEnd.c_str(), xmlEnd.size());
+    if (this->binary)
+    {
+      // Write the index and trailer, which allow LogPlay to open the file
+      // and seek without reading any chunks.
+      this->trailer.indexOffset = this->offset;
+      std::memcpy(this->trailer.magic, binarylog::kIndexMagic,
+          binarylog::kMagicSize);
+      this->logFile.write(this->index.data(), this->index.size());
+      this->logFile.write(reinterpret_cast<const char *>(&this->trailer),
+          sizeof(this->trailer));
+    }
+    else
+    {
+      std::string xmlEnd = "</gazebo_log>";
+      this->logFile.write(xmlEnd.c_str(), xmlEnd.size());
+    }
 
     this->logFile.close();
   }
@@ -906,7 +1031,27 @@ void LogRecordPrivate::Log::Start(const boost::filesystem::path &_path)
          << "<rand_seed>" << ignition::math::Rand::Seed() << "</rand_seed>\n"
          << "</header>\n";
 
-  this->buffer.append(stream.str());
+  this->binary = this->parent->Encoding() == "binary";
+  if (this->binary)
+  {
+    // Binary logs store the XML header as a length prefixed block, so
+    // that it can be parsed on its own.
+    stream << "</gazebo_log>\n";
+    std::string header = stream.str();
+
+    this->buffer.append(binarylog::kMagic, binarylog::kMagicSize);
+    binarylog::Append(static_cast<uint32_t>(header.size()), this->buffer);
+    this->buffer.append(header);
+
+    this->offset = this->buffer.size();
+    this->index.clear();
+    this->trailer = binarylog::Trailer();
+    this->chunkTime = common::Time();
+  }
+  else
+  {
+    this->buffer.append(stream.str());
+  }
 }
 
 //////////////////////////////////////////////////
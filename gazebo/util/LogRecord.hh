@@ -38,7 +38,7 @@ namespace gazebo
     /// \sa LogRecord::Start
     class LogRecordParams
     {
-      /// \brief The type of encoding (txt, zlib, or bz2).
+      /// \brief The type of encoding (txt, zlib, bz2, or binary).
       public: std::string encoding = "zlib";
 
       /// \brief Path in which to store log files.
@@ -176,14 +176,18 @@ namespace gazebo
       public: bool Start(const LogRecordParams &_params);
 
       /// \brief Start the logger.
-      /// \param[in] _encoding The type of encoding (txt, zlib, or bz2).
+      /// \param[in] _encoding The type of encoding (txt, zlib, bz2, or
+      /// binary).
       /// \param[in] _path Path in which to store log files.
       public: bool Start(const std::string &_encoding="zlib",
                          const std::string &_path="");
 
       /// \brief Get the encoding used.
-      /// \return Either [txt, zlib, or bz2], where txt is plain txt and bz2
-      /// and zlib are compressed data with Base64 encoding.
+      /// \return Either [txt, zlib, bz2, or binary], where txt is plain txt
+      /// and bz2 and zlib are compressed data with Base64 encoding. The binary
+      /// encoding stores zlib compressed chunks without Base64 encoding,
+      /// followed by an index of simulation times that LogPlay uses to
+      /// seek directly to a chunk.
       public: const std::string &Encoding() const;
 
       /// \brief Get the filename for a log object.
@@ -26,6 +26,9 @@
 #include <condition_variable>
 #include <boost/filesystem.hpp>
 
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/LogFormatPrivate.hh"
+
 namespace gazebo
 {
   namespace util
@@ -68,6 +71,11 @@ namespace gazebo
         /// \return The size of the data buffer.
         public: unsigned int Update();
 
+        /// \brief Compress a chunk of data and append it to the buffer
+        /// using the binary log format.
+        /// \param[in] _data Chunk of log data.
+        public: void AppendBinaryChunk(const std::string &_data);
+
         /// \brief Clear the data buffer.
         public: void ClearBuffer();
 
@@ -101,6 +109,23 @@ namespace gazebo
 
         /// \brief Complete file path.
         public: boost::filesystem::path completePath;
+
+        /// \brief True if the log is written using the binary format.
+        public: bool binary = false;
+
+        /// \brief File offset of the next byte appended to the buffer.
+        /// Only used by binary logs.
+        public: uint64_t offset = 0;
+
+        /// \brief Serialized chunk index of a binary log.
+        public: std::string index;
+
+        /// \brief Trailer written at the end of a binary log.
+        public: binarylog::Trailer trailer;
+
+        /// \brief Simulation time of the last chunk that contained a
+        /// <sim_time>.
+        public: common::Time chunkTime;
       };
 
       /// \def Log_M
@@ -15,6 +15,7 @@
  *
 */
 #include <functional>
+#include <set>
 
 #include <gazebo/common/Events.hh>
 #include <gazebo/common/Assert.hh>
@@ -27,6 +28,7 @@
 
 #include <gazebo/physics/World.hh>
 #include <gazebo/physics/Model.hh>
+#include <gazebo/physics/ModelSpatialIndex.hh>
 
 #include "plugins/events/OccupiedEventSource.hh"
 
@@ -39,6 +41,13 @@ OccupiedEventSource::OccupiedEventSource(transport::PublisherPtr _pub,
 {
 }
 
+/////////////////////////////////////////////////
+OccupiedEventSource::~OccupiedEventSource()
+{
+  if (this->spatialIndex)
+    this->spatialIndex->RemoveUser();
+}
+
 /////////////////////////////////////////////////
 void OccupiedEventSource::Load(const sdf::ElementPtr _sdf)
 {
@@ -94,6 +103,11 @@ void OccupiedEventSource::Load(const sdf::ElementPtr _sdf)
 
     this->msg.set_data(data);
 
+    // Keep the spatial index of the world up to date
+    this->spatialIndex = this->world->SpatialIndex();
+    if (this->spatialIndex)
+      this->spatialIndex->AddUser();
+
     // Connect to the update event.
     this->updateConnection = event::Events::ConnectWorldUpdateBegin(
         std::bind(&OccupiedEventSource::Update, this));
@@ -103,21 +117,28 @@ void OccupiedEventSource::Load(const sdf::ElementPtr _sdf)
 /////////////////////////////////////////////////
 void OccupiedEventSource::Update()
 {
-  // Get all the models.
-  physics::Model_V models = this->world->Models();
+  const RegionPtr &region = this->regions[this->regionName];
 
-  // Process each model.
-  for (physics::Model_V::iterator iter = models.begin();
-       iter != models.end(); ++iter)
+  // Only the models near the volumes of the region can be inside it.
+  std::set<uint32_t> checked;
+  for (auto const &box : region->boxes)
   {
-    // Skip models that are static
-    if ((*iter)->IsStatic())
-      continue;
-
-    // If inside, then transmit the desired message.
-    if (this->regions[this->regionName]->Contains((*iter)->WorldPose().Pos()))
+    for (auto const &model : this->world->ModelsInBox(box))
     {
-      this->msgPub->Publish(this->msg);
+      // Skip nested models, and models seen in a previous volume
+      if (model->GetParent() &&
+          model->GetParent()->HasType(physics::Base::MODEL))
+        continue;
+      if (!checked.insert(model->GetId()).second)
+        continue;
+
+      // Skip models that are static
+      if (model->IsStatic())
+        continue;
+
+      // If inside, then transmit the desired message.
+      if (region->Contains(model->WorldPose().Pos()))
+        this->msgPub->Publish(this->msg);
     }
   }
 }
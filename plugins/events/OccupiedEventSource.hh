@@ -26,6 +26,7 @@
 #include <gazebo/transport/TransportTypes.hh>
 
 #include <gazebo/common/Plugin.hh>
+#include <gazebo/physics/PhysicsTypes.hh>
 #include <gazebo/util/system.hh>
 
 #include "Region.hh"
@@ -63,7 +64,7 @@ namespace gazebo
                 const std::map<std::string, RegionPtr> &_regions);
 
     /// \brief Destructor.
-    public: ~OccupiedEventSource() = default;
+    public: virtual ~OccupiedEventSource();
 
     // Documentation inherited
     public: virtual void Load(const sdf::ElementPtr _sdf);
@@ -91,6 +92,10 @@ namespace gazebo
 
     /// \brief The region used for the in region check.
     private: std::string regionName;
+
+    /// \brief Spatial index of the world, used to find the models in the
+    /// region.
+    private: physics::ModelSpatialIndexPtr spatialIndex;
   };
 }
 #endif
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gazebo/test/ServerFixture.hh"
+#include "gazebo/common/Timer.hh"
+#include "gazebo/physics/physics.hh"
+
+using namespace gazebo;
+
+class SpeedThreadNarrowPhaseTest : public ServerFixture
+{
+  /// \brief Spawn a grid of boxes that rest on the ground plane and touch
+  /// their neighbours.
+  /// \param[in] _side Number of boxes along each side of the grid.
+  public: void SpawnBoxGrid(const unsigned int _side);
+
+  /// \brief Run collision detection once and copy the generated contacts.
+  /// \param[in] _physics Physics engine.
+  /// \return Contacts generated by the physics engine.
+  public: std::vector<physics::Contact> Collide(
+              physics::PhysicsEnginePtr _physics);
+};
+
+/////////////////////////////////////////////////
+void SpeedThreadNarrowPhaseTest::SpawnBoxGrid(const unsigned int _side)
+{
+  for (unsigned int i = 0; i < _side; ++i)
+  {
+    for (unsigned int j = 0; j < _side; ++j)
+    {
+      std::ostringstream name;
+      name << "box_" << i << "_" << j;
+      // Boxes are slightly larger than their spacing, so that each box
+      // penetrates its neighbours and the ground.
+      SpawnBox(name.str(), ignition::math::Vector3d(1.02, 1.02, 1.02),
+          ignition::math::Vector3d(i * 1.0, j * 1.0, 0.5));
+    }
+  }
+
+  std::ostringstream last;
+  last << "box_" << _side - 1 << "_" << _side - 1;
+  WaitUntilEntitySpawn(last.str(), 100, 100);
+}
+
+/////////////////////////////////////////////////
+std::vector<physics::Contact> SpeedThreadNarrowPhaseTest::Collide(
+    physics::PhysicsEnginePtr _physics)
+{
+  _physics->UpdateCollision();
+
+  std::vector<physics::Contact> contacts;
+  physics::ContactManager *mgr = _physics->GetContactManager();
+  for (unsigned int i = 0; i < mgr->GetContactCount(); ++i)
+    contacts.push_back(*mgr->GetContact(i));
+  return contacts;
+}
+
+/////////////////////////////////////////////////
+// The parallel narrow phase must generate exactly the same contacts, in the
+// same order, as the serial path.
+TEST_F(SpeedThreadNarrowPhaseTest, ParallelMatchesSerial)
+{
+  Load("worlds/empty.world", true, "ode");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  // Serial by default
+  bool parallel = true;
+  EXPECT_NO_THROW(parallel =
+      boost::any_cast<bool>(physics->GetParam("parallel_narrow_phase")));
+  EXPECT_FALSE(parallel);
+
+  SpawnBoxGrid(10);
+  physics->GetContactManager()->SetNeverDropContacts(true);
+
+  std::vector<physics::Contact> serial = Collide(physics);
+  EXPECT_GT(serial.size(), 100u);
+
+  EXPECT_TRUE(physics->SetParam("parallel_narrow_phase", true));
+  EXPECT_TRUE(physics->SetParam("narrow_phase_threads", 4));
+  EXPECT_EQ(4,
+      boost::any_cast<int>(physics->GetParam("narrow_phase_threads")));
+
+  std::vector<physics::Contact> threaded = Collide(physics);
+  ASSERT_EQ(serial.size(), threaded.size());
+
+  for (size_t i = 0; i < serial.size(); ++i)
+  {
+    EXPECT_EQ(serial[i].collision1, threaded[i].collision1);
+    EXPECT_EQ(serial[i].collision2, threaded[i].collision2);
+    ASSERT_EQ(serial[i].count, threaded[i].count);
+    for (int j = 0; j < serial[i].count; ++j)
+    {
+      EXPECT_EQ(serial[i].positions[j], threaded[i].positions[j]);
+      EXPECT_EQ(serial[i].normals[j], threaded[i].normals[j]);
+      EXPECT_DOUBLE_EQ(serial[i].depths[j], threaded[i].depths[j]);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+// Report the time spent in collision detection with and without the
+// parallel narrow phase.
+TEST_F(SpeedThreadNarrowPhaseTest, Speedup)
+{
+  Load("worlds/empty.world", true, "ode");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  SpawnBoxGrid(30);
+
+  const int iterations = 200;
+  common::Timer timer;
+
+  timer.Start();
+  for (int i = 0; i < iterations; ++i)
+    physics->UpdateCollision();
+  timer.Stop();
+  common::Time serialTime = timer.GetElapsed();
+
+  physics->SetParam("parallel_narrow_phase", true);
+
+  timer.Reset();
+  timer.Start();
+  for (int i = 0; i < iterations; ++i)
+    physics->UpdateCollision();
+  timer.Stop();
+  common::Time parallelTime = timer.GetElapsed();
+
+  gzmsg << "UpdateCollision x" << iterations << "\n"
+        << "\t serial   [" << serialTime << "]\n"
+        << "\t parallel [" << parallelTime << "]\n";
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
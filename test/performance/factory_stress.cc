@@ -14,6 +14,10 @@
  * limitations under the License.
  *
 */
+#include <string>
+#include <vector>
+
+#include "gazebo/physics/physics.hh"
 #include "gazebo/test/ServerFixture.hh"
 
 using namespace gazebo;
@@ -44,6 +48,92 @@ TEST_F(FactoryStressTest, Bookshelf)
   sub.reset();
 }
 
+/////////////////////////////////////////////////
+/// \brief Spawn 10000 copies of a box with a single bulk factory message,
+/// and a tenth of them with one message each, for comparison.
+TEST_F(FactoryStressTest, BulkSpawn)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  const unsigned int initialCount = world->ModelCount();
+
+  const std::string boxSDF =
+    "<sdf version='" + std::string(SDF_VERSION) + "'>"
+    "<model name='pallet'>"
+    "  <static>true</static>"
+    "  <link name='link'>"
+    "    <collision name='collision'>"
+    "      <geometry><box><size>0.8 1.2 0.15</size></box></geometry>"
+    "    </collision>"
+    "    <visual name='visual'>"
+    "      <geometry><box><size>0.8 1.2 0.15</size></box></geometry>"
+    "    </visual>"
+    "  </link>"
+    "</model>"
+    "</sdf>";
+
+  // Poses on a grid, so the boxes don't touch
+  const unsigned int count = 10000;
+  std::vector<ignition::math::Pose3d> poses;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    poses.push_back(ignition::math::Pose3d(
+        (i % 100) * 2.0, (i / 100) * 2.0, 1.0, 0, 0, 0));
+  }
+
+  // Wait until the world holds a number of models, for up to a minute
+  auto waitForModels = [&](const unsigned int _count)
+  {
+    for (int i = 0; i < 6000 && world->ModelCount() < _count; ++i)
+      common::Time::MSleep(10);
+  };
+
+  // One message per model
+  const unsigned int singleCount = count / 10;
+  common::Time start = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < singleCount; ++i)
+  {
+    msgs::Factory msg;
+    std::string sdf = boxSDF;
+    sdf.replace(sdf.find("'pallet'"), 8, "'single_" + std::to_string(i) + "'");
+    msg.set_sdf(sdf);
+    msgs::Set(msg.mutable_pose(), poses[i] +
+        ignition::math::Pose3d(0, 0, 2, 0, 0, 0));
+    this->factoryPub->Publish(msg);
+  }
+  waitForModels(initialCount + singleCount);
+  double singleTime = (common::Time::GetWallTime() - start).Double();
+  ASSERT_EQ(world->ModelCount(), initialCount + singleCount);
+
+  // One bulk message
+  start = common::Time::GetWallTime();
+  msgs::Factory msg;
+  msg.set_sdf(boxSDF);
+  for (auto const &pose : poses)
+    msgs::Set(msg.add_instance_pose(), pose);
+  this->factoryPub->Publish(msg);
+  waitForModels(initialCount + singleCount + count);
+  double bulkTime = (common::Time::GetWallTime() - start).Double();
+  ASSERT_EQ(world->ModelCount(), initialCount + singleCount + count);
+
+  EXPECT_TRUE(world->ModelByName("pallet_0") != nullptr);
+  EXPECT_TRUE(world->ModelByName("pallet_" + std::to_string(count - 1)) !=
+      nullptr);
+
+  gzmsg << singleCount << " models, one message each: " << singleTime
+        << " s (" << singleTime / singleCount * 1e3 << " ms per model)\n"
+        << count << " models, one bulk message: " << bulkTime
+        << " s (" << bulkTime / count * 1e3 << " ms per model)\n";
+
+  // Step with all the models
+  start = common::Time::GetWallTime();
+  world->Step(100);
+  double stepTime = (common::Time::GetWallTime() - start).Double();
+  gzmsg << "100 steps with " << world->ModelCount() << " models: "
+        << stepTime << " s\n";
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -0,0 +1,232 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class ModelUpdateStressTest : public ServerFixture,
+                              public testing::WithParamInterface<unsigned int>
+{
+  /// \brief Spawn articulated models with position controlled joints.
+  /// \param[in] _count Number of models to spawn.
+  public: void SpawnArms(const unsigned int _count);
+
+  /// \brief Step the world in the given model update mode.
+  /// \param[in] _mode Model update mode.
+  /// \param[in] _steps Number of steps to take.
+  /// \return Wall time spent stepping.
+  public: common::Time StepMode(const std::string &_mode,
+                                const unsigned int _steps);
+
+  /// \brief Collect the position of every joint in the world.
+  /// \return Joint positions, ordered by model then joint.
+  public: std::vector<double> JointPositions();
+
+  /// \brief Pointer to the world.
+  public: physics::WorldPtr world;
+};
+
+/////////////////////////////////////////////////
+void ModelUpdateStressTest::SpawnArms(const unsigned int _count)
+{
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    std::ostringstream name;
+    name << "arm_" << i;
+
+    std::ostringstream sdfStr;
+    sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='" << name.str() << "'>"
+      << "<pose>" << (i % 20) * 2.0 << " " << (i / 20) * 2.0 << " 5 0 0 0"
+      << "</pose>";
+    for (unsigned int l = 0; l < 3; ++l)
+    {
+      sdfStr << "<link name='link_" << l << "'>"
+        << "<pose>0 0 " << -0.5 * l << " 0 0 0</pose>"
+        << "<inertial><mass>1.0</mass></inertial>"
+        << "</link>";
+    }
+    sdfStr << "<joint name='joint_0' type='revolute'>"
+      << "<parent>world</parent><child>link_0</child>"
+      << "<axis><xyz>1 0 0</xyz></axis>"
+      << "</joint>";
+    for (unsigned int j = 1; j < 3; ++j)
+    {
+      sdfStr << "<joint name='joint_" << j << "' type='revolute'>"
+        << "<parent>link_" << j - 1 << "</parent>"
+        << "<child>link_" << j << "</child>"
+        << "<axis><xyz>1 0 0</xyz></axis>"
+        << "</joint>";
+    }
+    sdfStr << "</model></sdf>";
+
+    SpawnSDF(sdfStr.str());
+  }
+
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    std::ostringstream name;
+    name << "arm_" << i;
+    WaitUntilEntitySpawn(name.str(), 10, 500);
+
+    physics::ModelPtr model = this->world->ModelByName(name.str());
+    ASSERT_TRUE(model != nullptr);
+
+    physics::JointControllerPtr controller = model->GetJointController();
+    for (auto const &joint : model->GetJoints())
+    {
+      controller->SetPositionPID(joint->GetScopedName(),
+          common::PID(50, 0.1, 1));
+      controller->SetPositionTarget(joint->GetScopedName(), 0.3 * (i % 5));
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+common::Time ModelUpdateStressTest::StepMode(const std::string &_mode,
+    const unsigned int _steps)
+{
+  EXPECT_TRUE(this->world->SetModelUpdateMode(_mode));
+  this->world->Reset();
+
+  common::Time start = common::Time::GetWallTime();
+  this->world->Step(_steps);
+  return common::Time::GetWallTime() - start;
+}
+
+/////////////////////////////////////////////////
+std::vector<double> ModelUpdateStressTest::JointPositions()
+{
+  std::vector<double> positions;
+  for (auto const &model : this->world->Models())
+  {
+    for (auto const &joint : model->GetJoints())
+      positions.push_back(joint->Position(0));
+  }
+  return positions;
+}
+
+/////////////////////////////////////////////////
+// Report the speedup of the parallel model update modes relative to the
+// serial loop, and check that the deterministic mode reproduces the serial
+// result exactly.
+TEST_P(ModelUpdateStressTest, Speedup)
+{
+  const unsigned int modelCount = GetParam();
+  const unsigned int steps = 1000;
+
+  Load("worlds/empty.world", true);
+  this->world = physics::get_world("default");
+  ASSERT_TRUE(this->world != nullptr);
+
+  SpawnArms(modelCount);
+
+  // Warm up, then take the serial reference twice so both runs being
+  // compared start from a reset that followed an identical run.
+  StepMode("serial", steps);
+  common::Time serialTime = StepMode("serial", steps);
+  std::vector<double> serialPositions = JointPositions();
+
+  common::Time deterministicTime = StepMode("deterministic", steps);
+  std::vector<double> deterministicPositions = JointPositions();
+
+  common::Time parallelTime = StepMode("parallel", steps);
+
+  ASSERT_EQ(serialPositions.size(), deterministicPositions.size());
+  for (size_t i = 0; i < serialPositions.size(); ++i)
+    EXPECT_EQ(serialPositions[i], deterministicPositions[i]);
+
+  gzmsg << "Models[" << modelCount << "] steps[" << steps << "]\n"
+        << "  serial        [" << serialTime.Double() << " s]\n"
+        << "  parallel      [" << parallelTime.Double() << " s] speedup["
+        << serialTime.Double() / parallelTime.Double() << "]\n"
+        << "  deterministic [" << deterministicTime.Double() << " s] speedup["
+        << serialTime.Double() / deterministicTime.Double() << "]\n";
+}
+
+INSTANTIATE_TEST_CASE_P(ModelCounts, ModelUpdateStressTest,
+    ::testing::Values(10u, 50u, 150u, 300u));
+
+/////////////////////////////////////////////////
+// Joint animations are applied after the parallel section, so every
+// completion callback runs once on the physics thread.
+TEST_F(ModelUpdateStressTest, JointAnimation)
+{
+  const unsigned int modelCount = 50;
+
+  Load("worlds/empty.world", true);
+  this->world = physics::get_world("default");
+  ASSERT_TRUE(this->world != nullptr);
+
+  SpawnArms(modelCount);
+  EXPECT_TRUE(this->world->SetModelUpdateMode("parallel"));
+
+  std::thread::id physicsThread;
+  event::ConnectionPtr updateConnection =
+      event::Events::ConnectWorldUpdateBegin(
+      [&](const common::UpdateInfo &)
+      {
+        physicsThread = std::this_thread::get_id();
+      });
+
+  unsigned int completed = 0;
+  bool sameThread = true;
+  for (unsigned int i = 0; i < modelCount; i += 2)
+  {
+    std::ostringstream name;
+    name << "arm_" << i;
+    physics::ModelPtr model = this->world->ModelByName(name.str());
+    ASSERT_TRUE(model != nullptr);
+
+    common::NumericAnimationPtr anim(
+        new common::NumericAnimation("joint_0", 0.5, false));
+    anim->CreateKeyFrame(0.0)->SetValue(0.0);
+    anim->CreateKeyFrame(0.5)->SetValue(0.7);
+
+    std::map<std::string, common::NumericAnimationPtr> anims;
+    anims[model->GetJoint("joint_0")->GetScopedName()] = anim;
+    model->SetJointAnimation(anims, [&]()
+    {
+      ++completed;
+      sameThread = sameThread &&
+          std::this_thread::get_id() == physicsThread;
+    });
+    EXPECT_TRUE(model->HasJointAnimation());
+  }
+
+  this->world->Step(1000);
+
+  EXPECT_EQ(completed, modelCount / 2);
+  EXPECT_TRUE(sameThread);
+  for (auto const &model : this->world->Models())
+    EXPECT_FALSE(model->HasJointAnimation());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
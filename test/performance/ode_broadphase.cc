@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/Timer.hh"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/physics/ode/ODEPhysics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+/// \brief Scenario and broadphase of a benchmark.
+typedef std::tuple<const char *, const char *> BroadphaseParam;
+
+class ODEBroadphaseTest : public ServerFixture,
+                          public testing::WithParamInterface<BroadphaseParam>
+{
+  /// \brief Write a benchmark world.
+  /// \param[in] _scenario One of "uniform", "mixed_sizes" or "clustered".
+  /// \param[in] _broadphase Broadphase of the ODE collision space.
+  /// \return Path of the world file.
+  public: std::string WriteWorld(const std::string &_scenario,
+              const std::string &_broadphase) const;
+};
+
+/////////////////////////////////////////////////
+/// \brief SDF of a box model.
+/// \param[in] _name Name of the model.
+/// \param[in] _pos Position of the model.
+/// \param[in] _size Size of the box.
+/// \param[in] _static True for a static model.
+/// \return The SDF.
+static std::string BoxModel(const std::string &_name,
+    const ignition::math::Vector3d &_pos,
+    const ignition::math::Vector3d &_size, const bool _static)
+{
+  std::ostringstream sdf;
+  sdf << "<model name='" << _name << "'>"
+      << "<static>" << _static << "</static>"
+      << "<pose>" << _pos << " 0 0 0</pose>"
+      << "<link name='link'>"
+      << "<collision name='collision'><geometry><box><size>" << _size
+      << "</size></box></geometry></collision>"
+      << "</link></model>\n";
+  return sdf.str();
+}
+
+/////////////////////////////////////////////////
+std::string ODEBroadphaseTest::WriteWorld(const std::string &_scenario,
+    const std::string &_broadphase) const
+{
+  std::ostringstream sdf;
+  sdf << "<?xml version='1.0'?>\n<sdf version='1.6'><world name='default'>"
+      << "<physics type='ode'><ode><gz:broadphase><type>" << _broadphase
+      << "</type></gz:broadphase></ode></physics>\n"
+      << "<include><uri>model://ground_plane</uri></include>\n";
+
+  const int side = 20;
+  if (_scenario == "uniform")
+  {
+    // Small boxes falling on the ground, evenly spread
+    for (int i = 0; i < side * side; ++i)
+    {
+      sdf << BoxModel("box_" + std::to_string(i),
+          ignition::math::Vector3d(i % side, i / side, 0.5),
+          ignition::math::Vector3d(0.2, 0.2, 0.2), false);
+    }
+  }
+  else if (_scenario == "mixed_sizes")
+  {
+    // A large terrain block, a few large static obstacles, and tiny parts
+    // scattered over them
+    sdf << BoxModel("terrain", ignition::math::Vector3d(0, 0, -0.5),
+        ignition::math::Vector3d(1000, 1000, 1), true);
+    for (int i = 0; i < 8; ++i)
+    {
+      sdf << BoxModel("obstacle_" + std::to_string(i),
+          ignition::math::Vector3d(-80 + 20 * i, 30, 10),
+          ignition::math::Vector3d(15, 15, 20), true);
+    }
+    for (int i = 0; i < side * side; ++i)
+    {
+      sdf << BoxModel("part_" + std::to_string(i),
+          ignition::math::Vector3d(-100 + 10 * (i % side),
+            -100 + 10 * (i / side), 0.05 + 0.01 * (i % 7)),
+          ignition::math::Vector3d(0.02, 0.02, 0.02), false);
+    }
+  }
+  else
+  {
+    // Stacks of small boxes, many overlapping AABBs
+    for (int i = 0; i < side * side; ++i)
+    {
+      const int column = i % 16;
+      sdf << BoxModel("box_" + std::to_string(i),
+          ignition::math::Vector3d(0.3 * (column % 4), 0.3 * (column / 4),
+            0.11 + 0.21 * (i / 16)),
+          ignition::math::Vector3d(0.2, 0.2, 0.2), false);
+    }
+  }
+  sdf << "</world></sdf>\n";
+
+  boost::filesystem::path dir =
+      boost::filesystem::temp_directory_path() / "ODEBroadphaseTest";
+  boost::filesystem::create_directories(dir);
+  boost::filesystem::path path =
+      dir / (_scenario + "_" + _broadphase + ".world");
+  std::ofstream out(path.string());
+  out << sdf.str();
+  return path.string();
+}
+
+/////////////////////////////////////////////////
+/// \brief Step a world with every broadphase and report the time spent.
+TEST_P(ODEBroadphaseTest, Step)
+{
+  const std::string scenario = std::get<0>(GetParam());
+  const std::string broadphase = std::get<1>(GetParam());
+
+  this->Load(this->WriteWorld(scenario, broadphase), true, "ode");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+  boost::any value;
+  ASSERT_TRUE(physics->GetParam("broadphase", value));
+  EXPECT_EQ(boost::any_cast<std::string>(value), broadphase);
+
+  // Let the models settle, then measure
+  world->Step(100);
+
+  const unsigned int steps = 1000;
+  common::Timer timer;
+  timer.Start();
+  world->Step(steps);
+  const common::Time elapsed = timer.GetElapsed();
+
+  gzmsg << "Scenario[" << scenario << "] broadphase[" << broadphase
+        << "] models[" << world->ModelCount() << "] steps[" << steps
+        << "] time[" << elapsed.Double() << " s] per step["
+        << elapsed.Double() * 1e3 / steps << " ms]\n";
+
+  // Nothing fell through the ground
+  for (auto const &model : world->Models())
+    EXPECT_GT(model->WorldPose().Pos().Z(), -1.0) << model->GetName();
+}
+
+INSTANTIATE_TEST_CASE_P(Broadphases, ODEBroadphaseTest,
+    ::testing::Combine(
+      ::testing::Values("uniform", "mixed_sizes", "clustered"),
+      ::testing::Values("hash", "sap", "quadtree", "aabb_tree")),);  // NOLINT
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -15,8 +15,16 @@
  *
 */
 
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 #include <boost/thread.hpp>
 #include "gazebo/test/ServerFixture.hh"
+#include "gazebo/transport/Connection.hh"
 #include "RAMLibrary.hh"
 
 using namespace gazebo;
@@ -115,6 +123,74 @@ TEST_F(TransportStressTest, LocalPublish)
   delete [] fakeData;
 }
 
+/////////////////////////////////////////////////
+// Publish a large image to a local subscriber, first by value and then as a
+// shared message. Publishing a shared message skips the copy made by the
+// publisher, so local delivery should be considerably faster.
+TEST_F(TransportStressTest, LocalPublishShared)
+{
+  Load("worlds/empty.world");
+
+  const unsigned int msgCount = 10000;
+
+  transport::NodePtr testNode = transport::NodePtr(new transport::Node());
+  testNode->Init("default");
+
+  transport::PublisherPtr pub = testNode->Advertise<msgs::Image>(
+      "~/test/local_publish_shared__", msgCount);
+
+  transport::SubscriberPtr sub = testNode->Subscribe(
+      "~/test/local_publish_shared__", &LocalPublishCB);
+
+  unsigned int width = 2048;
+  unsigned int height = 2048;
+  std::string fakeData(width * height, 0);
+
+  boost::shared_ptr<msgs::Image> fakeMsg(new msgs::Image);
+  fakeMsg->set_width(width);
+  fakeMsg->set_height(height);
+  fakeMsg->set_pixel_format(0);
+  fakeMsg->set_step(1);
+  fakeMsg->set_data(fakeData);
+
+  common::Time copyTime;
+  common::Time sharedTime;
+  for (bool shared : {false, true})
+  {
+    {
+      boost::mutex::scoped_lock lock(g_mutex);
+      g_localPublishCount = 0;
+      g_totalExpectedMsgCount = msgCount;
+    }
+
+    common::Time startTime = common::Time::GetWallTime();
+    for (unsigned int i = 0; i < msgCount; ++i)
+    {
+      if (shared)
+        pub->Publish(boost::shared_ptr<msgs::Image const>(fakeMsg));
+      else
+        pub->Publish(*fakeMsg);
+    }
+
+    int waitCount = 0;
+    while (g_localPublishCount < g_totalExpectedMsgCount && waitCount < 50)
+    {
+      common::Time::MSleep(100);
+      waitCount++;
+    }
+    EXPECT_EQ(g_totalExpectedMsgCount, g_localPublishCount);
+
+    if (shared)
+      sharedTime = g_localPublishEndTime - startTime;
+    else
+      copyTime = g_localPublishEndTime - startTime;
+  }
+
+  gzmsg << "Time to publish " << msgCount << " images locally\n"
+        << "\t copy   [" << copyTime << "]\n"
+        << "\t shared [" << sharedTime << "]\n";
+}
+
 /////////////////////////////////////////////////
 // Create a lot of nodes, each with a publisher and subscriber. Then send
 // out a few large messages.
@@ -236,6 +312,193 @@ TEST_F(TransportStressTest, ManyNodes)
   delete [] fakeData;
 }
 
+/////////////////////////////////////////////////
+// Measure the round trip time of messages between two connections, which is
+// the latency added by transport::Connection to each remote subscription.
+TEST_F(TransportStressTest, ConnectionLatency)
+{
+  Load("worlds/empty.world");
+
+  std::mutex mutex;
+  std::condition_variable cond;
+  transport::ConnectionPtr accepted;
+  unsigned int replies = 0;
+
+  transport::ConnectionPtr server(new transport::Connection());
+  server->Listen(0, [&](const transport::ConnectionPtr &_conn)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        accepted = _conn;
+        cond.notify_all();
+      });
+
+  transport::ConnectionPtr client(new transport::Connection());
+  ASSERT_TRUE(client->Connect(server->GetLocalAddress(),
+        server->GetLocalPort()));
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(cond.wait_for(lock, std::chrono::seconds(5),
+          [&]() { return accepted != nullptr; }));
+  }
+
+  // The accepted connection sends every message back
+  std::function<void(const std::string &)> echo =
+    [&](const std::string &_data)
+    {
+      accepted->AsyncRead(echo);
+      accepted->EnqueueMsg(_data, true);
+    };
+  accepted->AsyncRead(echo);
+
+  std::function<void(const std::string &)> onReply =
+    [&](const std::string &/*_data*/)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      ++replies;
+      cond.notify_all();
+    };
+
+  const unsigned int msgCount = 1000;
+  for (const std::size_t size : {64u, 65536u, 1048576u})
+  {
+    const std::string payload(size, 'x');
+    std::vector<double> latencies;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      replies = 0;
+    }
+
+    for (unsigned int i = 0; i < msgCount; ++i)
+    {
+      common::Time startTime = common::Time::GetWallTime();
+      client->AsyncRead(onReply);
+      client->EnqueueMsg(payload, true);
+
+      std::unique_lock<std::mutex> lock(mutex);
+      ASSERT_TRUE(cond.wait_for(lock, std::chrono::seconds(5),
+            [&]() { return replies == i + 1; }));
+      latencies.push_back(
+          (common::Time::GetWallTime() - startTime).Double());
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    double mean = 0;
+    for (auto const &latency : latencies)
+      mean += latency;
+    mean /= latencies.size();
+
+    // Out time for human testing purposes
+    gzmsg << "Round trip of " << msgCount << " messages of " << size
+      << " bytes\n"
+      << "\t mean   [" << mean * 1e3 << " ms]\n"
+      << "\t median [" << latencies[latencies.size() / 2] * 1e3 << " ms]\n"
+      << "\t p99    [" << latencies[latencies.size() * 99 / 100] * 1e3
+      << " ms]\n"
+      << "\t max    [" << latencies.back() * 1e3 << " ms]\n";
+
+    // A round trip of a small message on the loopback interface must not
+    // wait for any polling period.
+    if (size == 64u)
+      EXPECT_LT(latencies[latencies.size() / 2], 0.005);
+  }
+
+  client->Shutdown();
+  accepted->Shutdown();
+  server->Shutdown();
+}
+
+/////////////////////////////////////////////////
+// Measure the aggregate throughput of many connections, which are served by
+// the thread pool of the IO manager.
+TEST_F(TransportStressTest, ConnectionThroughput)
+{
+  Load("worlds/empty.world");
+
+  const unsigned int msgCount = 200;
+  const std::string payload(65536, 'x');
+  std::vector<double> throughputs;
+
+  for (const unsigned int clientCount : {1u, 4u, 16u})
+  {
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::vector<transport::ConnectionPtr> accepted;
+    unsigned int received = 0;
+
+    transport::ConnectionPtr server(new transport::Connection());
+    server->Listen(0, [&](const transport::ConnectionPtr &_conn)
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          accepted.push_back(_conn);
+          cond.notify_all();
+        });
+
+    std::vector<transport::ConnectionPtr> clients;
+    for (unsigned int i = 0; i < clientCount; ++i)
+    {
+      transport::ConnectionPtr client(new transport::Connection());
+      ASSERT_TRUE(client->Connect(server->GetLocalAddress(),
+            server->GetLocalPort()));
+      clients.push_back(client);
+    }
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      ASSERT_TRUE(cond.wait_for(lock, std::chrono::seconds(5),
+            [&]() { return accepted.size() == clientCount; }));
+    }
+
+    // Every client keeps reading until it got all its messages
+    std::vector<std::function<void(const std::string &)>> readers(
+        clientCount);
+    std::vector<unsigned int> counts(clientCount, 0);
+    for (unsigned int i = 0; i < clientCount; ++i)
+    {
+      readers[i] = [&, i](const std::string &/*_data*/)
+        {
+          if (++counts[i] < msgCount)
+            clients[i]->AsyncRead(readers[i]);
+
+          std::lock_guard<std::mutex> lock(mutex);
+          ++received;
+          cond.notify_all();
+        };
+      clients[i]->AsyncRead(readers[i]);
+    }
+
+    common::Time startTime = common::Time::GetWallTime();
+    for (unsigned int m = 0; m < msgCount; ++m)
+    {
+      for (auto &conn : accepted)
+        conn->EnqueueMsg(payload, true);
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      ASSERT_TRUE(cond.wait_for(lock, std::chrono::seconds(60),
+            [&]() { return received == msgCount * clientCount; }));
+    }
+    double duration = (common::Time::GetWallTime() - startTime).Double();
+    double throughput =
+      msgCount * clientCount * payload.size() / duration / 1e6;
+    throughputs.push_back(throughput);
+
+    // Out time for human testing purposes
+    gzmsg << clientCount << " connections received "
+      << msgCount * clientCount << " messages of " << payload.size()
+      << " bytes in " << duration << " s [" << throughput << " MB/s]\n";
+
+    for (auto &client : clients)
+      client->Shutdown();
+    for (auto &conn : accepted)
+      conn->Shutdown();
+    server->Shutdown();
+  }
+
+  // Connections are served concurrently when there is more than one core
+  if (std::thread::hardware_concurrency() > 1)
+    EXPECT_GT(throughputs.back(), throughputs.front());
+}
+
 /////////////////////////////////////////////////
 // Main function
 int main(int argc, char **argv)